@@ -365,6 +365,22 @@ class YuvType(enum.Enum) :
     ## Corresponds to T-REC-T.871 standard. Uses Kr=0.299, Kb=0.114. Y, U and V use full range [0..255].
     Trect871 = 3 
 
+## @ingroup python
+# Describes performance statistics of one internal function of %Simd Library. It is used in Simd.Lib.PerformanceStatisticItems.
+class PerformanceStatisticItem(ctypes.Structure) :
+	_fields_ = [
+		("name", ctypes.c_char_p),
+		("thread", ctypes.c_size_t),
+		("count", ctypes.c_uint64),
+		("total", ctypes.c_double),
+		("min", ctypes.c_double),
+		("max", ctypes.c_double),
+		("gflops", ctypes.c_double),
+		("p50", ctypes.c_double),
+		("p90", ctypes.c_double),
+		("p99", ctypes.c_double),
+		("p999", ctypes.c_double) ]
+
 ###################################################################################################
 
 ## @ingroup python
@@ -404,6 +420,15 @@ class Lib():
 		Lib.__lib.SimdPerformanceStatistic.argtypes = []
 		Lib.__lib.SimdPerformanceStatistic.restype = ctypes.c_char_p 
 		
+		Lib.__lib.SimdPerformanceStatisticItems.argtypes = [ ctypes.POINTER(PerformanceStatisticItem), ctypes.c_size_t, ctypes.c_int32 ]
+		Lib.__lib.SimdPerformanceStatisticItems.restype = ctypes.c_size_t 
+		
+		Lib.__lib.SimdPerformanceStatisticJson.argtypes = [ ctypes.c_int32 ]
+		Lib.__lib.SimdPerformanceStatisticJson.restype = ctypes.c_char_p 
+		
+		Lib.__lib.SimdPerformanceStatisticReset.argtypes = []
+		Lib.__lib.SimdPerformanceStatisticReset.restype = None 
+		
 		Lib.__lib.SimdAllocate.argtypes = [ ctypes.c_size_t, ctypes.c_size_t ]
 		Lib.__lib.SimdAllocate.restype = ctypes.c_void_p 
 		
@@ -425,6 +450,9 @@ class Lib():
 		Lib.__lib.SimdSetThreadNumber.argtypes = [ ctypes.c_size_t ]
 		Lib.__lib.SimdSetThreadNumber.restype = None 
 		
+		Lib.__lib.SimdSetThreadAffinity.argtypes = [ ctypes.POINTER(ctypes.c_size_t), ctypes.c_size_t ]
+		Lib.__lib.SimdSetThreadAffinity.restype = ctypes.c_bool 
+		
 		Lib.__lib.SimdEmpty.argtypes = []
 		Lib.__lib.SimdEmpty.restype = None
 		
@@ -669,6 +697,34 @@ class Lib():
 		ptr = Lib.__lib.SimdPerformanceStatistic()
 		return str(ptr, encoding='utf-8')
 	
+	## Gets internal %Simd Library performance statistics in structured form.
+	# @note %Simd Library must be built with switched on SIMD_PERF flag.
+	# @param threads - a flag to get statistics per thread.
+	# @return list of dictionaries with keys: name, thread, count, total, min, max, gflops, p50, p90, p99, p999 (times are in milliseconds).
+	def PerformanceStatisticItems(threads = False) -> list: 
+		size = Lib.__lib.SimdPerformanceStatisticItems(None, 0, 1 if threads else 0)
+		items = (PerformanceStatisticItem * size)()
+		size = min(size, Lib.__lib.SimdPerformanceStatisticItems(items, size, 1 if threads else 0))
+		result = []
+		for i in range(size) :
+			item = { f[0] : getattr(items[i], f[0]) for f in PerformanceStatisticItem._fields_ }
+			item["name"] = str(item["name"], encoding='utf-8')
+			result.append(item)
+		return result
+	
+	## Gets internal %Simd Library performance statistics in JSON format.
+	# @note %Simd Library must be built with switched on SIMD_PERF flag.
+	# @param threads - a flag to get statistics per thread.
+	# @return string with internal %Simd Library performance statistics in JSON format.	
+	def PerformanceStatisticJson(threads = False) -> str: 
+		ptr = Lib.__lib.SimdPerformanceStatisticJson(1 if threads else 0)
+		return str(ptr, encoding='utf-8')
+	
+	## Resets internal %Simd Library performance statistics.
+	# @note %Simd Library must be built with switched on SIMD_PERF flag.
+	def PerformanceStatisticReset(): 
+		Lib.__lib.SimdPerformanceStatisticReset()
+	
     ## Allocates aligned memory block.
     # @note The memory allocated by this function is must be deleted by function Simd.Lib.Free.
 	# @param size - an original size.
@@ -710,6 +766,13 @@ class Lib():
 	def SetThreadNumber(threadNumber: int) : 
 		Lib.__lib.SimdSetThreadNumber(threadNumber)
 		
+	## Restricts worker threads of %Simd Library to given set of CPUs (only on Linux).
+	# @param cpus - a list of CPU indices. Empty list removes the restriction.
+	# @return result of the operation.
+	def SetThreadAffinity(cpus : list) -> bool : 
+		array = (ctypes.c_size_t * len(cpus))(*cpus)
+		return Lib.__lib.SimdSetThreadAffinity(array, len(cpus))
+		
 	## Clears MMX registers.
 	# Clears MMX registers (runs EMMS instruction). It is x86 specific functionality.
 	def ClearMmx(): 
@@ -25,6 +25,7 @@ import ctypes
 import pathlib
 import sys
 import array
+import json
 import numpy
 
 import Simd
@@ -144,6 +145,24 @@ def SynetSetInputTest(args) :
 
 ###################################################################################################
 
+def PerformanceStatisticTest(args) :
+	image = LoadTestImage(args)
+	Simd.Resized(image, image.Width() // 2, image.Height() // 2, Simd.ResizeMethod.Area)
+	items = Simd.Lib.PerformanceStatisticItems(True)
+	statistics = json.loads(Simd.Lib.PerformanceStatisticJson(True))["statistics"]
+	if len(items) != len(statistics) :
+		raise Exception("PerformanceStatisticItems returns {0} items, but PerformanceStatisticJson returns {1}!".format(len(items), len(statistics)))
+	for item, stat in zip(items, statistics) :
+		if item["name"] != stat["name"] or item["thread"] != stat["thread"] or item["count"] != stat["count"] :
+			raise Exception("PerformanceStatisticItems and PerformanceStatisticJson mismatch for '{0}'!".format(item["name"]))
+	Simd.Lib.PerformanceStatisticReset()
+	for item in Simd.Lib.PerformanceStatisticItems(False) :
+		if item["count"] != 0 :
+			raise Exception("Performance statistic of '{0}' is not reset!".format(item["name"]))
+	print("Performance statistic items: {0}. ".format(len(items)), end="")
+
+###################################################################################################
+
 def InitTestList(args) :
 	tests = []
 	tests.append(PrintInfoTest)
@@ -156,6 +175,7 @@ def InitTestList(args) :
 	tests.append(ImageWarpAffineTest)
 	tests.append(ImageToNumpyArrayTest)
 	tests.append(SynetSetInputTest) 
+	tests.append(PerformanceStatisticTest)
 	
 	filtered = []
 	for test in tests:
@@ -0,0 +1,100 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdCpu.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdSse41.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX2_ENABLE) && (defined(_MSC_VER) || defined(__VPCLMULQDQ__))
+    namespace Avx2
+    {
+        const bool VpclmulEnable = Base::CheckBit(7, 0, Cpuid::Ecx, Cpuid::VPCLMULQDQ);
+
+        SIMD_INLINE __m128i Crc32Fold(__m128i a, __m128i b, __m128i k)
+        {
+            return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(a, k, 0x00), _mm_clmulepi64_si128(a, k, 0x11)), b);
+        }
+
+        SIMD_INLINE __m256i Crc32Fold(__m256i a, __m256i b, __m256i k)
+        {
+            return _mm256_xor_si256(_mm256_xor_si256(_mm256_clmulepi64_epi128(a, k, 0x00), _mm256_clmulepi64_epi128(a, k, 0x11)), b);
+        }
+
+        SIMD_INLINE uint32_t Crc32Reduce(__m128i x0)
+        {
+            const __m128i k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+            const __m128i k5 = _mm_set_epi64x(0x0000000000, 0x0163cd6124);
+            const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+            const __m128i mask = _mm_setr_epi32(-1, 0, -1, 0);
+            __m128i x1 = _mm_xor_si128(_mm_srli_si128(x0, 8), _mm_clmulepi64_si128(x0, k4, 0x10));
+            x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), k5, 0x00), _mm_srli_si128(x1, 4));
+            __m128i x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), poly, 0x10);
+            x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), poly, 0x00);
+            return ~(uint32_t)_mm_extract_epi32(_mm_xor_si128(x1, x2), 1);
+        }
+
+        uint32_t Crc32(const void* src, size_t size)
+        {
+            if (!VpclmulEnable || size < 256)
+                return Sse41::Crc32(src, size);
+            const uint8_t* p = (const uint8_t*)src;
+            const __m256i k1 = _mm256_set_epi64x(0x014a7fe880, 0x01e88ef372, 0x014a7fe880, 0x01e88ef372);
+            const __m256i k2 = _mm256_set_epi64x(0x015a546366, 0x00f1da05aa, 0x015a546366, 0x00f1da05aa);
+            const __m128i k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+            __m256i y0 = _mm256_xor_si256(_mm256_loadu_si256((__m256i*)p + 0), _mm256_setr_epi32(-1, 0, 0, 0, 0, 0, 0, 0));
+            __m256i y1 = _mm256_loadu_si256((__m256i*)p + 1);
+            __m256i y2 = _mm256_loadu_si256((__m256i*)p + 2);
+            __m256i y3 = _mm256_loadu_si256((__m256i*)p + 3);
+            size_t i = 128, size128 = AlignLo(size, 128), size32 = AlignLo(size, 32), size16 = AlignLo(size, 16);
+            for (; i < size128; i += 128)
+            {
+                y0 = Crc32Fold(y0, _mm256_loadu_si256((__m256i*)(p + i) + 0), k1);
+                y1 = Crc32Fold(y1, _mm256_loadu_si256((__m256i*)(p + i) + 1), k1);
+                y2 = Crc32Fold(y2, _mm256_loadu_si256((__m256i*)(p + i) + 2), k1);
+                y3 = Crc32Fold(y3, _mm256_loadu_si256((__m256i*)(p + i) + 3), k1);
+            }
+            y0 = Crc32Fold(y0, y1, k2);
+            y0 = Crc32Fold(y0, y2, k2);
+            y0 = Crc32Fold(y0, y3, k2);
+            for (; i < size32; i += 32)
+                y0 = Crc32Fold(y0, _mm256_loadu_si256((__m256i*)(p + i)), k2);
+            __m128i x0 = Crc32Fold(_mm256_castsi256_si128(y0), _mm256_extracti128_si256(y0, 1), k4);
+            for (; i < size16; i += 16)
+                x0 = Crc32Fold(x0, _mm_loadu_si128((__m128i*)(p + i)), k4);
+            return Base::Crc32(Crc32Reduce(x0), p + i, size - i);
+        }
+    }
+#elif defined(SIMD_AVX2_ENABLE)
+    namespace Avx2
+    {
+        uint32_t Crc32(const void* src, size_t size)
+        {
+            return Sse41::Crc32(src, size);
+        }
+    }
+#endif
+}
@@ -0,0 +1,86 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdImageLoad.h"
+#include "Simd/SimdImageLoadPng.h"
+#include "Simd/SimdImageSavePng.h"
+#include "Simd/SimdAvx2.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX2_ENABLE)
+    namespace Avx2
+    {
+        SIMD_INLINE void ZlibCopy(uint8_t* dst, size_t dist, size_t len)
+        {
+            const uint8_t* src = dst - dist;
+            uint8_t* stop = dst + len;
+            if (dist >= 32)
+            {
+                do
+                {
+                    _mm256_storeu_si256((__m256i*)dst, _mm256_loadu_si256((__m256i*)src));
+                    src += 32;
+                    dst += 32;
+                } while (dst < stop);
+            }
+            else if (dist >= 16)
+            {
+                do
+                {
+                    _mm_storeu_si128((__m128i*)dst, _mm_loadu_si128((__m128i*)src));
+                    src += 16;
+                    dst += 16;
+                } while (dst < stop);
+            }
+            else
+            {
+                static const uint8_t STEP[16] = { 0, 32, 32, 30, 32, 30, 30, 28, 32, 27, 30, 22, 24, 26, 28, 30 };
+                __m256i _src = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)src));
+                __m256i pattern = _mm256_shuffle_epi8(_src, _mm256_loadu_si256((__m256i*)Base::ZlibPattern[dist]));
+                size_t step = STEP[dist];
+                do
+                {
+                    _mm256_storeu_si256((__m256i*)dst, pattern);
+                    dst += step;
+                } while (dst < stop);
+            }
+        }
+
+        bool ZlibDecode(InputMemoryStream& is, OutputMemoryStream& os, bool parseHeader)
+        {
+            return Base::ZlibDecode(is, os, parseHeader, Base::ZlibParseHuffmanBlock<ZlibCopy>, Avx2::ZlibAdler32);
+        }
+
+        //---------------------------------------------------------------------
+
+        ImagePngLoader::ImagePngLoader(const ImageLoaderParam& param)
+            : Sse41::ImagePngLoader(param)
+        {
+            _zlibDecode = Avx2::ZlibDecode;
+            _crc32 = Avx2::Crc32;
+        }
+    }
+#endif
+}
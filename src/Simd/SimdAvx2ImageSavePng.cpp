@@ -33,37 +33,37 @@ namespace Simd
 #ifdef SIMD_AVX2_ENABLE    
     namespace Avx2
     {
-        static uint32_t ZlibAdler32(uint8_t* data, int size)
+        uint32_t ZlibAdler32(const uint8_t* data, int size)
         {
-            __m256i _i0 = _mm256_setr_epi32(0, -1, -2, -3, -4, -5, -6, -7), _8 = _mm256_set1_epi32(8);
+            const int BASE = 65521, BLOCK = 5552 / 32;
+            const __m256i tap = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+                16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
             uint32_t lo = 1, hi = 0;
-            for (int b = 0, n = (int)(size % 5552); b < size;)
+            for (int blocks = size / 32; blocks > 0;)
             {
-                int n8 = n & (~7), i = 0;
-                __m256i _i = _mm256_add_epi32(_i0, _mm256_set1_epi32(n));
-                __m256i _l = _mm256_setzero_si256(), _h = _mm256_setzero_si256();
-                for (; i < n8; i += 8)
+                int n = Simd::Min(blocks, BLOCK);
+                blocks -= n, size -= n * 32;
+                __m256i _p = _mm256_setr_epi32(lo * n, 0, 0, 0, 0, 0, 0, 0), _l = _mm256_setzero_si256(), _h = _mm256_setr_epi32(hi, 0, 0, 0, 0, 0, 0, 0);
+                for (; n > 0; n -= 1, data += 32)
                 {
-                    __m256i d = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)(data + b + i)));
-                    _l = _mm256_add_epi32(_l, d);
-                    _h = _mm256_add_epi32(_h, _mm256_mullo_epi32(d, _i));
-                    _i = _mm256_sub_epi32(_i, _8);
+                    __m256i d = _mm256_loadu_si256((__m256i*)data);
+                    _p = _mm256_add_epi32(_p, _l);
+                    _l = _mm256_add_epi32(_l, _mm256_sad_epu8(d, K_ZERO));
+                    _h = _mm256_add_epi32(_h, _mm256_madd_epi16(_mm256_maddubs_epi16(d, tap), K16_0001));
                 }
-                int l = Avx2::ExtractSum<uint32_t>(_l), h = Avx2::ExtractSum<uint32_t>(_h);
-                for (; i < n; ++i)
-                {
-                    l += data[b + i];
-                    h += data[b + i]*(n - i);
-                }
-                hi = (hi + h + lo*n) % 65521;
-                lo = (lo + l) % 65521;
-                b += n;
-                n = 5552;
+                _h = _mm256_add_epi32(_h, _mm256_slli_epi32(_p, 5));
+                lo = (lo + ExtractSum<uint32_t>(_l)) % BASE;
+                hi = ExtractSum<uint32_t>(_h) % BASE;
+            }
+            for (; size > 0; size -= 1)
+            {
+                lo += *data++;
+                hi += lo;
             }
-            return (hi << 16) | lo;
+            return ((hi % BASE) << 16) | (lo % BASE);
         }
 
-        void ZlibCompress(uint8_t* data, int size, int quality, OutputMemoryStream& stream)
+        void ZlibDeflate(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream)
         {
             const int ZHASH = 16384;
             if (quality < 5)
@@ -71,23 +71,22 @@ namespace Simd
             const int basket = quality * 2;
             Array32i hashTable(ZHASH * basket);
             memset(hashTable.data, -1, hashTable.RawSize());
+            Base::ZlibPrime(hashTable.data, basket, quality, data, begin);
 
-            stream.Write(uint8_t(0x78));
-            stream.Write(uint8_t(0x5e));
-            stream.WriteBits(1, 1);
+            stream.WriteBits(last ? 1 : 0, 1);
             stream.WriteBits(1, 2);
 
-            int i = 0, j;
-            while (i < size - 3)
+            int i = begin, j;
+            while (i < end - 3)
             {
                 int h = Base::ZlibHash(data + i) & (ZHASH - 1), best = 3;
-                uint8_t* bestLoc = 0;
+                const uint8_t* bestLoc = 0;
                 int* hList = hashTable.data + h * basket;
                 for (j = 0; hList[j] != -1 && j < basket; ++j)
                 {
                     if (hList[j] > i - 32768)
                     {
-                        int d = Avx2::ZlibCount(data + hList[j], data + i, size - i);
+                        int d = Avx2::ZlibCount(data + hList[j], data + i, end - i);
                         if (d >= best)
                         {
                             best = d;
@@ -111,7 +110,7 @@ namespace Simd
                     {
                         if (hList[j] > i - 32767)
                         {
-                            int e = Avx2::ZlibCount(data + hList[j], data + i + 1, size - i - 1);
+                            int e = Avx2::ZlibCount(data + hList[j], data + i + 1, end - i - 1);
                             if (e > best)
                             {
                                 bestLoc = NULL;
@@ -141,11 +140,19 @@ namespace Simd
                     ++i;
                 }
             }
-            for (; i < size; ++i)
+            for (; i < end; ++i)
                 Base::ZlibHuffB(data[i], stream);
             Base::ZlibHuff(256, stream);
+            if (!last)
+                stream.WriteBits(0, 3);
             stream.FlushBits();
-            stream.WriteBe32u(ZlibAdler32(data, size));
+            if (!last)
+                stream.WriteBe32u(0x0000FFFF);
+        }
+
+        void ZlibDeflateRle(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream)
+        {
+            Base::ZlibDeflateDynamic(data, begin, end, last, Base::ZlibTokenizeRle<Avx2::ZlibCount>, stream);
         }
 
         uint32_t EncodeLine0(const uint8_t* src, size_t stride, size_t n, size_t size, int8_t* dst)
@@ -363,7 +370,10 @@ namespace Simd
             _encode[4] = Avx2::EncodeLine4;
             _encode[5] = Avx2::EncodeLine5;
             _encode[6] = Avx2::EncodeLine6;
-            _compress = Avx2::ZlibCompress;
+            _adler32 = Avx2::ZlibAdler32;
+            _crc32 = Avx2::Crc32;
+            _deflate = Avx2::ZlibDeflate;
+            _deflateRle = Avx2::ZlibDeflateRle;
         }
     }
 #endif// SIMD_AVX2_ENABLE
@@ -35,7 +35,7 @@ namespace Simd
     {
         void * ResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method)
         {
-            ResParam param(srcX, srcY, dstX, dstY, channels, type, method, sizeof(__m256i));
+            ResParam param(srcX, srcY, dstX, dstY, channels, type, method, sizeof(__m256i), ResizerInit);
             if (param.IsNearest() && dstX >= F)
                 return new ResizerNearest(param);
             else if (param.IsByteBilinear() && dstX >= A)
@@ -56,9 +56,19 @@ namespace Simd
 #endif
             else if (param.IsByteArea1x1())
                 return new ResizerByteArea1x1(param);
+            else if (param.IsKernel())
+                return new ResizerKernel(param);
             else
                 return Sse41::ResizerInit(srcX, srcY, dstX, dstY, channels, type, method);
         }
+
+        void* ResizerKernelInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, const float* kernel, size_t size, float support)
+        {
+            ResParam param(srcX, srcY, dstX, dstY, channels, type, SimdResizeMethodKernel, sizeof(__m256i), ResizerInit);
+            if (kernel == NULL || size < 2 || !(support > 0.0f))
+                return NULL;
+            return new ResizerKernel(param, kernel, size, support);
+        }
     }
 #endif 
 }
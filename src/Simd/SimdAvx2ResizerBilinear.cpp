@@ -42,16 +42,19 @@ namespace Simd
 
         void ResizerByteBilinear::EstimateParams()
         {
-            if (_ax.data)
+            if (_xSrcW == _param.srcW)
                 return;
-            if (_param.channels == 1 && _param.srcW < 4 * _param.dstW)
+            _xSrcW = _param.srcW;
+            _blocks = 0;
+            if (_param.channels == 1 && _param.srcW < 4 * _param.dstW && _param.srcW >= A)
                 _blocks = BlockCountMax(A);
             float scale = (float)_param.srcW / _param.dstW;
             _ax.Resize(AlignHi(_param.dstW, A) * _param.channels * 2, false, _param.align);
             uint8_t * alphas = _ax.data;
             if (_blocks)
             {
-                _ixg.Resize(_blocks);
+                if (_ixg.size < _blocks)
+                    _ixg.Resize(_blocks);
                 int block = 0;
                 _ixg[0].src = 0;
                 _ixg[0].dst = 0;
@@ -244,7 +247,7 @@ namespace Simd
             const uint8_t * ax = _ax.data;
             const int32_t * ix = _ix.data;
 
-            for (size_t yDst = 0; yDst < _param.dstH; yDst++, dst += dstStride)
+            for (size_t yDst = _yBeg; yDst < _yEnd; yDst++, dst += dstStride)
             {
                 a[0] = _mm256_set1_epi16(int16_t(Base::FRACTION_RANGE - _ay[yDst]));
                 a[1] = _mm256_set1_epi16(int16_t(_ay[yDst]));
@@ -293,7 +296,7 @@ namespace Simd
             const uint8_t * ax = _ax.data;
             const Idx * ixg = _ixg.data;
 
-            for (size_t yDst = 0; yDst < _param.dstH; yDst++, dst += dstStride)
+            for (size_t yDst = _yBeg; yDst < _yEnd; yDst++, dst += dstStride)
             {
                 a[0] = _mm256_set1_epi16(int16_t(Base::FRACTION_RANGE - _ay[yDst]));
                 a[1] = _mm256_set1_epi16(int16_t(_ay[yDst]));
@@ -441,7 +444,7 @@ namespace Simd
             size_t rs8 = AlignLo(rs, 8);
             size_t rs16 = AlignLo(rs, 16);
             __m256 _1 = _mm256_set1_ps(1.0f);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -592,7 +595,7 @@ namespace Simd
             size_t rs8 = AlignLo(rs, 8);
             size_t rs16 = AlignLo(rs, 16);
             __m256 _1 = _mm256_set1_ps(1.0f);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -820,7 +823,7 @@ namespace Simd
                 size_t rs3 = rs - 3, rs6 = AlignLoAny(rs3, 6), rscn = rs - cn, cnHF = cn - HF;
                 float* pbx[2] = { _bx[0].data, _bx[1].data };
                 int32_t prev = -2;
-                for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                 {
                     float fy1 = _ay[dy];
                     float fy0 = 1.0f - fy1;
@@ -1009,7 +1012,7 @@ namespace Simd
             }
             else
             {
-                for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                 {
                     __m256 fy1 = _mm256_set1_ps(_ay[dy]);
                     __m256 fy0 = _mm256_sub_ps(_1, fy1);
@@ -1281,7 +1284,7 @@ namespace Simd
                 size_t rs3 = AlignLoAny(rs - 1, 3), rs6 = AlignLoAny(rs - 1, 6);
                 float* pbx[2] = { _bx[0].data, _bx[1].data };
                 int32_t prev = -2;
-                for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                 {
                     float fy1 = _ay[dy];
                     float fy0 = 1.0f - fy1;
@@ -1472,7 +1475,7 @@ namespace Simd
             {
                 if (cnD)
                 {
-                    for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                    for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                     {
                         __m256 fy1 = _mm256_set1_ps(_ay[dy]);
                         __m256 fy0 = _mm256_sub_ps(_1, fy1);
@@ -1520,7 +1523,7 @@ namespace Simd
                 }
                 else if (cnF)
                 {
-                    for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                    for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                     {
                         __m256 fy1 = _mm256_set1_ps(_ay[dy]);
                         __m256 fy0 = _mm256_sub_ps(_1, fy1);
@@ -1551,7 +1554,7 @@ namespace Simd
                 }
                 else
                 {
-                    for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                    for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                     {
                         __m128 fy1 = _mm_set1_ps(_ay[dy]);
                         __m128 fy0 = _mm_sub_ps(_mm256_castps256_ps128(_1), fy1);
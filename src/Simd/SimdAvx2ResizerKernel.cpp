@@ -0,0 +1,176 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdResizer.h"
+#include "Simd/SimdBFloat16.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX2_ENABLE
+    namespace Avx2
+    {
+        ResizerKernel::ResizerKernel(const ResParam& param, const float* kernel, size_t size, float support)
+            : Sse41::ResizerKernel(param, kernel, size, support)
+        {
+            _kernelInit = ResizerKernelInit;
+        }
+
+        void ResizerKernel::Convert(const uint8_t* src, float* dst)
+        {
+            size_t size = _param.srcW * _param.channels, sizeF = AlignLo(size, F), i = 0;
+            switch (_param.type)
+            {
+            case SimdResizeChannelByte:
+                for (; i < sizeF; i += F)
+                    _mm256_storeu_si256((__m256i*)dst + i / F, _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)(src + i))));
+                for (; i < size; ++i)
+                    ((int32_t*)dst)[i] = src[i];
+                break;
+            case SimdResizeChannelShort:
+                for (; i < sizeF; i += F)
+                    _mm256_storeu_ps(dst + i, _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)((uint16_t*)src + i)))));
+                for (; i < size; ++i)
+                    dst[i] = float(((uint16_t*)src)[i]);
+                break;
+            case SimdResizeChannelBf16:
+                for (; i < sizeF; i += F)
+                    _mm256_storeu_ps(dst + i, BFloat16ToFloat32(_mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)((uint16_t*)src + i)))));
+                for (; i < size; ++i)
+                    dst[i] = Base::BFloat16ToFloat32(((uint16_t*)src)[i]);
+                break;
+            default:
+                assert(0);
+            }
+        }
+
+        void ResizerKernel::Horizontal(const float* src, float* dst)
+        {
+            size_t C = _param.channels, taps = _xTaps, size = _rowSize;
+            if (_param.type == SimdResizeChannelByte)
+            {
+                __m256i round = _mm256_set1_epi32(Base::KERNEL_X_ROUND);
+                for (size_t j = 0; j < size; j += F)
+                {
+                    __m256i ix = _mm256_load_si256((__m256i*)(_ix.data + j));
+                    const int* ps = (int*)src;
+                    const int32_t* pa = _axi.data + j;
+                    __m256i sum = _mm256_setzero_si256();
+                    for (size_t t = 0; t < taps; ++t, ps += C, pa += size)
+                        sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(_mm256_i32gather_epi32(ps, ix, 4), _mm256_load_si256((__m256i*)pa)));
+                    _mm256_store_si256((__m256i*)dst + j / F, _mm256_srai_epi32(_mm256_add_epi32(sum, round), Base::KERNEL_X_SHIFT));
+                }
+            }
+            else
+            {
+                for (size_t j = 0; j < size; j += F)
+                {
+                    __m256i ix = _mm256_load_si256((__m256i*)(_ix.data + j));
+                    const float* ps = src;
+                    const float* pa = _ax.data + j;
+                    __m256 sum = _mm256_setzero_ps();
+                    for (size_t t = 0; t < taps; ++t, ps += C, pa += size)
+                        sum = _mm256_fmadd_ps(_mm256_i32gather_ps(ps, ix, 4), _mm256_load_ps(pa), sum);
+                    _mm256_store_ps(dst + j, sum);
+                }
+            }
+        }
+
+        SIMD_INLINE __m256 KernelVertical(const float* const* rows, const float* ay, size_t taps, size_t offset)
+        {
+            __m256 sum = _mm256_setzero_ps();
+            for (size_t t = 0; t < taps; ++t)
+                sum = _mm256_fmadd_ps(_mm256_set1_ps(ay[t]), _mm256_load_ps(rows[t] + offset), sum);
+            return sum;
+        }
+
+        template<SimdResizeChannelType type> SIMD_INLINE void KernelStore(__m256 value, uint8_t* dst);
+
+        template<> SIMD_INLINE void KernelStore<SimdResizeChannelShort>(__m256 value, uint8_t* dst)
+        {
+            __m256i i32 = _mm256_cvtps_epi32(value);
+            _mm_storeu_si128((__m128i*)dst, _mm_packus_epi32(_mm256_castsi256_si128(i32), _mm256_extracti128_si256(i32, 1)));
+        }
+
+        template<> SIMD_INLINE void KernelStore<SimdResizeChannelFloat>(__m256 value, uint8_t* dst)
+        {
+            _mm256_storeu_ps((float*)dst, value);
+        }
+
+        template<> SIMD_INLINE void KernelStore<SimdResizeChannelBf16>(__m256 value, uint8_t* dst)
+        {
+            __m256i bf16 = Float32ToBFloat16(value);
+            _mm_storeu_si128((__m128i*)dst, _mm_packus_epi32(_mm256_castsi256_si128(bf16), _mm256_extracti128_si256(bf16, 1)));
+        }
+
+        template<SimdResizeChannelType type> void KernelVertical(const float* const* rows, const float* ay, size_t taps, size_t size, size_t elem, uint8_t* dst)
+        {
+            uint8_t buf[A];
+            size_t sizeF = AlignLo(size, F), j = 0;
+            for (; j < sizeF; j += F)
+                KernelStore<type>(KernelVertical(rows, ay, taps, j), dst + j * elem);
+            if (j < size)
+            {
+                KernelStore<type>(KernelVertical(rows, ay, taps, j), buf);
+                memcpy(dst + j * elem, buf, (size - j) * elem);
+            }
+        }
+
+        SIMD_INLINE __m128i KernelVertical(const float* const* rows, const int32_t* ay, size_t taps, size_t offset)
+        {
+            __m256i sum = _mm256_setzero_si256();
+            for (size_t t = 0; t < taps; ++t)
+                sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(_mm256_set1_epi32(ay[t]), _mm256_load_si256((__m256i*)(rows[t] + offset))));
+            sum = _mm256_srai_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(Base::KERNEL_Y_ROUND)), Base::KERNEL_Y_SHIFT);
+            __m128i i16 = _mm_packs_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+            return _mm_packus_epi16(i16, Sse41::K_ZERO);
+        }
+
+        void KernelVertical(const float* const* rows, const int32_t* ay, size_t taps, size_t size, uint8_t* dst)
+        {
+            size_t sizeF = AlignLo(size, F), j = 0;
+            for (; j < sizeF; j += F)
+                _mm_storel_epi64((__m128i*)(dst + j), KernelVertical(rows, ay, taps, j));
+            if (j < size)
+            {
+                uint8_t buf[Sse41::A];
+                _mm_storel_epi64((__m128i*)buf, KernelVertical(rows, ay, taps, j));
+                memcpy(dst + j, buf, size - j);
+            }
+        }
+
+        void ResizerKernel::Vertical(const float* const* rows, size_t dy, uint8_t* dst)
+        {
+            size_t size = _param.dstW * _param.channels, taps = _yTaps, elem = _param.ChannelSize();
+            switch (_param.type)
+            {
+            case SimdResizeChannelByte: KernelVertical(rows, _ayi.data + dy * taps, taps, size, dst); break;
+            case SimdResizeChannelShort: KernelVertical<SimdResizeChannelShort>(rows, _ay.data + dy * taps, taps, size, elem, dst); break;
+            case SimdResizeChannelFloat: KernelVertical<SimdResizeChannelFloat>(rows, _ay.data + dy * taps, taps, size, elem, dst); break;
+            case SimdResizeChannelBf16: KernelVertical<SimdResizeChannelBf16>(rows, _ay.data + dy * taps, taps, size, elem, dst); break;
+            default: assert(0);
+            }
+        }
+    }
+#endif
+}
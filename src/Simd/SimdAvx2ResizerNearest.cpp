@@ -67,7 +67,7 @@ namespace Simd
         {
             size_t body = AlignLo(_param.dstW, 8);
             size_t tail = _param.dstW - 8;
-            for (size_t dy = 0; dy < _param.dstH; dy++)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++)
             {
                 const uint8_t* srcRow = src + _iy[dy] * srcStride;
                 for (size_t dx = 0, offs = 0; dx < body; dx += 8, offs += 16)
@@ -88,7 +88,7 @@ namespace Simd
         {
             size_t body = AlignLo(_param.dstW - 1, 8);
             size_t tail = _param.dstW - 8;
-            for (size_t dy = 0; dy < _param.dstH; dy++)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++)
             {
                 const uint8_t* srcRow = src + _iy[dy] * srcStride;
                 for (size_t dx = 0, offs = 0; dx < body; dx +=8, offs += 24)
@@ -109,7 +109,7 @@ namespace Simd
         {
             size_t body = AlignLo(_param.dstW, 8);
             size_t tail = _param.dstW - 8;
-            for (size_t dy = 0; dy < _param.dstH; dy++)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++)
             {
                 const int32_t* srcRow = (int32_t*)(src + _iy[dy] * srcStride);
                 for (size_t dx = 0; dx < body; dx += 8)
@@ -130,7 +130,7 @@ namespace Simd
         {
             size_t body = AlignLo(_param.dstW, 4);
             size_t tail = _param.dstW - 4;
-            for (size_t dy = 0; dy < _param.dstH; dy++)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++)
             {
                 const int64_t* srcRow = (int64_t*)(src + _iy[dy] * srcStride);
                 for (size_t dx = 0; dx < body; dx += 4)
@@ -0,0 +1,196 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetPreprocess.h"
+#include "Simd/SimdBFloat16.h"
+#include "Simd/SimdExtract.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdAvx2.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX2_ENABLE) && defined(SIMD_SYNET_ENABLE)    
+    namespace Avx2
+    {
+        void SynetPreprocessHorizontal1(const uint8_t* src, size_t srcW, size_t channels, const int32_t* ix, const float* ax, size_t taps, size_t dstW, bool planar, float* dst)
+        {
+            size_t x = 0;
+            if (taps == 2)
+            {
+                size_t dstW8 = AlignLo(dstW, 8);
+                for (; x < dstW8; x += 8, ax += 16)
+                {
+                    __m256i s = _mm256_setr_epi32(*(uint16_t*)(src + ix[x + 0]), *(uint16_t*)(src + ix[x + 1]), *(uint16_t*)(src + ix[x + 2]), 
+                        *(uint16_t*)(src + ix[x + 3]), *(uint16_t*)(src + ix[x + 4]), *(uint16_t*)(src + ix[x + 5]), *(uint16_t*)(src + ix[x + 6]), *(uint16_t*)(src + ix[x + 7]));
+                    __m256 s0 = _mm256_cvtepi32_ps(_mm256_and_si256(s, K32_000000FF));
+                    __m256 s1 = _mm256_cvtepi32_ps(_mm256_srli_epi32(s, 8));
+                    __m256 a01 = _mm256_loadu_ps(ax + 0), a23 = _mm256_loadu_ps(ax + F);
+                    __m256 a0 = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a01, a23, 0x88)), 0xD8));
+                    __m256 a1 = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a01, a23, 0xDD)), 0xD8));
+                    _mm256_storeu_ps(dst + x, _mm256_add_ps(_mm256_mul_ps(a0, s0), _mm256_mul_ps(a1, s1)));
+                }
+            }
+            else if (taps >= 8)
+            {
+                size_t taps8 = AlignLo(taps, 8);
+                for (; x < dstW; ++x, ax += taps)
+                {
+                    const uint8_t* s = src + ix[x];
+                    __m256 sum = _mm256_setzero_ps();
+                    size_t t = 0;
+                    for (; t < taps8; t += 8)
+                        sum = _mm256_fmadd_ps(_mm256_loadu_ps(ax + t), _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i*)(s + t)))), sum);
+                    float res = ExtractSum(sum);
+                    for (; t < taps; ++t)
+                        res += ax[t] * float(s[t]);
+                    dst[x] = res;
+                }
+            }
+            if (x < dstW)
+                Sse41::SynetPreprocessHorizontal1(src, srcW, 1, ix + x, ax, taps, dstW - x, planar, dst + x);
+        }
+
+        static void SynetPreprocessMulRow(const float* src, float weight, size_t size, float* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i = 0;
+            __m256 _weight = _mm256_set1_ps(weight);
+            for (; i < sizeF; i += F)
+                _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), _weight));
+            for (; i < size; ++i)
+                dst[i] = src[i] * weight;
+        }
+
+        static void SynetPreprocessAddMulRow(const float* src, float weight, size_t size, float* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i = 0;
+            __m256 _weight = _mm256_set1_ps(weight);
+            for (; i < sizeF; i += F)
+                _mm256_storeu_ps(dst + i, _mm256_fmadd_ps(_mm256_loadu_ps(src + i), _weight, _mm256_loadu_ps(dst + i)));
+            for (; i < size; ++i)
+                dst[i] += src[i] * weight;
+        }
+
+        SIMD_INLINE __m256 Normalize(const float* src, const float* scale, const float* shift)
+        {
+            return _mm256_fmadd_ps(_mm256_loadu_ps(src), _mm256_loadu_ps(scale), _mm256_loadu_ps(shift));
+        }
+
+        static void SynetPreprocessStore32f(const float* src, const float* scale, const float* shift, size_t size, uint8_t* dst)
+        {
+            float* dst32f = (float*)dst;
+            size_t sizeF = AlignLo(size, F), i = 0;
+            for (; i < sizeF; i += F)
+                _mm256_storeu_ps(dst32f + i, Normalize(src + i, scale + i, shift + i));
+            for (; i < size; ++i)
+                dst32f[i] = src[i] * scale[i] + shift[i];
+        }
+
+        static void SynetPreprocessStore16b(const float* src, const float* scale, const float* shift, size_t size, uint8_t* dst)
+        {
+            uint16_t* dst16b = (uint16_t*)dst;
+            size_t sizeDF = AlignLo(size, DF), i = 0;
+            for (; i < sizeDF; i += DF)
+            {
+                __m256 lo = Normalize(src + i + 0, scale + i + 0, shift + i + 0);
+                __m256 hi = Normalize(src + i + F, scale + i + F, shift + i + F);
+                _mm256_storeu_si256((__m256i*)(dst16b + i), Float32ToBFloat16(lo, hi));
+            }
+            for (; i < size; ++i)
+                dst16b[i] = Base::Float32ToBFloat16(src[i] * scale[i] + shift[i]);
+        }
+
+        static void SynetPreprocessStore8u(const float* src, const float* scale, const float* shift, size_t size, uint8_t* dst)
+        {
+            size_t sizeDF = AlignLo(size, DF), i = 0;
+            for (; i < sizeDF; i += DF)
+            {
+                __m256i lo = _mm256_cvtps_epi32(Normalize(src + i + 0, scale + i + 0, shift + i + 0));
+                __m256i hi = _mm256_cvtps_epi32(Normalize(src + i + F, scale + i + F, shift + i + F));
+                __m256i i16 = PackI32ToI16(lo, hi);
+                _mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(_mm256_castsi256_si128(i16), _mm256_extracti128_si256(i16, 1)));
+            }
+            for (; i < size; ++i)
+                dst[i] = (uint8_t)RestrictRange(Round(src[i] * scale[i] + shift[i]), 0, 255);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SynetPreprocess::SynetPreprocess(const PreprocessParam& param)
+            : Sse41::SynetPreprocess(param)
+        {
+            const PreprocessParam& p = _param;
+            if (p.srcW >= DA)
+            {
+                if (p.channels == 3)
+                {
+                    switch (p.srcFormat)
+                    {
+                    case SimdPixelFormatGray8: _convert = GrayToBgr; break;
+                    case SimdPixelFormatRgb24: _convert = BgrToRgb; break;
+                    case SimdPixelFormatBgra32: _convert = BgraToBgr; break;
+                    case SimdPixelFormatRgba32: _convert = BgraToRgb; break;
+                    default: break;
+                    }
+                }
+                else
+                {
+                    switch (p.srcFormat)
+                    {
+                    case SimdPixelFormatBgr24: _convert = BgrToGray; break;
+                    case SimdPixelFormatRgb24: _convert = RgbToGray; break;
+                    case SimdPixelFormatBgra32: _convert = BgraToGray; break;
+                    case SimdPixelFormatRgba32: _convert = RgbaToGray; break;
+                    case SimdPixelFormatNv12: _toGray = BgrToGray; break;
+                    case SimdPixelFormatYuv420p: _toGray = BgrToGray; break;
+                    default: break;
+                    }
+                }
+                _deinterleaveUv = DeinterleaveUv;
+                _yuvToBgr = Yuv422pToBgrV2;
+            }
+            if (p.channels == 1)
+                _horizontal = SynetPreprocessHorizontal1;
+            _mulRow = SynetPreprocessMulRow;
+            _addMulRow = SynetPreprocessAddMulRow;
+            switch (p.dstType)
+            {
+            case SimdTensorData32f: _store = SynetPreprocessStore32f; break;
+            case SimdTensorData16b: _store = SynetPreprocessStore16b; break;
+            case SimdTensorData8u: _store = SynetPreprocessStore8u; break;
+            default: break;
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetPreprocessInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels,
+            SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat)
+        {
+            PreprocessParam param(srcW, srcH, srcFormat, yuvType, dstW, dstH, channels, method, lower, upper, dstType, dstFormat);
+            if (!param.Valid())
+                return NULL;
+            return new Avx2::SynetPreprocess(param);
+        }
+    }
+#endif
+}
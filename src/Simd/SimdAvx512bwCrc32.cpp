@@ -0,0 +1,103 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdCpu.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdAvx2.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX512BW_ENABLE) && (defined(_MSC_VER) || defined(__VPCLMULQDQ__))
+    namespace Avx512bw
+    {
+        const bool VpclmulEnable = Base::CheckBit(7, 0, Cpuid::Ecx, Cpuid::VPCLMULQDQ);
+
+        SIMD_INLINE __m128i Crc32Fold(__m128i a, __m128i b, __m128i k)
+        {
+            return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(a, k, 0x00), _mm_clmulepi64_si128(a, k, 0x11)), b);
+        }
+
+        SIMD_INLINE __m512i Crc32Fold(__m512i a, __m512i b, __m512i k)
+        {
+            return _mm512_ternarylogic_epi64(_mm512_clmulepi64_epi128(a, k, 0x00), _mm512_clmulepi64_epi128(a, k, 0x11), b, 0x96);
+        }
+
+        SIMD_INLINE uint32_t Crc32Reduce(__m128i x0)
+        {
+            const __m128i k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+            const __m128i k5 = _mm_set_epi64x(0x0000000000, 0x0163cd6124);
+            const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+            const __m128i mask = _mm_setr_epi32(-1, 0, -1, 0);
+            __m128i x1 = _mm_xor_si128(_mm_srli_si128(x0, 8), _mm_clmulepi64_si128(x0, k4, 0x10));
+            x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), k5, 0x00), _mm_srli_si128(x1, 4));
+            __m128i x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), poly, 0x10);
+            x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), poly, 0x00);
+            return ~(uint32_t)_mm_extract_epi32(_mm_xor_si128(x1, x2), 1);
+        }
+
+        uint32_t Crc32(const void* src, size_t size)
+        {
+            if (!VpclmulEnable || size < 512)
+                return Avx2::Crc32(src, size);
+            const uint8_t* p = (const uint8_t*)src;
+            const __m512i k1 = _mm512_broadcast_i32x4(_mm_set_epi64x(0x01322d1430, 0x011542778a));
+            const __m512i k2 = _mm512_broadcast_i32x4(_mm_set_epi64x(0x01c6e41596, 0x0154442bd4));
+            const __m128i k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+            __m512i z0 = _mm512_xor_si512(_mm512_loadu_si512(p + 0 * A), _mm512_maskz_set1_epi32(1, -1));
+            __m512i z1 = _mm512_loadu_si512(p + 1 * A);
+            __m512i z2 = _mm512_loadu_si512(p + 2 * A);
+            __m512i z3 = _mm512_loadu_si512(p + 3 * A);
+            size_t i = 4 * A, size4A = AlignLo(size, 4 * A), sizeA = AlignLo(size, A), size16 = AlignLo(size, 16);
+            for (; i < size4A; i += 4 * A)
+            {
+                z0 = Crc32Fold(z0, _mm512_loadu_si512(p + i + 0 * A), k1);
+                z1 = Crc32Fold(z1, _mm512_loadu_si512(p + i + 1 * A), k1);
+                z2 = Crc32Fold(z2, _mm512_loadu_si512(p + i + 2 * A), k1);
+                z3 = Crc32Fold(z3, _mm512_loadu_si512(p + i + 3 * A), k1);
+            }
+            z0 = Crc32Fold(z0, z1, k2);
+            z0 = Crc32Fold(z0, z2, k2);
+            z0 = Crc32Fold(z0, z3, k2);
+            for (; i < sizeA; i += A)
+                z0 = Crc32Fold(z0, _mm512_loadu_si512(p + i), k2);
+            __m128i x0 = _mm512_castsi512_si128(z0);
+            x0 = Crc32Fold(x0, _mm512_extracti32x4_epi32(z0, 1), k4);
+            x0 = Crc32Fold(x0, _mm512_extracti32x4_epi32(z0, 2), k4);
+            x0 = Crc32Fold(x0, _mm512_extracti32x4_epi32(z0, 3), k4);
+            for (; i < size16; i += 16)
+                x0 = Crc32Fold(x0, _mm_loadu_si128((__m128i*)(p + i)), k4);
+            return Base::Crc32(Crc32Reduce(x0), p + i, size - i);
+        }
+    }
+#elif defined(SIMD_AVX512BW_ENABLE)
+    namespace Avx512bw
+    {
+        uint32_t Crc32(const void* src, size_t size)
+        {
+            return Avx2::Crc32(src, size);
+        }
+    }
+#endif
+}
@@ -128,8 +128,8 @@ namespace Simd
             case SimdImageFilePgmBin: return new ImagePgmBinLoader(param);
             case SimdImageFilePpmTxt: return new ImagePpmTxtLoader(param);
             case SimdImageFilePpmBin: return new ImagePpmBinLoader(param);
-            case SimdImageFilePng: return new Sse41::ImagePngLoader(param);
-            case SimdImageFileJpeg: return new Avx2::ImageJpegLoader(param);
+            case SimdImageFilePng: return new ImagePngLoader(param);
+            case SimdImageFileJpeg: return new ImageJpegLoader(param);
             default:
                 return NULL;
             }
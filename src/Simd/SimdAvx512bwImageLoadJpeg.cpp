@@ -0,0 +1,319 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdImageLoad.h"
+#include "Simd/SimdImageLoadJpeg.h"
+#include "Simd/SimdArray.h"
+#include "Simd/SimdAvx512bw.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdYuvToBgr.h"
+#include "Simd/SimdInterleave.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX512BW_ENABLE    
+    namespace Avx512bw
+    {
+        SIMD_INLINE int JpegIdctPair(int lo, int hi)
+        {
+            return int((uint32_t(lo) & 0xFFFF) | (uint32_t(hi) << 16));
+        }
+
+        SIMD_INLINE __m512i JpegIdctRot(int k0, int k1, int k2, int k3)
+        {
+            return _mm512_setr_epi32(k0, k0, k0, k0, k1, k1, k1, k1, k2, k2, k2, k2, k3, k3, k3, k3);
+        }
+
+        SIMD_INLINE __m512i JpegIdctWiden(__m512i value, int part)
+        {
+            return _mm512_srai_epi32(part ? _mm512_unpackhi_epi16(_mm512_setzero_si512(), value) : _mm512_unpacklo_epi16(_mm512_setzero_si512(), value), 4);
+        }
+
+        template<int shift> SIMD_INLINE void JpegIdctPass(__m512i& z0, __m512i& z1, const __m512i* rot, __m512i bias)
+        {
+            static const __m512i X_IDX = SIMD_MM512_SETR_EPI64(4, 5, 14, 15, 10, 11, 0, 0);
+            static const __m512i Y_IDX = SIMD_MM512_SETR_EPI64(12, 13, 6, 7, 2, 3, 0, 0);
+            static const __m512i S_IDX = SIMD_MM512_SETR_EPI64(0, 0, 0, 0, 0, 0, 2, 3);
+            static const __m512i T_IDX = SIMD_MM512_SETR_EPI64(0, 0, 0, 0, 0, 0, 6, 7);
+            static const __m512i ED_IDX = SIMD_MM512_SETR_EPI64(0, 1, 8, 9, 8, 9, 0, 1);
+            static const __m512i R_IDX = SIMD_MM512_SETR_EPI64(8, 9, 0, 1, 0, 1, 8, 9);
+            static const __m512i A_IDX = SIMD_MM512_SETR_EPI64(12, 13, 10, 11, 4, 5, 2, 3);
+            static const __m512i B_IDX = SIMD_MM512_SETR_EPI64(6, 7, 14, 15, 14, 15, 6, 7);
+
+            __m512i s = _mm512_add_epi16(z0, _mm512_shuffle_i64x2(z1, z1, 0x4E));
+            __m512i x = _mm512_mask_permutexvar_epi64(_mm512_permutex2var_epi64(z0, X_IDX, z1), 0xC0, S_IDX, s);
+            __m512i y = _mm512_mask_permutexvar_epi64(_mm512_permutex2var_epi64(z0, Y_IDX, z1), 0xC0, T_IDX, s);
+            __m512i ed = _mm512_permutex2var_epi64(_mm512_add_epi16(z0, z1), ED_IDX, _mm512_sub_epi16(z0, z1));
+            __m512i dst[2][2];
+            for (int part = 0; part < 2; ++part)
+            {
+                __m512i xy = part ? _mm512_unpackhi_epi16(x, y) : _mm512_unpacklo_epi16(x, y);
+                __m512i p = _mm512_madd_epi16(xy, rot[0]);
+                __m512i q = _mm512_madd_epi16(xy, rot[1]);
+                __m512i e = JpegIdctWiden(ed, part);
+                __m512i r = _mm512_permutex2var_epi64(p, R_IDX, q);
+                __m512i u = _mm512_add_epi32(_mm512_mask_sub_epi32(_mm512_add_epi32(e, r), 0xFF00, e, r), bias);
+                __m512i v = _mm512_add_epi32(_mm512_permutex2var_epi64(p, A_IDX, q), _mm512_permutex2var_epi64(p, B_IDX, q));
+                dst[0][part] = _mm512_srai_epi32(_mm512_add_epi32(u, v), shift);
+                dst[1][part] = _mm512_srai_epi32(_mm512_sub_epi32(u, v), shift);
+            }
+            z0 = _mm512_packs_epi32(dst[0][0], dst[0][1]);
+            z1 = _mm512_packs_epi32(dst[1][0], dst[1][1]);
+        }
+
+        SIMD_INLINE void JpegIdctTranspose(__m512i& z0, __m512i& z1)
+        {
+            static const __m512i T0_IDX = SIMD_MM512_SETR_EPI16(
+                0x00, 0x08, 0x10, 0x18, 0x38, 0x30, 0x28, 0x20, 0x01, 0x09, 0x11, 0x19, 0x39, 0x31, 0x29, 0x21,
+                0x02, 0x0A, 0x12, 0x1A, 0x3A, 0x32, 0x2A, 0x22, 0x03, 0x0B, 0x13, 0x1B, 0x3B, 0x33, 0x2B, 0x23);
+            static const __m512i T1_IDX = SIMD_MM512_SETR_EPI16(
+                0x04, 0x0C, 0x14, 0x1C, 0x3C, 0x34, 0x2C, 0x24, 0x05, 0x0D, 0x15, 0x1D, 0x3D, 0x35, 0x2D, 0x25,
+                0x06, 0x0E, 0x16, 0x1E, 0x3E, 0x36, 0x2E, 0x26, 0x07, 0x0F, 0x17, 0x1F, 0x3F, 0x37, 0x2F, 0x27);
+            __m512i t0 = _mm512_permutex2var_epi16(z0, T0_IDX, z1);
+            __m512i t1 = _mm512_permutex2var_epi16(z0, T1_IDX, z1);
+            z0 = t0;
+            z1 = t1;
+        }
+
+        template<int row> SIMD_INLINE void JpegIdctStore(__m512i rows, uint8_t* dst, int stride)
+        {
+            __m128i lane = _mm512_extracti32x4_epi32(rows, row);
+            _mm_storel_epi64((__m128i*)(dst + row * stride), lane);
+            _mm_storeh_pd((double*)(dst + (row + 4) * stride), _mm_castsi128_pd(lane));
+        }
+
+        static void JpegIdctBlock(const int16_t* src, uint8_t* dst, int stride)
+        {
+            __m512i rot[2];
+            rot[0] = JpegIdctRot(
+                JpegIdctPair(Base::JpegIdctK00, Base::JpegIdctK00 + Base::JpegIdctK01),
+                JpegIdctPair(Base::JpegIdctK10 + Base::JpegIdctK04, Base::JpegIdctK10),
+                JpegIdctPair(Base::JpegIdctK11 + Base::JpegIdctK05, Base::JpegIdctK11),
+                JpegIdctPair(Base::JpegIdctK03 + Base::JpegIdctK08, Base::JpegIdctK03));
+            rot[1] = JpegIdctRot(
+                JpegIdctPair(Base::JpegIdctK00 + Base::JpegIdctK02, Base::JpegIdctK00),
+                JpegIdctPair(Base::JpegIdctK10, Base::JpegIdctK10 + Base::JpegIdctK06),
+                JpegIdctPair(Base::JpegIdctK11, Base::JpegIdctK11 + Base::JpegIdctK07),
+                JpegIdctPair(Base::JpegIdctK03, Base::JpegIdctK03 + Base::JpegIdctK09));
+            __m512i z0 = _mm512_loadu_si512(src + 0 * 32);
+            __m512i z1 = _mm512_loadu_si512(src + 1 * 32);
+            JpegIdctPass<10>(z0, z1, rot, _mm512_set1_epi32(512));
+            JpegIdctTranspose(z0, z1);
+            JpegIdctPass<17>(z0, z1, rot, _mm512_set1_epi32(65536 + (128 << 17)));
+            JpegIdctTranspose(z0, z1);
+            __m512i p = _mm512_packus_epi16(z0, z1);
+            JpegIdctStore<0>(p, dst, stride);
+            JpegIdctStore<1>(p, dst, stride);
+            JpegIdctStore<2>(p, dst, stride);
+            JpegIdctStore<3>(p, dst, stride);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SIMD_INLINE void JpegUpsampleRow(const uint8_t* near, const uint8_t* far, size_t w2, int16_t* buf)
+        {
+            for (size_t i = 0; i < w2; i += HA)
+            {
+                __mmask32 tail = TailMask32(w2 - i);
+                __m512i n = _mm512_cvtepu8_epi16(_mm512_castsi512_si256(_mm512_maskz_loadu_epi8(tail, near + i)));
+                __m512i f = _mm512_cvtepu8_epi16(_mm512_castsi512_si256(_mm512_maskz_loadu_epi8(tail, far + i)));
+                _mm512_mask_storeu_epi16(buf + 1 + i, tail, _mm512_add_epi16(_mm512_add_epi16(n, _mm512_add_epi16(n, n)), f));
+            }
+            buf[0] = buf[1];
+            buf[w2 + 1] = buf[w2];
+        }
+
+        SIMD_INLINE __m512i JpegUpsample(const int16_t* buf)
+        {
+            static const __m512i K16_0008 = SIMD_MM512_SET1_EPI16(8);
+            __m512i prev = _mm512_loadu_si512(buf + 0);
+            __m512i curr = _mm512_loadu_si512(buf + 1);
+            __m512i next = _mm512_loadu_si512(buf + 2);
+            __m512i base = _mm512_add_epi16(_mm512_add_epi16(curr, _mm512_add_epi16(curr, curr)), K16_0008);
+            __m512i even = _mm512_srli_epi16(_mm512_add_epi16(base, prev), 4);
+            __m512i odd = _mm512_srli_epi16(_mm512_add_epi16(base, next), 4);
+            return _mm512_packus_epi16(_mm512_unpacklo_epi16(even, odd), _mm512_unpackhi_epi16(even, odd));
+        }
+
+        template<SimdPixelFormatType format> struct JpegYuvToAny;
+
+        template<> struct JpegYuvToAny<SimdPixelFormatBgr24>
+        {
+            static const size_t step = 3;
+
+            template<bool mask> static SIMD_INLINE void Convert(const __m512i& y, const __m512i& u, const __m512i& v, const __m512i&, uint8_t* bgr, const __mmask64* tails)
+            {
+                __m512i b = YuvToBlue<Base::Trect871>(y, u);
+                __m512i g = YuvToGreen<Base::Trect871>(y, u, v);
+                __m512i r = YuvToRed<Base::Trect871>(y, v);
+                Store<false, mask>(bgr + 0 * A, InterleaveBgr<0>(b, g, r), tails[0]);
+                Store<false, mask>(bgr + 1 * A, InterleaveBgr<1>(b, g, r), tails[1]);
+                Store<false, mask>(bgr + 2 * A, InterleaveBgr<2>(b, g, r), tails[2]);
+            }
+        };
+
+        template<> struct JpegYuvToAny<SimdPixelFormatRgb24>
+        {
+            static const size_t step = 3;
+
+            template<bool mask> static SIMD_INLINE void Convert(const __m512i& y, const __m512i& u, const __m512i& v, const __m512i&, uint8_t* rgb, const __mmask64* tails)
+            {
+                __m512i b = YuvToBlue<Base::Trect871>(y, u);
+                __m512i g = YuvToGreen<Base::Trect871>(y, u, v);
+                __m512i r = YuvToRed<Base::Trect871>(y, v);
+                Store<false, mask>(rgb + 0 * A, InterleaveBgr<0>(r, g, b), tails[0]);
+                Store<false, mask>(rgb + 1 * A, InterleaveBgr<1>(r, g, b), tails[1]);
+                Store<false, mask>(rgb + 2 * A, InterleaveBgr<2>(r, g, b), tails[2]);
+            }
+        };
+
+        template<> struct JpegYuvToAny<SimdPixelFormatBgra32>
+        {
+            static const size_t step = 4;
+
+            template<bool mask> static SIMD_INLINE void Convert(const __m512i& y, const __m512i& u, const __m512i& v, const __m512i& a, uint8_t* bgra, const __mmask64* tails)
+            {
+                YuvToBgra<false, mask, Base::Trect871>(y, u, v, a, bgra, tails);
+            }
+        };
+
+        template<> struct JpegYuvToAny<SimdPixelFormatRgba32>
+        {
+            static const size_t step = 4;
+
+            template<bool mask> static SIMD_INLINE void Convert(const __m512i& y, const __m512i& u, const __m512i& v, const __m512i& a, uint8_t* rgba, const __mmask64* tails)
+            {
+                __m512i b = _mm512_permutexvar_epi32(K32_PERMUTE_FOR_TWO_UNPACK, YuvToBlue<Base::Trect871>(y, u));
+                __m512i g = _mm512_permutexvar_epi32(K32_PERMUTE_FOR_TWO_UNPACK, YuvToGreen<Base::Trect871>(y, u, v));
+                __m512i r = _mm512_permutexvar_epi32(K32_PERMUTE_FOR_TWO_UNPACK, YuvToRed<Base::Trect871>(y, v));
+                __m512i rg0 = UnpackU8<0>(r, g);
+                __m512i rg1 = UnpackU8<1>(r, g);
+                __m512i ba0 = UnpackU8<0>(b, a);
+                __m512i ba1 = UnpackU8<1>(b, a);
+                Store<false, mask>(rgba + 0 * A, UnpackU16<0>(rg0, ba0), tails[0]);
+                Store<false, mask>(rgba + 1 * A, UnpackU16<1>(rg0, ba0), tails[1]);
+                Store<false, mask>(rgba + 2 * A, UnpackU16<0>(rg1, ba1), tails[2]);
+                Store<false, mask>(rgba + 3 * A, UnpackU16<1>(rg1, ba1), tails[3]);
+            }
+        };
+
+        template<SimdPixelFormatType format> void JpegYuv420pToAny(const uint8_t* y, size_t yStride, const uint8_t* u, size_t uStride,
+            const uint8_t* v, size_t vStride, size_t width, size_t height, uint8_t* dst, size_t dstStride, uint8_t alpha)
+        {
+            typedef JpegYuvToAny<format> Converter;
+            size_t hL = height - 1, w2 = (width + 1) / 2, wA = AlignLo(width, A), tail = width - wA, bufSize = w2 + 2 + HA;
+            Array16i buf(bufSize * 2, true);
+            int16_t* bu = buf.data, * bv = buf.data + bufSize;
+            __mmask64 tails[5];
+            tails[0] = TailMask64(tail);
+            for (size_t i = 0; i < Converter::step; ++i)
+                tails[1 + i] = TailMask64(tail * Converter::step - A * i);
+            __m512i a = _mm512_set1_epi8(alpha);
+            for (size_t row = 0; row < height; row += 1)
+            {
+                int odd = row & 1;
+                JpegUpsampleRow(u, odd ? (row == hL ? u : u + uStride) : (row == 0 ? u : u - uStride), w2, bu);
+                JpegUpsampleRow(v, odd ? (row == hL ? v : v + vStride) : (row == 0 ? v : v - vStride), w2, bv);
+                size_t col = 0;
+                for (; col < wA; col += A)
+                    Converter::template Convert<false>(_mm512_loadu_si512(y + col), JpegUpsample(bu + col / 2), 
+                        JpegUpsample(bv + col / 2), a, dst + col * Converter::step, tails + 1);
+                if (col < width)
+                    Converter::template Convert<true>(Load<false, true>(y + col, tails[0]), JpegUpsample(bu + col / 2), 
+                        JpegUpsample(bv + col / 2), a, dst + col * Converter::step, tails + 1);
+                y += yStride;
+                dst += dstStride;
+                if (odd)
+                {
+                    u += uStride;
+                    v += vStride;
+                }
+            }
+        }
+
+        void JpegYuv420pToBgr(const uint8_t* y, size_t yStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, size_t width, size_t height, uint8_t* bgr, size_t bgrStride, SimdYuvType)
+        {
+            JpegYuv420pToAny<SimdPixelFormatBgr24>(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride, 0xFF);
+        }
+
+        void JpegYuv420pToRgb(const uint8_t* y, size_t yStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, size_t width, size_t height, uint8_t* rgb, size_t rgbStride, SimdYuvType)
+        {
+            JpegYuv420pToAny<SimdPixelFormatRgb24>(y, yStride, u, uStride, v, vStride, width, height, rgb, rgbStride, 0xFF);
+        }
+
+        void JpegYuv420pToBgra(const uint8_t* y, size_t yStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, size_t width, size_t height, uint8_t* bgra, size_t bgraStride, uint8_t alpha, SimdYuvType)
+        {
+            JpegYuv420pToAny<SimdPixelFormatBgra32>(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha);
+        }
+
+        void JpegYuv420pToRgba(const uint8_t* y, size_t yStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, size_t width, size_t height, uint8_t* rgba, size_t rgbaStride, uint8_t alpha, SimdYuvType)
+        {
+            JpegYuv420pToAny<SimdPixelFormatRgba32>(y, yStride, u, uStride, v, vStride, width, height, rgba, rgbaStride, alpha);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void JpegSetConverters(Base::JpegContext* context, SimdPixelFormatType format)
+        {
+            Avx2::JpegSetConverters(context, format);
+            context->idctBlock = JpegIdctBlock;
+            context->interleaveUv = Avx512bw::InterleaveUv;
+            if (format == SimdPixelFormatGray8)
+                context->rgbaToAny = Avx512bw::RgbaToGray;
+            if (format == SimdPixelFormatBgr24)
+            {
+                context->yuv444pToBgr = Avx512bw::Yuv444pToBgrV2;
+                context->yuv420pToBgr = Avx512bw::JpegYuv420pToBgr;
+                context->rgbaToAny = Avx512bw::BgraToRgb;
+            }
+            if (format == SimdPixelFormatBgra32)
+            {
+                context->yuv420pToBgra = Avx512bw::JpegYuv420pToBgra;
+                context->rgbaToAny = Avx512bw::BgraToRgba;
+            }
+            if (format == SimdPixelFormatRgb24)
+            {
+                context->yuv444pToBgr = Avx512bw::Yuv444pToRgbV2;
+                context->yuv420pToBgr = Avx512bw::JpegYuv420pToRgb;
+                context->rgbaToAny = Avx512bw::BgraToBgr;
+            }
+            if (format == SimdPixelFormatRgba32)
+                context->yuv420pToBgra = Avx512bw::JpegYuv420pToRgba;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        ImageJpegLoader::ImageJpegLoader(const ImageLoaderParam& param)
+            : Avx2::ImageJpegLoader(param)
+        {
+            Avx512bw::JpegSetConverters(_context, _param.format);
+        }
+
+        void* JpegDecoderInit()
+        {
+            return new Base::JpegDecoder(Avx512bw::JpegSetConverters);
+        }
+    }
+#endif
+}
@@ -33,40 +33,38 @@ namespace Simd
 #ifdef SIMD_AVX512BW_ENABLE    
     namespace Avx512bw
     {
-        static uint32_t ZlibAdler32(uint8_t* data, int size)
+        uint32_t ZlibAdler32(const uint8_t* data, int size)
         {
-            __m512i _i0 = _mm512_setr_epi32(0, -1, -2, -3, -4, -5, -6, -7, -8, -9, -10, -11, -12, -13, -14, -15), _16 = _mm512_set1_epi32(16);
+            const int BASE = 65521, BLOCK = 5552 / 64;
+            static const __m512i tap = SIMD_MM512_SETR_EPI8(
+                64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33,
+                32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
             uint32_t lo = 1, hi = 0;
-            for (int b = 0, n = (int)(size % 5552); b < size;)
+            for (int blocks = size / 64; blocks > 0;)
             {
-                int n16 = n & (~15), i = 0;
-                __m512i _i = _mm512_add_epi32(_i0, _mm512_set1_epi32(n));
-                __m512i _l = _mm512_setzero_si512(), _h = _mm512_setzero_si512();
-                for (; i < n16; i += 16)
+                int n = Simd::Min(blocks, BLOCK);
+                blocks -= n, size -= n * 64;
+                __m512i _p = _mm512_maskz_set1_epi32(1, lo * n), _l = _mm512_setzero_si512(), _h = _mm512_maskz_set1_epi32(1, hi);
+                for (; n > 0; n -= 1, data += 64)
                 {
-                    __m512i d = _mm512_cvtepu8_epi32(_mm_loadu_si128((__m128i*)(data + b + i)));
-                    _l = _mm512_add_epi32(_l, d);
-                    _h = _mm512_add_epi32(_h, _mm512_mullo_epi32(d, _i));
-                    _i = _mm512_sub_epi32(_i, _16);
+                    __m512i d = _mm512_loadu_si512(data);
+                    _p = _mm512_add_epi32(_p, _l);
+                    _l = _mm512_add_epi32(_l, _mm512_sad_epu8(d, K_ZERO));
+                    _h = _mm512_add_epi32(_h, _mm512_madd_epi16(_mm512_maddubs_epi16(d, tap), K16_0001));
                 }
-                if (i < n)
-                {
-                    __mmask16 t = TailMask16(n - i);
-                    __m512i d = _mm512_cvtepu8_epi32(_mm_maskz_loadu_epi8(t, (__m128i*)(data + b + i)));
-                    _l = _mm512_add_epi32(_l, d);
-                    _h = _mm512_add_epi32(_h, _mm512_mullo_epi32(d, _i));
-                    _i = _mm512_sub_epi32(_i, _16);
-                }
-                int l = Avx512bw::ExtractSum<uint32_t>(_l), h = Avx512bw::ExtractSum<uint32_t>(_h);
-                hi = (hi + h + lo*n) % 65521;
-                lo = (lo + l) % 65521;
-                b += n;
-                n = 5552;
+                _h = _mm512_add_epi32(_h, _mm512_slli_epi32(_p, 6));
+                lo = (lo + ExtractSum<uint32_t>(_l)) % BASE;
+                hi = ExtractSum<uint32_t>(_h) % BASE;
+            }
+            for (; size > 0; size -= 1)
+            {
+                lo += *data++;
+                hi += lo;
             }
-            return (hi << 16) | lo;
+            return ((hi % BASE) << 16) | (lo % BASE);
         }
 
-        void ZlibCompress(uint8_t* data, int size, int quality, OutputMemoryStream& stream)
+        void ZlibDeflate(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream)
         {
             const int ZHASH = 16384;
             if (quality < 5)
@@ -74,23 +72,22 @@ namespace Simd
             const int basket = quality * 2;
             Array32i hashTable(ZHASH * basket);
             memset(hashTable.data, -1, hashTable.RawSize());
+            Base::ZlibPrime(hashTable.data, basket, quality, data, begin);
 
-            stream.Write(uint8_t(0x78));
-            stream.Write(uint8_t(0x5e));
-            stream.WriteBits(1, 1);
+            stream.WriteBits(last ? 1 : 0, 1);
             stream.WriteBits(1, 2);
 
-            int i = 0, j;
-            while (i < size - 3)
+            int i = begin, j;
+            while (i < end - 3)
             {
                 int h = Base::ZlibHash(data + i) & (ZHASH - 1), best = 3;
-                uint8_t* bestLoc = 0;
+                const uint8_t* bestLoc = 0;
                 int* hList = hashTable.data + h * basket;
                 for (j = 0; hList[j] != -1 && j < basket; ++j)
                 {
                     if (hList[j] > i - 32768)
                     {
-                        int d = ZlibCount(data + hList[j], data + i, size - i);
+                        int d = ZlibCount(data + hList[j], data + i, end - i);
                         if (d >= best)
                         {
                             best = d;
@@ -114,7 +111,7 @@ namespace Simd
                     {
                         if (hList[j] > i - 32767)
                         {
-                            int e = ZlibCount(data + hList[j], data + i + 1, size - i - 1);
+                            int e = ZlibCount(data + hList[j], data + i + 1, end - i - 1);
                             if (e > best)
                             {
                                 bestLoc = NULL;
@@ -144,11 +141,19 @@ namespace Simd
                     ++i;
                 }
             }
-            for (; i < size; ++i)
+            for (; i < end; ++i)
                 Base::ZlibHuffB(data[i], stream);
             Base::ZlibHuff(256, stream);
+            if (!last)
+                stream.WriteBits(0, 3);
             stream.FlushBits();
-            stream.WriteBe32u(ZlibAdler32(data, size));
+            if (!last)
+                stream.WriteBe32u(0x0000FFFF);
+        }
+
+        void ZlibDeflateRle(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream)
+        {
+            Base::ZlibDeflateDynamic(data, begin, end, last, Base::ZlibTokenizeRle<Avx512bw::ZlibCount>, stream);
         }
 
         uint32_t EncodeLine0(const uint8_t* src, size_t stride, size_t n, size_t size, int8_t* dst)
@@ -394,7 +399,10 @@ namespace Simd
             _encode[4] = Avx512bw::EncodeLine4;
             _encode[5] = Avx512bw::EncodeLine5;
             _encode[6] = Avx512bw::EncodeLine6;
-            _compress = Avx512bw::ZlibCompress;
+            _adler32 = Avx512bw::ZlibAdler32;
+            _crc32 = Avx512bw::Crc32;
+            _deflate = Avx512bw::ZlibDeflate;
+            _deflateRle = Avx512bw::ZlibDeflateRle;
         }
     }
 #endif// SIMD_AVX512BW_ENABLE
@@ -34,7 +34,7 @@ namespace Simd
     {
         void * ResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method)
         {
-            ResParam param(srcX, srcY, dstX, dstY, channels, type, method, sizeof(__m512i));
+            ResParam param(srcX, srcY, dstX, dstY, channels, type, method, sizeof(__m512i), ResizerInit);
             if (param.IsNearest() && ResizerNearest::Preferable(param))
                 return new ResizerNearest(param);
             else if (param.IsByteBilinear() && dstX >= A)
@@ -51,9 +51,19 @@ namespace Simd
                 return new ResizerByteArea2x2(param);
             else if (param.IsByteArea1x1())
                 return new ResizerByteArea1x1(param);
+            else if (param.IsKernel())
+                return new ResizerKernel(param);
             else
                 return Avx2::ResizerInit(srcX, srcY, dstX, dstY, channels, type, method);
         }
+
+        void* ResizerKernelInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, const float* kernel, size_t size, float support)
+        {
+            ResParam param(srcX, srcY, dstX, dstY, channels, type, SimdResizeMethodKernel, sizeof(__m512i), ResizerInit);
+            if (kernel == NULL || size < 2 || !(support > 0.0f))
+                return NULL;
+            return new ResizerKernel(param, kernel, size, support);
+        }
     }
 #endif //SIMD_AVX512BW_ENABLE 
 }
@@ -220,7 +220,7 @@ namespace Simd
             const int32_t * ix = _ix.data;
             size_t dstW = _param.dstW;
 
-            for (size_t yDst = 0; yDst < _param.dstH; yDst++, dst += dstStride)
+            for (size_t yDst = _yBeg; yDst < _yEnd; yDst++, dst += dstStride)
             {
                 a[0] = _mm512_set1_epi16(int16_t(Base::FRACTION_RANGE - _ay[yDst]));
                 a[1] = _mm512_set1_epi16(int16_t(_ay[yDst]));
@@ -266,7 +266,7 @@ namespace Simd
             const uint8_t * ax = _ax.data;
             const Idx * ixg = _ixg.data;
 
-            for (size_t yDst = 0; yDst < _param.dstH; yDst++, dst += dstStride)
+            for (size_t yDst = _yBeg; yDst < _yEnd; yDst++, dst += dstStride)
             {
                 a[0] = _mm512_set1_epi16(int16_t(Base::FRACTION_RANGE - _ay[yDst]));
                 a[1] = _mm512_set1_epi16(int16_t(_ay[yDst]));
@@ -426,7 +426,7 @@ namespace Simd
             size_t rs32 = AlignLo(rs, 32);
             __mmask16 tail16 = TailMask16(rs - rs16);
             __m512 _1 = _mm512_set1_ps(1.0f);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -556,7 +556,7 @@ namespace Simd
             size_t rs32 = AlignLo(rs, 32);
             __mmask16 tail16 = TailMask16(rs - rs16);
             __m512 _1 = _mm512_set1_ps(1.0f);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -757,7 +757,7 @@ namespace Simd
                 __mmask16 rsMF = TailMask16(rs - rsF);
                 size_t fs = AlignLoAny(F, cn), rsFS = (_fastLoad1 || _fastLoad2) ? AlignLoAny(rs, fs) : rs;
                 __mmask16 rsMSM = TailMask16(fs), rsMST = TailMask16(rs - rsFS), rsMSTS = TailMask16(_param.srcW*cn - _ix[rsFS]);
-                for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                 {
                     float fy1 = _ay[dy];
                     float fy0 = 1.0f - fy1;
@@ -891,7 +891,7 @@ namespace Simd
                     Avx2::ResizerFloatBilinear::Run(src, srcStride, dst, dstStride);
                     return;
                 }
-                for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                 {
                     __m512 fy1 = _mm512_set1_ps(_ay[dy]);
                     __m512 fy0 = _mm512_sub_ps(_1, fy1);
@@ -992,7 +992,7 @@ namespace Simd
                 __mmask16 rsMF = TailMask16(rs - rsF);
                 float* pbx[2] = { _bx[0].data, _bx[1].data };
                 int32_t prev = -2;
-                for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                 {
                     float fy1 = _ay[dy];
                     float fy0 = 1.0f - fy1;
@@ -1157,7 +1157,7 @@ namespace Simd
             {
                 if (cn >= DF)
                 {
-                    for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                    for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                     {
                         __m512 fy1 = _mm512_set1_ps(_ay[dy]);
                         __m512 fy0 = _mm512_sub_ps(_1, fy1);
@@ -1203,7 +1203,7 @@ namespace Simd
                 }
                 else if (cn <= HF)
                 {
-                    for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                    for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                     {
                         __m256 fy1 = _mm256_set1_ps(_ay[dy]);
                         __m256 fy0 = _mm256_sub_ps(_mm512_castps512_ps256(_1), fy1);
@@ -1222,7 +1222,7 @@ namespace Simd
                 }
                 else
                 {
-                    for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                    for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                     {
                         __m512 fy1 = _mm512_set1_ps(_ay[dy]);
                         __m512 fy0 = _mm512_sub_ps(_1, fy1);
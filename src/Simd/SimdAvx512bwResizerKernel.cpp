@@ -0,0 +1,166 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdResizer.h"
+#include "Simd/SimdBFloat16.h"
+
+namespace Simd
+{
+#ifdef SIMD_AVX512BW_ENABLE
+    namespace Avx512bw
+    {
+        ResizerKernel::ResizerKernel(const ResParam& param, const float* kernel, size_t size, float support)
+            : Avx2::ResizerKernel(param, kernel, size, support)
+        {
+            _kernelInit = ResizerKernelInit;
+        }
+
+        void ResizerKernel::Convert(const uint8_t* src, float* dst)
+        {
+            size_t size = _param.srcW * _param.channels, sizeF = AlignLo(size, F), i = 0;
+            __mmask16 tail = TailMask16(size - sizeF);
+            switch (_param.type)
+            {
+            case SimdResizeChannelByte:
+                for (; i < sizeF; i += F)
+                    _mm512_storeu_si512(dst + i, _mm512_cvtepu8_epi32(_mm_loadu_si128((__m128i*)(src + i))));
+                if (i < size)
+                    _mm512_mask_storeu_epi32(dst + i, tail, _mm512_cvtepu8_epi32(_mm_maskz_loadu_epi8(tail, src + i)));
+                break;
+            case SimdResizeChannelShort:
+                for (; i < sizeF; i += F)
+                    _mm512_storeu_ps(dst + i, _mm512_cvtepi32_ps(_mm512_cvtepu16_epi32(_mm256_loadu_si256((__m256i*)((uint16_t*)src + i)))));
+                if (i < size)
+                    _mm512_mask_storeu_ps(dst + i, tail, _mm512_cvtepi32_ps(_mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(tail, (uint16_t*)src + i))));
+                break;
+            case SimdResizeChannelBf16:
+                for (; i < sizeF; i += F)
+                    _mm512_storeu_ps(dst + i, BFloat16ToFloat32(_mm512_cvtepu16_epi32(_mm256_loadu_si256((__m256i*)((uint16_t*)src + i)))));
+                if (i < size)
+                    _mm512_mask_storeu_ps(dst + i, tail, BFloat16ToFloat32(_mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(tail, (uint16_t*)src + i))));
+                break;
+            default:
+                assert(0);
+            }
+        }
+
+        void ResizerKernel::Horizontal(const float* src, float* dst)
+        {
+            size_t C = _param.channels, taps = _xTaps, size = _rowSize;
+            if (_param.type == SimdResizeChannelByte)
+            {
+                __m512i round = _mm512_set1_epi32(Base::KERNEL_X_ROUND);
+                for (size_t j = 0; j < size; j += F)
+                {
+                    __m512i ix = _mm512_load_si512(_ix.data + j);
+                    const int* ps = (int*)src;
+                    const int32_t* pa = _axi.data + j;
+                    __m512i sum = _mm512_setzero_si512();
+                    for (size_t t = 0; t < taps; ++t, ps += C, pa += size)
+                        sum = _mm512_add_epi32(sum, _mm512_mullo_epi32(_mm512_i32gather_epi32(ix, ps, 4), _mm512_load_si512(pa)));
+                    _mm512_store_si512(dst + j, _mm512_srai_epi32(_mm512_add_epi32(sum, round), Base::KERNEL_X_SHIFT));
+                }
+            }
+            else
+            {
+                for (size_t j = 0; j < size; j += F)
+                {
+                    __m512i ix = _mm512_load_si512(_ix.data + j);
+                    const float* ps = src;
+                    const float* pa = _ax.data + j;
+                    __m512 sum = _mm512_setzero_ps();
+                    for (size_t t = 0; t < taps; ++t, ps += C, pa += size)
+                        sum = _mm512_fmadd_ps(_mm512_i32gather_ps(ix, ps, 4), _mm512_load_ps(pa), sum);
+                    _mm512_store_ps(dst + j, sum);
+                }
+            }
+        }
+
+        SIMD_INLINE __m512 KernelVertical(const float* const* rows, const float* ay, size_t taps, size_t offset)
+        {
+            __m512 sum = _mm512_setzero_ps();
+            for (size_t t = 0; t < taps; ++t)
+                sum = _mm512_fmadd_ps(_mm512_set1_ps(ay[t]), _mm512_load_ps(rows[t] + offset), sum);
+            return sum;
+        }
+
+        template<SimdResizeChannelType type> SIMD_INLINE void KernelStore(__m512 value, uint8_t* dst, __mmask16 mask);
+
+        template<> SIMD_INLINE void KernelStore<SimdResizeChannelShort>(__m512 value, uint8_t* dst, __mmask16 mask)
+        {
+            _mm512_mask_cvtusepi32_storeu_epi16(dst, mask, _mm512_max_epi32(_mm512_cvtps_epi32(value), K_ZERO));
+        }
+
+        template<> SIMD_INLINE void KernelStore<SimdResizeChannelFloat>(__m512 value, uint8_t* dst, __mmask16 mask)
+        {
+            _mm512_mask_storeu_ps((float*)dst, mask, value);
+        }
+
+        template<> SIMD_INLINE void KernelStore<SimdResizeChannelBf16>(__m512 value, uint8_t* dst, __mmask16 mask)
+        {
+            _mm512_mask_cvtepi32_storeu_epi16(dst, mask, Float32ToBFloat16(value));
+        }
+
+        template<SimdResizeChannelType type> void KernelVertical(const float* const* rows, const float* ay, size_t taps, size_t size, size_t elem, uint8_t* dst)
+        {
+            size_t sizeF = AlignLo(size, F), j = 0;
+            for (; j < sizeF; j += F)
+                KernelStore<type>(KernelVertical(rows, ay, taps, j), dst + j * elem, __mmask16(-1));
+            if (j < size)
+                KernelStore<type>(KernelVertical(rows, ay, taps, j), dst + j * elem, TailMask16(size - j));
+        }
+
+        SIMD_INLINE __m512i KernelVertical(const float* const* rows, const int32_t* ay, size_t taps, size_t offset)
+        {
+            __m512i sum = _mm512_setzero_si512();
+            for (size_t t = 0; t < taps; ++t)
+                sum = _mm512_add_epi32(sum, _mm512_mullo_epi32(_mm512_set1_epi32(ay[t]), _mm512_load_si512(rows[t] + offset)));
+            sum = _mm512_srai_epi32(_mm512_add_epi32(sum, _mm512_set1_epi32(Base::KERNEL_Y_ROUND)), Base::KERNEL_Y_SHIFT);
+            return _mm512_max_epi32(sum, K_ZERO);
+        }
+
+        void KernelVertical(const float* const* rows, const int32_t* ay, size_t taps, size_t size, uint8_t* dst)
+        {
+            size_t sizeF = AlignLo(size, F), j = 0;
+            for (; j < sizeF; j += F)
+                _mm512_mask_cvtusepi32_storeu_epi8(dst + j, __mmask16(-1), KernelVertical(rows, ay, taps, j));
+            if (j < size)
+                _mm512_mask_cvtusepi32_storeu_epi8(dst + j, TailMask16(size - j), KernelVertical(rows, ay, taps, j));
+        }
+
+        void ResizerKernel::Vertical(const float* const* rows, size_t dy, uint8_t* dst)
+        {
+            size_t size = _param.dstW * _param.channels, taps = _yTaps, elem = _param.ChannelSize();
+            switch (_param.type)
+            {
+            case SimdResizeChannelByte: KernelVertical(rows, _ayi.data + dy * taps, taps, size, dst); break;
+            case SimdResizeChannelShort: KernelVertical<SimdResizeChannelShort>(rows, _ay.data + dy * taps, taps, size, elem, dst); break;
+            case SimdResizeChannelFloat: KernelVertical<SimdResizeChannelFloat>(rows, _ay.data + dy * taps, taps, size, elem, dst); break;
+            case SimdResizeChannelBf16: KernelVertical<SimdResizeChannelBf16>(rows, _ay.data + dy * taps, taps, size, elem, dst); break;
+            default: assert(0);
+            }
+        }
+    }
+#endif
+}
@@ -0,0 +1,190 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetPreprocess.h"
+#include "Simd/SimdBFloat16.h"
+#include "Simd/SimdExtract.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdAvx512bw.h"
+
+namespace Simd
+{
+#if defined(SIMD_AVX512BW_ENABLE) && defined(SIMD_SYNET_ENABLE)    
+    namespace Avx512bw
+    {
+        static void SynetPreprocessHorizontal1(const uint8_t* src, size_t srcW, size_t channels, const int32_t* ix, const float* ax, size_t taps, size_t dstW, bool planar, float* dst)
+        {
+            if (taps == 2)
+            {
+                static const __m512i EVEN = SIMD_MM512_SETR_EPI32(0x00, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x10, 0x12, 0x14, 0x16, 0x18, 0x1A, 0x1C, 0x1E);
+                static const __m512i ODD = SIMD_MM512_SETR_EPI32(0x01, 0x03, 0x05, 0x07, 0x09, 0x0B, 0x0D, 0x0F, 0x11, 0x13, 0x15, 0x17, 0x19, 0x1B, 0x1D, 0x1F);
+                size_t dstW16 = AlignLo(dstW, 16), x = 0;
+                for (; x < dstW16; x += 16, ax += 32)
+                {
+                    __m512i s = _mm512_setr_epi32(*(uint16_t*)(src + ix[x + 0x0]), *(uint16_t*)(src + ix[x + 0x1]), *(uint16_t*)(src + ix[x + 0x2]), *(uint16_t*)(src + ix[x + 0x3]),
+                        *(uint16_t*)(src + ix[x + 0x4]), *(uint16_t*)(src + ix[x + 0x5]), *(uint16_t*)(src + ix[x + 0x6]), *(uint16_t*)(src + ix[x + 0x7]),
+                        *(uint16_t*)(src + ix[x + 0x8]), *(uint16_t*)(src + ix[x + 0x9]), *(uint16_t*)(src + ix[x + 0xA]), *(uint16_t*)(src + ix[x + 0xB]),
+                        *(uint16_t*)(src + ix[x + 0xC]), *(uint16_t*)(src + ix[x + 0xD]), *(uint16_t*)(src + ix[x + 0xE]), *(uint16_t*)(src + ix[x + 0xF]));
+                    __m512 s0 = _mm512_cvtepi32_ps(_mm512_and_si512(s, K32_000000FF));
+                    __m512 s1 = _mm512_cvtepi32_ps(_mm512_srli_epi32(s, 8));
+                    __m512 a01 = _mm512_loadu_ps(ax + 0), a23 = _mm512_loadu_ps(ax + F);
+                    __m512 a0 = _mm512_permutex2var_ps(a01, EVEN, a23), a1 = _mm512_permutex2var_ps(a01, ODD, a23);
+                    _mm512_storeu_ps(dst + x, _mm512_add_ps(_mm512_mul_ps(a0, s0), _mm512_mul_ps(a1, s1)));
+                }
+                if (x < dstW)
+                    Avx2::SynetPreprocessHorizontal1(src, srcW, 1, ix + x, ax, taps, dstW - x, planar, dst + x);
+            }
+            else
+            {
+                for (size_t x = 0; x < dstW; ++x, ax += taps)
+                {
+                    const uint8_t* s = src + ix[x];
+                    __m512 sum = _mm512_setzero_ps();
+                    for (size_t t = 0; t < taps; t += F)
+                    {
+                        __mmask16 mask = TailMask16(taps - t);
+                        __m512 pixel = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_maskz_loadu_epi8(mask, s + t)));
+                        sum = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, ax + t), pixel, sum);
+                    }
+                    dst[x] = ExtractSum(sum);
+                }
+            }
+        }
+
+        static void SynetPreprocessMulRow(const float* src, float weight, size_t size, float* dst)
+        {
+            __m512 _weight = _mm512_set1_ps(weight);
+            for (size_t i = 0; i < size; i += F)
+            {
+                __mmask16 mask = TailMask16(size - i);
+                _mm512_mask_storeu_ps(dst + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, src + i), _weight));
+            }
+        }
+
+        static void SynetPreprocessAddMulRow(const float* src, float weight, size_t size, float* dst)
+        {
+            __m512 _weight = _mm512_set1_ps(weight);
+            for (size_t i = 0; i < size; i += F)
+            {
+                __mmask16 mask = TailMask16(size - i);
+                __m512 sum = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, src + i), _weight, _mm512_maskz_loadu_ps(mask, dst + i));
+                _mm512_mask_storeu_ps(dst + i, mask, sum);
+            }
+        }
+
+        SIMD_INLINE __m512 Normalize(const float* src, const float* scale, const float* shift, __mmask16 mask)
+        {
+            return _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, src), _mm512_maskz_loadu_ps(mask, scale), _mm512_maskz_loadu_ps(mask, shift));
+        }
+
+        static void SynetPreprocessStore32f(const float* src, const float* scale, const float* shift, size_t size, uint8_t* dst)
+        {
+            float* dst32f = (float*)dst;
+            for (size_t i = 0; i < size; i += F)
+            {
+                __mmask16 mask = TailMask16(size - i);
+                _mm512_mask_storeu_ps(dst32f + i, mask, Normalize(src + i, scale + i, shift + i, mask));
+            }
+        }
+
+        static void SynetPreprocessStore16b(const float* src, const float* scale, const float* shift, size_t size, uint8_t* dst)
+        {
+            uint16_t* dst16b = (uint16_t*)dst;
+            for (size_t i = 0; i < size; i += F)
+            {
+                __mmask16 mask = TailMask16(size - i);
+                _mm512_mask_cvtepi32_storeu_epi16(dst16b + i, mask, Float32ToBFloat16(Normalize(src + i, scale + i, shift + i, mask)));
+            }
+        }
+
+        static void SynetPreprocessStore8u(const float* src, const float* scale, const float* shift, size_t size, uint8_t* dst)
+        {
+            for (size_t i = 0; i < size; i += F)
+            {
+                __mmask16 mask = TailMask16(size - i);
+                __m512i i32 = _mm512_max_epi32(_mm512_cvtps_epi32(Normalize(src + i, scale + i, shift + i, mask)), _mm512_setzero_si512());
+                _mm512_mask_cvtusepi32_storeu_epi8(dst + i, mask, i32);
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SynetPreprocess::SynetPreprocess(const PreprocessParam& param)
+            : Avx2::SynetPreprocess(param)
+        {
+            const PreprocessParam& p = _param;
+            if (p.srcW >= DA)
+            {
+                if (p.channels == 3)
+                {
+                    switch (p.srcFormat)
+                    {
+                    case SimdPixelFormatGray8: _convert = GrayToBgr; break;
+                    case SimdPixelFormatRgb24: _convert = BgrToRgb; break;
+                    case SimdPixelFormatBgra32: _convert = BgraToBgr; break;
+                    case SimdPixelFormatRgba32: _convert = BgraToRgb; break;
+                    default: break;
+                    }
+                }
+                else
+                {
+                    switch (p.srcFormat)
+                    {
+                    case SimdPixelFormatBgr24: _convert = BgrToGray; break;
+                    case SimdPixelFormatRgb24: _convert = RgbToGray; break;
+                    case SimdPixelFormatBgra32: _convert = BgraToGray; break;
+                    case SimdPixelFormatRgba32: _convert = RgbaToGray; break;
+                    case SimdPixelFormatNv12: _toGray = BgrToGray; break;
+                    case SimdPixelFormatYuv420p: _toGray = BgrToGray; break;
+                    default: break;
+                    }
+                }
+                _deinterleaveUv = DeinterleaveUv;
+                _yuvToBgr = Yuv422pToBgrV2;
+            }
+            if (p.channels == 1)
+                _horizontal = SynetPreprocessHorizontal1;
+            _mulRow = SynetPreprocessMulRow;
+            _addMulRow = SynetPreprocessAddMulRow;
+            switch (p.dstType)
+            {
+            case SimdTensorData32f: _store = SynetPreprocessStore32f; break;
+            case SimdTensorData16b: _store = SynetPreprocessStore16b; break;
+            case SimdTensorData8u: _store = SynetPreprocessStore8u; break;
+            default: break;
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetPreprocessInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels,
+            SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat)
+        {
+            PreprocessParam param(srcW, srcH, srcFormat, yuvType, dstW, dstH, channels, method, lower, upper, dstType, dstFormat);
+            if (!param.Valid())
+                return NULL;
+            return new Avx512bw::SynetPreprocess(param);
+        }
+    }
+#endif
+}
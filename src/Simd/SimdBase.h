@@ -36,6 +36,14 @@ namespace Simd
 
         void SetThreadNumber(size_t threadNumber);
 
+        bool SetThreadAffinity(const size_t * cpus, size_t count);
+
+        void * ThreadPoolInit(size_t threadNumber, const size_t * cpus, size_t count);
+
+        void ThreadPoolBind(void * pool);
+
+        uint32_t Crc32(uint32_t crc, const void* src, size_t size);
+
         uint32_t Crc32(const void* src, size_t size);
 
         uint32_t Crc32c(const void * src, size_t size);
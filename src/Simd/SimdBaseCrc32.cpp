@@ -588,10 +588,10 @@ namespace Simd
             }
         };
 
-        uint32_t Crc32(const void* src, size_t size)
+        uint32_t Crc32(uint32_t crc, const void* src, size_t size)
         {
             const uint8_t* p8 = (const uint8_t*)src;
-            uint32_t crc = 0xFFFFFFFF;
+            crc = ~crc;
 
             for (; ((uintptr_t)p8 & (sizeof(uint32_t) - 1)) != 0 && size > 0; ++p8, --size)
                 crc = Crc32Table[0][(crc ^ *p8) & 0xFF] ^ (crc >> 8);
@@ -652,6 +652,11 @@ namespace Simd
             return (~crc);
         }
 
+        uint32_t Crc32(const void* src, size_t size)
+        {
+            return Crc32(0, src, size);
+        }
+
         //---------------------------------------------------------------------
 
         // Precalculated CRC32c lookup table for polynomial 0x1EDC6F41 (castagnoli-crc).
@@ -104,7 +104,26 @@ namespace Simd
         {
         }
 
-        bool ImagePxmLoader::ReadHeader(size_t version)
+        bool ImagePxmLoader::Probe(SimdImageInfo& info)
+        {
+            bool gray = _param.file == SimdImageFilePgmTxt || _param.file == SimdImageFilePgmBin;
+            size_t version = 0;
+            switch (_param.file)
+            {
+            case SimdImageFilePgmTxt: version = 2; break;
+            case SimdImageFilePpmTxt: version = 3; break;
+            case SimdImageFilePgmBin: version = 5; break;
+            case SimdImageFilePpmBin: version = 6; break;
+            default: return false;
+            }
+            uint32_t width, height;
+            if (!ReadSize(version, width, height))
+                return false;
+            InitInfo(info, width, height, gray ? 1 : 3);
+            return true;
+        }
+
+        bool ImagePxmLoader::ReadSize(size_t version, uint32_t& width, uint32_t& height)
         {
             if (_stream.Size() < 3 ||
                 _stream.Data()[0] != 'P' ||
@@ -112,13 +131,19 @@ namespace Simd
                 _stream.Data()[2] != '\n')
                 return false;
             _stream.Seek(3);
-            uint32_t width, height, max;
+            uint32_t max;
             if (!(_stream.ReadUnsigned(width) && _stream.ReadUnsigned(height) && _stream.ReadUnsigned(max)))
                 return false;
             if (!(width > 0 && height > 0 && max == 255))
                 return false;
             uint8_t byte;
-            if (!(_stream.Read(byte) && byte == '\n'))
+            return _stream.Read(byte) && byte == '\n';
+        }
+
+        bool ImagePxmLoader::ReadHeader(size_t version)
+        {
+            uint32_t width, height;
+            if (!ReadSize(version, width, height))
                 return false;
             _image.Recreate(width, height, (Image::Format)_param.format);
             _block = height;
@@ -363,6 +388,18 @@ namespace Simd
             }
             return NULL;
         }
+
+        bool ImageProbeFromMemory(const uint8_t* data, size_t size, SimdImageInfo* info)
+        {
+            ImageLoaderParam param(data, size, SimdPixelFormatNone);
+            if (info && param.Validate())
+            {
+                Holder<ImageLoader> loader(CreateImageLoader(param));
+                if (loader)
+                    return loader->Probe(*info);
+            }
+            return false;
+        }
     }
 }
 
@@ -27,6 +27,7 @@
 #include "Simd/SimdCpu.h"
 #include "Simd/SimdBase.h"
 #include "Simd/SimdYuvToBgr.h"
+#include "Simd/SimdParallel.hpp"
 
 namespace Simd
 {
@@ -112,10 +113,31 @@ namespace Simd
 
         //-------------------------------------------------------------------------------------------------
 
+        struct JpegWorker
+        {
+            InputMemoryStream stream;
+            JpegContext context;
+            Array8u band;
+            int error;
+
+            JpegWorker()
+                : context(&stream)
+                , error(0)
+            {
+            }
+        };
+
         JpegContext::JpegContext(InputMemoryStream* s)
             : stream(s)
             , img_n(0)
+            , scale(0)
+        {
+        }
+
+        JpegContext::~JpegContext()
         {
+            for (size_t i = 0; i < workers.size(); ++i)
+                delete workers[i];
         }
 
         void JpegContext::Reset()
@@ -523,6 +545,51 @@ namespace Simd
                 JpegIdct<int, uint8_t, 1>(buf + 8 * i, dst);
         }
 
+        //-------------------------------------------------------------------------------------------------
+
+        SIMD_ALIGNED(16) const float JpegIdct4x4K[16] =
+        {
+            0.353553391f, 0.353553391f, 0.353553391f, 0.353553391f,
+            0.461939766f, 0.191341716f, -0.191341716f, -0.461939766f,
+            0.353553391f, -0.353553391f, -0.353553391f, 0.353553391f,
+            0.191341716f, -0.461939766f, 0.461939766f, -0.191341716f,
+        };
+
+        static void JpegIdctBlock4x4(const int16_t* src, uint8_t* dst, int stride)
+        {
+            const float* k = JpegIdct4x4K;
+            float t[4][4];
+            for (int v = 0; v < 4; ++v)
+            {
+                float f0 = src[v * 8 + 0], f1 = src[v * 8 + 1], f2 = src[v * 8 + 2], f3 = src[v * 8 + 3];
+                for (int x = 0; x < 4; ++x)
+                    t[v][x] = (f0 * k[0 * 4 + x] + f1 * k[1 * 4 + x]) + (f2 * k[2 * 4 + x] + f3 * k[3 * 4 + x]);
+            }
+            for (int y = 0; y < 4; ++y, dst += stride)
+            {
+                for (int x = 0; x < 4; ++x)
+                {
+                    float o = (k[0 * 4 + y] * t[0][x] + k[2 * 4 + y] * t[2][x]) + (k[1 * 4 + y] * t[1][x] + k[3 * 4 + y] * t[3][x]);
+                    dst[x] = RestrictRange(Round(o) + 128);
+                }
+            }
+        }
+
+        static void JpegIdctBlock2x2(const int16_t* src, uint8_t* dst, int stride)
+        {
+            int s0 = src[0] + src[8], d0 = src[0] - src[8];
+            int s1 = src[1] + src[9], d1 = src[1] - src[9];
+            dst[0] = RestrictRange(((s0 + s1 + 4) >> 3) + 128);
+            dst[1] = RestrictRange(((s0 - s1 + 4) >> 3) + 128);
+            dst[stride + 0] = RestrictRange(((d0 + d1 + 4) >> 3) + 128);
+            dst[stride + 1] = RestrictRange(((d0 - d1 + 4) >> 3) + 128);
+        }
+
+        static void JpegIdctBlock1x1(const int16_t* src, uint8_t* dst, int stride)
+        {
+            dst[0] = RestrictRange(((src[0] + 4) >> 3) + 128);
+        }
+
         static uint8_t JpegGetMarker(JpegContext* j)
         {
             uint8_t x;
@@ -540,12 +607,311 @@ namespace Simd
             return x;
         }
 
+        const size_t JpegParallelSizeMin = 512 * 512;
+
+        SIMD_INLINE size_t JpegThreadNumber(const JpegContext* z)
+        {
+            return size_t(z->img_x) * z->img_y >= JpegParallelSizeMin ? Base::GetThreadNumber() : 1;
+        }
+
+        SIMD_INLINE int JpegUnitCount(const JpegContext* z)
+        {
+            if (z->scan_n == 1)
+            {
+                const JpegImgComp& c = z->img_comp[z->order[0]];
+                return ((c.x + 7) >> 3) * ((c.y + 7) >> 3);
+            }
+            return z->img_mcu_x * z->img_mcu_y;
+        }
+
+        static int JpegDecodeUnits(JpegContext* z, int begin, int end)
+        {
+            SIMD_ALIGNED(16) short data[64];
+            IdctBlockPtr idctBlock = z->IdctBlock();
+            int bs = z->BlockSize();
+            if (z->scan_n == 1)
+            {
+                int n = z->order[0];
+                JpegImgComp& c = z->img_comp[n];
+                int w = (c.x + 7) >> 3, stride = c.w2 >> z->scale;
+                for (int u = begin; u < end; ++u)
+                {
+                    int i = u % w, j = u / w;
+                    if (!JpegDecodeBlock(z, data, z->huff_dc + c.hd, z->huff_ac + c.ha, z->huff_ac[c.ha].fast_ac, n, z->dequant[c.tq]))
+                        return 0;
+                    idctBlock(data, c.data + stride * j * bs + i * bs, stride);
+                }
+            }
+            else
+            {
+                for (int u = begin; u < end; ++u)
+                {
+                    int i = u % z->img_mcu_x, j = u / z->img_mcu_x;
+                    for (int k = 0; k < z->scan_n; ++k)
+                    {
+                        int n = z->order[k];
+                        JpegImgComp& c = z->img_comp[n];
+                        int stride = c.w2 >> z->scale;
+                        for (int y = 0; y < c.v; ++y)
+                        {
+                            for (int x = 0; x < c.h; ++x)
+                            {
+                                int x2 = (i * c.h + x) * bs;
+                                int y2 = (j * c.v + y) * bs;
+                                if (!JpegDecodeBlock(z, data, z->huff_dc + c.hd, z->huff_ac + c.ha, z->huff_ac[c.ha].fast_ac, n, z->dequant[c.tq]))
+                                    return 0;
+                                idctBlock(data, c.data + stride * y2 + x2, stride);
+                            }
+                        }
+                    }
+                }
+            }
+            return 1;
+        }
+
+        static void JpegInitWorker(JpegContext& dst, const JpegContext& src)
+        {
+            memcpy(dst.huff_dc, src.huff_dc, sizeof(src.huff_dc));
+            memcpy(dst.huff_ac, src.huff_ac, sizeof(src.huff_ac));
+            memcpy(dst.dequant, src.dequant, sizeof(src.dequant));
+            dst.img_x = src.img_x;
+            dst.img_y = src.img_y;
+            dst.img_n = src.img_n;
+            dst.img_h_max = src.img_h_max;
+            dst.img_v_max = src.img_v_max;
+            dst.img_mcu_x = src.img_mcu_x;
+            dst.img_mcu_y = src.img_mcu_y;
+            dst.img_mcu_w = src.img_mcu_w;
+            dst.img_mcu_h = src.img_mcu_h;
+            for (int n = 0; n < 4; ++n)
+            {
+                JpegImgComp& d = dst.img_comp[n];
+                const JpegImgComp& s = src.img_comp[n];
+                d.id = s.id, d.h = s.h, d.v = s.v, d.tq = s.tq, d.hd = s.hd, d.ha = s.ha;
+                d.x = s.x, d.y = s.y, d.w2 = s.w2, d.h2 = s.h2;
+                d.data = s.data, d.coeff = s.coeff, d.coeffW = s.coeffW, d.coeffH = s.coeffH;
+            }
+            dst.progressive = src.progressive;
+            dst.spec_start = src.spec_start;
+            dst.spec_end = src.spec_end;
+            dst.succ_high = src.succ_high;
+            dst.succ_low = src.succ_low;
+            dst.scan_n = src.scan_n;
+            for (int k = 0; k < 4; ++k)
+                dst.order[k] = src.order[k];
+            dst.restart_interval = src.restart_interval;
+            dst.scale = src.scale;
+            dst.idctBlock = src.idctBlock;
+            dst.idctBlock4x4 = src.idctBlock4x4;
+            dst.idctBlock2x2 = src.idctBlock2x2;
+            dst.idctBlock1x1 = src.idctBlock1x1;
+        }
+
+        static bool JpegFindRestartMarkers(const InputMemoryStream& stream, std::vector<size_t>& starts, size_t& end)
+        {
+            const uint8_t* data = stream.Data();
+            size_t pos = stream.Pos(), size = stream.Size();
+            starts.clear();
+            starts.push_back(pos);
+            while (pos + 1 < size)
+            {
+                if (data[pos] != 0xFF)
+                    pos += 1;
+                else if (data[pos + 1] == 0x00)
+                    pos += 2;
+                else if (data[pos + 1] == 0xFF)
+                    pos += 1;
+                else if (data[pos + 1] >= 0xD0 && data[pos + 1] <= 0xD7)
+                {
+                    pos += 2;
+                    starts.push_back(pos);
+                }
+                else
+                {
+                    end = pos;
+                    if (starts.back() == end)
+                        starts.pop_back();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static int JpegParseRestartIntervals(JpegContext* z, size_t threadNumber)
+        {
+            std::vector<size_t> starts;
+            size_t end;
+            if (!JpegFindRestartMarkers(*z->stream, starts, end))
+                return -1;
+            int count = JpegUnitCount(z), interval = z->restart_interval;
+            if (starts.size() != size_t((count + interval - 1) / interval))
+                return -1;
+            threadNumber = Min(threadNumber, starts.size());
+            while (z->workers.size() < threadNumber)
+                z->workers.push_back(new JpegWorker());
+            for (size_t t = 0; t < threadNumber; ++t)
+            {
+                JpegInitWorker(z->workers[t]->context, *z);
+                z->workers[t]->error = 0;
+            }
+            const uint8_t* data = z->stream->Data();
+            Parallel(0, starts.size(), [&](size_t thread, size_t begin, size_t finish)
+            {
+                JpegWorker& worker = *z->workers[thread];
+                for (size_t s = begin; s < finish && !worker.error; ++s)
+                {
+                    worker.stream.Init(data + starts[s], end - starts[s]);
+                    worker.context.Reset();
+                    int first = int(s) * interval;
+                    if (!JpegDecodeUnits(&worker.context, first, Min(first + interval, count)))
+                        worker.error = 1;
+                }
+            }, threadNumber);
+            for (size_t t = 0; t < threadNumber; ++t)
+                if (z->workers[t]->error)
+                    return 0;
+            z->stream->Seek(end);
+            z->Reset();
+            return 1;
+        }
+
+#ifndef SIMD_FUTURE_DISABLE
+        const int JpegPipelineRing = 8;
+
+        static int JpegDecodeRow(JpegContext* z, int j)
+        {
+            int slot = j % JpegPipelineRing;
+            if (z->scan_n == 1)
+            {
+                int n = z->order[0];
+                JpegImgComp& c = z->img_comp[n];
+                int w = (c.x + 7) >> 3;
+                short* dst = c.bufR.data + slot * w * 64;
+                for (int i = 0; i < w; ++i, dst += 64)
+                    if (!JpegDecodeBlock(z, dst, z->huff_dc + c.hd, z->huff_ac + c.ha, z->huff_ac[c.ha].fast_ac, n, z->dequant[c.tq]))
+                        return 0;
+            }
+            else
+            {
+                for (int i = 0; i < z->img_mcu_x; ++i)
+                {
+                    for (int k = 0; k < z->scan_n; ++k)
+                    {
+                        int n = z->order[k];
+                        JpegImgComp& c = z->img_comp[n];
+                        int rowBlocks = z->img_mcu_x * c.h;
+                        for (int y = 0; y < c.v; ++y)
+                        {
+                            short* dst = c.bufR.data + ((slot * c.v + y) * rowBlocks + i * c.h) * 64;
+                            for (int x = 0; x < c.h; ++x, dst += 64)
+                                if (!JpegDecodeBlock(z, dst, z->huff_dc + c.hd, z->huff_ac + c.ha, z->huff_ac[c.ha].fast_ac, n, z->dequant[c.tq]))
+                                    return 0;
+                        }
+                    }
+                }
+            }
+            return 1;
+        }
+
+        static void JpegTransformRow(JpegContext* z, int j)
+        {
+            IdctBlockPtr idctBlock = z->IdctBlock();
+            int bs = z->BlockSize(), slot = j % JpegPipelineRing;
+            if (z->scan_n == 1)
+            {
+                JpegImgComp& c = z->img_comp[z->order[0]];
+                int w = (c.x + 7) >> 3, stride = c.w2 >> z->scale;
+                const short* src = c.bufR.data + slot * w * 64;
+                for (int i = 0; i < w; ++i, src += 64)
+                    idctBlock(src, c.data + stride * j * bs + i * bs, stride);
+            }
+            else
+            {
+                for (int k = 0; k < z->scan_n; ++k)
+                {
+                    JpegImgComp& c = z->img_comp[z->order[k]];
+                    int rowBlocks = z->img_mcu_x * c.h, stride = c.w2 >> z->scale;
+                    for (int y = 0; y < c.v; ++y)
+                    {
+                        const short* src = c.bufR.data + (slot * c.v + y) * rowBlocks * 64;
+                        uint8_t* dst = c.data + stride * (j * c.v + y) * bs;
+                        for (int i = 0; i < rowBlocks; ++i, src += 64)
+                            idctBlock(src, dst + i * bs, stride);
+                    }
+                }
+            }
+        }
+
+        static int JpegParsePipelined(JpegContext* z)
+        {
+            int rows;
+            if (z->scan_n == 1)
+            {
+                JpegImgComp& c = z->img_comp[z->order[0]];
+                rows = (c.y + 7) >> 3;
+                c.bufR.Resize(JpegPipelineRing * ((c.x + 7) >> 3) * 64);
+            }
+            else
+            {
+                rows = z->img_mcu_y;
+                for (int k = 0; k < z->scan_n; ++k)
+                {
+                    JpegImgComp& c = z->img_comp[z->order[k]];
+                    c.bufR.Resize(JpegPipelineRing * z->img_mcu_x * c.h * c.v * 64);
+                }
+            }
+            const int batch = JpegPipelineRing / 2;
+            for (int j = 0; j < Min(batch, rows); ++j)
+                if (!JpegDecodeRow(z, j))
+                    return 0;
+            int error = 0;
+            for (int t = 0; t < rows && !error; t += batch)
+            {
+                int d = t + batch;
+                Parallel(0, 2, [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t stage = begin; stage < end; ++stage)
+                    {
+                        if (stage == 0)
+                        {
+                            for (int j = d; j < Min(d + batch, rows) && !error; ++j)
+                                if (!JpegDecodeRow(z, j))
+                                    error = 1;
+                        }
+                        else
+                        {
+                            for (int j = t; j < Min(t + batch, rows); ++j)
+                                JpegTransformRow(z, j);
+                        }
+                    }
+                }, 2);
+            }
+            return !error;
+        }
+#endif
+
         static int JpegParseEntropyCodedData(JpegContext* z)
         {
             z->Reset();
+            size_t threadNumber = JpegThreadNumber(z);
+            if (!z->progressive && threadNumber > 1)
+            {
+                if (z->restart_interval)
+                {
+                    int result = JpegParseRestartIntervals(z, threadNumber);
+                    if (result >= 0)
+                        return result;
+                }
+#ifndef SIMD_FUTURE_DISABLE
+                else
+                    return JpegParsePipelined(z);
+#endif
+            }
             if (!z->progressive)
             {
                 SIMD_ALIGNED(16) short data[64];
+                IdctBlockPtr idctBlock = z->IdctBlock();
+                int bs = z->BlockSize();
                 if (z->scan_n == 1) 
                 {
                     int n = z->order[0];
@@ -558,7 +924,8 @@ namespace Simd
                             int ha = z->img_comp[n].ha;
                             if (!JpegDecodeBlock(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->huff_ac[ha].fast_ac, n, z->dequant[z->img_comp[n].tq])) 
                                 return 0;
-                            z->idctBlock(data, z->img_comp[n].data + z->img_comp[n].w2 * j * 8 + i * 8, z->img_comp[n].w2);
+                            int stride = z->img_comp[n].w2 >> z->scale;
+                            idctBlock(data, z->img_comp[n].data + stride * j * bs + i * bs, stride);
                             if (--z->todo <= 0) 
                             {
                                 if (z->code_bits < 24) 
@@ -584,12 +951,13 @@ namespace Simd
                                 {
                                     for (int x = 0; x < z->img_comp[n].h; ++x)
                                     {
-                                        int x2 = (i * z->img_comp[n].h + x) * 8;
-                                        int y2 = (j * z->img_comp[n].v + y) * 8;
+                                        int x2 = (i * z->img_comp[n].h + x) * bs;
+                                        int y2 = (j * z->img_comp[n].v + y) * bs;
                                         int ha = z->img_comp[n].ha;
                                         if (!JpegDecodeBlock(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->huff_ac[ha].fast_ac, n, z->dequant[z->img_comp[n].tq])) 
                                             return 0;
-                                        z->idctBlock(data, z->img_comp[n].data + z->img_comp[n].w2 * y2 + x2, z->img_comp[n].w2);
+                                        int stride = z->img_comp[n].w2 >> z->scale;
+                                        idctBlock(data, z->img_comp[n].data + stride * y2 + x2, stride);
                                     }
                                 }
                             }
@@ -679,10 +1047,13 @@ namespace Simd
 
         static void JpegFinish(JpegContext* z)
         {
+            IdctBlockPtr idctBlock = z->IdctBlock();
+            int bs = z->BlockSize();
             for (int n = 0; n < z->img_n; ++n) 
             {
                 int w = (z->img_comp[n].x + 7) >> 3;
                 int h = (z->img_comp[n].y + 7) >> 3;
+                int stride = z->img_comp[n].w2 >> z->scale;
                 for (int j = 0; j < h; ++j) 
                 {
                     for (int i = 0; i < w; ++i) 
@@ -691,12 +1062,29 @@ namespace Simd
                         const uint16_t* dequant = z->dequant[z->img_comp[n].tq];
                         for (int k = 0; k < 64; ++k)
                             data[k] *= dequant[k];
-                        z->idctBlock(data, z->img_comp[n].data + z->img_comp[n].w2 * j * 8 + i * 8, z->img_comp[n].w2);
+                        idctBlock(data, z->img_comp[n].data + stride * j * bs + i * bs, stride);
                     }
                 }
             }
         }
 
+        static void JpegScaleGeometry(JpegContext* z)
+        {
+            if (z->scale == 0)
+                return;
+            int add = (1 << z->scale) - 1;
+            z->img_x = (z->img_x + add) >> z->scale;
+            z->img_y = (z->img_y + add) >> z->scale;
+            for (int n = 0; n < z->img_n; ++n)
+            {
+                JpegImgComp& c = z->img_comp[n];
+                c.x = (c.x + add) >> z->scale;
+                c.y = (c.y + add) >> z->scale;
+                c.w2 >>= z->scale;
+                c.h2 >>= z->scale;
+            }
+        }
+
         static int JpegProcessMarker(JpegContext* z, int m)
         {
             int L;
@@ -896,7 +1284,7 @@ namespace Simd
                 if (z->img_comp[i].tq > 3) 
                     return JpegLoadError("bad TQ", "Corrupt JPEG");
             }
-            if (scan) 
+            if (scan != JpegScanLoad) 
                 return 1;
             if (z->img_x* z->img_y * z->img_n > INT_MAX) 
                 return JpegLoadError("too large", "Image too large to decode");
@@ -919,7 +1307,7 @@ namespace Simd
                 z->img_comp[i].w2 = z->img_mcu_x * z->img_comp[i].h * 8;
                 z->img_comp[i].h2 = z->img_mcu_y * z->img_comp[i].v * 8;
                 z->img_comp[i].coeff = 0;
-                z->img_comp[i].bufD.Resize(z->img_comp[i].w2 * z->img_comp[i].h2);
+                z->img_comp[i].bufD.Resize((z->img_comp[i].w2 >> z->scale) * (z->img_comp[i].h2 >> z->scale));
                 if (z->img_comp[i].bufD.Empty())
                     return JpegLoadError("outofmem", "Out of memory");
                 z->img_comp[i].data = z->img_comp[i].bufD.data;
@@ -944,7 +1332,7 @@ namespace Simd
             int m = JpegGetMarker(z);
             if (m != JpegMarkerSoi)
                 return JpegLoadError("no SOI", "Corrupt JPEG");
-            if (scan) 
+            if (scan == JpegScanType) 
                 return 1;
             m = JpegGetMarker(z);
             while (!(m == 0xC0 || m == 0xC1 || m == 0xC2))
@@ -965,11 +1353,20 @@ namespace Simd
             return 1;
         }
 
-        static int JpegDecode(JpegContext* j)
+        int JpegDecodeHeader(JpegContext* j)
         {
             j->restart_interval = 0;
-            if (!DecodeJpegHeader(j, 0)) 
-                return 0;
+            return DecodeJpegHeader(j, JpegScanLoad);
+        }
+
+        int JpegProbeHeader(JpegContext* j)
+        {
+            j->restart_interval = 0;
+            return DecodeJpegHeader(j, JpegScanHeader);
+        }
+
+        int JpegDecodeData(JpegContext* j)
+        {
             int m = JpegGetMarker(j);
             while (m != JpegMarkerEoi)
             {
@@ -1010,6 +1407,7 @@ namespace Simd
             }
             if (j->progressive)
                 JpegFinish(j);
+            JpegScaleGeometry(j);
             return 1;
         }
 
@@ -1332,103 +1730,279 @@ namespace Simd
 
         //-------------------------------------------------------------------------------------------------
 
-        ImageJpegLoader::ImageJpegLoader(const ImageLoaderParam& param)
-            : ImageLoader(param)
-            , _context(new JpegContext(&_stream))
+        void JpegSetConverters(JpegContext* context, SimdPixelFormatType format)
         {
-            _context->idctBlock = JpegIdctBlock;
-            _context->resampleRowHv2 = JpegResampleRowHv2;
-            _context->yuvToRgbRow = JpegYuvToRgbRow;
-            if (_param.format == SimdPixelFormatNone)
-                _param.format = SimdPixelFormatRgb24;
-            if (_param.format == SimdPixelFormatGray8)
-                _context->rgbaToAny = Base::RgbaToGray;
-            if (_param.format == SimdPixelFormatBgr24)
+            context->idctBlock = JpegIdctBlock;
+            context->idctBlock4x4 = JpegIdctBlock4x4;
+            context->idctBlock2x2 = JpegIdctBlock2x2;
+            context->idctBlock1x1 = JpegIdctBlock1x1;
+            context->resampleRowHv2 = JpegResampleRowHv2;
+            context->yuvToRgbRow = JpegYuvToRgbRow;
+            context->interleaveUv = Base::InterleaveUv;
+            if (format == SimdPixelFormatGray8)
+                context->rgbaToAny = Base::RgbaToGray;
+            if (format == SimdPixelFormatBgr24)
             {
-                _context->yuv444pToBgr = Base::Yuv444pToBgrV2;
-                _context->yuv420pToBgr = Base::JpegYuv420pToBgr;
-                _context->rgbaToAny = Base::BgraToRgb;
+                context->yuv444pToBgr = Base::Yuv444pToBgrV2;
+                context->yuv420pToBgr = Base::JpegYuv420pToBgr;
+                context->rgbaToAny = Base::BgraToRgb;
             }
-            if (_param.format == SimdPixelFormatBgra32)
+            if (format == SimdPixelFormatBgra32)
             {
-                _context->yuv444pToBgra = Base::Yuv444pToBgraV2;
-                _context->yuv420pToBgra = Base::JpegYuv420pToBgra;
-                _context->rgbaToAny = Base::BgraToRgba;
+                context->yuv444pToBgra = Base::Yuv444pToBgraV2;
+                context->yuv420pToBgra = Base::JpegYuv420pToBgra;
+                context->rgbaToAny = Base::BgraToRgba;
             }
-            if (_param.format == SimdPixelFormatRgb24)
+            if (format == SimdPixelFormatRgb24)
             {
-                _context->yuv444pToBgr = Base::Yuv444pToRgbV2;
-                _context->yuv420pToBgr = Base::JpegYuv420pToRgb;
-                _context->rgbaToAny = Base::BgraToBgr;
+                context->yuv444pToBgr = Base::Yuv444pToRgbV2;
+                context->yuv420pToBgr = Base::JpegYuv420pToRgb;
+                context->rgbaToAny = Base::BgraToBgr;
             }
-            if (_param.format == SimdPixelFormatRgba32)
+            if (format == SimdPixelFormatRgba32)
             {
-                _context->yuv444pToBgra = Base::Yuv444pToRgbaV2;
-                _context->yuv420pToBgra = Base::JpegYuv420pToRgba;
+                context->yuv444pToBgra = Base::Yuv444pToRgbaV2;
+                context->yuv420pToBgra = Base::JpegYuv420pToRgba;
             }
         }
 
-        ImageJpegLoader::~ImageJpegLoader()
+        static void JpegYuv420pConvertRows(const JpegContext* z, bool alpha, size_t begin, size_t height, uint8_t* dst, size_t stride)
         {
-            if (_context)
-                delete _context;
+            const JpegImgComp* c = z->img_comp;
+            const uint8_t* y = c[0].data + begin * c[0].w2, * u = c[1].data + begin / 2 * c[1].w2, * v = c[2].data + begin / 2 * c[2].w2;
+            if (alpha)
+                z->yuv420pToBgra(y, c[0].w2, u, c[1].w2, v, c[2].w2, z->img_x, height, dst, stride, 0xFF, SimdYuvTrect871);
+            else
+                z->yuv420pToBgr(y, c[0].w2, u, c[1].w2, v, c[2].w2, z->img_x, height, dst, stride, SimdYuvTrect871);
         }
 
-        bool ImageJpegLoader::FromStream()
+        static void JpegYuv420pConvertBand(const JpegContext* z, bool alpha, size_t begin, size_t end, uint8_t* dst, size_t stride, Array8u& buf)
         {
-            if (!JpegDecode(_context))
-                return false;
-            _image.Recreate(_context->img_x, _context->img_y, (Image::Format)_param.format);
-            if (CanCopyGray(*_context) && _param.format == SimdPixelFormatGray8)
+            JpegYuv420pConvertRows(z, alpha, begin, end - begin, dst + begin * stride, stride);
+            if (begin == 0 && end == z->img_y)
+                return;
+            // Chroma upsampling of border rows of the band uses neighbor chroma rows from other bands:
+            size_t rowSize = z->img_x * (alpha ? 4 : 3);
+            if (buf.size < rowSize * 3)
+                buf.Resize(rowSize * 3);
+            if (begin > 0)
             {
-                Base::Copy(_context->img_comp[0].data, _context->img_comp[0].w2, _context->img_x, _context->img_y, 1, _image.data, _image.stride);
+                JpegYuv420pConvertRows(z, alpha, begin - 2, 3, buf.data, rowSize);
+                memcpy(dst + begin * stride, buf.data + 2 * rowSize, rowSize);
+            }
+            if (end < z->img_y)
+            {
+                JpegYuv420pConvertRows(z, alpha, end - 2, 3, buf.data, rowSize);
+                memcpy(dst + (end - 1) * stride, buf.data + rowSize, rowSize);
+            }
+        }
+
+        bool JpegConvert(JpegContext* context, SimdPixelFormatType format, uint8_t* dst, size_t stride)
+        {
+            if (CanCopyGray(*context) && format == SimdPixelFormatGray8)
+            {
+                Base::Copy(context->img_comp[0].data, context->img_comp[0].w2, context->img_x, context->img_y, 1, dst, stride);
                 return true;
             }
-            if (IsYuv420(*_context))
+            const JpegImgComp* c = context->img_comp;
+            size_t width = context->img_x, threadNumber = JpegThreadNumber(context);
+            if (IsYuv420(*context) && (format == SimdPixelFormatBgr24 || format == SimdPixelFormatRgb24 || 
+                format == SimdPixelFormatBgra32 || format == SimdPixelFormatRgba32))
             {
-                switch (_param.format)
+                bool alpha = format == SimdPixelFormatBgra32 || format == SimdPixelFormatRgba32;
+                while (context->workers.size() < threadNumber)
+                    context->workers.push_back(new JpegWorker());
+                Parallel(0, context->img_y, [&](size_t thread, size_t begin, size_t end)
                 {
-                case SimdPixelFormatBgr24:
-                case SimdPixelFormatRgb24:
-                    _context->yuv420pToBgr(_context->img_comp[0].data, _context->img_comp[0].w2, _context->img_comp[1].data, _context->img_comp[1].w2,
-                        _context->img_comp[2].data, _context->img_comp[2].w2, _context->img_x, _context->img_y, _image.data, _image.stride, SimdYuvTrect871);
-                    return true;
-                case SimdPixelFormatBgra32:
-                case SimdPixelFormatRgba32:
-                    _context->yuv420pToBgra(_context->img_comp[0].data, _context->img_comp[0].w2, _context->img_comp[1].data, _context->img_comp[1].w2,
-                        _context->img_comp[2].data, _context->img_comp[2].w2, _context->img_x, _context->img_y, _image.data, _image.stride, 0xFF, SimdYuvTrect871);
-                    return true;
-                }
+                    JpegYuv420pConvertBand(context, alpha, begin, end, dst, stride, context->workers[thread]->band);
+                }, threadNumber, 2);
+                return true;
             }
-            if (IsYuv444(*_context))
+            if (IsYuv444(*context) && (format == SimdPixelFormatBgr24 || format == SimdPixelFormatRgb24 ||
+                format == SimdPixelFormatBgra32 || format == SimdPixelFormatRgba32))
             {
-                switch (_param.format)
+                Parallel(0, context->img_y, [&](size_t thread, size_t begin, size_t end)
                 {
-                case SimdPixelFormatBgr24:
-                case SimdPixelFormatRgb24:
-                    _context->yuv444pToBgr(_context->img_comp[0].data, _context->img_comp[0].w2, _context->img_comp[1].data, _context->img_comp[1].w2,
-                        _context->img_comp[2].data, _context->img_comp[2].w2, _context->img_x, _context->img_y, _image.data, _image.stride, SimdYuvTrect871);
-                    return true;
-                case SimdPixelFormatBgra32:
-                case SimdPixelFormatRgba32:
-                    _context->yuv444pToBgra(_context->img_comp[0].data, _context->img_comp[0].w2, _context->img_comp[1].data, _context->img_comp[1].w2,
-                        _context->img_comp[2].data, _context->img_comp[2].w2, _context->img_x, _context->img_y, _image.data, _image.stride, 0xFF, SimdYuvTrect871);
-                    return true;
-                }
+                    const uint8_t* y = c[0].data + begin * c[0].w2, * u = c[1].data + begin * c[1].w2, * v = c[2].data + begin * c[2].w2;
+                    if (format == SimdPixelFormatBgr24 || format == SimdPixelFormatRgb24)
+                        context->yuv444pToBgr(y, c[0].w2, u, c[1].w2, v, c[2].w2, width, end - begin, dst + begin * stride, stride, SimdYuvTrect871);
+                    else
+                        context->yuv444pToBgra(y, c[0].w2, u, c[1].w2, v, c[2].w2, width, end - begin, dst + begin * stride, stride, 0xFF, SimdYuvTrect871);
+                }, threadNumber);
+                return true;
             }
-            if (JpegToRgba(_context))
+            if (JpegToRgba(context))
             {
-                size_t stride = 4 * _context->img_x;
-                if (_param.format == SimdPixelFormatRgba32)
-                    Base::Copy(_context->out.data, stride, _context->img_x, _context->img_y, 4, _image.data, _image.stride);
-                else if (_param.format == SimdPixelFormatGray8 || _param.format == SimdPixelFormatBgr24 ||
-                    _param.format == SimdPixelFormatBgra32 || _param.format == SimdPixelFormatRgb24)
-                    _context->rgbaToAny(_context->out.data, _context->img_x, _context->img_y, stride, _image.data, _image.stride);
+                size_t rgbaStride = 4 * context->img_x;
+                if (format == SimdPixelFormatRgba32)
+                    Base::Copy(context->out.data, rgbaStride, context->img_x, context->img_y, 4, dst, stride);
+                else if (format == SimdPixelFormatGray8 || format == SimdPixelFormatBgr24 ||
+                    format == SimdPixelFormatBgra32 || format == SimdPixelFormatRgb24)
+                    context->rgbaToAny(context->out.data, context->img_x, context->img_y, rgbaStride, dst, stride);
                 else
                     return false;
                 return true;
             }
             return false;
         }
+
+        bool JpegCopyYuv420p(JpegContext* context, uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride)
+        {
+            size_t uvW = (context->img_x + 1) / 2, uvH = (context->img_y + 1) / 2;
+            if (IsYuv420(*context))
+            {
+                Base::Copy(context->img_comp[0].data, context->img_comp[0].w2, context->img_x, context->img_y, 1, y, yStride);
+                Base::Copy(context->img_comp[1].data, context->img_comp[1].w2, uvW, uvH, 1, u, uStride);
+                Base::Copy(context->img_comp[2].data, context->img_comp[2].w2, uvW, uvH, 1, v, vStride);
+                return true;
+            }
+            if (context->img_n == 1)
+            {
+                Base::Copy(context->img_comp[0].data, context->img_comp[0].w2, context->img_x, context->img_y, 1, y, yStride);
+                Base::Fill(u, uStride, uvW, uvH, 1, 128);
+                Base::Fill(v, vStride, uvW, uvH, 1, 128);
+                return true;
+            }
+            return false;
+        }
+
+        bool JpegCopyNv12(JpegContext* context, uint8_t* y, size_t yStride, uint8_t* uv, size_t uvStride)
+        {
+            size_t uvW = (context->img_x + 1) / 2, uvH = (context->img_y + 1) / 2;
+            if (IsYuv420(*context))
+            {
+                Base::Copy(context->img_comp[0].data, context->img_comp[0].w2, context->img_x, context->img_y, 1, y, yStride);
+                context->interleaveUv(context->img_comp[1].data, context->img_comp[1].w2, context->img_comp[2].data, context->img_comp[2].w2, uvW, uvH, uv, uvStride);
+                return true;
+            }
+            if (context->img_n == 1)
+            {
+                Base::Copy(context->img_comp[0].data, context->img_comp[0].w2, context->img_x, context->img_y, 1, y, yStride);
+                Base::Fill(uv, uvStride, uvW * 2, uvH, 1, 128);
+                return true;
+            }
+            return false;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        ImageJpegLoader::ImageJpegLoader(const ImageLoaderParam& param)
+            : ImageLoader(param)
+            , _context(new JpegContext(&_stream))
+        {
+            if (_param.format == SimdPixelFormatNone)
+                _param.format = SimdPixelFormatRgb24;
+            JpegSetConverters(_context, _param.format);
+        }
+
+        ImageJpegLoader::~ImageJpegLoader()
+        {
+            if (_context)
+                delete _context;
+        }
+
+        bool ImageJpegLoader::FromStream()
+        {
+            if (!(JpegDecodeHeader(_context) && JpegDecodeData(_context)))
+                return false;
+            _image.Recreate(_context->img_x, _context->img_y, (Image::Format)_param.format);
+            return JpegConvert(_context, _param.format, _image.data, _image.stride);
+        }
+
+        bool ImageJpegLoader::Probe(SimdImageInfo& info)
+        {
+            const JpegContext& c = *_context;
+            if (!JpegProbeHeader(_context))
+                return false;
+            InitInfo(info, c.img_x, c.img_y, c.img_n);
+            info.progressive = c.progressive ? SimdTrue : SimdFalse;
+            if (c.img_n >= 3)
+            {
+                int hMax = 1, vMax = 1;
+                for (int i = 0; i < c.img_n; ++i)
+                {
+                    hMax = Max(c.img_comp[i].h, hMax);
+                    vMax = Max(c.img_comp[i].v, vMax);
+                }
+                info.subsamplingX = hMax / c.img_comp[1].h;
+                info.subsamplingY = vMax / c.img_comp[1].v;
+            }
+            return true;
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        JpegDecoder::JpegDecoder(JpegSetConvertersPtr setConverters)
+            : _context(&_stream)
+            , _setConverters(setConverters)
+            , _parsed(false)
+            , _scale(0)
+        {
+        }
+
+        bool JpegDecoder::SetScale(size_t denominator)
+        {
+            switch (denominator)
+            {
+            case 1: _scale = 0; return true;
+            case 2: _scale = 1; return true;
+            case 4: _scale = 2; return true;
+            case 8: _scale = 3; return true;
+            default: return false;
+            }
+        }
+
+        bool JpegDecoder::Parse(const uint8_t* data, size_t size, size_t* width, size_t* height)
+        {
+            _stream.Init(data, size);
+            _context.scale = _scale;
+            _parsed = size >= 2 && data[0] == 0xFF && data[1] == JpegMarkerSoi && JpegDecodeHeader(&_context);
+            if (!_parsed)
+                return false;
+            int add = (1 << _scale) - 1;
+            if (width)
+                *width = (_context.img_x + add) >> _scale;
+            if (height)
+                *height = (_context.img_y + add) >> _scale;
+            return true;
+        }
+
+        bool JpegDecoder::Decode(uint8_t* dst, size_t stride, SimdPixelFormatType format)
+        {
+            if (!(format == SimdPixelFormatGray8 || format == SimdPixelFormatBgr24 ||
+                format == SimdPixelFormatBgra32 || format == SimdPixelFormatRgb24 || format == SimdPixelFormatRgba32))
+                return false;
+            if (!DecodeData(format))
+                return false;
+            return JpegConvert(&_context, format, dst, stride);
+        }
+
+        bool JpegDecoder::DecodeYuv420p(uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride)
+        {
+            if (!DecodeData(SimdPixelFormatNone))
+                return false;
+            return JpegCopyYuv420p(&_context, y, yStride, u, uStride, v, vStride);
+        }
+
+        bool JpegDecoder::DecodeNv12(uint8_t* y, size_t yStride, uint8_t* uv, size_t uvStride)
+        {
+            if (!DecodeData(SimdPixelFormatNone))
+                return false;
+            return JpegCopyNv12(&_context, y, yStride, uv, uvStride);
+        }
+
+        bool JpegDecoder::DecodeData(SimdPixelFormatType format)
+        {
+            if (!_parsed)
+                return false;
+            _parsed = false;
+            _setConverters(&_context, format);
+            return JpegDecodeData(&_context) != 0;
+        }
+
+        void* JpegDecoderInit()
+        {
+            return new JpegDecoder(Base::JpegSetConverters);
+        }
     }
 }
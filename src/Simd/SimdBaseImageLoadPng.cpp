@@ -33,339 +33,284 @@ namespace Simd
 {
     namespace Base
     {
-        namespace Zlib
+        bool ZlibHuffman::Build(const uint8_t* sizes, int num, bool literals)
         {
-            const size_t ZFAST_BITS = 9;
-            const size_t ZFAST_SIZE = 1 << ZFAST_BITS;
-            const size_t ZFAST_MASK = ZFAST_SIZE - 1;
-
-            struct Zhuffman
+            int i, k = 0;
+            int code, nextCode[16], count[17];
+
+            memset(count, 0, sizeof(count));
+            memset(fast, 0, sizeof(fast));
+            for (i = 0; i < num; ++i)
+                ++count[sizes[i]];
+            count[0] = 0;
+            for (i = 1; i < 16; ++i)
+                if (count[i] > (1 << i))
+                    return CorruptPngError("bad sizes");
+            code = 0;
+            for (i = 1; i < 16; ++i)
+            {
+                nextCode[i] = code;
+                firstCode[i] = (uint16_t)code;
+                firstSymbol[i] = (uint16_t)k;
+                code = (code + count[i]);
+                if (count[i] && code - 1 >= (1 << i))
+                    return CorruptPngError("bad codelengths");
+                maxCode[i] = code << (16 - i);
+                code <<= 1;
+                k += count[i];
+            }
+            maxCode[16] = 0x10000;
+            literal = literals ? 256 : 0;
+            for (i = 0; i < num; ++i)
             {
-                uint16_t fast[ZFAST_SIZE];
-                uint16_t firstCode[16];
-                int maxCode[17];
-                uint16_t firstSymbol[16];
-                uint8_t  size[288];
-                uint16_t value[288];
-
-                bool Build(const uint8_t* sizelist, int num)
+                int s = sizes[i];
+                if (s)
                 {
-                    int i, k = 0;
-                    int code, nextCode[16], sizes[17];
-
-                    memset(sizes, 0, sizeof(sizes));
-                    memset(fast, 0, sizeof(fast));
-                    for (i = 0; i < num; ++i)
-                        ++sizes[sizelist[i]];
-                    sizes[0] = 0;
-                    for (i = 1; i < 16; ++i)
-                        if (sizes[i] > (1 << i))
-                            return CorruptPngError("bad sizes");
-                    code = 0;
-                    for (i = 1; i < 16; ++i)
+                    int c = nextCode[s] - firstCode[s] + firstSymbol[s];
+                    size[c] = (uint8_t)s;
+                    value[c] = (uint16_t)i;
+                    if (s <= (int)ZLIB_FAST_BITS)
                     {
-                        nextCode[i] = code;
-                        firstCode[i] = (uint16_t)code;
-                        firstSymbol[i] = (uint16_t)k;
-                        code = (code + sizes[i]);
-                        if (sizes[i] && code - 1 >= (1 << i))
-                            return CorruptPngError("bad codelengths");
-                        maxCode[i] = code << (16 - i);
-                        code <<= 1;
-                        k += sizes[i];
-                    }
-                    maxCode[16] = 0x10000;
-                    for (i = 0; i < num; ++i)
-                    {
-                        int s = sizelist[i];
-                        if (s)
-                        {
-                            int c = nextCode[s] - firstCode[s] + firstSymbol[s];
-                            uint16_t fastv = (uint16_t)((s << 9) | i);
-                            size[c] = (uint8_t)s;
-                            value[c] = (uint16_t)i;
-                            if (s <= (int)ZFAST_BITS)
-                            {
-                                int j = ZlibBitRev(nextCode[s], s);
-                                while (j < (1 << ZFAST_BITS))
-                                {
-                                    fast[j] = fastv;
-                                    j += (1 << s);
-                                }
-                            }
-                            ++nextCode[s];
-                        }
+                        uint32_t entry = s | ((i < (int)literal ? ZLIB_TYPE_ONE : ZLIB_TYPE_SYM) << 8) | (i << 16);
+                        for (int j = ZlibBitRev16(nextCode[s]) >> (16 - s); j < (int)ZLIB_FAST_SIZE; j += (1 << s))
+                            fast[j] = entry;
                     }
-                    return 1;
+                    ++nextCode[s];
                 }
-            };
-
-            static SIMD_INLINE int BitRev16(int n)
-            {
-                n = ((n & 0xAAAA) >> 1) | ((n & 0x5555) << 1);
-                n = ((n & 0xCCCC) >> 2) | ((n & 0x3333) << 2);
-                n = ((n & 0xF0F0) >> 4) | ((n & 0x0F0F) << 4);
-                n = ((n & 0xFF00) >> 8) | ((n & 0x00FF) << 8);
-                return n;
             }
-
-            static SIMD_INLINE int ZhuffmanDecode(InputMemoryStream& is, const Zhuffman& z)
+            if (literals)
             {
-                int b, s;
-                if (is.BitCount() < 16)
-                {
-                    if (is.Eof())
-                        return -1;
-                    is.FillBits();
-                }
-                b = z.fast[is.BitBuffer() & ZFAST_MASK];
-                if (b)
+                uint32_t single[ZLIB_FAST_SIZE];
+                memcpy(single, fast, sizeof(fast));
+                for (i = 0; i < (int)ZLIB_FAST_SIZE; ++i)
                 {
-                    s = b >> 9;
-                    is.BitBuffer() >>= s;
-                    is.BitCount() -= s;
-                    return b & 511;
-                }
-                else
-                {
-                    int k;
-                    k = BitRev16((int)is.BitBuffer());
-                    for (s = ZFAST_BITS + 1; k >= z.maxCode[s]; ++s);
-                    if (s >= 16)
-                        return -1;
-                    b = (k >> (16 - s)) - z.firstCode[s] + z.firstSymbol[s];
-                    if (b >= sizeof(z.size) || z.size[b] != s)
-                        return -1;
-                    is.BitBuffer() >>= s;
-                    is.BitCount() -= s;
-                    return z.value[b];
+                    uint32_t first = single[i];
+                    if ((first >> 8 & 3) != ZLIB_TYPE_ONE)
+                        continue;
+                    uint32_t s0 = first & 0xFF, second = single[i >> s0], s1 = second & 0xFF;
+                    if ((second >> 8 & 3) == ZLIB_TYPE_ONE && s0 + s1 <= ZLIB_FAST_BITS)
+                        fast[i] = (s0 + s1) | (ZLIB_TYPE_TWO << 8) | (first >> 16 << 16) | (second >> 16 << 24);
                 }
             }
+            return 1;
+        }
 
-            static int ParseHuffmanBlock(InputMemoryStream& is, const Zhuffman& zLength, const Zhuffman& zDistance, OutputMemoryStream& os)
-            {
-                static const int zlengthBase[31] = { 3,4,5,6,7,8,9,10,11,13, 15,17,19,23,27,31,35,43,51,59, 67,83,99,115,131,163,195,227,258,0,0 };
-                static const int zlengthExtra[31] = { 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0,0,0 };
-                static const int zdistBase[32] = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193, 257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577,0,0 };
-                static const int zdistExtra[32] = { 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13 };
+        const uint8_t ZlibPattern[16][64] = {
+            { 0 },
+            { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+            { 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1 },
+            { 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0 },
+            { 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3 },
+            { 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 0, 1, 2, 3 },
+            { 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3 },
+            { 0, 1, 2, 3, 4, 5, 6, 0, 1, 2, 3, 4, 5, 6, 0, 1, 2, 3, 4, 5, 6, 0, 1, 2, 3, 4, 5, 6, 0, 1, 2, 3, 4, 5, 6, 0, 1, 2, 3, 4, 5, 6, 0, 1, 2, 3, 4, 5, 6, 0, 1, 2, 3, 4, 5, 6, 0, 1, 2, 3, 4, 5, 6, 0 },
+            { 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7 },
+            { 0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 1, 2, 3, 4, 5, 6, 7, 8, 0 },
+            { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2, 3 },
+            { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 1, 2, 3, 4, 5, 6, 7, 8 },
+            { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 1, 2, 3 },
+            { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 },
+            { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 0, 1, 2, 3, 4, 5, 6, 7 },
+            { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 0, 1, 2, 3 },
+        };
 
-                SIMD_PERF_FUNC();
+        static int ZlibDecodeSymbol(InputMemoryStream& is, const ZlibHuffman& z)
+        {
+            if (is.BitCount() < 16)
+                is.FillBits();
+            uint32_t entry = z.Decode(is.BitBuffer());
+            size_t size = entry & 0xFF;
+            if (entry == 0 || size > is.BitCount())
+                return -1;
+            is.BitBuffer() >>= size;
+            is.BitCount() -= size;
+            return int(entry >> 16);
+        }
 
-                uint8_t* beg = os.Data(), * dst = os.Current(), * end = beg + os.Capacity();
-                for (;;)
+        SIMD_INLINE void ZlibCopy(uint8_t* dst, size_t dist, size_t len)
+        {
+            const uint8_t* src = dst - dist;
+            uint8_t* stop = dst + len;
+            if (dist >= 8)
+            {
+                do
                 {
-                    int z = ZhuffmanDecode(is, zLength);
-                    if (z < 256)
-                    {
-                        if (z < 0)
-                            return CorruptPngError("bad huffman code");
-                        if (dst >= end)
-                        {
-                            os.Reserve(end - beg + 1);
-                            beg = os.Data();
-                            dst = os.Current();
-                            end = beg + os.Capacity();
-                        }
-                        *dst++ = (uint8_t)z;
-                    }
-                    else
-                    {
-                        int len, dist;
-                        if (z == 256)
-                        {
-                            os.Seek(dst - beg);
-                            return 1;
-                        }
-                        z -= 257;
-                        len = zlengthBase[z];
-                        if (zlengthExtra[z])
-                            len += (int)is.ReadBits(zlengthExtra[z]);
-                        z = ZhuffmanDecode(is, zDistance);
-                        if (z < 0)
-                            return CorruptPngError("bad huffman code");
-                        dist = zdistBase[z];
-                        if (zdistExtra[z])
-                            dist += (int)is.ReadBits(zdistExtra[z]);
-                        if (dst - beg < dist)
-                            return CorruptPngError("bad dist");
-                        if (dst + len > end)
-                        {
-                            os.Reserve(dst - beg + len);
-                            beg = os.Data();
-                            dst = os.Current();
-                            end = beg + os.Capacity();
-                        }
-                        if (dist == 1)
-                        {
-                            uint8_t val = dst[-dist];
-                            if (len < 16)
-                            {
-                                while (len--)
-                                    *dst++ = val;
-                            }
-                            else
-                            {
-                                memset(dst, val, len);
-                                dst += len;
-                            }
-                        }
-                        else
-                        {
-                            uint8_t* src = dst - dist;
-                            if (dist < len || len < 16)
-                            {
-                                while(len--)
-                                    *dst++ = *src++;
-                            }
-                            else
-                            {
-                                memcpy(dst, src, len);
-                                dst += len;
-                            }                        
-                        }
-                    }
-                }
+                    *(uint64_t*)dst = *(uint64_t*)src;
+                    src += 8;
+                    dst += 8;
+                } while (dst < stop);
             }
-
-            static int ComputeHuffmanCodes(InputMemoryStream& is, Zhuffman& zLength, Zhuffman& zDistance)
+            else if (dist == 1)
             {
-                static const uint8_t length_dezigzag[19] = { 16,17,18,0,8,7,9,6,10,5,11,4,12,3,13,2,14,1,15 };
-                Zhuffman z_codelength;
-                uint8_t lencodes[286 + 32 + 137];
-                uint8_t codelength_sizes[19];
-                int i, n;
-
-                int hlit = (int)is.ReadBits(5) + 257;
-                int hdist = (int)is.ReadBits(5) + 1;
-                int hclen = (int)is.ReadBits(4) + 4;
-                int ntot = hlit + hdist;
-
-                memset(codelength_sizes, 0, sizeof(codelength_sizes));
-                for (i = 0; i < hclen; ++i)
+                uint64_t val = uint64_t(src[0]) * 0x0101010101010101;
+                do
                 {
-                    int s = (int)is.ReadBits(3);
-                    codelength_sizes[length_dezigzag[i]] = (uint8_t)s;
-                }
-                if (!z_codelength.Build(codelength_sizes, 19))
-                    return 0;
-                n = 0;
-                while (n < ntot)
+                    *(uint64_t*)dst = val;
+                    dst += 8;
+                } while (dst < stop);
+            }
+            else
+            {
+                while (dst < stop)
+                    *dst++ = *src++;
+            }
+        }
+
+        static int ZlibComputeHuffmanCodes(InputMemoryStream& is, ZlibHuffman& zLength, ZlibHuffman& zDistance)
+        {
+            static const uint8_t length_dezigzag[19] = { 16,17,18,0,8,7,9,6,10,5,11,4,12,3,13,2,14,1,15 };
+            ZlibHuffman z_codelength;
+            uint8_t lencodes[286 + 32 + 137];
+            uint8_t codelength_sizes[19];
+            int i, n;
+
+            int hlit = (int)is.ReadBits(5) + 257;
+            int hdist = (int)is.ReadBits(5) + 1;
+            int hclen = (int)is.ReadBits(4) + 4;
+            int ntot = hlit + hdist;
+
+            memset(codelength_sizes, 0, sizeof(codelength_sizes));
+            for (i = 0; i < hclen; ++i)
+            {
+                int s = (int)is.ReadBits(3);
+                codelength_sizes[length_dezigzag[i]] = (uint8_t)s;
+            }
+            if (!z_codelength.Build(codelength_sizes, 19, false))
+                return 0;
+            n = 0;
+            while (n < ntot)
+            {
+                int c = ZlibDecodeSymbol(is, z_codelength);
+                if (c < 0 || c >= 19)
+                    return CorruptPngError("bad codelengths");
+                if (c < 16)
+                    lencodes[n++] = (uint8_t)c;
+                else
                 {
-                    int c = ZhuffmanDecode(is, z_codelength);
-                    if (c < 0 || c >= 19)
-                        return CorruptPngError("bad codelengths");
-                    if (c < 16)
-                        lencodes[n++] = (uint8_t)c;
-                    else
+                    uint8_t fill = 0;
+                    if (c == 16)
                     {
-                        uint8_t fill = 0;
-                        if (c == 16)
-                        {
-                            c = (int)is.ReadBits(2) + 3;
-                            if (n == 0) return CorruptPngError("bad codelengths");
-                            fill = lencodes[n - 1];
-                        }
-                        else if (c == 17)
-                            c = (int)is.ReadBits(3) + 3;
-                        else if (c == 18)
-                            c = (int)is.ReadBits(7) + 11;
-                        else
-                            return CorruptPngError("bad codelengths");
-                        if (ntot - n < c)
-                            return CorruptPngError("bad codelengths");
-                        memset(lencodes + n, fill, c);
-                        n += c;
+                        c = (int)is.ReadBits(2) + 3;
+                        if (n == 0) return CorruptPngError("bad codelengths");
+                        fill = lencodes[n - 1];
                     }
+                    else if (c == 17)
+                        c = (int)is.ReadBits(3) + 3;
+                    else if (c == 18)
+                        c = (int)is.ReadBits(7) + 11;
+                    else
+                        return CorruptPngError("bad codelengths");
+                    if (ntot - n < c)
+                        return CorruptPngError("bad codelengths");
+                    memset(lencodes + n, fill, c);
+                    n += c;
                 }
-                if (n != ntot)
-                    return CorruptPngError("bad codelengths");
-                if (!zLength.Build(lencodes, hlit))
-                    return 0;
-                if (!zDistance.Build(lencodes + hlit, hdist))
-                    return 0;
-                return 1;
             }
+            if (n != ntot)
+                return CorruptPngError("bad codelengths");
+            if (!zLength.Build(lencodes, hlit, true))
+                return 0;
+            if (!zDistance.Build(lencodes + hlit, hdist, false))
+                return 0;
+            return 1;
+        }
 
-            static int ParseUncompressedBlock(InputMemoryStream& is, OutputMemoryStream& os)
-            {
-                is.ClearBits();
-                uint16_t len, nlen;
-                if (!is.Read16u(len) || !is.Read16u(nlen) || nlen != (len ^ 0xffff))
-                    return CorruptPngError("zlib corrupt");
-                if (!os.Write(is, len))
-                    return CorruptPngError("read past buffer");
-                return 1;
-            }
+        static int ZlibParseUncompressedBlock(InputMemoryStream& is, OutputMemoryStream& os)
+        {
+            is.ClearBits();
+            uint16_t len, nlen;
+            if (!is.Read16u(len) || !is.Read16u(nlen) || nlen != (len ^ 0xffff))
+                return CorruptPngError("zlib corrupt");
+            if (!os.Write(is, len))
+                return CorruptPngError("read past buffer");
+            return 1;
+        }
 
-            static int ParseHeader(InputMemoryStream& is)
+        static int ZlibParseHeader(InputMemoryStream& is)
+        {
+            uint8_t cmf, flg;
+            if (!(is.Read8u(cmf) && is.Read8u(flg)))
+                return CorruptPngError("bad zlib header");
+            if ((int(cmf) * 256 + flg) % 31 != 0)
+                return CorruptPngError("bad zlib header");
+            if (flg & 32)
+                return CorruptPngError("no preset dict");
+            if ((cmf & 15) != 8)
+                return CorruptPngError("bad compression");
+            return 1;
+        }
+
+        bool ZlibDecode(InputMemoryStream& is, OutputMemoryStream& os, bool parseHeader, ZlibParseBlockPtr parseBlock, ZlibAdler32Ptr adler32)
+        {
+            static const uint8_t ZdefaultLength[288] = {
+               8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8, 8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,
+               8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8, 8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,
+               8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8, 8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,
+               8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8, 8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,
+               8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8, 9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,
+               9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9, 9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,
+               9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9, 9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,
+               9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9, 9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,
+               7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7, 7,7,7,7,7,7,7,7,8,8,8,8,8,8,8,8
+            };
+            static const uint8_t ZdefaultDistance[32] = {
+               5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5
+            };
+            ZlibHuffman zLength, zDistance;
+            bool fixed = false;
+            int final, type;
+            if (parseHeader)
             {
-                uint8_t cmf, flg;
-                if (!(is.Read8u(cmf) && is.Read8u(flg)))
-                    return CorruptPngError("bad zlib header");
-                if ((int(cmf) * 256 + flg) % 31 != 0)
-                    return CorruptPngError("bad zlib header");
-                if (flg & 32)
-                    return CorruptPngError("no preset dict");
-                if ((cmf & 15) != 8)
-                    return CorruptPngError("bad compression");
-                return 1;
+                if (!ZlibParseHeader(is))
+                    return false;
             }
-
-            bool Decode(InputMemoryStream& is, OutputMemoryStream& os, bool parseHeader)
+            do
             {
-                static const uint8_t ZdefaultLength[288] = {
-                   8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8, 8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,
-                   8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8, 8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,
-                   8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8, 8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,
-                   8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8, 8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,
-                   8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8, 9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,
-                   9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9, 9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,
-                   9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9, 9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,
-                   9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9, 9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,
-                   7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7, 7,7,7,7,7,7,7,7,8,8,8,8,8,8,8,8
-                };
-                static const uint8_t ZdefaultDistance[32] = {
-                   5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5
-                };
-
-                Zhuffman zLength, zDistance;
-                int final, type;
-                if (parseHeader)
+                final = (int)is.ReadBits(1);
+                type = (int)is.ReadBits(2);
+                if (type == 0)
                 {
-                    if (!ParseHeader(is))
+                    if (!ZlibParseUncompressedBlock(is, os))
                         return false;
                 }
-                do
+                else if (type == 3)
+                    return false;
+                else
                 {
-                    final = (int)is.ReadBits(1);
-                    type = (int)is.ReadBits(2);
-                    if (type == 0)
-                    {
-                        if (!ParseUncompressedBlock(is, os))
-                            return false;
-                    }
-                    else if (type == 3)
-                        return false;
-                    else
+                    if (type == 1)
                     {
-                        if (type == 1)
+                        if (!fixed)
                         {
-                            if (!zLength.Build(ZdefaultLength, 288))
-                                return false;
-                            if (!zDistance.Build(ZdefaultDistance, 32))
+                            if (!zLength.Build(ZdefaultLength, 288, true))
                                 return false;
-                        }
-                        else
-                        {
-                            if (!ComputeHuffmanCodes(is, zLength, zDistance))
+                            if (!zDistance.Build(ZdefaultDistance, 32, false))
                                 return false;
+                            fixed = true;
                         }
-                        if (!ParseHuffmanBlock(is, zLength, zDistance, os))
+                    }
+                    else
+                    {
+                        if (!ZlibComputeHuffmanCodes(is, zLength, zDistance))
                             return false;
+                        fixed = false;
                     }
-                } while (!final);
-                return true;
+                    if (!parseBlock(is, zLength, zDistance, os))
+                        return false;
+                }
+            } while (!final);
+            if (parseHeader)
+            {
+                uint32_t adler;
+                is.ClearBits();
+                if (!is.ReadBe32u(adler) || adler != adler32(os.Data(), (int)os.Size()))
+                    return CorruptPngError("bad zlib adler32") != 0;
             }
+            return true;
+        }
+
+        bool ZlibDecode(InputMemoryStream& is, OutputMemoryStream& os, bool parseHeader)
+        {
+            return ZlibDecode(is, os, parseHeader, ZlibParseHuffmanBlock<ZlibCopy>, Base::ZlibAdler32);
         }
 
         //-------------------------------------------------------------------------------------------------
@@ -799,6 +744,8 @@ namespace Simd
             _decodeLine[5] = Base::DecodeLine5;
             _decodeLine[6] = Base::DecodeLine6;
             _expandPalette = Base::ExpandPalette;
+            _zlibDecode = Base::ZlibDecode;
+            _crc32 = Base::Crc32;
         }
 
         void ImagePngLoader::SetConverter()
@@ -824,7 +771,7 @@ namespace Simd
 
             InputMemoryStream zSrc = MergedDataStream();
             OutputMemoryStream zDst(AlignHi(size_t(_width) * _depth, 8) * _height * _channels + _height);
-            if(!Zlib::Decode(zSrc, zDst, !_iPhone))
+            if(!_zlibDecode(zSrc, zDst, !_iPhone))
                 return false;
 
             if (!CreateImage(zDst.Data(), zDst.Size()))
@@ -845,7 +792,17 @@ namespace Simd
             return true;
         }
 
-        bool ImagePngLoader::ParseFile()
+        bool ImagePngLoader::Probe(SimdImageInfo& info)
+        {
+            if (!ParseFile(true))
+                return false;
+            InitInfo(info, _width, _height, _paletteChannels ? _paletteChannels : _channels + (_hasTrans ? 1 : 0));
+            info.depth = _depth;
+            info.progressive = _interlace ? SimdTrue : SimdFalse;
+            return true;
+        }
+
+        bool ImagePngLoader::ParseFile(bool probe)
         {
             _first = true, _iPhone = false, _hasTrans = false;
             if (!CheckHeader())
@@ -877,6 +834,8 @@ namespace Simd
                 }
                 else if (chunk.type == ChunkType('I', 'D', 'A', 'T'))
                 {
+                    if (probe)
+                        return !_first && !(_paletteChannels && _palette.size == 0);
                     if (!ReadData(chunk))
                         return false;
                 }
@@ -895,6 +854,8 @@ namespace Simd
                 uint32_t crc32;
                 if (!_stream.ReadBe32u(crc32))
                     return false;
+                if ((chunk.type & (1 << 29)) == 0 && crc32 != _crc32(_stream.Data() + chunk.offs - 4, chunk.size + 4))
+                    return false;
             }
             int reqN = 4;
             if (Image::ChannelCount((Image::Format)_param.format) == _channels && _depth != 16)
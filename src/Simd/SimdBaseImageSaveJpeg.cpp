@@ -25,6 +25,7 @@
 #include "Simd/SimdImageSave.h"
 #include "Simd/SimdImageSaveJpeg.h"
 #include "Simd/SimdBase.h"
+#include "Simd/SimdParallel.hpp"
 
 namespace Simd
 {
@@ -369,12 +370,19 @@ namespace Simd
 
         ImageJpegSaver::ImageJpegSaver(const ImageSaverParam& param)
             : ImageSaver(param)
-            , _deintBgra(NULL)
             , _deintBgr(NULL)
+            , _deintBgra(NULL)
             , _writeBlock(NULL)
             , _writeNv12Block(NULL)
             , _writeYuv420pBlock(NULL)
+            , _stripRows(0)
+        {
+        }
+
+        ImageJpegSaver::~ImageJpegSaver()
         {
+            for (size_t i = 0; i < _strips.size(); ++i)
+                delete _strips[i];
         }
 
         void ImageJpegSaver::Init()
@@ -442,6 +450,23 @@ namespace Simd
                 _buffer.Resize(_width * _block * 3);
         }
 
+        void ImageJpegSaver::InitStrips()
+        {
+            const int STRIPS_MAX = 32, RESTART_INTERVAL_MAX = 0xFFFF;
+            const size_t PARALLEL_SIZE_MIN = 512 * 512;
+            int mcuCols = _width / _block, mcuRows = (int)DivHi(_param.height, _block), strips = (int)ImageJpegSaverStrips();
+            _stripRows = 0;
+            if (strips == 0)
+            {
+                if (Base::GetThreadNumber() < 2 || _param.width * _param.height < PARALLEL_SIZE_MIN)
+                    return;
+                strips = STRIPS_MAX;
+            }
+            if (mcuRows < 2)
+                return;
+            _stripRows = Simd::Min((int)DivHi(mcuRows, strips), RESTART_INTERVAL_MAX / mcuCols);
+        }
+
         void ImageJpegSaver::WriteHeader()
         {
             static const uint8_t DC_LUM_COD[] = { 0, 0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0 };
@@ -488,18 +513,61 @@ namespace Simd
             _stream.Write8u(0x11); // HTUACinfo
             _stream.Write(AC_CHR_COD + 1, sizeof(AC_CHR_COD) - 1);
             _stream.Write(AC_CHR_VAL, sizeof(AC_CHR_VAL));
+            if (_stripRows)
+            {
+                int interval = _stripRows * _width / _block;
+                const uint8_t dri[] = { 0xFF, 0xDD, 0, 4, uint8_t(interval >> 8), uint8_t(interval) };
+                _stream.Write(dri, sizeof(dri));
+            }
             _stream.Write(head2, sizeof(head2));
         }
 
-        bool ImageJpegSaver::ToStream(const uint8_t* src, size_t stride)
+        template<class Rows> void ImageJpegSaver::WriteData(const Rows& rows)
         {
-            Init();
-            WriteHeader();
-            uint8_t* r = _buffer.data, * g = r + _width * _block,* b = g + _width * _block;
+            static const uint16_t FILL_BITS[] = { 0x7F, 7 };
+            int height = (int)_param.height;
+            if (_stripRows)
+            {
+                int stripHeight = _stripRows * _block, stripCount = (int)DivHi(height, stripHeight);
+                while (_strips.size() < (size_t)stripCount)
+                    _strips.push_back(new Strip());
+                Parallel(0, stripCount, [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t s = begin; s < end; ++s)
+                    {
+                        Strip& strip = *_strips[s];
+                        strip.buffer.Resize(_buffer.size);
+                        rows(strip.stream, strip.buffer.data, int(s) * stripHeight, Simd::Min(int(s + 1) * stripHeight, height));
+                        Base::WriteBits(strip.stream, FILL_BITS);
+                    }
+                }, Base::GetThreadNumber());
+                for (int s = 0; s < stripCount; ++s)
+                {
+                    _stream.Write(_strips[s]->stream.Data(), _strips[s]->stream.Pos());
+                    if (s < stripCount - 1)
+                    {
+                        _stream.Write8u(0xFF);
+                        _stream.Write8u(uint8_t(0xD0 + s % 8));
+                    }
+                }
+            }
+            else
+            {
+                rows(_stream, _buffer.data, 0, height);
+                Base::WriteBits(_stream, FILL_BITS);
+            }
+            _stream.Write8u(0xFF);
+            _stream.Write8u(0xD9);
+        }
+
+        void ImageJpegSaver::WriteRows(OutputMemoryStream& stream, uint8_t* buffer, const uint8_t* src, size_t stride, int begin, int end)
+        {
+            uint8_t* r = buffer, * g = r + _width * _block,* b = g + _width * _block;
             int dc[3] = { 0, 0, 0 };
-            for (int row = 0; row < (int)_param.height; row += _block)
+            src += begin * stride;
+            for (int row = begin; row < end; row += _block)
             {
-                int block = Simd::Min(row + _block, (int)_param.height) - row;
+                int block = Simd::Min(row + _block, end) - row;
                 switch (_param.format)
                 {
                 case SimdPixelFormatBgr24:
@@ -518,54 +586,76 @@ namespace Simd
                     break;
                 }
                 if(_param.format == SimdPixelFormatGray8)
-                    _writeBlock(_stream, (int)_param.width, block, src, src, src, (int)stride, _fY, _fUv, dc);
+                    _writeBlock(stream, (int)_param.width, block, src, src, src, (int)stride, _fY, _fUv, dc);
                 else
-                    _writeBlock(_stream, (int)_param.width, block, r, g, b, _width, _fY, _fUv, dc);
+                    _writeBlock(stream, (int)_param.width, block, r, g, b, _width, _fY, _fUv, dc);
                 src += block * stride;
             }
-            static const uint16_t FILL_BITS[] = { 0x7F, 7 };
-            Base::WriteBits(_stream, FILL_BITS);
-            _stream.Write8u(0xFF);
-            _stream.Write8u(0xD9);
-            return true;
         }
 
-        bool ImageJpegSaver::ToStream(const uint8_t* y, size_t yStride, const uint8_t* uv, size_t uvStride)
+        void ImageJpegSaver::WriteRows(OutputMemoryStream& stream, const uint8_t* y, size_t yStride, const uint8_t* uv, size_t uvStride, int begin, int end)
         {
-            Init();
-            WriteHeader();
             int dc[3] = { 0, 0, 0 };
-            for (int row = 0; row < (int)_param.height; row += _block)
+            y += begin * yStride;
+            uv += (begin / 2) * uvStride;
+            for (int row = begin; row < end; row += _block)
             {
-                int block = Simd::Min(row + _block, (int)_param.height) - row;
-                _writeNv12Block(_stream, (int)_param.width, block, y, (int)yStride, uv, (int)uvStride, _fY, _fUv, dc);
+                int block = Simd::Min(row + _block, end) - row;
+                _writeNv12Block(stream, (int)_param.width, block, y, (int)yStride, uv, (int)uvStride, _fY, _fUv, dc);
                 y += block * yStride;
                 uv += (block / 2) * uvStride;
             }
-            static const uint16_t FILL_BITS[] = { 0x7F, 7 };
-            Base::WriteBits(_stream, FILL_BITS);
-            _stream.Write8u(0xFF);
-            _stream.Write8u(0xD9);
-            return true;
         }
 
-        bool ImageJpegSaver::ToStream(const uint8_t* y, size_t yStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride)
+        void ImageJpegSaver::WriteRows(OutputMemoryStream& stream, const uint8_t* y, size_t yStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, int begin, int end)
         {
-            Init();
-            WriteHeader();
             int dc[3] = { 0, 0, 0 };
-            for (int row = 0; row < (int)_param.height; row += _block)
+            y += begin * yStride;
+            u += (begin / 2) * uStride;
+            v += (begin / 2) * vStride;
+            for (int row = begin; row < end; row += _block)
             {
-                int block = Simd::Min(row + _block, (int)_param.height) - row;
-                _writeYuv420pBlock(_stream, (int)_param.width, block, y, (int)yStride, u, (int)uStride, v, (int)vStride, _fY, _fUv, dc);
+                int block = Simd::Min(row + _block, end) - row;
+                _writeYuv420pBlock(stream, (int)_param.width, block, y, (int)yStride, u, (int)uStride, v, (int)vStride, _fY, _fUv, dc);
                 y += block * yStride;
                 u += (block / 2) * uStride;
                 v += (block / 2) * vStride;
             }
-            static const uint16_t FILL_BITS[] = { 0x7F, 7 };
-            Base::WriteBits(_stream, FILL_BITS);
-            _stream.Write8u(0xFF);
-            _stream.Write8u(0xD9);
+        }
+
+        bool ImageJpegSaver::ToStream(const uint8_t* src, size_t stride)
+        {
+            Init();
+            InitStrips();
+            WriteHeader();
+            WriteData([&](OutputMemoryStream& stream, uint8_t* buffer, int begin, int end)
+            {
+                WriteRows(stream, buffer, src, stride, begin, end);
+            });
+            return true;
+        }
+
+        bool ImageJpegSaver::ToStream(const uint8_t* y, size_t yStride, const uint8_t* uv, size_t uvStride)
+        {
+            Init();
+            InitStrips();
+            WriteHeader();
+            WriteData([&](OutputMemoryStream& stream, uint8_t* buffer, int begin, int end)
+            {
+                WriteRows(stream, y, yStride, uv, uvStride, begin, end);
+            });
+            return true;
+        }
+
+        bool ImageJpegSaver::ToStream(const uint8_t* y, size_t yStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride)
+        {
+            Init();
+            InitStrips();
+            WriteHeader();
+            WriteData([&](OutputMemoryStream& stream, uint8_t* buffer, int begin, int end)
+            {
+                WriteRows(stream, y, yStride, u, uStride, v, vStride, begin, end);
+            });
             return true;
         }
 
@@ -26,6 +26,7 @@
 #include "Simd/SimdImageSavePng.h"
 #include "Simd/SimdBase.h"
 #include "Simd/SimdCpu.h"
+#include "Simd/SimdParallel.hpp"
 
 namespace Simd
 {
@@ -36,6 +37,26 @@ namespace Simd
         const uint16_t ZlibDistC[31] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577, 32768 };
         const uint8_t  ZlibDistEb[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
 
+        // Index of length code in ZlibLenC for match length 3..258 (entries 0..2 are unused).
+        const uint8_t  ZlibLenSym[259] = {
+             0,  0,  0,  0,  1,  2,  3,  4,  5,  6,  7,  8,  8,  9,  9, 10,
+            10, 11, 11, 12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15,
+            15, 15, 15, 16, 16, 16, 16, 16, 16, 16, 16, 17, 17, 17, 17, 17,
+            17, 17, 17, 18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19,
+            19, 19, 19, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
+            20, 20, 20, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+            21, 21, 21, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+            22, 22, 22, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+            23, 23, 23, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+            24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+            24, 24, 24, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25,
+            25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25,
+            25, 25, 25, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26,
+            26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26,
+            26, 26, 26, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+            27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+            27, 27, 28 };
+
 #if defined(SIMD_PNG_ZLIB_BIT_REV_TABLE)
         int ZlibBitRevTable[512];
         static bool ZlibBitRevTableInit()
@@ -56,7 +77,7 @@ namespace Simd
 
 #endif
 
-        uint32_t ZlibAdler32(uint8_t* data, int size)
+        uint32_t ZlibAdler32(const uint8_t* data, int size)
         {
             uint32_t lo = 1, hi = 0;
             for (int b = 0, n = (int)(size % 5552); b < size;)
@@ -74,7 +95,7 @@ namespace Simd
             return (hi << 16) | lo;
         }
 
-        void ZlibCompress(uint8_t* data, int size, int quality, OutputMemoryStream& stream)
+        void ZlibDeflate(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream)
         {
             const int ZHASH = 16384;
             if (quality < 5)
@@ -82,23 +103,22 @@ namespace Simd
             const int basket = quality * 2;
             Array32i hashTable(ZHASH * basket);
             memset(hashTable.data, -1, hashTable.RawSize());
+            Base::ZlibPrime(hashTable.data, basket, quality, data, begin);
 
-            stream.Write(uint8_t(0x78));
-            stream.Write(uint8_t(0x5e));
-            stream.WriteBits(1, 1);
+            stream.WriteBits(last ? 1 : 0, 1);
             stream.WriteBits(1, 2);
 
-            int i = 0, j;
-            while (i < size - 3)
+            int i = begin, j;
+            while (i < end - 3)
             {
                 int h = ZlibHash(data + i) & (ZHASH - 1), best = 3;
-                uint8_t* bestLoc = 0;
+                const uint8_t* bestLoc = 0;
                 int* hList = hashTable.data + h * basket;
                 for (j = 0; hList[j] != -1 && j < basket; ++j)
                 {
                     if (hList[j] > i - 32768)
                     {
-                        int d = ZlibCount(data + hList[j], data + i, size - i);
+                        int d = ZlibCount(data + hList[j], data + i, end - i);
                         if (d >= best)
                         {
                             best = d;
@@ -122,7 +142,7 @@ namespace Simd
                     {
                         if (hList[j] > i - 32767)
                         {
-                            int e = ZlibCount(data + hList[j], data + i + 1, size - i - 1);
+                            int e = ZlibCount(data + hList[j], data + i + 1, end - i - 1);
                             if (e > best)
                             {
                                 bestLoc = NULL;
@@ -152,11 +172,320 @@ namespace Simd
                     ++i;
                 }
             }
-            for (; i < size; ++i)
+            for (; i < end; ++i)
                 ZlibHuffB(data[i], stream);
             ZlibHuff(256, stream);
+            if (!last)
+                stream.WriteBits(0, 3);
+            stream.FlushBits();
+            if (!last)
+                stream.WriteBe32u(0x0000FFFF);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        const int ZLIB_BLOCK_SIZE = 65536;
+
+        struct ZlibBitWriter
+        {
+            SIMD_INLINE ZlibBitWriter(OutputMemoryStream& stream, size_t capacity)
+                : _stream(stream)
+            {
+                _stream.Reserve(_stream.Pos() + capacity + 8);
+                _dst = _stream.Current();
+                _buf = _stream.BitBuffer();
+                _cnt = _stream.BitCount();
+            }
+
+            SIMD_INLINE ~ZlibBitWriter()
+            {
+                for (; _cnt >= 8; _cnt -= 8, _buf >>= 8)
+                    *_dst++ = uint8_t(_buf);
+                _stream.Seek(_dst - _stream.Data());
+                _stream.BitBuffer() = _buf;
+                _stream.BitCount() = _cnt;
+            }
+
+            SIMD_INLINE void Put(uint32_t bits, size_t count)
+            {
+                _buf |= uint64_t(bits) << _cnt;
+                _cnt += count;
+                if (_cnt >= 32)
+                {
+                    *(uint32_t*)_dst = uint32_t(_buf);
+                    _dst += 4;
+                    _buf >>= 32;
+                    _cnt -= 32;
+                }
+            }
+
+        private:
+            OutputMemoryStream& _stream;
+            uint8_t* _dst;
+            uint64_t _buf;
+            size_t _cnt;
+        };
+
+        static void ZlibHuffmanLengths(const uint32_t* hist, int num, int maxBits, uint8_t* lens)
+        {
+            uint32_t keys[288];
+            uint16_t syms[288];
+            int n = 0;
+            for (int s = 0; s < num; ++s)
+            {
+                lens[s] = 0;
+                if (hist[s])
+                    syms[n++] = uint16_t(s);
+            }
+            if (n < 2)
+            {
+                int s = n ? syms[0] : 0;
+                lens[s] = 1;
+                lens[s ? 0 : 1] = 1;
+                return;
+            }
+            std::stable_sort(syms, syms + n, [hist](uint16_t a, uint16_t b) { return hist[a] < hist[b]; });
+            for (int i = 0; i < n; ++i)
+                keys[i] = hist[syms[i]];
+
+            int root = 0, leaf = 2, next, avbl, used, dpth;
+            keys[0] += keys[1];
+            for (next = 1; next < n - 1; next++)
+            {
+                if (leaf >= n || keys[root] < keys[leaf])
+                {
+                    keys[next] = keys[root];
+                    keys[root++] = next;
+                }
+                else
+                    keys[next] = keys[leaf++];
+                if (leaf >= n || (root < next && keys[root] < keys[leaf]))
+                {
+                    keys[next] += keys[root];
+                    keys[root++] = next;
+                }
+                else
+                    keys[next] += keys[leaf++];
+            }
+            keys[n - 2] = 0;
+            for (next = n - 3; next >= 0; next--)
+                keys[next] = keys[keys[next]] + 1;
+            avbl = 1, used = 0, dpth = 0, root = n - 2, next = n - 1;
+            while (avbl > 0)
+            {
+                while (root >= 0 && (int)keys[root] == dpth)
+                {
+                    used++;
+                    root--;
+                }
+                while (avbl > used)
+                {
+                    keys[next--] = dpth;
+                    avbl--;
+                }
+                avbl = 2 * used;
+                dpth++;
+                used = 0;
+            }
+
+            int count[33] = { 0 };
+            for (int i = 0; i < n; ++i)
+                count[Min((int)keys[i], 32)]++;
+            for (int l = maxBits + 1; l <= 32; ++l)
+                count[maxBits] += count[l];
+            uint32_t total = 0;
+            for (int l = maxBits; l > 0; --l)
+                total += uint32_t(count[l]) << (maxBits - l);
+            while (total != (1u << maxBits))
+            {
+                count[maxBits]--;
+                for (int l = maxBits - 1; l > 0; --l)
+                {
+                    if (count[l])
+                    {
+                        count[l]--;
+                        count[l + 1] += 2;
+                        break;
+                    }
+                }
+                total--;
+            }
+            for (int l = maxBits, i = 0; l > 0; --l)
+                for (int k = count[l]; k > 0; --k)
+                    lens[syms[i++]] = uint8_t(l);
+        }
+
+        static void ZlibHuffmanCodes(const uint8_t* lens, int num, uint16_t* codes)
+        {
+            int count[16] = { 0 }, next[16];
+            for (int s = 0; s < num; ++s)
+                count[lens[s]]++;
+            count[0] = 0;
+            for (int l = 1, code = 0; l < 16; ++l)
+            {
+                code = (code + count[l - 1]) << 1;
+                next[l] = code;
+            }
+            for (int s = 0; s < num; ++s)
+            {
+                int l = lens[s], code = l ? next[l]++ : 0, rev = 0;
+                for (int b = 0; b < l; ++b, code >>= 1)
+                    rev = (rev << 1) | (code & 1);
+                codes[s] = uint16_t(rev);
+            }
+        }
+
+        static void ZlibStoreBlocks(const uint8_t* data, int size, bool last, OutputMemoryStream& stream)
+        {
+            for (int i = 0; i < size;)
+            {
+                int n = Min(size - i, 65535);
+                stream.WriteBits(last && i + n == size ? 1 : 0, 1);
+                stream.WriteBits(0, 2);
+                stream.FlushBits();
+                stream.Write<uint16_t>(uint16_t(n));
+                stream.Write<uint16_t>(uint16_t(~n));
+                stream.Write(data + i, n);
+                i += n;
+            }
+        }
+
+        static void ZlibDynamicBlock(const uint8_t* data, int size, const uint16_t* tokens, size_t count, uint32_t* hist, bool last, OutputMemoryStream& stream)
+        {
+            static const uint8_t ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+            uint8_t lens[286 + 2], clLens[19];
+            uint16_t codes[286], clCodes[19], cl[286 + 2];
+            uint32_t clHist[19] = { 0 };
+
+            hist[256] = 1;
+            ZlibHuffmanLengths(hist, 286, 15, lens);
+            int numLit = 286;
+            while (numLit > 257 && lens[numLit - 1] == 0)
+                numLit--;
+            lens[numLit + 0] = 1;
+            lens[numLit + 1] = 1;
+
+            int numCl = 0, total = numLit + 2;
+            for (int i = 0; i < total;)
+            {
+                int len = lens[i], run = 1;
+                while (i + run < total && lens[i + run] == len)
+                    run++;
+                i += run;
+                if (len == 0)
+                {
+                    for (; run >= 11; run -= Min(run, 138))
+                        cl[numCl++] = uint16_t(18 | (Min(run, 138) - 11) << 8);
+                    if (run >= 3)
+                        cl[numCl++] = uint16_t(17 | (run - 3) << 8), run = 0;
+                }
+                else
+                {
+                    cl[numCl++] = uint16_t(len), run--;
+                    for (; run >= 3; run -= Min(run, 6))
+                        cl[numCl++] = uint16_t(16 | (Min(run, 6) - 3) << 8);
+                }
+                for (; run > 0; run--)
+                    cl[numCl++] = uint16_t(len);
+            }
+            for (int i = 0; i < numCl; ++i)
+                clHist[cl[i] & 0xFF]++;
+            ZlibHuffmanLengths(clHist, 19, 7, clLens);
+            ZlibHuffmanCodes(clLens, 19, clCodes);
+            int hclen = 19;
+            while (hclen > 4 && clLens[ORDER[hclen - 1]] == 0)
+                hclen--;
+
+            uint64_t bits = 3 + 5 + 5 + 4 + hclen * 3;
+            for (int s = 0; s < 19; ++s)
+                bits += clHist[s] * (clLens[s] + (s == 16 ? 2 : s == 17 ? 3 : s == 18 ? 7 : 0));
+            for (int s = 0; s < numLit; ++s)
+                bits += hist[s] * (lens[s] + (s > 256 ? ZlibLenEb[s - 257] + 1 : 0));
+            if (bits > (uint64_t(size) + 5 * DivHi(size, 65535)) * 8)
+            {
+                ZlibStoreBlocks(data, size, last, stream);
+                return;
+            }
+
+            ZlibHuffmanCodes(lens, numLit, codes);
+            ZlibBitWriter writer(stream, size_t(DivHi(bits, 8)));
+            writer.Put(last ? 1 : 0, 1);
+            writer.Put(2, 2);
+            writer.Put(numLit - 257, 5);
+            writer.Put(1, 5);
+            writer.Put(hclen - 4, 4);
+            for (int i = 0; i < hclen; ++i)
+                writer.Put(clLens[ORDER[i]], 3);
+            for (int i = 0; i < numCl; ++i)
+            {
+                int s = cl[i] & 0xFF, e = cl[i] >> 8;
+                writer.Put(clCodes[s], clLens[s]);
+                if (s == 16)
+                    writer.Put(e, 2);
+                else if (s == 17)
+                    writer.Put(e, 3);
+                else if (s == 18)
+                    writer.Put(e, 7);
+            }
+            if (tokens)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    int t = tokens[i];
+                    if (t < 256)
+                        writer.Put(codes[t], lens[t]);
+                    else
+                    {
+                        int len = t - 256, j = ZlibLenSym[len];
+                        writer.Put(codes[257 + j], lens[257 + j]);
+                        writer.Put(len - ZlibLenC[j], ZlibLenEb[j]);
+                        writer.Put(0, 1);
+                    }
+                }
+            }
+            else
+            {
+                for (int i = 0; i < size; ++i)
+                    writer.Put(codes[data[i]], lens[data[i]]);
+            }
+            writer.Put(codes[256], lens[256]);
+        }
+
+        void ZlibDeflateDynamic(const uint8_t* data, int begin, int end, bool last, ZlibTokenizePtr tokenize, OutputMemoryStream& stream)
+        {
+            Array16u tokens(tokenize ? ZLIB_BLOCK_SIZE : 0);
+            uint32_t hist[286];
+            for (int i = begin; i < end; i += ZLIB_BLOCK_SIZE)
+            {
+                int size = Min(end - i, ZLIB_BLOCK_SIZE);
+                size_t count = 0;
+                memset(hist, 0, sizeof(hist));
+                if (tokenize)
+                    count = tokenize(data, i, i + size, tokens.data, hist);
+                else
+                    Base::Histogram(data + i, size, 1, size, hist);
+                ZlibDynamicBlock(data + i, size, tokenize ? tokens.data : NULL, count, hist, last && i + size == end, stream);
+            }
+            if (!last)
+                stream.WriteBits(0, 3);
             stream.FlushBits();
-            stream.WriteBe32u(ZlibAdler32(data, size));
+            if (!last)
+                stream.WriteBe32u(0x0000FFFF);
+        }
+
+        void ZlibDeflateStored(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream)
+        {
+            ZlibStoreBlocks(data + begin, end - begin, last, stream);
+        }
+
+        void ZlibDeflateHuffman(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream)
+        {
+            ZlibDeflateDynamic(data, begin, end, last, NULL, stream);
+        }
+
+        void ZlibDeflateRle(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream)
+        {
+            ZlibDeflateDynamic(data, begin, end, last, ZlibTokenizeRle<Base::ZlibCount>, stream);
         }
 
         uint32_t EncodeLine0(const uint8_t* src, size_t stride, size_t n, size_t size, int8_t* dst)
@@ -268,9 +597,10 @@ namespace Simd
 
         ImagePngSaver::ImagePngSaver(const ImageSaverParam& param)
             : ImageSaver(param)
+            , _convert(NULL)
             , _channels(0)
             , _size(0)
-            , _convert(NULL)
+            , _chunkRows(0)
         {
             switch (_param.format)
             {
@@ -312,25 +642,46 @@ namespace Simd
             _encode[4] = Base::EncodeLine4;
             _encode[5] = Base::EncodeLine5;
             _encode[6] = Base::EncodeLine6;
-            _compress = Base::ZlibCompress;
+            _adler32 = Base::ZlibAdler32;
+            _crc32 = Base::Crc32;
+            _deflate = Base::ZlibDeflate;
+            _deflateRle = Base::ZlibDeflateRle;
         }
 
-        bool ImagePngSaver::ToStream(const uint8_t* src, size_t stride)
+        ImagePngSaver::~ImagePngSaver()
         {
-            if (_convert)
-            {
-                _convert(src, _param.width, _param.height, stride, _buff.data, _size);
-                src = _buff.data;
-                stride = _size;
-            }
-            for (size_t row = 0; row < _param.height; ++row)
+            for (size_t i = 0; i < _chunks.size(); ++i)
+                delete _chunks[i];
+        }
+
+        void ImagePngSaver::InitChunks()
+        {
+            const size_t CHUNKS_MAX = 32, CHUNK_SIZE_MIN = 256 * 1024, PARALLEL_SIZE_MIN = 512 * 512;
+            size_t height = _param.height;
+            _chunkRows = 0;
+            if (Base::GetThreadNumber() < 2 || _param.width * height < PARALLEL_SIZE_MIN)
+                return;
+            size_t rows = Simd::Max(DivHi(height, CHUNKS_MAX), DivHi(CHUNK_SIZE_MIN, _size + 1));
+            if (rows < height)
+                _chunkRows = rows;
+        }
+
+        void ImagePngSaver::EncodeRows(const uint8_t* src, size_t stride, size_t begin, size_t end, int8_t* line)
+        {
+            for (size_t row = begin; row < end; ++row)
             {
+                if (_param.quality == LEVEL_STORED)
+                {
+                    _filt[row * (_size + 1)] = 0;
+                    memcpy(_filt.data + row * (_size + 1) + 1, src + stride * row, _size);
+                    continue;
+                }
                 int bestFilter = 0, bestSum = INT_MAX;
                 for (int filter = 0; filter < FILTERS; filter++)
                 {
                     static const int TYPES[] = { 0, 1, 0, 5, 6, 0, 1, 2, 3, 4 };
                     int type = TYPES[filter + (row ? 1 : 0) * FILTERS];
-                    int sum = _encode[type](src + stride * row, stride, _channels, _size, _line.data + _size * filter);
+                    int sum = _encode[type](src + stride * row, stride, _channels, _size, line + _size * filter);
                     if (sum < bestSum)
                     {
                         bestSum = sum;
@@ -338,17 +689,71 @@ namespace Simd
                     }
                 }
                 _filt[row * (_size + 1)] = (uint8_t)bestFilter;
-                memcpy(_filt.data + row * (_size + 1) + 1, _line.data + _size * bestFilter, _size);
+                memcpy(_filt.data + row * (_size + 1) + 1, line + _size * bestFilter, _size);
+            }
+        }
+
+        bool ImagePngSaver::ToStream(const uint8_t* src, size_t stride)
+        {
+            if (_convert)
+            {
+                _convert(src, _param.width, _param.height, stride, _buff.data, _size);
+                src = _buff.data;
+                stride = _size;
             }
+            InitChunks();
+            size_t threads = _chunkRows ? Base::GetThreadNumber() : 1;
+            _line.Resize(_size * FILTERS * threads);
+            Parallel(0, _param.height, [&](size_t thread, size_t begin, size_t end)
+            {
+                EncodeRows(src, stride, begin, end, _line.data + _size * FILTERS * thread);
+            }, threads);
             OutputMemoryStream zlib(Simd::Min(_param.width * _param.height, Base::AlgCacheL1()));
-            _compress(_filt.data, (int)_filt.size, COMPRESSION, zlib);
+            zlib.Write(uint8_t(0x78));
+            zlib.Write(uint8_t(0x5e));
+            int size = (int)_filt.size;
+            DeflatePtr deflate = _deflate;
+            if (_param.quality == LEVEL_STORED)
+                deflate = Base::ZlibDeflateStored;
+            else if (_param.quality == LEVEL_HUFFMAN)
+                deflate = Base::ZlibDeflateHuffman;
+            else if (_param.quality == LEVEL_RLE)
+                deflate = _deflateRle;
+            if (_chunkRows)
+            {
+                int chunkSize = int(_chunkRows * (_size + 1)), chunkCount = (int)DivHi(size, chunkSize);
+                while (_chunks.size() < (size_t)chunkCount)
+                    _chunks.push_back(new Chunk());
+                Parallel(0, chunkCount, [&](size_t thread, size_t begin, size_t end)
+                {
+                    for (size_t c = begin; c < end; ++c)
+                    {
+                        int chunkBeg = int(c) * chunkSize, chunkEnd = Simd::Min(chunkBeg + chunkSize, size);
+                        deflate(_filt.data, chunkBeg, chunkEnd, COMPRESSION, chunkEnd == size, _chunks[c]->stream);
+                        _chunks[c]->adler = _adler32(_filt.data + chunkBeg, chunkEnd - chunkBeg);
+                    }
+                }, threads);
+                uint32_t adler = _chunks[0]->adler;
+                for (int c = 0; c < chunkCount; ++c)
+                {
+                    zlib.Write(_chunks[c]->stream.Data(), _chunks[c]->stream.Size());
+                    if (c)
+                        adler = ZlibAdler32Combine(adler, _chunks[c]->adler, Simd::Min(chunkSize, size - c * chunkSize));
+                }
+                zlib.WriteBe32u(adler);
+            }
+            else
+            {
+                deflate(_filt.data, 0, size, COMPRESSION, true, zlib);
+                zlib.WriteBe32u(_adler32(_filt.data, size));
+            }
             WriteToStream(zlib.Data(), zlib.Size());
             return true;
         }
 
-        SIMD_INLINE void WriteCrc32(OutputMemoryStream& stream, size_t size)
+        SIMD_INLINE void WriteCrc32(OutputMemoryStream& stream, size_t size, uint32_t (*crc32)(const void* src, size_t size))
         {
-            stream.WriteBe32u(Base::Crc32(stream.Current() - size - 4, size + 4));
+            stream.WriteBe32u(crc32(stream.Current() - size - 4, size + 4));
         }
 
         void ImagePngSaver::WriteToStream(const uint8_t* zlib, size_t zlen)
@@ -366,14 +771,14 @@ namespace Simd
             _stream.Write8u(0);
             _stream.Write8u(0);
             _stream.Write8u(0);
-            WriteCrc32(_stream, 13);
+            WriteCrc32(_stream, 13, _crc32);
             _stream.WriteBe32u((uint32_t)zlen);
             _stream.Write("IDAT", 4);
             _stream.Write(zlib, zlen);
-            WriteCrc32(_stream, zlen);
+            WriteCrc32(_stream, zlen, _crc32);
             _stream.WriteBe32u(0);
             _stream.Write("IEND", 4);
-            WriteCrc32(_stream, 0);
+            WriteCrc32(_stream, 0, _crc32);
         }
     }
 }
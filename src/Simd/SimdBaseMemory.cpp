@@ -0,0 +1,211 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <fstream>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace Simd
+{
+    namespace Base
+    {
+        std::atomic<SimdHugePageModeType> g_hugePageMode(SimdHugePageOff);
+        std::atomic<bool> g_hugePageUsed(false);
+
+        static std::atomic<size_t> g_hugePageThreshold(HUGE_PAGE_SIZE);
+
+        struct HugePageRegistry
+        {
+            struct Block
+            {
+                size_t size;
+                SimdHugePageInfoType type;
+            };
+
+            std::mutex mutex;
+            std::map<void*, Block> blocks;
+            size_t sizes[SimdHugePageInfoFallbacks];
+            size_t fallbacks;
+
+            HugePageRegistry()
+                : fallbacks(0)
+            {
+                for (size_t i = 0; i < SimdHugePageInfoFallbacks; ++i)
+                    sizes[i] = 0;
+            }
+
+            static HugePageRegistry& Global()
+            {
+                static HugePageRegistry registry;
+                return registry;
+            }
+
+            void Add(void* ptr, size_t size, SimdHugePageInfoType type, size_t fallback)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                Block& block = blocks[ptr];
+                block.size = size;
+                block.type = type;
+                sizes[type] += size;
+                fallbacks += fallback;
+            }
+
+            bool Remove(void* ptr, Block& block)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                std::map<void*, Block>::iterator it = blocks.find(ptr);
+                if (it == blocks.end())
+                    return false;
+                block = it->second;
+                sizes[block.type] -= block.size;
+                blocks.erase(it);
+                return true;
+            }
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+#if defined(__linux__)
+        static bool ReadSysFile(const char* path, std::string& value)
+        {
+            std::ifstream ifs(path);
+            if (!ifs.is_open())
+                return false;
+            std::getline(ifs, value);
+            return true;
+        }
+
+        static bool TransparentHugePageAvailable()
+        {
+            std::string value;
+            if (!ReadSysFile("/sys/kernel/mm/transparent_hugepage/enabled", value))
+                return false;
+            return value.find("[never]") == std::string::npos;
+        }
+
+        static bool ExplicitHugePageAvailable()
+        {
+            std::string value;
+            if (!ReadSysFile("/sys/kernel/mm/hugepages/hugepages-2048kB/nr_hugepages", value))
+                return false;
+            return atoi(value.c_str()) > 0;
+        }
+
+        void* HugePageAllocate(size_t size, size_t align)
+        {
+            if (size < g_hugePageThreshold || align > HUGE_PAGE_SIZE)
+                return NULL;
+            size_t fallback = 0;
+            size = AlignHi(size, HUGE_PAGE_SIZE);
+            if (g_hugePageMode == SimdHugePageExplicit)
+            {
+                void* ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (ptr != MAP_FAILED)
+                {
+                    HugePageRegistry::Global().Add(ptr, size, SimdHugePageInfoExplicit, fallback);
+                    return ptr;
+                }
+                fallback++;
+            }
+            void* ptr = NULL;
+            if (posix_memalign(&ptr, HUGE_PAGE_SIZE, size))
+                return NULL;
+            if (madvise(ptr, size, MADV_HUGEPAGE) == 0)
+                HugePageRegistry::Global().Add(ptr, size, SimdHugePageInfoTransparent, fallback);
+            else
+                HugePageRegistry::Global().Add(ptr, size, SimdHugePageInfoRegular, fallback + 1);
+            return ptr;
+        }
+
+        bool HugePageFree(void* ptr)
+        {
+            HugePageRegistry::Block block;
+            if (!HugePageRegistry::Global().Remove(ptr, block))
+                return false;
+            if (block.type == SimdHugePageInfoExplicit)
+                munmap(ptr, block.size);
+            else
+                free(ptr);
+            return true;
+        }
+#else
+        static bool TransparentHugePageAvailable()
+        {
+            return false;
+        }
+
+        static bool ExplicitHugePageAvailable()
+        {
+            return false;
+        }
+
+        void* HugePageAllocate(size_t size, size_t align)
+        {
+            return NULL;
+        }
+
+        bool HugePageFree(void* ptr)
+        {
+            return false;
+        }
+#endif
+
+        bool SetHugePageMode(SimdHugePageModeType mode, size_t threshold)
+        {
+            g_hugePageThreshold = threshold ? threshold : HUGE_PAGE_SIZE;
+            g_hugePageMode = mode;
+            if (mode == SimdHugePageOff)
+                return true;
+            g_hugePageUsed = true;
+            if (mode == SimdHugePageExplicit)
+                return ExplicitHugePageAvailable();
+            else
+                return TransparentHugePageAvailable();
+        }
+
+        size_t HugePageInfo(SimdHugePageInfoType type)
+        {
+            HugePageRegistry& registry = HugePageRegistry::Global();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            switch (type)
+            {
+            case SimdHugePageInfoExplicit:
+            case SimdHugePageInfoTransparent:
+            case SimdHugePageInfoRegular:
+                return registry.sizes[type];
+            case SimdHugePageInfoFallbacks:
+                return registry.fallbacks;
+            default:
+                return 0;
+            }
+        }
+    }
+}
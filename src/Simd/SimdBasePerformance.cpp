@@ -23,6 +23,8 @@
 */
 #include "Simd/SimdPerformance.h"
 
+#include <cmath>
+
 #if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
 namespace Simd
 {
@@ -33,6 +35,65 @@ namespace Simd
             return double(count) / double(TimeFrequency()) * 1000.0;
         }
 
+        PerformanceHistogram::PerformanceHistogram()
+        {
+            Reset();
+        }
+
+        size_t PerformanceHistogram::Index(int64_t value)
+        {
+            if (value < 2 * SUB_SIZE)
+                return value < 0 ? 0 : size_t(value);
+            int msb = 0;
+            for (int shift = 32; shift > 0; shift >>= 1)
+                if (uint64_t(value) >> (msb + shift))
+                    msb += shift;
+            return size_t(msb - SUB_BITS + 1) * SUB_SIZE + size_t((value >> (msb - SUB_BITS)) - SUB_SIZE);
+        }
+
+        int64_t PerformanceHistogram::Lower(size_t index)
+        {
+            if (index < 2 * SUB_SIZE)
+                return int64_t(index);
+            return int64_t(index % SUB_SIZE + SUB_SIZE) << (index / SUB_SIZE - 1);
+        }
+
+        void PerformanceHistogram::Add(int64_t value)
+        {
+            _counts[Index(value)]++;
+        }
+
+        void PerformanceHistogram::Combine(const PerformanceHistogram& other)
+        {
+            for (size_t i = 0; i < SIZE; ++i)
+                _counts[i] += other._counts[i];
+        }
+
+        void PerformanceHistogram::Reset()
+        {
+            for (size_t i = 0; i < SIZE; ++i)
+                _counts[i] = 0;
+        }
+
+        int64_t PerformanceHistogram::Percentile(double percent) const
+        {
+            uint64_t total = 0;
+            for (size_t i = 0; i < SIZE; ++i)
+                total += _counts[i];
+            if (total == 0)
+                return 0;
+            uint64_t target = std::max<uint64_t>(uint64_t(std::ceil(double(total) * percent / 100.0)), 1), sum = 0;
+            for (size_t i = 0; i < SIZE; ++i)
+            {
+                sum += _counts[i];
+                if (sum >= target)
+                    return i + 1 < SIZE ? (Lower(i) + Lower(i + 1) - 1) / 2 : Lower(i);
+            }
+            return Lower(SIZE - 1);
+        }
+
+        //---------------------------------------------------------------------
+
         PerformanceMeasurer::PerformanceMeasurer(const String& name, int64_t flop)
             : _name(name)
             , _flop(flop)
@@ -43,6 +104,7 @@ namespace Simd
             , _max(std::numeric_limits<int64_t>::min())
             , _entered(false)
             , _paused(false)
+            , _epoch(s_epoch.load())
         {
         }
 
@@ -57,11 +119,19 @@ namespace Simd
             , _max(pm._max)
             , _entered(pm._entered)
             , _paused(pm._paused)
+            , _histogram(pm._histogram)
+            , _epoch(pm._epoch.load())
         {
         }
 
         void PerformanceMeasurer::Enter()
         {
+            uint64_t epoch = s_epoch.load(std::memory_order_acquire);
+            if (_epoch.load(std::memory_order_relaxed) != epoch)
+            {
+                Reset();
+                _epoch.store(epoch, std::memory_order_release);
+            }
             if (!_entered)
             {
                 _entered = true;
@@ -84,6 +154,7 @@ namespace Simd
                     _total += _current;
                     _min = std::min(_min, _current);
                     _max = std::max(_max, _current);
+                    _histogram.Add(_current);
                     ++_count;
                     _current = 0;
                 }
@@ -110,6 +181,52 @@ namespace Simd
             _total += other._total;
             _min = std::min(_min, other._min);
             _max = std::max(_max, other._max);
+            _histogram.Combine(other._histogram);
+        }
+
+        void PerformanceMeasurer::Reset()
+        {
+            _count = 0;
+            _current = 0;
+            _total = 0;
+            _min = std::numeric_limits<int64_t>::max();
+            _max = std::numeric_limits<int64_t>::min();
+            _histogram.Reset();
+        }
+
+        void PerformanceMeasurer::Get(SimdPerformanceStatisticItem& item) const
+        {
+            item.name = _name.c_str();
+            item.thread = 0;
+            item.count = _count;
+            item.total = Miliseconds(_total);
+            item.min = _count ? Miliseconds(_min) : 0;
+            item.max = _count ? Miliseconds(_max) : 0;
+            item.gflops = GFlops();
+            item.p50 = Miliseconds(_histogram.Percentile(50.0));
+            item.p90 = Miliseconds(_histogram.Percentile(90.0));
+            item.p99 = Miliseconds(_histogram.Percentile(99.0));
+            item.p999 = Miliseconds(_histogram.Percentile(99.9));
+        }
+
+        String PerformanceMeasurer::Json() const
+        {
+            SimdPerformanceStatisticItem item;
+            Get(item);
+            std::stringstream ss;
+            ss << "{\"name\": \"";
+            for (size_t i = 0; i < _name.size(); ++i)
+            {
+                if (_name[i] == '"' || _name[i] == '\\')
+                    ss << '\\';
+                ss << _name[i];
+            }
+            ss << "\", \"count\": " << item.count;
+            ss << std::setprecision(6) << std::fixed;
+            ss << ", \"total\": " << item.total << ", \"min\": " << item.min << ", \"max\": " << item.max;
+            ss << ", \"gflops\": " << item.gflops;
+            ss << ", \"p50\": " << item.p50 << ", \"p90\": " << item.p90 << ", \"p99\": " << item.p99 << ", \"p999\": " << item.p999 << "}";
+            return ss.str();
         }
 
         double PerformanceMeasurer::Average() const
@@ -124,31 +241,96 @@ namespace Simd
 
         //---------------------------------------------------------------------
 
+        std::atomic<uint64_t> PerformanceMeasurer::s_epoch(0);
+
         PerformanceMeasurerStorage PerformanceMeasurerStorage::s_storage;
 
-        const char * PerformanceMeasurerStorage::PerformanceStatistic()
+        PerformanceMeasurerStorage::PmPtr PerformanceMeasurerStorage::Copy(const PerformanceMeasurer& pm)
         {
-            if (_map.empty())
-                return "";
-            FunctionMap combined;
+            PmPtr copy(new PerformanceMeasurer(pm));
+            if (!pm.Actual())
+                copy->Reset();
+            return copy;
+        }
+
+        void PerformanceMeasurerStorage::MakeSnapshot(Snapshot& snapshot, bool threads) const
+        {
+            snapshot.clear();
             std::lock_guard<std::mutex> lock(_mutex);
-            for (ThreadMap::const_iterator thread = _map.begin(); thread != _map.end(); ++thread)
+            if (threads)
             {
-                for (FunctionMap::const_iterator function = thread->second.begin(); function != thread->second.end(); ++function)
+                size_t index = 0;
+                for (ThreadMap::const_iterator thread = _map.begin(); thread != _map.end(); ++thread, ++index)
+                    for (FunctionMap::const_iterator function = thread->second.begin(); function != thread->second.end(); ++function)
+                        snapshot.push_back(std::make_pair(index, Copy(*function->second)));
+            }
+            else
+            {
+                FunctionMap combined;
+                for (ThreadMap::const_iterator thread = _map.begin(); thread != _map.end(); ++thread)
                 {
-                    if (combined.find(function->first) == combined.end())
-                        combined[function->first].reset(new PerformanceMeasurer(*function->second));
-                    else
-                        combined[function->first]->Combine(*function->second);
+                    for (FunctionMap::const_iterator function = thread->second.begin(); function != thread->second.end(); ++function)
+                    {
+                        if (combined.find(function->first) == combined.end())
+                            combined[function->first] = Copy(*function->second);
+                        else if (function->second->Actual())
+                            combined[function->first]->Combine(*function->second);
+                    }
                 }
+                for (FunctionMap::const_iterator it = combined.begin(); it != combined.end(); ++it)
+                    snapshot.push_back(std::make_pair(size_t(0), it->second));
             }
+        }
+
+        const char * PerformanceMeasurerStorage::PerformanceStatistic()
+        {
+            if (_map.empty())
+                return "";
+            Snapshot combined;
+            MakeSnapshot(combined, false);
             std::stringstream report;
             report << std::endl << "Simd Library Internal Performance Statistics:" << std::endl;
-            for (FunctionMap::const_iterator it = combined.begin(); it != combined.end(); ++it)
-                report << it->second->Statistic() << std::endl;
+            for (size_t i = 0; i < combined.size(); ++i)
+                report << combined[i].second->Statistic() << std::endl;
             _report = report.str();
             return _report.c_str();
         }
+
+        size_t PerformanceMeasurerStorage::PerformanceStatistic(SimdPerformanceStatisticItem* items, size_t size, bool threads)
+        {
+            MakeSnapshot(_snapshot, threads);
+            for (size_t i = 0; i < _snapshot.size() && i < size && items; ++i)
+            {
+                _snapshot[i].second->Get(items[i]);
+                items[i].thread = _snapshot[i].first;
+            }
+            return _snapshot.size();
+        }
+
+        const char* PerformanceMeasurerStorage::PerformanceStatisticJson(bool threads)
+        {
+            Snapshot snapshot;
+            MakeSnapshot(snapshot, threads);
+            std::stringstream json;
+            json << "{\"statistics\": [";
+            for (size_t i = 0; i < snapshot.size(); ++i)
+            {
+                String item = snapshot[i].second->Json();
+                if (threads)
+                    item.insert(1, "\"thread\": " + ToStr(snapshot[i].first) + ", ");
+                json << (i ? "," : "") << std::endl << "  " << item;
+            }
+            json << std::endl << "]}" << std::endl;
+            _json = json.str();
+            return _json.c_str();
+        }
+
+        // Measurers are modified only by their own threads: each one drops its counters in the next Enter
+        // after the epoch is changed, and snapshots treat measurers of previous epochs as empty.
+        void PerformanceMeasurerStorage::Reset()
+        {
+            PerformanceMeasurer::s_epoch++;
+        }
     }
 }
 #endif
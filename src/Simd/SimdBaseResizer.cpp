@@ -23,14 +23,147 @@
 */
 #include "Simd/SimdMemory.h"
 #include "Simd/SimdResizer.h"
+#include "Simd/SimdParallelRows.h"
 
 namespace Simd
 {
+    Resizer::~Resizer()
+    {
+        for (size_t i = 0; i < _workers.size(); ++i)
+            delete _workers[i];
+    }
+
+    Resizer* Resizer::Clone() const
+    {
+        const ResParam& p = _param;
+        return (Resizer*)p.init(p.srcW, p.srcH, p.dstW, p.dstH, p.channels, p.type, p.method);
+    }
+
+    bool Resizer::Reset(size_t srcW, size_t srcH)
+    {
+        return false;
+    }
+
+    void Resizer::RunParallel(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+    {
+        const ResParam& p = _param;
+        size_t threads = p.init && p.dstH ? ParallelRowsThreads((p.srcW * p.srcH / p.dstH + p.dstW) * p.PixelSize(), p.dstH) : 1;
+        if (threads < 2)
+        {
+            Run(src, srcStride, dst, dstStride);
+            return;
+        }
+        while (_workers.size() + 1 < threads)
+            _workers.push_back(Clone());
+        Simd::Parallel(0, p.dstH, [&](size_t thread, size_t begin, size_t end)
+        {
+            bool& nested = ParallelRowsNested();
+            nested = true;
+            Resizer* resizer = thread ? _workers[thread - 1] : this;
+            resizer->_yBeg = begin, resizer->_yEnd = end;
+            resizer->Run(src, srcStride, dst + begin * dstStride, dstStride);
+            resizer->_yBeg = 0, resizer->_yEnd = p.dstH;
+            nested = false;
+        }, threads, 1);
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    const size_t RESIZER_BATCH_CACHE_SIZE = 16;
+
+    ResizerBatch::ResizerBatch(const ResParam& param)
+        : _param(param)
+        , _used(0)
+    {
+    }
+
+    ResizerBatch::~ResizerBatch()
+    {
+        for (size_t t = 0; t < _caches.size(); ++t)
+            for (size_t i = 0; i < _caches[t].size(); ++i)
+                delete _caches[t][i].resizer;
+    }
+
+    Resizer* ResizerBatch::Get(size_t thread, size_t srcW, size_t srcH)
+    {
+        Cache& cache = _caches[thread];
+        size_t oldest = 0;
+        for (size_t i = 0; i < cache.size(); ++i)
+        {
+            if (cache[i].srcW == srcW && cache[i].srcH == srcH)
+            {
+                cache[i].used = _used;
+                return cache[i].resizer;
+            }
+            if (cache[i].used < cache[oldest].used)
+                oldest = i;
+        }
+        if (cache.size() && cache[oldest].resizer && cache[oldest].resizer->Reset(srcW, srcH))
+        {
+            cache[oldest].srcW = srcW;
+            cache[oldest].srcH = srcH;
+            cache[oldest].used = _used;
+            return cache[oldest].resizer;
+        }
+        const ResParam& p = _param;
+        Item item = { srcW, srcH, _used, (Resizer*)p.init(srcW, srcH, p.dstW, p.dstH, p.channels, p.type, p.method) };
+        if (cache.size() < RESIZER_BATCH_CACHE_SIZE)
+            cache.push_back(item);
+        else
+        {
+            delete cache[oldest].resizer;
+            cache[oldest] = item;
+        }
+        return item.resizer;
+    }
+
+    bool ResizerBatch::Run(const uint8_t* src, size_t srcW, size_t srcH, size_t srcStride, const size_t* rois, size_t count, uint8_t* dst, size_t dstStride)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const size_t* roi = rois + i * 4;
+            if (roi[0] >= roi[2] || roi[1] >= roi[3] || roi[2] > srcW || roi[3] > srcH)
+                return false;
+        }
+        const ResParam& p = _param;
+        size_t pixelSize = p.PixelSize(), dstSize = p.dstH * dstStride;
+        size_t threads = ParallelRowsThreads(p.dstW * p.dstH * pixelSize, count);
+        if (_caches.size() < threads)
+            _caches.resize(threads);
+        _used++;
+        if (threads < 2)
+        {
+            for (size_t i = 0; i < count; ++i, rois += 4)
+            {
+                Resizer* resizer = Get(0, rois[2] - rois[0], rois[3] - rois[1]);
+                if (resizer)
+                    resizer->RunParallel(src + rois[1] * srcStride + rois[0] * pixelSize, srcStride, dst + i * dstSize, dstStride);
+            }
+            return true;
+        }
+        Simd::Parallel(0, count, [&](size_t thread, size_t begin, size_t end)
+        {
+            bool& nested = ParallelRowsNested();
+            nested = true;
+            for (size_t i = begin; i < end; ++i)
+            {
+                const size_t* roi = rois + i * 4;
+                Resizer* resizer = Get(thread, roi[2] - roi[0], roi[3] - roi[1]);
+                if (resizer)
+                    resizer->Run(src + roi[1] * srcStride + roi[0] * pixelSize, srcStride, dst + i * dstSize, dstStride);
+            }
+            nested = false;
+        }, threads, 1);
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
     namespace Base
     {
         void * ResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method)
         {
-            ResParam param(srcX, srcY, dstX, dstY, channels, type, method, sizeof(void*));
+            ResParam param(srcX, srcY, dstX, dstY, channels, type, method, sizeof(void*), ResizerInit);
             if (param.IsNearest())
                 return new ResizerNearest(param);
             else if (param.IsByteBilinear())
@@ -47,9 +180,19 @@ namespace Simd
                 return new ResizerByteArea2x2(param);
             else if (param.IsByteArea1x1())
                 return new ResizerByteArea1x1(param);
+            else if (param.IsKernel())
+                return new ResizerKernel(param);
             else
                 return NULL;
         }
+
+        void* ResizerKernelInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, const float* kernel, size_t size, float support)
+        {
+            ResParam param(srcX, srcY, dstX, dstY, channels, type, SimdResizeMethodKernel, sizeof(void*), ResizerInit);
+            if (kernel == NULL || size < 2 || !(support > 0.0f))
+                return NULL;
+            return new ResizerKernel(param, kernel, size, support);
+        }
     }
 }
 
@@ -32,11 +32,26 @@ namespace Simd
     {
         ResizerByteBilinear::ResizerByteBilinear(const ResParam & param)
             : Resizer(param)
+            , _xSrcW(0)
         {
             _ay.Resize(_param.dstH);
             _iy.Resize(_param.dstH);
             EstimateIndexAlpha(_param.srcH, _param.dstH, 1, _iy.data, _ay.data);
         }        
+
+        bool ResizerByteBilinear::Reset(size_t srcW, size_t srcH)
+        {
+            ResParam param = _param;
+            param.srcW = srcW;
+            param.srcH = srcH;
+            if (param.IsNearest() || !param.IsByteBilinear())
+                return false;
+            _param = param;
+            EstimateIndexAlpha(_param.srcH, _param.dstH, 1, _iy.data, _ay.data);
+            for (size_t i = 0; i < _workers.size(); ++i)
+                _workers[i]->Reset(srcW, srcH);
+            return true;
+        }
         
         void ResizerByteBilinear::EstimateIndexAlpha(size_t srcSize, size_t dstSize, size_t channels, int32_t * indices, int32_t * alphas)
         {
@@ -73,17 +88,18 @@ namespace Simd
         {
             size_t cn =  _param.channels;
             size_t rs = _param.dstW * cn;
-            if (_ax.data == 0)
+            if (_xSrcW != _param.srcW)
             {
                 _ax.Resize(rs);
                 _ix.Resize(rs);
                 EstimateIndexAlpha(_param.srcW, _param.dstW, cn, _ix.data, _ax.data);
                 _bx[0].Resize(rs);
                 _bx[1].Resize(rs);
+                _xSrcW = _param.srcW;
             }
             int32_t * pbx[2] = { _bx[0].data, _bx[1].data };
             int32_t prev = -2;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 int32_t fy = _ay[dy];
                 int32_t sy = _iy[dy];
@@ -182,7 +198,7 @@ namespace Simd
             size_t rs = _param.dstW * N;
             float* pbx[2] = { _bx[0].data, _bx[1].data };
             int32_t prev = -2;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -215,7 +231,7 @@ namespace Simd
         template<size_t N> void ResizerShortBilinear::RunS(const uint16_t* src, size_t srcStride, uint16_t* dst, size_t dstStride)
         {
             size_t rs = _param.dstW * N;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -363,7 +379,7 @@ namespace Simd
             size_t rs = _param.dstW * cn;
             float * pbx[2] = { _bx[0].data, _bx[1].data };
             int32_t prev = -2;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -428,7 +444,7 @@ namespace Simd
             size_t rs = _param.dstW * cn;
             float* pbx[2] = { _bx[0].data, _bx[1].data };
             int32_t prev = -2;
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -0,0 +1,327 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdResizer.h"
+#include "Simd/SimdBFloat16.h"
+
+namespace Simd
+{
+    namespace Base
+    {
+        ResizerKernel::ResizerKernel(const ResParam& param, const float* kernel, size_t size, float support)
+            : Resizer(param)
+            , _support(support)
+            , _kernelInit(ResizerKernelInit)
+        {
+            if (kernel)
+                _kernel.Assign(kernel, size);
+            else if (param.method == SimdResizeMethodLanczos)
+                _support = 3.0f;
+        }
+
+        Resizer* ResizerKernel::Clone() const
+        {
+            if (_kernel.size == 0)
+                return Resizer::Clone();
+            const ResParam& p = _param;
+            return (Resizer*)_kernelInit(p.srcW, p.srcH, p.dstW, p.dstH, p.channels, p.type, _kernel.data, _kernel.size, _support);
+        }
+
+        SIMD_INLINE double Sinc(double x)
+        {
+            if (x == 0.0)
+                return 1.0;
+            x *= M_PI;
+            return ::sin(x) / x;
+        }
+
+        float ResizerKernel::Kernel(float x) const
+        {
+            x = ::fabs(x);
+            if (x >= _support)
+                return 0.0f;
+            if (_kernel.size == 0)
+                return float(Sinc(x) * Sinc(x / _support));
+            float pos = x * float(_kernel.size - 1) / _support;
+            size_t idx = Simd::Min((size_t)pos, _kernel.size - 2);
+            float d = pos - float(idx);
+            return _kernel[idx] * (1.0f - d) + _kernel[idx + 1] * d;
+        }
+
+        void ResizerKernel::EstimateKernelTaps(size_t srcSize, size_t dstSize, size_t& taps, Array32i& index, Array32f& alpha) const
+        {
+            double scale = double(srcSize) / double(dstSize);
+            double stretch = Simd::Max(scale, 1.0);
+            double support = _support * stretch;
+            taps = Simd::Min((size_t)::ceil(support) * 2 + 1, srcSize);
+            index.Resize(dstSize);
+            alpha.Resize(dstSize * taps, true);
+            for (size_t i = 0; i < dstSize; ++i)
+            {
+                double center = (double(i) + 0.5) * scale;
+                ptrdiff_t beg = Simd::Max((ptrdiff_t)(center - support + 0.5), ptrdiff_t(0));
+                ptrdiff_t end = Simd::Min((ptrdiff_t)(center + support + 0.5), (ptrdiff_t)srcSize);
+                ptrdiff_t idx = Simd::Min(beg, ptrdiff_t(srcSize - taps));
+                float * a = alpha.data + i * taps;
+                double sum = 0;
+                for (ptrdiff_t s = beg; s < end && s < idx + (ptrdiff_t)taps; ++s)
+                {
+                    a[s - idx] = Kernel(float((double(s) + 0.5 - center) / stretch));
+                    sum += a[s - idx];
+                }
+                if (sum != 0.0)
+                {
+                    for (size_t t = 0; t < taps; ++t)
+                        a[t] = float(a[t] / sum);
+                }
+                index[i] = (int32_t)idx;
+            }
+        }
+
+        void ResizerKernel::EstimateBicubicTaps(size_t srcSize, size_t dstSize, size_t& taps, Array32i& index, Array32f& alpha) const
+        {
+            double scale = double(srcSize) / double(dstSize);
+            taps = Simd::Min<size_t>(4, srcSize);
+            index.Resize(dstSize);
+            alpha.Resize(dstSize * taps, true);
+            for (size_t i = 0; i < dstSize; ++i)
+            {
+                double pos = (double(i) + 0.5) * scale - 0.5;
+                ptrdiff_t idx = (ptrdiff_t)::floor(pos);
+                double d = pos - double(idx);
+                if (idx < 0)
+                {
+                    idx = 0;
+                    d = 0.0;
+                }
+                if (idx > (ptrdiff_t)srcSize - 2)
+                {
+                    idx = (ptrdiff_t)srcSize - 2;
+                    d = 1.0;
+                }
+                double w[4];
+                w[0] = -d * (d - 1.0) * (d - 2.0) / 6.0;
+                w[1] = (d + 1.0) * (d - 1.0) * (d - 2.0) / 2.0;
+                w[2] = -(d + 1.0) * d * (d - 2.0) / 2.0;
+                w[3] = (d + 1.0) * d * (d - 1.0) / 6.0;
+                ptrdiff_t beg = Simd::Min(Simd::Max(idx - 1, ptrdiff_t(0)), ptrdiff_t(srcSize - taps));
+                float* a = alpha.data + i * taps;
+                for (ptrdiff_t k = 0; k < 4; ++k)
+                    a[RestrictRange(idx - 1 + k, ptrdiff_t(0), ptrdiff_t(srcSize - 1)) - beg] += float(w[k]);
+                index[i] = (int32_t)beg;
+            }
+        }
+
+        void ResizerKernel::EstimateAreaTaps(size_t srcSize, size_t dstSize, size_t& taps, Array32i& index, Array32f& alpha) const
+        {
+            double scale = double(srcSize) / double(dstSize);
+            taps = Simd::Min((size_t)::ceil(scale) + 1, srcSize);
+            index.Resize(dstSize);
+            alpha.Resize(dstSize * taps, true);
+            for (size_t i = 0; i < dstSize; ++i)
+            {
+                double lo = double(i) * scale, hi = Simd::Min(double(i + 1) * scale, double(srcSize));
+                ptrdiff_t beg = (ptrdiff_t)::floor(lo);
+                ptrdiff_t end = Simd::Min((ptrdiff_t)::ceil(hi), (ptrdiff_t)srcSize);
+                ptrdiff_t idx = Simd::Min(beg, ptrdiff_t(srcSize - taps));
+                float* a = alpha.data + i * taps;
+                for (ptrdiff_t s = beg; s < end; ++s)
+                    a[s - idx] = float((Simd::Min(double(s + 1), hi) - Simd::Max(double(s), lo)) / (hi - lo));
+                index[i] = (int32_t)idx;
+            }
+        }
+
+        void ResizerKernel::EstimateTaps(size_t srcSize, size_t dstSize, size_t& taps, Array32i& index, Array32f& alpha) const
+        {
+            switch (_param.method)
+            {
+            case SimdResizeMethodBicubic:
+                EstimateBicubicTaps(srcSize, dstSize, taps, index, alpha);
+                break;
+            case SimdResizeMethodArea:
+            case SimdResizeMethodAreaFast:
+                EstimateAreaTaps(srcSize, dstSize, taps, index, alpha);
+                break;
+            default:
+                EstimateKernelTaps(srcSize, dstSize, taps, index, alpha);
+            }
+        }
+
+        void ResizerKernel::Init()
+        {
+            if (_iy.data)
+                return;
+            const ResParam& p = _param;
+            EstimateTaps(p.srcH, p.dstH, _yTaps, _iy, _ay);
+            Array32i ix;
+            Array32f ax;
+            EstimateTaps(p.srcW, p.dstW, _xTaps, ix, ax);
+            size_t C = p.channels, size = p.dstW * C;
+            _rowSize = AlignHi(size, Simd::Max(p.align / sizeof(float), size_t(1)));
+            _ix.Resize(_rowSize, true, p.align);
+            _ax.Resize(_rowSize * _xTaps, true, p.align);
+            for (size_t x = 0, j = 0; x < p.dstW; ++x)
+            {
+                for (size_t c = 0; c < C; ++c, ++j)
+                {
+                    _ix[j] = ix[x] * (int32_t)C + (int32_t)c;
+                    for (size_t t = 0; t < _xTaps; ++t)
+                        _ax[t * _rowSize + j] = ax[x * _xTaps + t];
+                }
+            }
+            if (p.type == SimdResizeChannelByte)
+            {
+                _axi.Resize(_ax.size, false, p.align);
+                for (size_t i = 0; i < _ax.size; ++i)
+                    _axi[i] = Round(_ax[i] * KERNEL_RANGE);
+                _ayi.Resize(_ay.size);
+                for (size_t i = 0; i < _ay.size; ++i)
+                    _ayi[i] = Round(_ay[i] * KERNEL_RANGE);
+            }
+            if (p.type != SimdResizeChannelFloat)
+                _bs.Resize(p.srcW * C, false, p.align);
+            _by.Resize(_rowSize * _yTaps, false, p.align);
+            _ry.Resize(_yTaps);
+            _rows.resize(_yTaps);
+        }
+
+        void ResizerKernel::Convert(const uint8_t* src, float* dst)
+        {
+            size_t size = _param.srcW * _param.channels;
+            switch (_param.type)
+            {
+            case SimdResizeChannelByte:
+                for (size_t i = 0; i < size; ++i)
+                    ((int32_t*)dst)[i] = src[i];
+                break;
+            case SimdResizeChannelShort:
+                for (size_t i = 0; i < size; ++i)
+                    dst[i] = float(((uint16_t*)src)[i]);
+                break;
+            case SimdResizeChannelBf16:
+                for (size_t i = 0; i < size; ++i)
+                    dst[i] = BFloat16ToFloat32(((uint16_t*)src)[i]);
+                break;
+            default:
+                assert(0);
+            }
+        }
+
+        void ResizerKernel::Horizontal(const float* src, float* dst)
+        {
+            size_t C = _param.channels, taps = _xTaps, size = _rowSize;
+            const int32_t* ix = _ix.data;
+            if (_param.type == SimdResizeChannelByte)
+            {
+                const int32_t* si = (int32_t*)src;
+                int32_t* di = (int32_t*)dst;
+                for (size_t j = 0; j < size; ++j)
+                {
+                    const int32_t* ps = si + ix[j];
+                    const int32_t* pa = _axi.data + j;
+                    int32_t sum = 0;
+                    for (size_t t = 0; t < taps; ++t, ps += C, pa += size)
+                        sum += pa[0] * ps[0];
+                    di[j] = (sum + KERNEL_X_ROUND) >> KERNEL_X_SHIFT;
+                }
+            }
+            else
+            {
+                for (size_t j = 0; j < size; ++j)
+                {
+                    const float* ps = src + ix[j];
+                    const float* pa = _ax.data + j;
+                    float sum = 0;
+                    for (size_t t = 0; t < taps; ++t, ps += C, pa += size)
+                        sum += pa[0] * ps[0];
+                    dst[j] = sum;
+                }
+            }
+        }
+
+        void ResizerKernel::Vertical(const float* const* rows, size_t dy, uint8_t* dst)
+        {
+            size_t size = _param.dstW * _param.channels, taps = _yTaps;
+            if (_param.type == SimdResizeChannelByte)
+            {
+                const int32_t* ay = _ayi.data + dy * taps;
+                for (size_t j = 0; j < size; ++j)
+                {
+                    int32_t sum = 0;
+                    for (size_t t = 0; t < taps; ++t)
+                        sum += ay[t] * ((int32_t*)rows[t])[j];
+                    dst[j] = RestrictRange((sum + KERNEL_Y_ROUND) >> KERNEL_Y_SHIFT, 0, 255);
+                }
+            }
+            else
+            {
+                const float* ay = _ay.data + dy * taps;
+                for (size_t j = 0; j < size; ++j)
+                {
+                    float sum = 0;
+                    for (size_t t = 0; t < taps; ++t)
+                        sum += ay[t] * rows[t][j];
+                    switch (_param.type)
+                    {
+                    case SimdResizeChannelShort: ((uint16_t*)dst)[j] = (uint16_t)RestrictRange(Round(sum), 0, 0xFFFF); break;
+                    case SimdResizeChannelFloat: ((float*)dst)[j] = sum; break;
+                    case SimdResizeChannelBf16: ((uint16_t*)dst)[j] = Float32ToBFloat16(sum); break;
+                    default: assert(0);
+                    }
+                }
+            }
+        }
+
+        void ResizerKernel::Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride)
+        {
+            Init();
+            for (size_t i = 0; i < _yTaps; ++i)
+                _ry[i] = -1;
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
+            {
+                int32_t sy = _iy[dy];
+                for (size_t t = 0; t < _yTaps; ++t)
+                {
+                    int32_t y = sy + (int32_t)t;
+                    size_t i = y % _yTaps;
+                    float* row = _by.data + i * _rowSize;
+                    if (_ry[i] != y)
+                    {
+                        const uint8_t* ps = src + y * srcStride;
+                        if (_param.type == SimdResizeChannelFloat)
+                            Horizontal((float*)ps, row);
+                        else
+                        {
+                            Convert(ps, _bs.data);
+                            Horizontal(_bs.data, row);
+                        }
+                        _ry[i] = y;
+                    }
+                    _rows[t] = row;
+                }
+                Vertical(_rows.data(), dy, dst);
+            }
+        }
+    }
+}
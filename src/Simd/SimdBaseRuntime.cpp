@@ -0,0 +1,168 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include "Simd/SimdRuntime.h"
+#include "Simd/SimdEnable.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdCpu.h"
+
+#include <fstream>
+#include <cstdio>
+
+namespace Simd
+{
+    namespace Base
+    {
+        RuntimeCache & RuntimeCache::Global()
+        {
+            static RuntimeCache cache;
+            return cache;
+        }
+
+        RuntimeCache::RuntimeCache()
+            : _mode(SimdRuntimeCacheOff)
+            , _hits(0)
+            , _misses(0)
+            , _stores(0)
+        {
+        }
+
+        bool RuntimeCache::Open(const char * path, SimdRuntimeCacheModeType mode)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _mode = SimdRuntimeCacheOff;
+            _path.clear();
+            _signatures.clear();
+            _hits = 0;
+            _misses = 0;
+            _stores = 0;
+            if (mode == SimdRuntimeCacheOff)
+                return true;
+            if (path == NULL || path[0] == 0)
+                return false;
+            if (_signature.empty())
+            {
+                _signature = CpuModel();
+                if (_signature.empty())
+                    _signature = "Unknown CPU";
+            }
+            _path = path;
+            bool read = Read();
+            if (mode == SimdRuntimeCacheRead && !read)
+                return false;
+            if (mode != SimdRuntimeCacheRead && !Write())
+                return false;
+            _mode = mode;
+            return true;
+        }
+
+        String RuntimeCache::Key(const String & info, const String & names) const
+        {
+            std::stringstream ss;
+            ss << info << " isa=0x" << std::hex << GetIsaMask() << std::dec;
+            ss << " threads=" << GetThreadNumber() << " {" << names << "}";
+            return ss.str();
+        }
+
+        bool RuntimeCache::Load(const String & key, String & name)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            Signatures::const_iterator signature = _signatures.find(_signature);
+            if (signature != _signatures.end())
+            {
+                Entries::const_iterator entry = signature->second.find(key);
+                if (entry != signature->second.end())
+                {
+                    name = entry->second;
+                    _hits++;
+                    return true;
+                }
+            }
+            _misses++;
+            return false;
+        }
+
+        void RuntimeCache::Store(const String & key, const String & name)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_path.empty())
+                return;
+            _signatures[_signature][key] = name;
+            _stores++;
+            Write();
+        }
+
+        bool RuntimeCache::Read()
+        {
+            std::ifstream ifs(_path.c_str());
+            if (!ifs.is_open())
+                return false;
+            String line;
+            while (std::getline(ifs, line))
+            {
+                if (line.size() && line[line.size() - 1] == '\r')
+                    line.resize(line.size() - 1);
+                if (line.empty() || line[0] == '#')
+                    continue;
+                size_t tab0 = line.find('\t'), tab1 = line.rfind('\t');
+                if (tab0 == String::npos || tab1 == tab0)
+                    continue;
+                _signatures[line.substr(0, tab0)][line.substr(tab0 + 1, tab1 - tab0 - 1)] = line.substr(tab1 + 1);
+            }
+            return true;
+        }
+
+        bool RuntimeCache::Write() const
+        {
+            String tmp = _path + ".tmp";
+            {
+                std::ofstream ofs(tmp.c_str());
+                if (!ofs.is_open())
+                    return false;
+                ofs << "# Simd Library runtime cache: <CPU>\t<problem>\t<best function>" << std::endl;
+                for (Signatures::const_iterator signature = _signatures.begin(); signature != _signatures.end(); ++signature)
+                    for (Entries::const_iterator entry = signature->second.begin(); entry != signature->second.end(); ++entry)
+                        ofs << signature->first << "\t" << entry->first << "\t" << entry->second << std::endl;
+                ofs.close();
+                if (ofs.fail())
+                {
+                    std::remove(tmp.c_str());
+                    return false;
+                }
+            }
+            // Readers never see a partially written cache: the new file replaces the old one at once.
+            // On Windows rename() does not overwrite existing file, so it is removed first.
+            if (std::rename(tmp.c_str(), _path.c_str()) != 0)
+            {
+                std::remove(_path.c_str());
+                if (std::rename(tmp.c_str(), _path.c_str()) != 0)
+                {
+                    std::remove(tmp.c_str());
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+}
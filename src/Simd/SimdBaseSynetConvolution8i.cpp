@@ -243,8 +243,7 @@ namespace Simd
     {
         if (buf == NULL)
         {
-            _buffer.Resize(ExternalBufferSize());
-            buf = _buffer.data;
+            buf = Workspace(_buffer, ExternalBufferSize());
         }
         const ConvParam& p = _param;
         uint8_t* src8u = _src8u ? NULL : Allocate<uint8_t>(buf, _sizeS * _merge);
@@ -625,8 +625,7 @@ namespace Simd
                 return buffer;
             else
             {
-                _buffer.Resize(ExternalBufferSize());
-                return _buffer.data;
+                return Workspace(_buffer, ExternalBufferSize());
             }
         }
 
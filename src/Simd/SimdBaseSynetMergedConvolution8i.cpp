@@ -301,8 +301,7 @@ namespace Simd
                 return buffer;
             else
             {
-                _buffer.Resize(ExternalBufferSize());
-                return _buffer.data;
+                return Workspace(_buffer, ExternalBufferSize());
             }
         }
 
@@ -0,0 +1,325 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetPreprocess.h"
+#include "Simd/SimdBFloat16.h"
+#include "Simd/SimdParallelRows.h"
+#include "Simd/SimdBase.h"
+
+namespace Simd
+{
+#if defined(SIMD_SYNET_ENABLE)
+    PreprocessParam::PreprocessParam(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels,
+        SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat)
+    {
+        this->srcW = srcW;
+        this->srcH = srcH;
+        this->srcFormat = srcFormat;
+        this->yuvType = yuvType;
+        this->dstW = dstW;
+        this->dstH = dstH;
+        this->channels = channels;
+        this->method = method;
+        for (size_t c = 0; c < 3; ++c)
+        {
+            this->lower[c] = lower && c < channels ? lower[c] : 0.0f;
+            this->upper[c] = upper && c < channels ? upper[c] : 1.0f;
+        }
+        this->dstType = dstType;
+        this->dstFormat = dstFormat;
+    }
+
+    bool PreprocessParam::Valid() const
+    {
+        if (srcW == 0 || srcH == 0 || dstW == 0 || dstH == 0)
+            return false;
+        if (channels != 1 && channels != 3)
+            return false;
+        if (srcFormat != SimdPixelFormatGray8 && srcFormat != SimdPixelFormatBgr24 && srcFormat != SimdPixelFormatBgra32 && 
+            srcFormat != SimdPixelFormatRgb24 && srcFormat != SimdPixelFormatRgba32 && !IsYuv())
+            return false;
+        if (IsYuv() && (srcW % 2 != 0 || srcH % 2 != 0 || yuvType < SimdYuvBt601 || yuvType > SimdYuvTrect871))
+            return false;
+        if (method != SimdResizeMethodBilinear && method != SimdResizeMethodArea && method != SimdResizeMethodAreaFast)
+            return false;
+        if (dstType != SimdTensorData32f && dstType != SimdTensorData16b && dstType != SimdTensorData8u)
+            return false;
+        if (dstFormat != SimdTensorFormatNchw && dstFormat != SimdTensorFormatNhwc)
+            return false;
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    namespace Base
+    {
+        void SynetPreprocessHorizontal(const uint8_t* src, size_t srcW, size_t channels, const int32_t* ix, const float* ax, size_t taps, size_t dstW, bool planar, float* dst)
+        {
+            size_t xStep = planar ? 1 : channels, cStep = planar ? dstW : 1;
+            for (size_t x = 0; x < dstW; ++x, ax += taps)
+            {
+                const uint8_t* s = src + ix[x] * channels;
+                for (size_t c = 0; c < channels; ++c)
+                {
+                    float sum = 0.0f;
+                    for (size_t t = 0; t < taps; ++t)
+                        sum += ax[t] * float(s[t * channels + c]);
+                    dst[x * xStep + c * cStep] = sum;
+                }
+            }
+        }
+
+        static void SynetPreprocessMulRow(const float* src, float weight, size_t size, float* dst)
+        {
+            for (size_t i = 0; i < size; ++i)
+                dst[i] = src[i] * weight;
+        }
+
+        static void SynetPreprocessAddMulRow(const float* src, float weight, size_t size, float* dst)
+        {
+            for (size_t i = 0; i < size; ++i)
+                dst[i] += src[i] * weight;
+        }
+
+        static void SynetPreprocessStore32f(const float* src, const float* scale, const float* shift, size_t size, uint8_t* dst)
+        {
+            float* dst32f = (float*)dst;
+            for (size_t i = 0; i < size; ++i)
+                dst32f[i] = src[i] * scale[i] + shift[i];
+        }
+
+        static void SynetPreprocessStore16b(const float* src, const float* scale, const float* shift, size_t size, uint8_t* dst)
+        {
+            uint16_t* dst16b = (uint16_t*)dst;
+            for (size_t i = 0; i < size; ++i)
+                dst16b[i] = Float32ToBFloat16(src[i] * scale[i] + shift[i]);
+        }
+
+        static void SynetPreprocessStore8u(const float* src, const float* scale, const float* shift, size_t size, uint8_t* dst)
+        {
+            for (size_t i = 0; i < size; ++i)
+                dst[i] = (uint8_t)RestrictRange(Round(src[i] * scale[i] + shift[i]), 0, 255);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SynetPreprocess::SynetPreprocess(const PreprocessParam& param)
+            : _param(param)
+        {
+            const PreprocessParam& p = _param;
+            _planar = p.dstFormat == SimdTensorFormatNchw;
+            _rowSize = p.dstW * p.channels;
+            EstimateTaps(p.srcW, p.dstW, _xTaps, _ix, _ax);
+            EstimateTaps(p.srcH, p.dstH, _yTaps, _iy, _ay);
+            _scale.Resize(_rowSize);
+            _shift.Resize(_rowSize);
+            for (size_t x = 0; x < p.dstW; ++x)
+            {
+                for (size_t c = 0; c < p.channels; ++c)
+                {
+                    size_t i = _planar ? c * p.dstW + x : x * p.channels + c;
+                    _scale[i] = (p.upper[c] - p.lower[c]) / 255.0f;
+                    _shift[i] = p.lower[c];
+                }
+            }
+
+            _convert = NULL;
+            _toGray = NULL;
+            if (p.channels == 3)
+            {
+                switch (p.srcFormat)
+                {
+                case SimdPixelFormatGray8: _convert = GrayToBgr; break;
+                case SimdPixelFormatRgb24: _convert = BgrToRgb; break;
+                case SimdPixelFormatBgra32: _convert = BgraToBgr; break;
+                case SimdPixelFormatRgba32: _convert = BgraToRgb; break;
+                default: break;
+                }
+            }
+            else
+            {
+                switch (p.srcFormat)
+                {
+                case SimdPixelFormatBgr24: _convert = BgrToGray; break;
+                case SimdPixelFormatRgb24: _convert = RgbToGray; break;
+                case SimdPixelFormatBgra32: _convert = BgraToGray; break;
+                case SimdPixelFormatRgba32: _convert = RgbaToGray; break;
+                case SimdPixelFormatNv12: _toGray = BgrToGray; break;
+                case SimdPixelFormatYuv420p: _toGray = BgrToGray; break;
+                default: break;
+                }
+            }
+            _deinterleaveUv = DeinterleaveUv;
+            _yuvToBgr = Yuv422pToBgrV2;
+            _horizontal = SynetPreprocessHorizontal;
+            _mulRow = SynetPreprocessMulRow;
+            _addMulRow = SynetPreprocessAddMulRow;
+            switch (p.dstType)
+            {
+            case SimdTensorData32f: _store = SynetPreprocessStore32f; break;
+            case SimdTensorData16b: _store = SynetPreprocessStore16b; break;
+            case SimdTensorData8u: _store = SynetPreprocessStore8u; break;
+            default: _store = NULL; break;
+            }
+        }
+
+        void SynetPreprocess::EstimateTaps(size_t srcSize, size_t dstSize, size_t& taps, Array32i& index, Array32f& alpha)
+        {
+            double scale = double(srcSize) / double(dstSize);
+            bool area = _param.method != SimdResizeMethodBilinear && srcSize > dstSize;
+            taps = Simd::Min(area ? (size_t)::ceil(scale) + 1 : size_t(2), srcSize);
+            index.Resize(dstSize);
+            alpha.Resize(dstSize * taps, true);
+            std::vector<float> buf(taps + 1);
+            for (size_t i = 0; i < dstSize; ++i)
+            {
+                ptrdiff_t beg, end;
+                if (area)
+                {
+                    double lo = double(i) * scale, hi = double(i + 1) * scale;
+                    beg = (ptrdiff_t)::floor(lo);
+                    end = Simd::Min((ptrdiff_t)::ceil(hi), (ptrdiff_t)srcSize);
+                    for (ptrdiff_t s = beg; s < end; ++s)
+                        buf[s - beg] = float((Simd::Min(double(s + 1), hi) - Simd::Max(double(s), lo)) / scale);
+                }
+                else
+                {
+                    double pos = Simd::Max(0.0, Simd::Min((double(i) + 0.5) * scale - 0.5, double(srcSize - 1)));
+                    beg = Simd::Min((ptrdiff_t)::floor(pos), (ptrdiff_t)srcSize - (ptrdiff_t)taps);
+                    end = beg + taps;
+                    float frac = float(pos - double(beg));
+                    buf[0] = 1.0f - frac;
+                    buf[1] = frac;
+                }
+                ptrdiff_t offs = Simd::Max(ptrdiff_t(0), beg + (ptrdiff_t)taps - (ptrdiff_t)srcSize);
+                index[i] = int32_t(beg - offs);
+                float* a = alpha.data + i * taps;
+                for (ptrdiff_t s = beg; s < end; ++s)
+                    a[s - beg + offs] = buf[s - beg];
+            }
+        }
+
+        const uint8_t* SynetPreprocess::SourceRow(Buffer& buf, const uint8_t* src, size_t srcStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, size_t row)
+        {
+            const PreprocessParam& p = _param;
+            src += row * srcStride;
+            if (p.IsYuv())
+            {
+                size_t halfW = p.srcW / 2;
+                u += row / 2 * uStride;
+                if (p.srcFormat == SimdPixelFormatNv12)
+                {
+                    _deinterleaveUv(u, uStride, halfW, 1, buf.uv.data, halfW, buf.uv.data + halfW, halfW);
+                    u = buf.uv.data;
+                    v = buf.uv.data + halfW;
+                }
+                else
+                    v += row / 2 * vStride;
+                uint8_t* bgr = buf.pixels.data;
+                _yuvToBgr(src, srcStride, u, uStride, v, vStride, p.srcW, 1, bgr, p.srcW * 3, p.yuvType);
+                if (_toGray == NULL)
+                    return bgr;
+                _toGray(bgr, p.srcW, 1, p.srcW * 3, bgr + p.srcW * 3, p.srcW);
+                return bgr + p.srcW * 3;
+            }
+            if (_convert == NULL)
+                return src;
+            _convert(src, p.srcW, 1, srcStride, buf.pixels.data, p.srcW * p.channels);
+            return buf.pixels.data;
+        }
+
+        void SynetPreprocess::Run(Buffer& buf, const uint8_t* src, size_t srcStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, size_t yBeg, size_t yEnd, uint8_t* dst)
+        {
+            const PreprocessParam& p = _param;
+            if (buf.sum.size != _rowSize)
+            {
+                buf.pixels.Resize(p.srcW * 4);
+                buf.uv.Resize(p.srcW);
+                buf.rows.Resize(_yTaps * _rowSize);
+                buf.sum.Resize(_rowSize);
+                buf.index.Resize(_yTaps);
+            }
+            for (size_t i = 0; i < _yTaps; ++i)
+                buf.index[i] = -1;
+            size_t typeSize = p.DstTypeSize();
+            for (size_t dy = yBeg; dy < yEnd; ++dy)
+            {
+                const float* ay = _ay.data + dy * _yTaps;
+                for (size_t t = 0; t < _yTaps; ++t)
+                {
+                    int32_t sy = _iy[dy] + int32_t(t);
+                    size_t slot = sy % _yTaps;
+                    float* row = buf.rows.data + slot * _rowSize;
+                    if (buf.index[slot] != sy)
+                    {
+                        _horizontal(SourceRow(buf, src, srcStride, u, uStride, v, vStride, sy), p.srcW, p.channels, _ix.data, _ax.data, _xTaps, p.dstW, _planar, row);
+                        buf.index[slot] = sy;
+                    }
+                    if (t == 0)
+                        _mulRow(row, ay[t], _rowSize, buf.sum.data);
+                    else
+                        _addMulRow(row, ay[t], _rowSize, buf.sum.data);
+                }
+                if (_planar)
+                {
+                    for (size_t c = 0; c < p.channels; ++c)
+                        _store(buf.sum.data + c * p.dstW, _scale.data + c * p.dstW, _shift.data + c * p.dstW, p.dstW, dst + ((c * p.dstH + dy) * p.dstW) * typeSize);
+                }
+                else
+                    _store(buf.sum.data, _scale.data, _shift.data, _rowSize, dst + dy * _rowSize * typeSize);
+            }
+        }
+
+        void SynetPreprocess::Forward(const uint8_t* src, size_t srcStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, uint8_t* dst)
+        {
+            const PreprocessParam& p = _param;
+            size_t threads = ParallelRowsThreads((p.srcW * p.srcH / p.dstH + p.dstW) * p.channels, p.dstH);
+            if (_buffers.size() < threads)
+                _buffers.resize(threads);
+            if (threads < 2)
+            {
+                Run(_buffers[0], src, srcStride, u, uStride, v, vStride, 0, p.dstH, dst);
+                return;
+            }
+            Simd::Parallel(0, p.dstH, [&](size_t thread, size_t begin, size_t end)
+            {
+                bool& nested = ParallelRowsNested();
+                nested = true;
+                Run(_buffers[thread], src, srcStride, u, uStride, v, vStride, begin, end, dst);
+                nested = false;
+            }, threads, 1);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetPreprocessInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels,
+            SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat)
+        {
+            PreprocessParam param(srcW, srcH, srcFormat, yuvType, dstW, dstH, channels, method, lower, upper, dstType, dstFormat);
+            if (!param.Valid())
+                return NULL;
+            return new SynetPreprocess(param);
+        }
+    }
+#endif
+}
@@ -22,7 +22,9 @@
 * SOFTWARE.
 */
 #include "Simd/SimdMath.h"
+#include "Simd/SimdMemory.h"
 #include "Simd/SimdBase.h"
+#include "Simd/SimdParallel.hpp"
 
 #include <thread>
 
@@ -34,12 +36,66 @@ namespace Simd
 
         size_t GetThreadNumber()
         {
+#ifndef SIMD_FUTURE_DISABLE
+            Simd::ThreadPool * pool = Simd::ThreadPool::Bound();
+            if (pool)
+                return pool->Size() + 1;
+#endif
             return g_threadNumber;
         }
 
         void SetThreadNumber(size_t threadNumber)
         {
             g_threadNumber = Simd::RestrictRange<size_t>(threadNumber, 1, std::thread::hardware_concurrency());
+#ifndef SIMD_FUTURE_DISABLE
+            Simd::ThreadPool::Global().Resize(g_threadNumber - 1);
+#endif
+        }
+
+        bool SetThreadAffinity(const size_t * cpus, size_t count)
+        {
+#ifndef SIMD_FUTURE_DISABLE
+            return Simd::ThreadPool::Global().SetAffinity(std::vector<size_t>(cpus, cpus + count));
+#else
+            return false;
+#endif
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+#ifndef SIMD_FUTURE_DISABLE
+        struct ThreadPoolContext : public Deletable
+        {
+            Simd::ThreadPool pool;
+
+            ThreadPoolContext(size_t threadNumber, const size_t * cpus, size_t count)
+            {
+                pool.SetAffinity(std::vector<size_t>(cpus, cpus + count));
+                pool.Resize(Simd::RestrictRange<size_t>(threadNumber, 1, std::thread::hardware_concurrency()) - 1);
+            }
+
+            virtual ~ThreadPoolContext()
+            {
+                if (Simd::ThreadPool::Bound() == &pool)
+                    Simd::ThreadPool::Bind(NULL);
+            }
+        };
+#endif
+
+        void * ThreadPoolInit(size_t threadNumber, const size_t * cpus, size_t count)
+        {
+#ifndef SIMD_FUTURE_DISABLE
+            return new ThreadPoolContext(threadNumber, cpus, count);
+#else
+            return NULL;
+#endif
+        }
+
+        void ThreadPoolBind(void * pool)
+        {
+#ifndef SIMD_FUTURE_DISABLE
+            Simd::ThreadPool::Bind(pool ? &((ThreadPoolContext*)pool)->pool : NULL);
+#endif
         }
     }
 }
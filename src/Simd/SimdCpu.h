@@ -52,6 +52,7 @@ namespace Simd
 
             // In ECX:
             SSE3 = 1 << 0,
+            PCLMULQDQ = 1 << 1,
             SSSE3 = 1 << 9,
             FMA = 1 << 12,
             SSE41 = 1 << 19,
@@ -73,6 +74,7 @@ namespace Simd
 
             // In ECX:
             AVX512_VBMI = 1 << 1,
+            VPCLMULQDQ = 1 << 10,
             AVX512_VNNI = 1 << 11,
 
             // In EDX:
@@ -26,14 +26,57 @@
 
 #include "Simd/SimdDefs.h"
 
+#include <atomic>
+
 namespace Simd
 {
+    const std::atomic<bool> & IsaEnable(SimdIsaType isa);
+
+    uint32_t GetIsaMask();
+
+    void SetIsaMask(uint32_t mask);
+
+    class IsaDispatchBase
+    {
+    public:
+        virtual void Resolve() = 0;
+
+    protected:
+        void Register();
+    };
+
+    template<class Ptr> class IsaDispatch : public IsaDispatchBase
+    {
+    public:
+        typedef Ptr(*Resolver)();
+
+        IsaDispatch(Resolver resolver)
+            : _resolver(resolver)
+        {
+            Register();
+        }
+
+        virtual void Resolve()
+        {
+            _ptr.store(_resolver(), std::memory_order_release);
+        }
+
+        SIMD_INLINE operator Ptr() const
+        {
+            return _ptr.load(std::memory_order_acquire);
+        }
+
+    private:
+        Resolver _resolver;
+        std::atomic<Ptr> _ptr;
+    };
+
 #ifdef SIMD_SSE41_ENABLE
     namespace Sse41
     {
         bool GetEnable();
 
-        const bool Enable = GetEnable();
+        static const std::atomic<bool> & Enable = IsaEnable(SimdIsaSse41);
     }
 #endif
 
@@ -42,7 +85,7 @@ namespace Simd
     {
         bool GetEnable();
 
-        const bool Enable = GetEnable();
+        static const std::atomic<bool> & Enable = IsaEnable(SimdIsaAvx2);
 
         bool GetSlowGather();
 
@@ -55,7 +98,7 @@ namespace Simd
     {
         bool GetEnable();
 
-        const bool Enable = GetEnable();
+        static const std::atomic<bool> & Enable = IsaEnable(SimdIsaAvx512bw);
     }
 #endif
 
@@ -64,7 +107,7 @@ namespace Simd
     {
         bool GetEnable();
 
-        const bool Enable = GetEnable();
+        static const std::atomic<bool> & Enable = IsaEnable(SimdIsaAvx512vnni);
     }
 #endif
 
@@ -73,7 +116,7 @@ namespace Simd
     {
         bool GetEnable();
 
-        const bool Enable = GetEnable();
+        static const std::atomic<bool> & Enable = IsaEnable(SimdIsaAmxBf16);
     }
 #endif
 
@@ -82,7 +125,7 @@ namespace Simd
     {
         bool GetEnable();
 
-        const bool Enable = GetEnable();
+        static const std::atomic<bool> & Enable = IsaEnable(SimdIsaNeon);
     }
 #endif
 }
@@ -136,4 +179,6 @@ namespace Simd
 #define SIMD_FUNC8(func, EXT1, EXT2, EXT3, EXT4, EXT5, EXT6, EXT7, EXT8) EXT1(func) EXT2(func) EXT3(func) EXT4(func) EXT5(func) EXT6(func) EXT7(func) EXT8(func) SIMD_BASE_FUNC(func)
 #define SIMD_FUNC9(func, EXT1, EXT2, EXT3, EXT4, EXT5, EXT6, EXT7, EXT8, EXT9) EXT1(func) EXT2(func) EXT3(func) EXT4(func) EXT5(func) EXT6(func) EXT7(func) EXT8(func) EXT9(func) SIMD_BASE_FUNC(func)
 
+#define SIMD_DISPATCH(Ptr, name, funcs) const static Simd::IsaDispatch<Ptr> name([]() -> Ptr { return funcs; })
+
 #endif//__SimdEnable_h__
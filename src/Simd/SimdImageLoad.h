@@ -74,6 +74,8 @@ namespace Simd
 
         virtual bool FromStream() = 0;
 
+        virtual bool Probe(SimdImageInfo& info) = 0;
+
         SIMD_INLINE uint8_t* Release(size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format)
         {
             *stride = _image.stride;
@@ -82,6 +84,20 @@ namespace Simd
             *format = (SimdPixelFormatType)_image.format;
             return _image.Release();
         }
+
+    protected:
+        SIMD_INLINE void InitInfo(SimdImageInfo& info, size_t width, size_t height, size_t channels) const
+        {
+            info.file = _param.file;
+            info.width = width;
+            info.height = height;
+            info.channels = channels;
+            info.depth = 8;
+            info.progressive = SimdFalse;
+            info.subsamplingX = 1;
+            info.subsamplingY = 1;
+            info.format = _param.format;
+        }
     };
 
     namespace Base
@@ -91,6 +107,8 @@ namespace Simd
         public:
             ImagePxmLoader(const ImageLoaderParam& param);
 
+            virtual bool Probe(SimdImageInfo& info);
+
         protected:
             typedef void (*ToAnyPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride);
             typedef void (*ToBgraPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* bgra, size_t bgraStride, uint8_t alpha);
@@ -99,6 +117,7 @@ namespace Simd
             Array8u _buffer;
             size_t _block, _size;
 
+            bool ReadSize(size_t version, uint32_t& width, uint32_t& height);
             bool ReadHeader(size_t version);
             virtual void SetConverters() = 0;
         };
@@ -154,15 +173,21 @@ namespace Simd
 
             virtual bool FromStream();
 
+            virtual bool Probe(SimdImageInfo& info);
+
             typedef void (*DecodeLinePtr)(const uint8_t* curr, const uint8_t* prev, int width, int srcN, int dstN, uint8_t* dst);
             typedef void (*ExpandPalettePtr)(const uint8_t* src, size_t size, int outN, const uint8_t* palette, uint8_t* dst);
             typedef void (*ConverterPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride);
+            typedef bool (*ZlibDecodePtr)(InputMemoryStream& is, OutputMemoryStream& os, bool parseHeader);
+            typedef uint32_t (*Crc32Ptr)(const void* src, size_t size);
 
         protected:
 
             DecodeLinePtr _decodeLine[7];
             ExpandPalettePtr _expandPalette;
             ConverterPtr _converter;
+            ZlibDecodePtr _zlibDecode;
+            Crc32Ptr _crc32;
             virtual void SetConverter();
 
         private:
@@ -181,7 +206,7 @@ namespace Simd
             typedef std::vector<Chunk> Chunks;
             Chunks _idats;
 
-            bool ParseFile();
+            bool ParseFile(bool probe = false);
             bool CheckHeader();
             bool ReadChunk(Chunk& chunk);
             bool ReadHeader(const Chunk & chunk);
@@ -204,6 +229,8 @@ namespace Simd
 
             virtual bool FromStream();
 
+            virtual bool Probe(SimdImageInfo& info);
+
         protected:
             struct JpegContext* _context;
         };
@@ -211,6 +238,8 @@ namespace Simd
         //---------------------------------------------------------------------
 
         uint8_t* ImageLoadFromMemory(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format);
+
+        bool ImageProbeFromMemory(const uint8_t* data, size_t size, SimdImageInfo* info);
     }
 
 #ifdef SIMD_SSE41_ENABLE    
@@ -311,12 +340,16 @@ namespace Simd
             virtual void SetConverters();
         };
 
+        class ImagePngLoader : public Sse41::ImagePngLoader
+        {
+        public:
+            ImagePngLoader(const ImageLoaderParam& param);
+        };
+
         class ImageJpegLoader : public Sse41::ImageJpegLoader
         {
         public:
             ImageJpegLoader(const ImageLoaderParam& param);
-
-            virtual bool FromStream();
         };
 
         //---------------------------------------------------------------------
@@ -364,6 +397,18 @@ namespace Simd
             virtual void SetConverters();
         };
 
+        class ImagePngLoader : public Avx2::ImagePngLoader
+        {
+        public:
+            ImagePngLoader(const ImageLoaderParam& param);
+        };
+
+        class ImageJpegLoader : public Avx2::ImageJpegLoader
+        {
+        public:
+            ImageJpegLoader(const ImageLoaderParam& param);
+        };
+
         //---------------------------------------------------------------------
 
         uint8_t* ImageLoadFromMemory(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format);
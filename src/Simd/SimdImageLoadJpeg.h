@@ -39,8 +39,14 @@ namespace Simd
         const int JpegMarkerSos = 0xDA;
         const int JpegMarkerDnl = 0xDC;
 
+        const int JpegScanLoad = 0;
+        const int JpegScanType = 1;
+        const int JpegScanHeader = 2;
+
         extern const uint8_t JpegDeZigZag[80];
 
+        extern const float JpegIdct4x4K[16];
+
         //-------------------------------------------------------------------------------------------------
 
         struct JpegHuffman
@@ -69,7 +75,7 @@ namespace Simd
             int x, y, w2, h2;
             Array8u bufD, bufL;
             uint8_t* data;
-            Array16i bufC;
+            Array16i bufC, bufR;
             short* coeff;
             int coeffW, coeffH;
         };
@@ -82,9 +88,12 @@ namespace Simd
         typedef void (*YuvToBgrPtr)(const uint8_t* y, size_t yStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, size_t width, size_t height, uint8_t* bgr, size_t bgrStride, SimdYuvType yuvType);
         typedef void (*YuvToBgraPtr)(const uint8_t* y, size_t yStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, size_t width, size_t height, uint8_t* bgr, size_t bgrStride, uint8_t alpha, SimdYuvType yuvType);
         typedef void (*AnyToAnyPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride);
+        typedef void (*InterleaveUvPtr)(const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, size_t width, size_t height, uint8_t* uv, size_t uvStride);
 
         //-------------------------------------------------------------------------------------------------
 
+        struct JpegWorker;
+
         struct JpegContext
         {
             InputMemoryStream* stream;
@@ -120,21 +129,43 @@ namespace Simd
 
             Array8u out;
 
-            IdctBlockPtr idctBlock;
+            int scale;
+
+            IdctBlockPtr idctBlock, idctBlock4x4, idctBlock2x2, idctBlock1x1;
             ResampleRowPtr resampleRowHv2;
             YuvToRgbRowPtr yuvToRgbRow;
 
             YuvToBgrPtr yuv444pToBgr, yuv420pToBgr;
             YuvToBgraPtr yuv444pToBgra, yuv420pToBgra;
             AnyToAnyPtr rgbaToAny;
+            InterleaveUvPtr interleaveUv;
+
+            std::vector<JpegWorker*> workers;
 
             JpegContext(InputMemoryStream* s);
+            ~JpegContext();
             void Reset();
 
             SIMD_INLINE bool NeedRestart() const
             {
                 return marker >= 0xd0 && marker <= 0xd7;
             }
+
+            SIMD_INLINE int BlockSize() const
+            {
+                return 8 >> scale;
+            }
+
+            SIMD_INLINE IdctBlockPtr IdctBlock() const
+            {
+                switch (scale)
+                {
+                case 1: return idctBlock4x4;
+                case 2: return idctBlock2x2;
+                case 3: return idctBlock1x1;
+                default: return idctBlock;
+                }
+            }
         };
 
         //-------------------------------------------------------------------------------------------------
@@ -164,23 +195,79 @@ namespace Simd
             std::cout << "JPEG load error: " << text << ", " << type << "!" << std::endl;
             return 0;
         }
+
+        //-------------------------------------------------------------------------------------------------
+
+        int JpegDecodeHeader(JpegContext* context);
+
+        int JpegProbeHeader(JpegContext* context);
+
+        int JpegDecodeData(JpegContext* context);
+
+        bool JpegConvert(JpegContext* context, SimdPixelFormatType format, uint8_t* dst, size_t stride);
+
+        bool JpegCopyYuv420p(JpegContext* context, uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride);
+
+        bool JpegCopyNv12(JpegContext* context, uint8_t* y, size_t yStride, uint8_t* uv, size_t uvStride);
+
+        typedef void (*JpegSetConvertersPtr)(JpegContext* context, SimdPixelFormatType format);
+
+        void JpegSetConverters(JpegContext* context, SimdPixelFormatType format);
+
+        //-------------------------------------------------------------------------------------------------
+
+        class JpegDecoder : public Deletable
+        {
+        public:
+            JpegDecoder(JpegSetConvertersPtr setConverters);
+
+            bool SetScale(size_t denominator);
+
+            bool Parse(const uint8_t* data, size_t size, size_t* width, size_t* height);
+
+            bool Decode(uint8_t* dst, size_t stride, SimdPixelFormatType format);
+
+            bool DecodeYuv420p(uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride);
+
+            bool DecodeNv12(uint8_t* y, size_t yStride, uint8_t* uv, size_t uvStride);
+
+        protected:
+            bool DecodeData(SimdPixelFormatType format);
+
+            InputMemoryStream _stream;
+            JpegContext _context;
+            JpegSetConvertersPtr _setConverters;
+            bool _parsed;
+            int _scale;
+        };
+
+        void* JpegDecoderInit();
     }
 
 #ifdef SIMD_SSE41_ENABLE    
     namespace Sse41
     {
+        void JpegSetConverters(Base::JpegContext* context, SimdPixelFormatType format);
+
+        void* JpegDecoderInit();
     }
 #endif
 
 #ifdef SIMD_AVX2_ENABLE    
     namespace Avx2
     {
+        void JpegSetConverters(Base::JpegContext* context, SimdPixelFormatType format);
+
+        void* JpegDecoderInit();
     }
 #endif
 
 #ifdef SIMD_AVX512BW_ENABLE    
     namespace Avx512bw
     {
+        void JpegSetConverters(Base::JpegContext* context, SimdPixelFormatType format);
+
+        void* JpegDecoderInit();
     }
 #endif
 
@@ -25,6 +25,8 @@
 #define __SimdImageLoadPng_h__
 
 #include "Simd/SimdImageLoad.h"
+#include "Simd/SimdImageSavePng.h"
+#include "Simd/SimdPerformance.h"
 
 namespace Simd
 {
@@ -40,23 +42,224 @@ namespace Simd
         {
             return PngLoadError(text, "Corrupt PNG");
         }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SIMD_INLINE int ZlibBitRev16(int n)
+        {
+            n = ((n & 0xAAAA) >> 1) | ((n & 0x5555) << 1);
+            n = ((n & 0xCCCC) >> 2) | ((n & 0x3333) << 2);
+            n = ((n & 0xF0F0) >> 4) | ((n & 0x0F0F) << 4);
+            n = ((n & 0xFF00) >> 8) | ((n & 0x00FF) << 8);
+            return n;
+        }
+
+        const size_t ZLIB_FAST_BITS = 11;
+        const size_t ZLIB_FAST_SIZE = 1 << ZLIB_FAST_BITS;
+        const size_t ZLIB_FAST_MASK = ZLIB_FAST_SIZE - 1;
+        const size_t ZLIB_COPY_MARGIN = 64;
+        const size_t ZLIB_CODE_BITS = 15;
+        const size_t ZLIB_MATCH_BITS = 5 + 15 + 13;
+
+        const uint32_t ZLIB_TYPE_ONE = 1;
+        const uint32_t ZLIB_TYPE_TWO = 2;
+        const uint32_t ZLIB_TYPE_SYM = 3;
+
+        // Entry of the fast table: bits [0..7] - code size, bits [8..9] - entry type (0 - error, 1 - one literal, 
+        // 2 - two literals, 3 - symbol), bits [16..31] - literal(s) or symbol value.
+        struct ZlibHuffman
+        {
+            uint32_t fast[ZLIB_FAST_SIZE];
+            uint16_t firstCode[16];
+            int maxCode[17];
+            uint16_t firstSymbol[16];
+            uint8_t  size[288];
+            uint16_t value[288];
+            uint32_t literal;
+
+            bool Build(const uint8_t* sizes, int num, bool literals);
+
+            SIMD_INLINE uint32_t Decode(uint64_t bits) const
+            {
+                uint32_t entry = fast[bits & ZLIB_FAST_MASK];
+                if (entry)
+                    return entry;
+                int k = ZlibBitRev16(int(bits & 0xFFFF)), s = ZLIB_FAST_BITS + 1;
+                while (k >= maxCode[s])
+                    s++;
+                if (s >= 16)
+                    return 0;
+                int b = (k >> (16 - s)) - firstCode[s] + firstSymbol[s];
+                if (b >= 288 || size[b] != s)
+                    return 0;
+                uint32_t v = value[b];
+                return s | ((v < literal ? ZLIB_TYPE_ONE : ZLIB_TYPE_SYM) << 8) | (v << 16);
+            }
+        };
+
+        struct ZlibBits
+        {
+            const uint8_t* src, * end;
+            uint64_t buf;
+            size_t cnt, over;
+
+            SIMD_INLINE ZlibBits(const InputMemoryStream& is)
+            {
+                cnt = is.BitCount();
+                src = is.Current() - cnt / 8;
+                end = is.Data() + is.Size();
+                cnt = cnt & 7;
+                buf = uint64_t(is.BitBuffer()) & ((uint64_t(1) << cnt) - 1);
+                over = 0;
+            }
+
+            SIMD_INLINE bool Refill()
+            {
+                if (src + 8 <= end)
+                {
+                    buf |= *(uint64_t*)src << cnt;
+                    src += (63 - cnt) >> 3;
+                    cnt |= 56;
+                    return true;
+                }
+                for (; cnt <= 56; cnt += 8)
+                {
+                    if (src < end)
+                        buf |= uint64_t(*src++) << cnt;
+                    else
+                        over++;
+                }
+                return cnt >= over * 8;
+            }
+
+            SIMD_INLINE void Skip(size_t count)
+            {
+                buf >>= count;
+                cnt -= count;
+            }
+
+            SIMD_INLINE size_t Get(size_t count)
+            {
+                size_t bits = size_t(buf & ((uint64_t(1) << count) - 1));
+                buf >>= count;
+                cnt -= count;
+                return bits;
+            }
+
+            SIMD_INLINE bool Store(InputMemoryStream& is) const
+            {
+                if (cnt < over * 8)
+                    return false;
+                size_t valid = cnt - over * 8;
+                is.Seek(src - valid / 8 - is.Data());
+                is.BitCount() = valid & 7;
+                is.BitBuffer() = size_t(buf & ((uint64_t(1) << is.BitCount()) - 1));
+                return true;
+            }
+        };
+
+        extern const uint8_t ZlibPattern[16][64];
+
+        SIMD_INLINE void ZlibReserve(OutputMemoryStream& os, uint8_t*& beg, uint8_t*& dst, uint8_t*& end, size_t size)
+        {
+            if (dst + size > end)
+            {
+                size_t pos = dst - beg;
+                os.Seek(pos);
+                os.Reserve(pos + size);
+                beg = os.Data();
+                dst = beg + pos;
+                end = beg + os.Capacity();
+            }
+        }
+
+        typedef void (*ZlibCopyPtr)(uint8_t* dst, size_t dist, size_t len);
+
+        template<ZlibCopyPtr copy> int ZlibParseHuffmanBlock(InputMemoryStream& is, const ZlibHuffman& zLength, const ZlibHuffman& zDistance, OutputMemoryStream& os)
+        {
+            SIMD_PERF_FUNC();
+
+            uint8_t* beg = os.Data(), * dst = os.Current(), * end = beg + os.Capacity();
+            ZlibBits bits(is);
+            for (;;)
+            {
+                if (bits.cnt < ZLIB_CODE_BITS && !bits.Refill())
+                    return CorruptPngError("unexpected end of data");
+                uint32_t entry = zLength.Decode(bits.buf), type = entry >> 8 & 3;
+                if (type == 0)
+                    return CorruptPngError("bad huffman code");
+                bits.Skip(entry & 0xFF);
+                if (type != ZLIB_TYPE_SYM)
+                {
+                    if (dst + 2 <= end)
+                        *(uint16_t*)dst = uint16_t(entry >> 16);
+                    else
+                    {
+                        ZlibReserve(os, beg, dst, end, type);
+                        for (uint32_t i = 0; i < type; ++i)
+                            dst[i] = uint8_t(entry >> (16 + 8 * i));
+                    }
+                    dst += type;
+                    continue;
+                }
+                size_t sym = entry >> 16;
+                if (sym == 256)
+                    break;
+                if ((sym -= 257) >= 29)
+                    return CorruptPngError("bad huffman code");
+                if (bits.cnt < ZLIB_MATCH_BITS && !bits.Refill())
+                    return CorruptPngError("unexpected end of data");
+                size_t len = ZlibLenC[sym] + bits.Get(ZlibLenEb[sym]);
+                entry = zDistance.Decode(bits.buf);
+                if (entry == 0 || (sym = entry >> 16) >= 30)
+                    return CorruptPngError("bad huffman code");
+                bits.Skip(entry & 0xFF);
+                size_t dist = ZlibDistC[sym] + bits.Get(ZlibDistEb[sym]);
+                if (size_t(dst - beg) < dist)
+                    return CorruptPngError("bad dist");
+                if (dst + len + ZLIB_COPY_MARGIN <= end)
+                    copy(dst, dist, len);
+                else
+                {
+                    ZlibReserve(os, beg, dst, end, len);
+                    for (size_t i = 0; i < len; ++i)
+                        dst[i] = dst[i - dist];
+                }
+                dst += len;
+            }
+            os.Seek(dst - beg);
+            if (!bits.Store(is))
+                return CorruptPngError("unexpected end of data");
+            return 1;
+        }
+
+        typedef int (*ZlibParseBlockPtr)(InputMemoryStream& is, const ZlibHuffman& zLength, const ZlibHuffman& zDistance, OutputMemoryStream& os);
+
+        typedef uint32_t (*ZlibAdler32Ptr)(const uint8_t* data, int size);
+
+        bool ZlibDecode(InputMemoryStream& is, OutputMemoryStream& os, bool parseHeader, ZlibParseBlockPtr parseBlock, ZlibAdler32Ptr adler32);
+
+        bool ZlibDecode(InputMemoryStream& is, OutputMemoryStream& os, bool parseHeader);
     }
 
 #ifdef SIMD_SSE41_ENABLE    
     namespace Sse41
     {
+        bool ZlibDecode(InputMemoryStream& is, OutputMemoryStream& os, bool parseHeader);
     }
 #endif
 
 #ifdef SIMD_AVX2_ENABLE    
     namespace Avx2
     {
+        bool ZlibDecode(InputMemoryStream& is, OutputMemoryStream& os, bool parseHeader);
     }
 #endif
 
 #ifdef SIMD_AVX512BW_ENABLE    
     namespace Avx512bw
     {
+        bool ZlibDecode(InputMemoryStream& is, OutputMemoryStream& os, bool parseHeader);
     }
 #endif
 
@@ -28,6 +28,8 @@
 #include "Simd/SimdArray.h"
 #include "Simd/SimdPerformance.h"
 
+#include <vector>
+
 namespace Simd
 {
     typedef uint8_t* (*ImageSaveToMemoryPtr)(const uint8_t* src, size_t stride, size_t width, size_t height, SimdPixelFormatType format, SimdImageFileType file, int quality, size_t* size);
@@ -168,29 +170,52 @@ namespace Simd
         {
         public:
             ImagePngSaver(const ImageSaverParam& param);
+            virtual ~ImagePngSaver();
 
             virtual bool ToStream(const uint8_t* src, size_t stride);
         protected:
             static const int COMPRESSION = 8;
+            static const int LEVEL_STORED = -1, LEVEL_HUFFMAN = -2, LEVEL_RLE = -3;
             static const int FILTERS = 5;
             static const int TYPES = 7;
             typedef void (*ConvertPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride);
             typedef uint32_t (*EncodePtr)(const uint8_t* src, size_t stride, size_t n, size_t size, int8_t* dst);
-            typedef void (*CompressPtr)(uint8_t* data, int size, int quality, OutputMemoryStream& stream);
+            typedef uint32_t (*Adler32Ptr)(const uint8_t* data, int size);
+            typedef uint32_t (*Crc32Ptr)(const void* src, size_t size);
+            typedef void (*DeflatePtr)(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream);
             ConvertPtr _convert;
             EncodePtr _encode[TYPES];
-            CompressPtr _compress;
-            size_t _channels, _size;
+            Adler32Ptr _adler32;
+            Crc32Ptr _crc32;
+            DeflatePtr _deflate, _deflateRle;
+            size_t _channels, _size, _chunkRows;
             Array8u _filt, _buff;
             Array8i _line;
 
+            struct Chunk
+            {
+                OutputMemoryStream stream;
+                uint32_t adler;
+            };
+            std::vector<Chunk*> _chunks;
+
+            void InitChunks();
+            void EncodeRows(const uint8_t* src, size_t stride, size_t begin, size_t end, int8_t* line);
             void WriteToStream(const uint8_t* zlib, size_t zlen);
         };
 
+        // Test hook: if non-zero it sets number of JPEG restart interval strips regardless of image size and thread number.
+        SIMD_INLINE size_t & ImageJpegSaverStrips()
+        {
+            thread_local size_t strips = 0;
+            return strips;
+        }
+
         class ImageJpegSaver : public ImageSaver
         {
         public:
             ImageJpegSaver(const ImageSaverParam& param);
+            virtual ~ImageJpegSaver();
 
             virtual bool ToStream(const uint8_t* src, size_t stride);
 
@@ -216,14 +241,27 @@ namespace Simd
             WriteNv12BlockPtr _writeNv12Block;
             WriteYuv420pBlockPtr _writeYuv420pBlock;
             bool _subSample;
-            int _quality, _block, _width;
+            int _quality, _block, _width, _stripRows;
             float _fY[64], _fUv[64];
             uint8_t _uY[64], _uUv[64];
 
+            struct Strip
+            {
+                OutputMemoryStream stream;
+                Array8u buffer;
+            };
+            std::vector<Strip*> _strips;
+
             virtual void Init();
 
             void InitParams(bool trans);
+            void InitStrips();
             void WriteHeader();
+            template<class Rows> void WriteData(const Rows& rows);
+
+            void WriteRows(OutputMemoryStream& stream, uint8_t* buffer, const uint8_t* src, size_t stride, int begin, int end);
+            void WriteRows(OutputMemoryStream& stream, const uint8_t* y, size_t yStride, const uint8_t* uv, size_t uvStride, int begin, int end);
+            void WriteRows(OutputMemoryStream& stream, const uint8_t* y, size_t yStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, int begin, int end);
         };
 
         //---------------------------------------------------------------------
@@ -37,6 +37,7 @@ namespace Simd
         extern const uint8_t  ZlibLenEb[29];
         extern const uint16_t ZlibDistC[31];
         extern const uint8_t  ZlibDistEb[30];
+        extern const uint8_t  ZlibLenSym[259];
 
 #if defined(SIMD_PNG_ZLIB_BIT_REV_TABLE)
         const int ZlibBitRevShift = 9;
@@ -138,6 +139,73 @@ namespace Simd
             return i;
         }
 
+        typedef size_t (*ZlibTokenizePtr)(const uint8_t* data, int begin, int end, uint16_t* tokens, uint32_t* hist);
+
+        void ZlibDeflateDynamic(const uint8_t* data, int begin, int end, bool last, ZlibTokenizePtr tokenize, OutputMemoryStream& stream);
+
+        template<int (*Count)(const uint8_t* a, const uint8_t* b, int limit)> size_t ZlibTokenizeRle(const uint8_t* data, int begin, int end, uint16_t* tokens, uint32_t* hist)
+        {
+            size_t size = 0;
+            int i = begin;
+            if (i == 0 && i < end)
+            {
+                hist[data[i]]++;
+                tokens[size++] = data[i++];
+            }
+            while (i < end)
+            {
+                int run = 0;
+                if (i + 3 <= end && data[i] == data[i - 1])
+                    run = Count(data + i - 1, data + i, end - i);
+                if (run >= 3)
+                {
+                    hist[257 + ZlibLenSym[run]]++;
+                    tokens[size++] = uint16_t(256 + run);
+                    i += run;
+                }
+                else
+                {
+                    hist[data[i]]++;
+                    tokens[size++] = data[i++];
+                }
+            }
+            return size;
+        }
+
+        SIMD_INLINE void ZlibPrime(int* hashTable, int basket, int quality, const uint8_t* data, int begin)
+        {
+            const int ZHASH = 16384;
+            for (int i = Max(begin - 32768, 0); i < begin; ++i)
+            {
+                int* hList = hashTable + (ZlibHash(data + i) & (ZHASH - 1)) * basket, j = 0;
+                while (j < basket && hList[j] != -1)
+                    ++j;
+                if (j == basket)
+                {
+                    memcpy(hList, hList + quality, quality * sizeof(int));
+                    memset(hList + quality, -1, quality * sizeof(int));
+                    j = quality;
+                }
+                hList[j] = i;
+            }
+        }
+
+        uint32_t ZlibAdler32(const uint8_t* data, int size);
+
+        SIMD_INLINE uint32_t ZlibAdler32Combine(uint32_t adler1, uint32_t adler2, size_t size2)
+        {
+            const uint32_t BASE = 65521;
+            uint32_t rem = uint32_t(size2 % BASE);
+            uint32_t lo = adler1 & 0xFFFF, hi = uint32_t(uint64_t(rem) * lo % BASE);
+            lo += (adler2 & 0xFFFF) + BASE - 1;
+            hi += (adler1 >> 16) + (adler2 >> 16) + BASE - rem;
+            if (lo >= BASE) lo -= BASE;
+            if (lo >= BASE) lo -= BASE;
+            if (hi >= BASE * 2) hi -= BASE * 2;
+            if (hi >= BASE) hi -= BASE;
+            return (hi << 16) | lo;
+        }
+
         SIMD_INLINE uint8_t Paeth(int a, int b, int c)
         {
             int p = a + b - c, pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
@@ -152,6 +220,8 @@ namespace Simd
 #ifdef SIMD_SSE41_ENABLE    
     namespace Sse41
     {
+        uint32_t ZlibAdler32(const uint8_t* data, int size);
+
         SIMD_INLINE int ZlibCount(const uint8_t* a, const uint8_t* b, int limit)
         {
             limit = Min(limit, 258);
@@ -182,6 +252,8 @@ namespace Simd
 #ifdef SIMD_AVX2_ENABLE    
     namespace Avx2
     {
+        uint32_t ZlibAdler32(const uint8_t* data, int size);
+
         SIMD_INLINE int ZlibCount(const uint8_t* a, const uint8_t* b, int limit)
         {
             limit = Min(limit, 258);
@@ -205,6 +277,8 @@ namespace Simd
 #ifdef SIMD_AVX512BW_ENABLE    
     namespace Avx512bw
     {
+        uint32_t ZlibAdler32(const uint8_t* data, int size);
+
         SIMD_INLINE int ZlibCount(const uint8_t* a, const uint8_t* b, int limit)
         {
             limit = Min(limit, 258);
@@ -228,6 +302,7 @@ namespace Simd
 #ifdef SIMD_NEON_ENABLE    
     namespace Neon
     {
+        uint32_t ZlibAdler32(const uint8_t* data, int size);
     }
 #endif// SIMD_NEON_ENABLE
 }
@@ -61,11 +61,14 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD dwReasonForCall, LPVOID lpReserved)
 #include "Simd/SimdConst.h"
 #include "Simd/SimdLog.h"
 #include "Simd/SimdPerformance.h"
+#include "Simd/SimdParallelRows.h"
+#include "Simd/SimdRuntime.h"
 #include "Simd/SimdEmpty.h"
 
 #include "Simd/SimdDescrInt.h"
 #include "Simd/SimdGaussianBlur.h"
 #include "Simd/SimdImageLoad.h"
+#include "Simd/SimdImageLoadJpeg.h"
 #include "Simd/SimdImageSave.h"
 #include "Simd/SimdRecursiveBilateralFilter.h"
 #include "Simd/SimdResizer.h"
@@ -82,7 +85,9 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD dwReasonForCall, LPVOID lpReserved)
 #include "Simd/SimdSynetMergedConvolution16b.h"
 #include "Simd/SimdSynetMergedConvolution8i.h"
 #include "Simd/SimdSynetPermute.h"
+#include "Simd/SimdSynetPreprocess.h"
 #include "Simd/SimdSynetScale8i.h"
+#include "Simd/SimdSynetWorkspace.h"
 #include "Simd/SimdWarpAffine.h"
 
 #include "Simd/SimdBase.h"
@@ -97,8 +102,119 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD dwReasonForCall, LPVOID lpReserved)
 #include "Simd/SimdVersion.h"
 #endif
 
+#include <mutex>
+
 namespace Simd
 {
+    class IsaTable
+    {
+        uint32_t _support;
+        std::atomic<uint32_t> _mask;
+        std::atomic<bool> _enable[32];
+        std::mutex _mutex;
+        std::vector<IsaDispatchBase*> _dispatches;
+
+        static uint32_t Support()
+        {
+            uint32_t support = 0;
+#ifdef SIMD_SSE41_ENABLE
+            if (Sse41::GetEnable())
+                support |= SimdIsaSse41;
+#endif
+#ifdef SIMD_AVX2_ENABLE
+            if (Avx2::GetEnable())
+                support |= SimdIsaAvx2;
+#endif
+#ifdef SIMD_AVX512BW_ENABLE
+            if (Avx512bw::GetEnable())
+                support |= SimdIsaAvx512bw;
+#endif
+#if defined(SIMD_AVX512VNNI_ENABLE) && !defined(SIMD_AMX_EMULATE)
+            if (Avx512vnni::GetEnable())
+                support |= SimdIsaAvx512vnni;
+#endif
+#if defined(SIMD_AMXBF16_ENABLE) || (defined(SIMD_AVX512BW_ENABLE) && defined(SIMD_AMX_EMULATE))
+            if (AmxBf16::GetEnable())
+                support |= SimdIsaAmxBf16;
+#endif
+#ifdef SIMD_NEON_ENABLE
+            if (Neon::GetEnable())
+                support |= SimdIsaNeon;
+#endif
+            return support;
+        }
+
+    public:
+        IsaTable()
+            : _support(Support())
+        {
+            Set(SimdIsaAll);
+        }
+
+        uint32_t Get() const
+        {
+            return _mask.load();
+        }
+
+        void Set(uint32_t mask)
+        {
+            mask &= _support;
+            if ((mask & SimdIsaSse41) == 0)
+                mask &= ~SimdIsaAvx2;
+            if ((mask & SimdIsaAvx2) == 0)
+                mask &= ~SimdIsaAvx512bw;
+            if ((mask & SimdIsaAvx512bw) == 0)
+                mask &= ~(SimdIsaAvx512vnni | SimdIsaAmxBf16);
+            std::lock_guard<std::mutex> lock(_mutex);
+            _mask = mask;
+            for (size_t i = 0; i < 32; ++i)
+                _enable[i] = (mask >> i) & 1;
+            for (size_t i = 0; i < _dispatches.size(); ++i)
+                _dispatches[i]->Resolve();
+        }
+
+        void Register(IsaDispatchBase * dispatch)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            dispatch->Resolve();
+            _dispatches.push_back(dispatch);
+        }
+
+        const std::atomic<bool> & Enable(SimdIsaType isa) const
+        {
+            size_t i = 0;
+            while (i < 31 && (uint32_t(isa) >> i) != 1)
+                i++;
+            return _enable[i];
+        }
+
+        static IsaTable & Global()
+        {
+            static IsaTable table;
+            return table;
+        }
+    };
+
+    const std::atomic<bool> & IsaEnable(SimdIsaType isa)
+    {
+        return IsaTable::Global().Enable(isa);
+    }
+
+    void IsaDispatchBase::Register()
+    {
+        IsaTable::Global().Register(this);
+    }
+
+    uint32_t GetIsaMask()
+    {
+        return IsaTable::Global().Get();
+    }
+
+    void SetIsaMask(uint32_t mask)
+    {
+        IsaTable::Global().Set(mask);
+    }
+
     const size_t ALIGNMENT = GetAlignment();
 }
 
@@ -154,6 +270,16 @@ SIMD_API uint64_t SimdCpuInfo(SimdCpuInfoType type)
     }
 }
 
+SIMD_API uint32_t SimdGetIsaMask()
+{
+    return GetIsaMask();
+}
+
+SIMD_API void SimdSetIsaMask(uint32_t mask)
+{
+    SetIsaMask(mask);
+}
+
 SIMD_API const char * SimdPerformanceStatistic()
 {
 #if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
@@ -163,6 +289,36 @@ SIMD_API const char * SimdPerformanceStatistic()
 #endif
 }
 
+SIMD_API size_t SimdPerformanceStatisticItems(SimdPerformanceStatisticItem * items, size_t size, SimdBool threads)
+{
+#if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
+    return Base::PerformanceMeasurerStorage::s_storage.PerformanceStatistic(items, size, threads == SimdTrue);
+#else
+    return 0;
+#endif
+}
+
+SIMD_API const char * SimdPerformanceStatisticJson(SimdBool threads)
+{
+#if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
+    return Base::PerformanceMeasurerStorage::s_storage.PerformanceStatisticJson(threads == SimdTrue);
+#else
+    return "{\"statistics\": []}";
+#endif
+}
+
+SIMD_API void SimdPerformanceStatisticReset()
+{
+#if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
+    Base::PerformanceMeasurerStorage::s_storage.Reset();
+#endif
+}
+
+SIMD_API SimdBool SimdSetRuntimeCache(const char * path, SimdRuntimeCacheModeType mode)
+{
+    return Base::RuntimeCache::Global().Open(path, mode) ? SimdTrue : SimdFalse;
+}
+
 SIMD_API void * SimdAllocate(size_t size, size_t align)
 {
     return Allocate(size, align);
@@ -188,6 +344,16 @@ SIMD_API void SimdRelease(void * context)
     delete (Deletable*)context;
 }
 
+SIMD_API SimdBool SimdSetHugePageMode(SimdHugePageModeType mode, size_t threshold)
+{
+    return Base::SetHugePageMode(mode, threshold) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API size_t SimdHugePageInfo(SimdHugePageInfoType type)
+{
+    return Base::HugePageInfo(type);
+}
+
 SIMD_API size_t SimdGetThreadNumber()
 {
     return Base::GetThreadNumber();
@@ -198,6 +364,21 @@ SIMD_API void SimdSetThreadNumber(size_t threadNumber)
     Base::SetThreadNumber(threadNumber);
 }
 
+SIMD_API SimdBool SimdSetThreadAffinity(const size_t * cpus, size_t count)
+{
+    return Base::SetThreadAffinity(cpus, count) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API void * SimdThreadPoolInit(size_t threadNumber, const size_t * cpus, size_t count)
+{
+    return Base::ThreadPoolInit(threadNumber, cpus, count);
+}
+
+SIMD_API void SimdThreadPoolBind(void * pool)
+{
+    Base::ThreadPoolBind(pool);
+}
+
 SIMD_API SimdBool SimdGetFastMode()
 {
 #ifdef SIMD_SSE41_ENABLE
@@ -235,7 +416,23 @@ SIMD_API void SimdEmpty()
 
 SIMD_API uint32_t SimdCrc32(const void* src, size_t size)
 {
-    return Base::Crc32(src, size);
+    SIMD_EMPTY();
+#ifdef SIMD_AVX512BW_ENABLE
+    if (Avx512bw::Enable)
+        return Avx512bw::Crc32(src, size);
+    else
+#endif
+#ifdef SIMD_AVX2_ENABLE
+    if (Avx2::Enable)
+        return Avx2::Crc32(src, size);
+    else
+#endif
+#ifdef SIMD_SSE41_ENABLE
+    if (Sse41::Enable)
+        return Sse41::Crc32(src, size);
+    else
+#endif
+        return Base::Crc32(src, size);
 }
 
 SIMD_API uint32_t SimdCrc32c(const void * src, size_t size)
@@ -253,6 +450,11 @@ SIMD_API void SimdAbsDifference(const uint8_t *a, size_t aStride, const uint8_t
     size_t width, size_t height)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdAbsDifference(a + begin * aStride, aStride, b + begin * bStride, bStride, c + begin * cStride, cStride, width, end - begin);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::AbsDifference(a, aStride, b, bStride, c, cStride, width, height);
@@ -977,6 +1179,11 @@ SIMD_API void SimdBgraToBayer(const uint8_t * bgra, size_t width, size_t height,
 SIMD_API void SimdBgraToBgr(const uint8_t * bgra, size_t width, size_t height, size_t bgraStride, uint8_t * bgr, size_t bgrStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdBgraToBgr(bgra + begin * bgraStride, width, end - begin, bgraStride, bgr + begin * bgrStride, bgrStride);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::BgraToBgr(bgra, width, height, bgraStride, bgr, bgrStride);
@@ -1003,6 +1210,11 @@ SIMD_API void SimdBgraToBgr(const uint8_t * bgra, size_t width, size_t height, s
 SIMD_API void SimdBgraToGray(const uint8_t *bgra, size_t width, size_t height, size_t bgraStride, uint8_t *gray, size_t grayStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdBgraToGray(bgra + begin * bgraStride, width, end - begin, bgraStride, gray + begin * grayStride, grayStride);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::BgraToGray(bgra, width, height, bgraStride, gray, grayStride);
@@ -1029,6 +1241,11 @@ SIMD_API void SimdBgraToGray(const uint8_t *bgra, size_t width, size_t height, s
 SIMD_API void SimdBgraToRgb(const uint8_t* bgra, size_t width, size_t height, size_t bgraStride, uint8_t* rgb, size_t rgbStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdBgraToRgb(bgra + begin * bgraStride, width, end - begin, bgraStride, rgb + begin * rgbStride, rgbStride);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::BgraToRgb(bgra, width, height, bgraStride, rgb, rgbStride);
@@ -1055,6 +1272,11 @@ SIMD_API void SimdBgraToRgb(const uint8_t* bgra, size_t width, size_t height, si
 SIMD_API void SimdBgraToRgba(const uint8_t* bgra, size_t width, size_t height, size_t bgraStride, uint8_t* rgba, size_t rgbaStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdBgraToRgba(bgra + begin * bgraStride, width, end - begin, bgraStride, rgba + begin * rgbaStride, rgbaStride);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::BgraToRgba(bgra, width, height, bgraStride, rgba, rgbaStride);
@@ -1082,6 +1304,11 @@ SIMD_API void SimdBgraToYuv420pV2(const uint8_t* bgra, size_t bgraStride, size_t
     uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 2, [&](size_t begin, size_t end)
+    {
+        SimdBgraToYuv420pV2(bgra + begin * bgraStride, bgraStride, width, end - begin, y + begin * yStride, yStride, u + begin / 2 * uStride, uStride, v + begin / 2 * vStride, vStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::BgraToYuv420pV2(bgra, bgraStride, width, height, y, yStride, u, uStride, v, vStride, yuvType);
@@ -1109,6 +1336,11 @@ SIMD_API void SimdBgraToYuv422pV2(const uint8_t* bgra, size_t bgraStride, size_t
     uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdBgraToYuv422pV2(bgra + begin * bgraStride, bgraStride, width, end - begin, y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::BgraToYuv422pV2(bgra, bgraStride, width, height, y, yStride, u, uStride, v, vStride, yuvType);
@@ -1136,6 +1368,11 @@ SIMD_API void SimdBgraToYuv444pV2(const uint8_t* bgra, size_t bgraStride, size_t
     uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdBgraToYuv444pV2(bgra + begin * bgraStride, bgraStride, width, end - begin, y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::BgraToYuv444pV2(bgra, bgraStride, width, height, y, yStride, u, uStride, v, vStride, yuvType);
@@ -1163,6 +1400,11 @@ SIMD_API void SimdBgraToYuva420pV2(const uint8_t* bgra, size_t bgraStride, size_
     uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride, uint8_t* a, size_t aStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 2, [&](size_t begin, size_t end)
+    {
+        SimdBgraToYuva420pV2(bgra + begin * bgraStride, bgraStride, width, end - begin, y + begin * yStride, yStride, u + begin / 2 * uStride, uStride, v + begin / 2 * vStride, vStride, a + begin * aStride, aStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::BgraToYuva420pV2(bgra, bgraStride, width, height, y, yStride, u, uStride, v, vStride, a, aStride, yuvType);
@@ -1210,6 +1452,11 @@ SIMD_API void SimdBgrToBayer(const uint8_t * bgr, size_t width, size_t height, s
 SIMD_API void SimdBgrToBgra(const uint8_t *bgr, size_t width, size_t height, size_t bgrStride, uint8_t *bgra, size_t bgraStride, uint8_t alpha)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdBgrToBgra(bgr + begin * bgrStride, width, end - begin, bgrStride, bgra + begin * bgraStride, bgraStride, alpha);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::BgrToBgra(bgr, width, height, bgrStride, bgra, bgraStride, alpha);
@@ -1237,6 +1484,11 @@ SIMD_API void SimdBgr48pToBgra32(const uint8_t * blue, size_t blueStride, size_t
     const uint8_t * green, size_t greenStride, const uint8_t * red, size_t redStride, uint8_t * bgra, size_t bgraStride, uint8_t alpha)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdBgr48pToBgra32(blue + begin * blueStride, blueStride, width, end - begin, green + begin * greenStride, greenStride, red + begin * redStride, redStride, bgra + begin * bgraStride, bgraStride, alpha);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Bgr48pToBgra32(blue, blueStride, width, height, green, greenStride, red, redStride, bgra, bgraStride, alpha);
@@ -1263,6 +1515,11 @@ SIMD_API void SimdBgr48pToBgra32(const uint8_t * blue, size_t blueStride, size_t
 SIMD_API void SimdBgrToGray(const uint8_t *bgr, size_t width, size_t height, size_t bgrStride, uint8_t *gray, size_t grayStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdBgrToGray(bgr + begin * bgrStride, width, end - begin, bgrStride, gray + begin * grayStride, grayStride);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::BgrToGray(bgr, width, height, bgrStride, gray, grayStride);
@@ -1289,18 +1546,33 @@ SIMD_API void SimdBgrToGray(const uint8_t *bgr, size_t width, size_t height, siz
 SIMD_API void SimdBgrToHsl(const uint8_t * bgr, size_t width, size_t height, size_t bgrStride, uint8_t * hsl, size_t hslStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdBgrToHsl(bgr + begin * bgrStride, width, end - begin, bgrStride, hsl + begin * hslStride, hslStride);
+    }))
+        return;
     Base::BgrToHsl(bgr, width, height, bgrStride, hsl, hslStride);
 }
 
 SIMD_API void SimdBgrToHsv(const uint8_t * bgr, size_t width, size_t height, size_t bgrStride, uint8_t * hsv, size_t hsvStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdBgrToHsv(bgr + begin * bgrStride, width, end - begin, bgrStride, hsv + begin * hsvStride, hsvStride);
+    }))
+        return;
     Base::BgrToHsv(bgr, width, height, bgrStride, hsv, hsvStride);
 }
 
 SIMD_API void SimdBgrToRgb(const uint8_t *bgr, size_t width, size_t height, size_t bgrStride, uint8_t * rgb, size_t rgbStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdBgrToRgb(bgr + begin * bgrStride, width, end - begin, bgrStride, rgb + begin * rgbStride, rgbStride);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::BgrToRgb(bgr, width, height, bgrStride, rgb, rgbStride);
@@ -1328,6 +1600,11 @@ SIMD_API void SimdBgrToYuv420pV2(const uint8_t* bgr, size_t bgrStride, size_t wi
     uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 2, [&](size_t begin, size_t end)
+    {
+        SimdBgrToYuv420pV2(bgr + begin * bgrStride, bgrStride, width, end - begin, y + begin * yStride, yStride, u + begin / 2 * uStride, uStride, v + begin / 2 * vStride, vStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::BgrToYuv420pV2(bgr, bgrStride, width, height, y, yStride, u, uStride, v, vStride, yuvType);
@@ -1355,6 +1632,11 @@ SIMD_API void SimdBgrToYuv422pV2(const uint8_t* bgr, size_t bgrStride, size_t wi
     uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdBgrToYuv422pV2(bgr + begin * bgrStride, bgrStride, width, end - begin, y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::BgrToYuv422pV2(bgr, bgrStride, width, height, y, yStride, u, uStride, v, vStride, yuvType);
@@ -1382,6 +1664,11 @@ SIMD_API void SimdBgrToYuv444pV2(const uint8_t* bgr, size_t bgrStride, size_t wi
     uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdBgrToYuv444pV2(bgr + begin * bgrStride, bgrStride, width, end - begin, y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::BgrToYuv444pV2(bgr, bgrStride, width, height, y, yStride, u, uStride, v, vStride, yuvType);
@@ -1645,7 +1932,7 @@ SIMD_API void* SimdDescrIntInit(size_t size, size_t depth)
 {
     SIMD_EMPTY();
     typedef void* (*SimdDescrIntInitPtr) (size_t size, size_t depth);
-    const static SimdDescrIntInitPtr simdDescrIntInit = SIMD_FUNC6(DescrIntInit, SIMD_AMXBF16_FUNC, SIMD_AVX512VNNI_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdDescrIntInitPtr, simdDescrIntInit, SIMD_FUNC6(DescrIntInit, SIMD_AMXBF16_FUNC, SIMD_AVX512VNNI_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     return simdDescrIntInit(size, depth);
 }
@@ -2100,7 +2387,7 @@ SIMD_API void SimdFill32f(float * dst, size_t size, const float * value)
 {
     SIMD_EMPTY();
     typedef void(*SimdFill32fPtr) (float * dst, size_t size, const float * value);
-    const static SimdFill32fPtr simdFill32f = SIMD_FUNC4(Fill32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdFill32fPtr, simdFill32f, SIMD_FUNC4(Fill32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdFill32f(dst, size, value);
 }
@@ -2109,7 +2396,7 @@ SIMD_API void SimdFloat32ToBFloat16(const float* src, size_t size, uint16_t* dst
 {
     SIMD_EMPTY();
     typedef void(*SimdFloat32ToBFloat16Ptr) (const float* src, size_t size, uint16_t* dst);
-    const static SimdFloat32ToBFloat16Ptr simdFloat32ToBFloat16 = SIMD_FUNC5(Float32ToBFloat16, SIMD_AMXBF16_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdFloat32ToBFloat16Ptr, simdFloat32ToBFloat16, SIMD_FUNC5(Float32ToBFloat16, SIMD_AMXBF16_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdFloat32ToBFloat16(src, size, dst);
 }
@@ -2118,7 +2405,7 @@ SIMD_API void SimdBFloat16ToFloat32(const uint16_t* src, size_t size, float* dst
 {
     SIMD_EMPTY();
     typedef void(*SimdBFloat16ToFloat32Ptr) (const uint16_t* src, size_t size, float* dst);
-    const static SimdBFloat16ToFloat32Ptr simdBFloat16ToFloat32 = SIMD_FUNC4(BFloat16ToFloat32, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdBFloat16ToFloat32Ptr, simdBFloat16ToFloat32, SIMD_FUNC4(BFloat16ToFloat32, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdBFloat16ToFloat32(src, size, dst);
 }
@@ -2357,7 +2644,7 @@ SIMD_API void SimdCosineDistance32f(const float * a, const float * b, size_t siz
 {
     SIMD_EMPTY();
     typedef void(*SimdCosineDistance32fPtr) (const float * a, const float * b, size_t size, float * distance);
-    const static SimdCosineDistance32fPtr simdCosineDistance32f = SIMD_FUNC4(CosineDistance32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdCosineDistance32fPtr, simdCosineDistance32f, SIMD_FUNC4(CosineDistance32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdCosineDistance32f(a, b, size, distance);
 }
@@ -2393,7 +2680,7 @@ SIMD_API void* SimdGaussianBlurInit(size_t width, size_t height, size_t channels
 {
     SIMD_EMPTY();
     typedef void* (*SimdGaussianBlurInitPtr) (size_t width, size_t height, size_t channels, const float* sigma, const float* epsilon);
-    const static SimdGaussianBlurInitPtr simdGaussianBlurInit = SIMD_FUNC4(GaussianBlurInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdGaussianBlurInitPtr, simdGaussianBlurInit, SIMD_FUNC4(GaussianBlurInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     return simdGaussianBlurInit(width, height, channels, sigma, epsilon);
 }
@@ -2409,7 +2696,7 @@ typedef void(*SimdGemm32fPtr) (size_t M, size_t N, size_t K, const float * alpha
 SIMD_API void SimdGemm32fNN(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
 {
     SIMD_EMPTY();
-    const static SimdGemm32fPtr simdGemm32fNN = SIMD_FUNC4(Gemm32fNN, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdGemm32fPtr, simdGemm32fNN, SIMD_FUNC4(Gemm32fNN, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdGemm32fNN(M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
 }
@@ -2417,7 +2704,7 @@ SIMD_API void SimdGemm32fNN(size_t M, size_t N, size_t K, const float * alpha, c
 SIMD_API void SimdGemm32fNT(size_t M, size_t N, size_t K, const float * alpha, const float * A, size_t lda, const float * B, size_t ldb, const float * beta, float * C, size_t ldc)
 {
     SIMD_EMPTY();
-    const static SimdGemm32fPtr simdGemm32fNT = SIMD_FUNC4(Gemm32fNT, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdGemm32fPtr, simdGemm32fNT, SIMD_FUNC4(Gemm32fNT, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdGemm32fNT(M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
 }
@@ -2425,6 +2712,11 @@ SIMD_API void SimdGemm32fNT(size_t M, size_t N, size_t K, const float * alpha, c
 SIMD_API void SimdGrayToBgr(const uint8_t * gray, size_t width, size_t height, size_t grayStride, uint8_t * bgr, size_t bgrStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdGrayToBgr(gray + begin * grayStride, width, end - begin, grayStride, bgr + begin * bgrStride, bgrStride);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::GrayToBgr(gray, width, height, grayStride, bgr, bgrStride);
@@ -2451,6 +2743,11 @@ SIMD_API void SimdGrayToBgr(const uint8_t * gray, size_t width, size_t height, s
 SIMD_API void SimdGrayToBgra(const uint8_t * gray, size_t width, size_t height, size_t grayStride, uint8_t * bgra, size_t bgraStride, uint8_t alpha)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdGrayToBgra(gray + begin * grayStride, width, end - begin, grayStride, bgra + begin * bgraStride, bgraStride, alpha);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::GrayToBgra(gray, width, height, grayStride, bgra, bgraStride, alpha);
@@ -2477,6 +2774,11 @@ SIMD_API void SimdGrayToBgra(const uint8_t * gray, size_t width, size_t height,
 SIMD_API void SimdGrayToY(const uint8_t * gray, size_t grayStride, size_t width, size_t height, uint8_t * y, size_t yStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdGrayToY(gray + begin * grayStride, grayStride, width, end - begin, y + begin * yStride, yStride);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::GrayToY(gray, grayStride, width, height, y, yStride);
@@ -2733,7 +3035,7 @@ SIMD_API void SimdHogFilterSeparable(const float * src, size_t srcStride, size_t
 SIMD_API uint8_t* SimdImageSaveToMemory(const uint8_t* src, size_t stride, size_t width, size_t height, SimdPixelFormatType format, SimdImageFileType file, int quality, size_t* size)
 {
     SIMD_EMPTY();
-    const static Simd::ImageSaveToMemoryPtr imageSaveToMemory = SIMD_FUNC4(ImageSaveToMemory, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(Simd::ImageSaveToMemoryPtr, imageSaveToMemory, SIMD_FUNC4(ImageSaveToMemory, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     return imageSaveToMemory(src, stride, width, height, format, file, quality, size);
 }
@@ -2741,7 +3043,7 @@ SIMD_API uint8_t* SimdImageSaveToMemory(const uint8_t* src, size_t stride, size_
 SIMD_API SimdBool SimdImageSaveToFile(const uint8_t* src, size_t stride, size_t width, size_t height, SimdPixelFormatType format, SimdImageFileType file, int quality, const char* path)
 {
     SIMD_EMPTY();
-    const static Simd::ImageSaveToMemoryPtr imageSaveToMemory = SIMD_FUNC4(ImageSaveToMemory, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(Simd::ImageSaveToMemoryPtr, imageSaveToMemory, SIMD_FUNC4(ImageSaveToMemory, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     return ImageSaveToFile(imageSaveToMemory, src, stride, width, height, format, file, quality, path);
 }
@@ -2750,7 +3052,7 @@ SIMD_API uint8_t* SimdNv12SaveAsJpegToMemory(const uint8_t* y, size_t yStride, c
 {
     SIMD_EMPTY();
     typedef uint8_t*(*SimdNv12SaveAsJpegToMemoryPtr) (const uint8_t* y, size_t yStride, const uint8_t* uv, size_t uvStride, size_t width, size_t height, SimdYuvType yuvType, int quality, size_t* size);
-    const static SimdNv12SaveAsJpegToMemoryPtr simdNv12SaveAsJpegToMemory = SIMD_FUNC4(Nv12SaveAsJpegToMemory, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNv12SaveAsJpegToMemoryPtr, simdNv12SaveAsJpegToMemory, SIMD_FUNC4(Nv12SaveAsJpegToMemory, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     return simdNv12SaveAsJpegToMemory(y, yStride, uv, uvStride, width, height, yuvType, quality, size);
 }
@@ -2761,7 +3063,7 @@ SIMD_API uint8_t* SimdYuv420pSaveAsJpegToMemory(const uint8_t* y, size_t yStride
     SIMD_EMPTY();
     typedef uint8_t* (*SimdYuv420pSaveAsJpegToMemoryPtr) (const uint8_t* y, size_t yStride, const uint8_t* u, size_t uStride, 
         const uint8_t* v, size_t vStride, size_t width, size_t height, SimdYuvType yuvType, int quality, size_t* size);
-    const static SimdYuv420pSaveAsJpegToMemoryPtr simdYuv420pSaveAsJpegToMemory = SIMD_FUNC4(Yuv420pSaveAsJpegToMemory, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdYuv420pSaveAsJpegToMemoryPtr, simdYuv420pSaveAsJpegToMemory, SIMD_FUNC4(Yuv420pSaveAsJpegToMemory, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     return simdYuv420pSaveAsJpegToMemory(y, yStride, u, uStride, v, vStride, width, height, yuvType, quality, size);
 }
@@ -2769,7 +3071,7 @@ SIMD_API uint8_t* SimdYuv420pSaveAsJpegToMemory(const uint8_t* y, size_t yStride
 SIMD_API uint8_t* SimdImageLoadFromMemory(const uint8_t* data, size_t size, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format)
 {
     SIMD_EMPTY();
-    const static Simd::ImageLoadFromMemoryPtr imageLoadFromMemory = SIMD_FUNC4(ImageLoadFromMemory, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(Simd::ImageLoadFromMemoryPtr, imageLoadFromMemory, SIMD_FUNC4(ImageLoadFromMemory, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     return imageLoadFromMemory(data, size, stride, width, height, format);
 }
@@ -2777,14 +3079,64 @@ SIMD_API uint8_t* SimdImageLoadFromMemory(const uint8_t* data, size_t size, size
 SIMD_API uint8_t* SimdImageLoadFromFile(const char* path, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType* format)
 {
     SIMD_EMPTY();
-    const static Simd::ImageLoadFromMemoryPtr imageLoadFromMemory = SIMD_FUNC4(ImageLoadFromMemory, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(Simd::ImageLoadFromMemoryPtr, imageLoadFromMemory, SIMD_FUNC4(ImageLoadFromMemory, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     return ImageLoadFromFile(imageLoadFromMemory, path, stride, width, height, format);
 }
 
+SIMD_API SimdBool SimdImageProbeFromMemory(const uint8_t* data, size_t size, SimdImageInfo* info)
+{
+    SIMD_EMPTY();
+    return Base::ImageProbeFromMemory(data, size, info) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API void * SimdJpegDecoderInit()
+{
+    SIMD_EMPTY();
+    typedef void* (*SimdJpegDecoderInitPtr) ();
+    SIMD_DISPATCH(SimdJpegDecoderInitPtr, simdJpegDecoderInit, SIMD_FUNC3(JpegDecoderInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));
+
+    return simdJpegDecoderInit();
+}
+
+SIMD_API SimdBool SimdJpegDecoderSetScale(void * decoder, size_t denominator)
+{
+    SIMD_EMPTY();
+    return ((Base::JpegDecoder*)decoder)->SetScale(denominator) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API SimdBool SimdJpegDecoderParse(void * decoder, const uint8_t * data, size_t size, size_t * width, size_t * height)
+{
+    SIMD_EMPTY();
+    return ((Base::JpegDecoder*)decoder)->Parse(data, size, width, height) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API SimdBool SimdJpegDecoderDecode(void * decoder, uint8_t * dst, size_t stride, SimdPixelFormatType format)
+{
+    SIMD_EMPTY();
+    return ((Base::JpegDecoder*)decoder)->Decode(dst, stride, format) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API SimdBool SimdJpegDecoderDecodeYuv420p(void * decoder, uint8_t * y, size_t yStride, uint8_t * u, size_t uStride, uint8_t * v, size_t vStride)
+{
+    SIMD_EMPTY();
+    return ((Base::JpegDecoder*)decoder)->DecodeYuv420p(y, yStride, u, uStride, v, vStride) ? SimdTrue : SimdFalse;
+}
+
+SIMD_API SimdBool SimdJpegDecoderDecodeNv12(void * decoder, uint8_t * y, size_t yStride, uint8_t * uv, size_t uvStride)
+{
+    SIMD_EMPTY();
+    return ((Base::JpegDecoder*)decoder)->DecodeNv12(y, yStride, uv, uvStride) ? SimdTrue : SimdFalse;
+}
+
 SIMD_API void SimdInt16ToGray(const uint8_t * src, size_t width, size_t height, size_t srcStride, uint8_t * dst, size_t dstStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdInt16ToGray(src + begin * srcStride, width, end - begin, srcStride, dst + begin * dstStride, dstStride);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Int16ToGray(src, width, height, srcStride, dst, dstStride);
@@ -3170,7 +3522,7 @@ SIMD_API void SimdNeuralProductSum(const float * a, const float * b, size_t size
 {
     SIMD_EMPTY();
     typedef void(*SimdNeuralProductSumPtr) (const float * a, const float * b, size_t size, float * sum);
-    const static SimdNeuralProductSumPtr simdNeuralProductSum = SIMD_FUNC4(NeuralProductSum, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralProductSumPtr, simdNeuralProductSum, SIMD_FUNC4(NeuralProductSum, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralProductSum(a, b, size, sum);
 }
@@ -3179,7 +3531,7 @@ SIMD_API void SimdNeuralAddValue(const float * value, float * dst, size_t size)
 {
     SIMD_EMPTY();
     typedef void(*SimdNeuralAddValuePtr) (const float * value, float * dst, size_t size);
-    const static SimdNeuralAddValuePtr simdNeuralAddValue = SIMD_FUNC4(NeuralAddValue, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralAddValuePtr, simdNeuralAddValue, SIMD_FUNC4(NeuralAddValue, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralAddValue(value, dst, size);
 }
@@ -3188,7 +3540,7 @@ SIMD_API void SimdNeuralAddVector(const float * src, size_t size, float * dst)
 {
     SIMD_EMPTY();
     typedef void(*SimdNeuralAddVectorPtr) (const float * src, size_t size, float * dst);
-    const static SimdNeuralAddVectorPtr simdNeuralAddVector = SIMD_FUNC4(NeuralAddVector, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralAddVectorPtr, simdNeuralAddVector, SIMD_FUNC4(NeuralAddVector, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralAddVector(src, size, dst);
 }
@@ -3197,7 +3549,7 @@ SIMD_API void SimdNeuralAddVectorMultipliedByValue(const float * src, size_t siz
 {
     SIMD_EMPTY();
     typedef void(*SimdNeuralAddVectorMultipliedByValuePtr) (const float * src, size_t size, const float * value, float * dst);
-    const static SimdNeuralAddVectorMultipliedByValuePtr simdNeuralAddVectorMultipliedByValue = SIMD_FUNC4(NeuralAddVectorMultipliedByValue, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralAddVectorMultipliedByValuePtr, simdNeuralAddVectorMultipliedByValue, SIMD_FUNC4(NeuralAddVectorMultipliedByValue, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralAddVectorMultipliedByValue(src, size, value, dst);
 }
@@ -3206,7 +3558,7 @@ SIMD_API void SimdNeuralDerivativeSigmoid(const float * src, size_t size, const
 {
     SIMD_EMPTY();
     typedef void(*SimdNeuralDerivativeSigmoidPtr) (const float * src, size_t size, const float * slope, float * dst);
-    const static SimdNeuralDerivativeSigmoidPtr simdNeuralDerivativeSigmoid = SIMD_FUNC4(NeuralDerivativeSigmoid, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralDerivativeSigmoidPtr, simdNeuralDerivativeSigmoid, SIMD_FUNC4(NeuralDerivativeSigmoid, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralDerivativeSigmoid(src, size, slope, dst);
 }
@@ -3215,7 +3567,7 @@ SIMD_API void SimdNeuralDerivativeTanh(const float * src, size_t size, const flo
 {
     SIMD_EMPTY();
     typedef void(*SimdNeuralDerivativeTanhPtr) (const float * src, size_t size, const float * slope, float * dst);
-    const static SimdNeuralDerivativeTanhPtr simdNeuralDerivativeTanh = SIMD_FUNC4(NeuralDerivativeTanh, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralDerivativeTanhPtr, simdNeuralDerivativeTanh, SIMD_FUNC4(NeuralDerivativeTanh, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralDerivativeTanh(src, size, slope, dst);
 }
@@ -3224,7 +3576,7 @@ SIMD_API void SimdNeuralDerivativeRelu(const float * src, size_t size, const flo
 {
     SIMD_EMPTY();
     typedef void(*SimdNeuralDerivativeReluPtr) (const float * src, size_t size, const float * slope, float * dst);
-    const static SimdNeuralDerivativeReluPtr simdNeuralDerivativeRelu = SIMD_FUNC4(NeuralDerivativeRelu, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralDerivativeReluPtr, simdNeuralDerivativeRelu, SIMD_FUNC4(NeuralDerivativeRelu, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralDerivativeRelu(src, size, slope, dst);
 }
@@ -3233,7 +3585,7 @@ SIMD_API void SimdNeuralPow(const float * src, size_t size, const float * expone
 {
     SIMD_EMPTY();
     typedef void(*SimdNeuralPowPtr) (const float * src, size_t size, const float * exponent, float * dst);
-    const static SimdNeuralPowPtr simdNeuralPow = SIMD_FUNC4(NeuralPow, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralPowPtr, simdNeuralPow, SIMD_FUNC4(NeuralPow, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralPow(src, size, exponent, dst);
 }
@@ -3242,7 +3594,7 @@ SIMD_API void SimdNeuralUpdateWeights(const float * x, size_t size, const float
 {
     SIMD_EMPTY();
     typedef void(*SimdNeuralUpdateWeightsPtr) (const float * x, size_t size, const float * a, const float * b, float * d, float * w);
-    const static SimdNeuralUpdateWeightsPtr simdNeuralUpdateWeights = SIMD_FUNC4(NeuralUpdateWeights, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralUpdateWeightsPtr, simdNeuralUpdateWeights, SIMD_FUNC4(NeuralUpdateWeights, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralUpdateWeights(x, size, a, b, d, w);
 }
@@ -3251,7 +3603,7 @@ SIMD_API void SimdNeuralAdaptiveGradientUpdate(const float * delta, size_t size,
 {
     SIMD_EMPTY();
     typedef void(*SimdNeuralAdaptiveGradientUpdatePtr) (const float * delta, size_t size, size_t batch, const float * alpha, const float * epsilon, float * gradient, float * weight);
-    const static SimdNeuralAdaptiveGradientUpdatePtr simdNeuralAdaptiveGradientUpdate = SIMD_FUNC4(NeuralAdaptiveGradientUpdate, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralAdaptiveGradientUpdatePtr, simdNeuralAdaptiveGradientUpdate, SIMD_FUNC4(NeuralAdaptiveGradientUpdate, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralAdaptiveGradientUpdate(delta, size, batch, alpha, epsilon, gradient, weight);
 }
@@ -3364,7 +3716,7 @@ SIMD_API void SimdNeuralAddConvolution2x2Backward(const float * src, size_t srcS
 {
     SIMD_EMPTY();
     typedef void(*SimdNeuralAddConvolution2x2BackwardPtr) (const float * src, size_t srcStride, size_t width, size_t height, const float * weights, float * dst, size_t dstStride);
-    const static SimdNeuralAddConvolution2x2BackwardPtr simdNeuralAddConvolution2x2Backward = SIMD_FUNC4(NeuralAddConvolution2x2Backward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralAddConvolution2x2BackwardPtr, simdNeuralAddConvolution2x2Backward, SIMD_FUNC4(NeuralAddConvolution2x2Backward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralAddConvolution2x2Backward(src, srcStride, width, height, weights, dst, dstStride);
 }
@@ -3373,7 +3725,7 @@ SIMD_API void SimdNeuralAddConvolution3x3Backward(const float * src, size_t srcS
 {
     SIMD_EMPTY();
     typedef void(*SimdNeuralAddConvolution3x3BackwardPtr) (const float * src, size_t srcStride, size_t width, size_t height, const float * weights, float * dst, size_t dstStride);
-    const static SimdNeuralAddConvolution3x3BackwardPtr simdNeuralAddConvolution3x3Backward = SIMD_FUNC4(NeuralAddConvolution3x3Backward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralAddConvolution3x3BackwardPtr, simdNeuralAddConvolution3x3Backward, SIMD_FUNC4(NeuralAddConvolution3x3Backward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralAddConvolution3x3Backward(src, srcStride, width, height, weights, dst, dstStride);
 }
@@ -3382,7 +3734,7 @@ SIMD_API void SimdNeuralAddConvolution4x4Backward(const float * src, size_t srcS
 {
     SIMD_EMPTY();
     typedef void(*SimdNeuralAddConvolution4x4BackwardPtr) (const float * src, size_t srcStride, size_t width, size_t height, const float * weights, float * dst, size_t dstStride);
-    const static SimdNeuralAddConvolution4x4BackwardPtr simdNeuralAddConvolution4x4Backward = SIMD_FUNC4(NeuralAddConvolution4x4Backward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralAddConvolution4x4BackwardPtr, simdNeuralAddConvolution4x4Backward, SIMD_FUNC4(NeuralAddConvolution4x4Backward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralAddConvolution4x4Backward(src, srcStride, width, height, weights, dst, dstStride);
 }
@@ -3391,7 +3743,7 @@ SIMD_API void SimdNeuralAddConvolution5x5Backward(const float * src, size_t srcS
 {
     SIMD_EMPTY();
     typedef void(*SimdNeuralAddConvolution5x5BackwardPtr) (const float * src, size_t srcStride, size_t width, size_t height, const float * weights, float * dst, size_t dstStride);
-    const static SimdNeuralAddConvolution5x5BackwardPtr simdNeuralAddConvolution5x5Backward = SIMD_FUNC4(NeuralAddConvolution5x5Backward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralAddConvolution5x5BackwardPtr, simdNeuralAddConvolution5x5Backward, SIMD_FUNC4(NeuralAddConvolution5x5Backward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralAddConvolution5x5Backward(src, srcStride, width, height, weights, dst, dstStride);
 }
@@ -3586,7 +3938,7 @@ SIMD_API void SimdNeuralConvolutionForward(const float * src, size_t srcWidth, s
     typedef void(*SimdNeuralConvolutionForwardPtr) (const float * src, size_t srcWidth, size_t srcHeight, size_t srcDepth, 
         const float * weight, size_t kernelX, size_t kernelY, size_t padX, size_t padY, size_t strideX, size_t strideY, size_t dilationX, size_t dilationY, 
         void * buffer, size_t * size, float * dst, size_t dstWidth, size_t dstHeight, size_t dstDepth, int add);
-    const static SimdNeuralConvolutionForwardPtr simdNeuralConvolutionForward = SIMD_FUNC4(NeuralConvolutionForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdNeuralConvolutionForwardPtr, simdNeuralConvolutionForward, SIMD_FUNC4(NeuralConvolutionForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdNeuralConvolutionForward(src, srcWidth, srcHeight, srcDepth, weight, kernelX, kernelY, padX, padY, strideX, strideY, dilationX, dilationY, buffer, size, dst, dstWidth, dstHeight, dstDepth, add);
 }
@@ -3676,7 +4028,7 @@ SIMD_API void* SimdRecursiveBilateralFilterInit(size_t width, size_t height, siz
 {
     SIMD_EMPTY();
     typedef void* (*SimdRecursiveBilateralFilterInitPtr) (size_t width, size_t height, size_t channels, const float* sigmaSpatial, const float* sigmaRange, SimdRecursiveBilateralFilterFlags flags);
-    const static SimdRecursiveBilateralFilterInitPtr simdRecursiveBilateralFilterInit = SIMD_FUNC2(RecursiveBilateralFilterInit, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);// , SIMD_AVX512BW_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdRecursiveBilateralFilterInitPtr, simdRecursiveBilateralFilterInit, SIMD_FUNC2(RecursiveBilateralFilterInit, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));// , SIMD_AVX512BW_FUNC, SIMD_NEON_FUNC);
     return simdRecursiveBilateralFilterInit(width, height, channels, sigmaSpatial, sigmaRange, flags);
 }
 
@@ -3903,20 +4255,51 @@ SIMD_API void * SimdResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t ds
 {
     SIMD_EMPTY();
     typedef void*(*SimdResizerInitPtr) (size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
-    const static SimdResizerInitPtr simdResizerInit = SIMD_FUNC4(ResizerInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdResizerInitPtr, simdResizerInit, SIMD_FUNC4(ResizerInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     return simdResizerInit(srcX, srcY, dstX, dstY, channels, type, method);
 }
 
+SIMD_API void * SimdResizerInitKernel(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, const float * kernel, size_t size, float support)
+{
+    SIMD_EMPTY();
+    typedef void* (*SimdResizerInitKernelPtr) (size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, const float * kernel, size_t size, float support);
+    SIMD_DISPATCH(SimdResizerInitKernelPtr, simdResizerInitKernel, SIMD_FUNC3(ResizerKernelInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));
+
+    return simdResizerInitKernel(srcX, srcY, dstX, dstY, channels, type, kernel, size, support);
+}
+
 SIMD_API void SimdResizerRun(const void * resizer, const uint8_t * src, size_t srcStride, uint8_t * dst, size_t dstStride)
 {
     SIMD_EMPTY();
-    ((Resizer*)resizer)->Run(src, srcStride, dst, dstStride);
+    ((Resizer*)resizer)->RunParallel(src, srcStride, dst, dstStride);
+}
+
+SIMD_API void * SimdResizerBatchInit(size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method)
+{
+    SIMD_EMPTY();
+    SIMD_DISPATCH(ResizerInitPtr, resizerInit, SIMD_FUNC4(ResizerInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
+    Resizer* probe = (Resizer*)resizerInit(dstX, dstY, dstX, dstY, channels, type, method);
+    if (probe == NULL)
+        return NULL;
+    delete probe;
+    return new ResizerBatch(ResParam(0, 0, dstX, dstY, channels, type, method, sizeof(void*), resizerInit));
+}
+
+SIMD_API SimdBool SimdResizerBatchRun(const void * resizer, const uint8_t * src, size_t srcX, size_t srcY, size_t srcStride, const size_t * rois, size_t count, uint8_t * dst, size_t dstStride)
+{
+    SIMD_EMPTY();
+    return ((ResizerBatch*)resizer)->Run(src, srcX, srcY, srcStride, rois, count, dst, dstStride) ? SimdTrue : SimdFalse;
 }
 
 SIMD_API void SimdRgbToBgra(const uint8_t* rgb, size_t width, size_t height, size_t rgbStride, uint8_t* bgra, size_t bgraStride, uint8_t alpha)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdRgbToBgra(rgb + begin * rgbStride, width, end - begin, rgbStride, bgra + begin * bgraStride, bgraStride, alpha);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::RgbToBgra(rgb, width, height, rgbStride, bgra, bgraStride, alpha);
@@ -3943,6 +4326,11 @@ SIMD_API void SimdRgbToBgra(const uint8_t* rgb, size_t width, size_t height, siz
 SIMD_API void SimdRgbToGray(const uint8_t* rgb, size_t width, size_t height, size_t rgbStride, uint8_t* gray, size_t grayStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdRgbToGray(rgb + begin * rgbStride, width, end - begin, rgbStride, gray + begin * grayStride, grayStride);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::RgbToGray(rgb, width, height, rgbStride, gray, grayStride);
@@ -3969,6 +4357,11 @@ SIMD_API void SimdRgbToGray(const uint8_t* rgb, size_t width, size_t height, siz
 SIMD_API void SimdRgbaToGray(const uint8_t* rgba, size_t width, size_t height, size_t rgbaStride, uint8_t* gray, size_t grayStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdRgbaToGray(rgba + begin * rgbaStride, width, end - begin, rgbaStride, gray + begin * grayStride, grayStride);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::RgbaToGray(rgba, width, height, rgbaStride, gray, grayStride);
@@ -4430,7 +4823,7 @@ SIMD_API void SimdSquaredDifferenceSum32f(const float * a, const float * b, size
 {
     SIMD_EMPTY();
     typedef void (* SimdSquaredDifferenceSum32fPtr) (const float * a, const float * b, size_t size, float * sum);
-    const static SimdSquaredDifferenceSum32fPtr simdSquaredDifferenceSum32f = SIMD_FUNC4(SquaredDifferenceSum32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSquaredDifferenceSum32fPtr, simdSquaredDifferenceSum32f, SIMD_FUNC4(SquaredDifferenceSum32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSquaredDifferenceSum32f(a, b, size, sum);
 }
@@ -4439,7 +4832,7 @@ SIMD_API void SimdSquaredDifferenceKahanSum32f(const float * a, const float * b,
 {
     SIMD_EMPTY();
     typedef void (* SimdSquaredDifferenceKahanSum32fPtr) (const float * a, const float * b, size_t size, float * sum);
-    const static SimdSquaredDifferenceKahanSum32fPtr simdSquaredDifferenceKahanSum32f = SIMD_FUNC4(SquaredDifferenceKahanSum32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSquaredDifferenceKahanSum32fPtr, simdSquaredDifferenceKahanSum32f, SIMD_FUNC4(SquaredDifferenceKahanSum32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSquaredDifferenceKahanSum32f(a, b, size, sum);
 }
@@ -4792,7 +5185,7 @@ SIMD_API void* SimdSynetAdd16bInit(const size_t* aShape, size_t aCount, SimdTens
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void* (*SimdSynetAdd16bInitPtr) (const size_t* aShape, size_t aCount, SimdTensorDataType aType, const size_t* bShape, size_t bCount, SimdTensorDataType bType, SimdTensorDataType dstType, SimdTensorFormatType format);
-    const static SimdSynetAdd16bInitPtr simdSynetAdd16bInit = SIMD_FUNC3(SynetAdd16bInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);
+    SIMD_DISPATCH(SimdSynetAdd16bInitPtr, simdSynetAdd16bInit, SIMD_FUNC3(SynetAdd16bInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));
 
     return simdSynetAdd16bInit(aShape, aCount, aType, bShape, bCount, bType, dstType, format);
 #else
@@ -4817,7 +5210,7 @@ SIMD_API void SimdSynetAddBias(const float * bias, size_t channels, size_t spati
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetAddBiasPtr) (const float * bias, size_t channels, size_t spatial, float * dst, SimdTensorFormatType format);
-    const static SimdSynetAddBiasPtr simdSynetAddBias = SIMD_FUNC4(SynetAddBias, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetAddBiasPtr, simdSynetAddBias, SIMD_FUNC4(SynetAddBias, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetAddBias(bias, channels, spatial, dst, format);
 #else
@@ -4832,7 +5225,7 @@ SIMD_API void SimdSynetAdd8i(const uint8_t* aData, const float* aScale, const fl
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetAdd8iPtr) (const uint8_t* aData, const float* aScale, const float* aShift, const uint8_t* bData, const float* bScale, const float* bShift,
         uint8_t* cData, const float* cScale, const float* cShift, size_t batch, size_t channels, size_t spatial, SimdTensorFormatType format, SimdSynetCompatibilityType compatibility);
-    const static SimdSynetAdd8iPtr simdSynetAdd8i = SIMD_FUNC3(SynetAdd8i, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);
+    SIMD_DISPATCH(SimdSynetAdd8iPtr, simdSynetAdd8i, SIMD_FUNC3(SynetAdd8i, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));
 
     simdSynetAdd8i(aData, aScale, aShift, bData, bScale, bShift, cData, cScale, cShift, batch, channels, spatial, format, compatibility);
 #else
@@ -4845,7 +5238,7 @@ SIMD_API void SimdSynetConvert32fTo8u(const float* src, size_t batch, size_t cha
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetConvert32fTo8uPtr) (const float* src, size_t batch, size_t channels, size_t height, size_t width, SimdTensorFormatType format, const float* scale, const float* shift, uint8_t* dst, SimdSynetCompatibilityType compatibility);
-    const static SimdSynetConvert32fTo8uPtr simdSynetConvert32fTo8u = SIMD_FUNC4(SynetConvert32fTo8u, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetConvert32fTo8uPtr, simdSynetConvert32fTo8u, SIMD_FUNC4(SynetConvert32fTo8u, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetConvert32fTo8u(src, batch, channels, height, width, format, scale, shift, dst, compatibility);
 #else
@@ -4858,7 +5251,7 @@ SIMD_API void SimdSynetConvert8uTo32f(const uint8_t* src, size_t batch, size_t c
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetConvert8uTo32fPtr) (const uint8_t* src, size_t batch, size_t channels, size_t height, size_t width, SimdTensorFormatType format, const float* scale, const float* shift, float* dst, SimdSynetCompatibilityType compatibility);
-    const static SimdSynetConvert8uTo32fPtr simdSynetConvert8uTo32f = SIMD_FUNC3(SynetConvert8uTo32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);//, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetConvert8uTo32fPtr, simdSynetConvert8uTo32f, SIMD_FUNC3(SynetConvert8uTo32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));//, SIMD_NEON_FUNC);
 
     simdSynetConvert8uTo32f(src, batch, channels, height, width, format, scale, shift, dst, compatibility);
 #else
@@ -4871,7 +5264,7 @@ SIMD_API void * SimdSynetConvolution32fInit(size_t batch, const SimdConvolutionP
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void* (*SimdSynetConvolution32fInitPtr) (size_t batch, const SimdConvolutionParameters * params);
-    const static SimdSynetConvolution32fInitPtr simdSynetConvolution32fInit = SIMD_FUNC4(SynetConvolution32fInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetConvolution32fInitPtr, simdSynetConvolution32fInit, SIMD_FUNC4(SynetConvolution32fInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     return simdSynetConvolution32fInit(batch, params);
 #else
@@ -4940,7 +5333,7 @@ SIMD_API void* SimdSynetConvolution16bInit(size_t batch, const SimdConvolutionPa
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void* (*SimdSynetConvolution6bInitPtr) (size_t batch, const SimdConvolutionParameters* conv, SimdSynetCompatibilityType compatibility);
-    const static SimdSynetConvolution6bInitPtr simdSynetConvolution6bInit = SIMD_FUNC4(SynetConvolution16bInit, SIMD_AMXBF16_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);
+    SIMD_DISPATCH(SimdSynetConvolution6bInitPtr, simdSynetConvolution6bInit, SIMD_FUNC4(SynetConvolution16bInit, SIMD_AMXBF16_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));
 
     return simdSynetConvolution6bInit(batch, conv, compatibility);
 #else
@@ -5009,7 +5402,7 @@ SIMD_API void* SimdSynetConvolution8iInit(size_t batch, const SimdConvolutionPar
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void* (*SimdSynetConvolution8iInitPtr) (size_t batch, const SimdConvolutionParameters* conv, SimdSynetCompatibilityType compatibility);
-    const static SimdSynetConvolution8iInitPtr simdSynetConvolution8iInit = SIMD_FUNC6(SynetConvolution8iInit, SIMD_AMXBF16_FUNC, SIMD_AVX512VNNI_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetConvolution8iInitPtr, simdSynetConvolution8iInit, SIMD_FUNC6(SynetConvolution8iInit, SIMD_AMXBF16_FUNC, SIMD_AVX512VNNI_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
     
     return simdSynetConvolution8iInit(batch, conv, compatibility);
 #else
@@ -5078,7 +5471,7 @@ SIMD_API void * SimdSynetDeconvolution32fInit(size_t batch, const SimdConvolutio
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void* (*SimdSynetDeconvolution32fInitPtr) (size_t batch, const SimdConvolutionParameters * params, SimdSynetCompatibilityType compatibility);
-    const static SimdSynetDeconvolution32fInitPtr simdSynetDeconvolution32fInit = SIMD_FUNC4(SynetDeconvolution32fInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetDeconvolution32fInitPtr, simdSynetDeconvolution32fInit, SIMD_FUNC4(SynetDeconvolution32fInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
     
     return simdSynetDeconvolution32fInit(batch, params, compatibility);
 #else
@@ -5147,7 +5540,7 @@ SIMD_API void* SimdSynetDeconvolution16bInit(size_t batch, const SimdConvolution
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void* (*SimdSynetDeconvolution16bInitPtr) (size_t batch, const SimdConvolutionParameters* conv, SimdSynetCompatibilityType compatibility);
-    const static SimdSynetDeconvolution16bInitPtr simdSynetDeconvolution16bInit = SIMD_FUNC4(SynetDeconvolution16bInit, SIMD_AMXBF16_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);
+    SIMD_DISPATCH(SimdSynetDeconvolution16bInitPtr, simdSynetDeconvolution16bInit, SIMD_FUNC4(SynetDeconvolution16bInit, SIMD_AMXBF16_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));
 
     return simdSynetDeconvolution16bInit(batch, conv, compatibility);
 #else
@@ -5216,7 +5609,7 @@ SIMD_API void SimdSynetEltwiseLayerForward(float const * const * src, const floa
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetEltwiseLayerForwardPtr) (float const * const * src, const float * weight, size_t count, size_t size, SimdSynetEltwiseOperationType type, float * dst);
-    const static SimdSynetEltwiseLayerForwardPtr simdSynetEltwiseLayerForward = SIMD_FUNC4(SynetEltwiseLayerForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetEltwiseLayerForwardPtr, simdSynetEltwiseLayerForward, SIMD_FUNC4(SynetEltwiseLayerForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetEltwiseLayerForward(src, weight, count, size, type, dst);
 #else
@@ -5229,7 +5622,7 @@ SIMD_API void SimdSynetElu32f(const float * src, size_t size, const float * alph
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetElu32fPtr) (const float * src, size_t size, const float * alpha, float * dst);
-    const static SimdSynetElu32fPtr simdSynetElu32f = SIMD_FUNC4(SynetElu32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetElu32fPtr, simdSynetElu32f, SIMD_FUNC4(SynetElu32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetElu32f(src, size, alpha, dst);
 #else
@@ -5242,7 +5635,7 @@ SIMD_API void SimdSynetGelu32f(const float* src, size_t size, float* dst)
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetGelu32fPtr) (const float* src, size_t size, float* dst);
-    const static SimdSynetGelu32fPtr simdSynetGelu32f = SIMD_FUNC4(SynetGelu32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetGelu32fPtr, simdSynetGelu32f, SIMD_FUNC4(SynetGelu32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetGelu32f(src, size, dst);
 #else
@@ -5257,7 +5650,7 @@ SIMD_API void* SimdSynetGridSample2dInit(size_t batch, size_t channels, size_t s
 #if defined(SIMD_SYNET_ENABLE)
     typedef void* (*SimdSynetGridSample2dInitPtr) (size_t batch, size_t channels, size_t srcH, size_t srcW, size_t dstH, size_t dstW,
         SimdTensorDataType type, SimdGridSampleInterpType interp, SimdGridSamplePaddingType padding, SimdBool align);
-    const static SimdSynetGridSample2dInitPtr simdSynetGridSample2dInit = SIMD_FUNC2(SynetGridSample2dInit, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);// , SIMD_AVX512BW_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetGridSample2dInitPtr, simdSynetGridSample2dInit, SIMD_FUNC2(SynetGridSample2dInit, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));// , SIMD_AVX512BW_FUNC, SIMD_NEON_FUNC);
 
     return simdSynetGridSample2dInit(batch, channels, srcH, srcW, dstH, dstW, type, interp, padding, align);
 #else
@@ -5292,7 +5685,7 @@ SIMD_API void SimdSynetHardSigmoid32f(const float* src, size_t size, const float
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetHardSigmoid32fPtr) (const float* src, size_t size, const float* scale, const float* shift, float* dst);
-    const static SimdSynetHardSigmoid32fPtr simdSynetHardSigmoid32f = SIMD_FUNC4(SynetHardSigmoid32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetHardSigmoid32fPtr, simdSynetHardSigmoid32f, SIMD_FUNC4(SynetHardSigmoid32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetHardSigmoid32f(src, size, scale, shift, dst);
 #else
@@ -5305,7 +5698,7 @@ SIMD_API void SimdSynetHswish32f(const float * src, size_t size, const float * s
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetHswish32fPtr) (const float * src, size_t size, const float * shift, const float * scale, float * dst);
-    const static SimdSynetHswish32fPtr simdSynetHswish32f = SIMD_FUNC4(SynetHswish32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetHswish32fPtr, simdSynetHswish32f, SIMD_FUNC4(SynetHswish32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetHswish32f(src, size, shift, scale, dst);
 #else
@@ -5318,7 +5711,7 @@ SIMD_API void* SimdSynetInnerProduct32fInit(size_t batch, size_t input, size_t o
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void* (*SimdSynetInnerProduct32fInitPtr) (size_t batch, size_t input, size_t output, SimdBool transpose, SimdConvolutionActivationType activation);
-    const static SimdSynetInnerProduct32fInitPtr simdSynetInnerProduct32fInit = SIMD_FUNC4(SynetInnerProduct32fInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetInnerProduct32fInitPtr, simdSynetInnerProduct32fInit, SIMD_FUNC4(SynetInnerProduct32fInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     return simdSynetInnerProduct32fInit(batch, input, output, transpose, activation);
 #else
@@ -5365,7 +5758,7 @@ SIMD_API void SimdSynetInnerProductLayerForward(const float * src, const float *
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetInnerProductLayerForwardPtr) (const float * src, const float * weight, const float * bias, size_t count, size_t size, float * dst);
-    const static SimdSynetInnerProductLayerForwardPtr simdSynetInnerProductLayerForward = SIMD_FUNC4(SynetInnerProductLayerForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetInnerProductLayerForwardPtr, simdSynetInnerProductLayerForward, SIMD_FUNC4(SynetInnerProductLayerForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetInnerProductLayerForward(src, weight, bias, count, size, dst);
 #else
@@ -5378,7 +5771,7 @@ SIMD_API void* SimdSynetInnerProduct16bInit(size_t M, size_t N, size_t K, SimdTe
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void* (*SimdSynetInnerProduct16bInitPtr) (size_t M, size_t N, size_t K, SimdTensorDataType typeA, SimdTensorDataType typeB, SimdTensorDataType typeC, SimdBool transB, SimdBool constB, SimdBool bias);
-    const static SimdSynetInnerProduct16bInitPtr simdSynetInnerProduct16bInit = SIMD_FUNC4(SynetInnerProduct16bInit, SIMD_AMXBF16_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);
+    SIMD_DISPATCH(SimdSynetInnerProduct16bInitPtr, simdSynetInnerProduct16bInit, SIMD_FUNC4(SynetInnerProduct16bInit, SIMD_AMXBF16_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));
 
     return simdSynetInnerProduct16bInit(M, N, K, typeA, typeB, typeC, transB, constB, bias);
 #else
@@ -5447,7 +5840,7 @@ SIMD_API void SimdSynetInnerProduct8i(size_t M, size_t N, size_t K, const uint8_
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetInnerProduct8iPtr) (size_t M, size_t N, size_t K, const uint8_t* src, const int8_t* weight, int32_t* dst, SimdSynetCompatibilityType compatibility);
-    const static SimdSynetInnerProduct8iPtr simdSynetInnerProduct8i = SIMD_FUNC3(SynetInnerProduct8i, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);
+    SIMD_DISPATCH(SimdSynetInnerProduct8iPtr, simdSynetInnerProduct8i, SIMD_FUNC3(SynetInnerProduct8i, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));
 
     simdSynetInnerProduct8i(M, N, K, src, weight, dst, compatibility);
 #else
@@ -5460,7 +5853,7 @@ SIMD_API void SimdSynetLrnLayerCrossChannels(const float * src, size_t half, siz
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetLrnLayerCrossChannelsPtr) (const float * src, size_t half, size_t channels, size_t spatial, const float * k, float * dst, SimdTensorFormatType format);
-    const static SimdSynetLrnLayerCrossChannelsPtr simdSynetLrnLayerCrossChannels = SIMD_FUNC4(SynetLrnLayerCrossChannels, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetLrnLayerCrossChannelsPtr, simdSynetLrnLayerCrossChannels, SIMD_FUNC4(SynetLrnLayerCrossChannels, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetLrnLayerCrossChannels(src, half, channels, spatial, k, dst, format);
 #else
@@ -5473,7 +5866,7 @@ SIMD_API void * SimdSynetMergedConvolution32fInit(size_t batch, const SimdConvol
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void* (*SimdSynetMergedConvolution32fInitPtr) (size_t batch, const SimdConvolutionParameters * convs, size_t count, SimdBool add);
-    const static SimdSynetMergedConvolution32fInitPtr simdSynetMergedConvolution32fInit = SIMD_FUNC4(SynetMergedConvolution32fInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetMergedConvolution32fInitPtr, simdSynetMergedConvolution32fInit, SIMD_FUNC4(SynetMergedConvolution32fInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     return simdSynetMergedConvolution32fInit(batch, convs, count, add);
 #else
@@ -5542,7 +5935,7 @@ SIMD_API void* SimdSynetMergedConvolution16bInit(size_t batch, const SimdConvolu
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void* (*SimdSynetMergedConvolution16bInitPtr) (size_t batch, const SimdConvolutionParameters* convs, size_t count, SimdBool add);
-    const static SimdSynetMergedConvolution16bInitPtr simdSynetMergedConvolution16bInit = SIMD_FUNC4(SynetMergedConvolution16bInit, SIMD_AMXBF16_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);
+    SIMD_DISPATCH(SimdSynetMergedConvolution16bInitPtr, simdSynetMergedConvolution16bInit, SIMD_FUNC4(SynetMergedConvolution16bInit, SIMD_AMXBF16_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));
 
     return simdSynetMergedConvolution16bInit(batch, convs, count, add);
 #else
@@ -5611,7 +6004,7 @@ SIMD_API void* SimdSynetMergedConvolution8iInit(size_t batch, const SimdConvolut
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void* (*SimdSynetMergedConvolution8iInitPtr) (size_t batch, const SimdConvolutionParameters* convs, size_t count, SimdSynetCompatibilityType compatibility);
-    const static SimdSynetMergedConvolution8iInitPtr simdSynetMergedConvolution8iInit = SIMD_FUNC5(SynetMergedConvolution8iInit, SIMD_AMXBF16_FUNC, SIMD_AVX512VNNI_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);
+    SIMD_DISPATCH(SimdSynetMergedConvolution8iInitPtr, simdSynetMergedConvolution8iInit, SIMD_FUNC5(SynetMergedConvolution8iInit, SIMD_AMXBF16_FUNC, SIMD_AVX512VNNI_FUNC, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));
 
     return simdSynetMergedConvolution8iInit(batch, convs, count, compatibility);
 #else
@@ -5680,7 +6073,7 @@ SIMD_API void SimdSynetMish32f(const float* src, size_t size, const float* thres
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetMish32fPtr) (const float* src, size_t size, const float* threshold, float* dst);
-    const static SimdSynetMish32fPtr simdSynetMish32f = SIMD_FUNC4(SynetMish32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetMish32fPtr, simdSynetMish32f, SIMD_FUNC4(SynetMish32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetMish32f(src, size, threshold, dst);
 #else
@@ -5695,7 +6088,7 @@ SIMD_API void SimdSynetNormalizeLayerForward(const float* src, size_t batch, siz
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetNormalizeLayerForwardPtr) (const float* src, size_t batch, size_t channels, size_t spatial,
         const float* scale, const float* eps, SimdBool acrossSpatial, SimdTensorFormatType format, float* buf, float* dst);
-    const static SimdSynetNormalizeLayerForwardPtr simdSynetNormalizeLayerForward = SIMD_FUNC3(SynetNormalizeLayerForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);// , SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetNormalizeLayerForwardPtr, simdSynetNormalizeLayerForward, SIMD_FUNC3(SynetNormalizeLayerForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));// , SIMD_NEON_FUNC);
 
     simdSynetNormalizeLayerForward(src, batch, channels, spatial, scale, eps, acrossSpatial, format, buf, dst);
 #else
@@ -5710,7 +6103,7 @@ SIMD_API void SimdSynetNormalizeLayerForwardV2(const float* src, size_t batch, s
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetNormalizeLayerForwardV2Ptr) (const float* src, size_t batch, size_t channels, size_t spatial,
         const float* scale, const float* shift, const float* eps, SimdTensorFormatType format, float* buf, float* dst);
-    const static SimdSynetNormalizeLayerForwardV2Ptr simdSynetNormalizeLayerForwardV2 = SIMD_FUNC3(SynetNormalizeLayerForwardV2, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);// , SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetNormalizeLayerForwardV2Ptr, simdSynetNormalizeLayerForwardV2, SIMD_FUNC3(SynetNormalizeLayerForwardV2, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));// , SIMD_NEON_FUNC);
 
     simdSynetNormalizeLayerForwardV2(src, batch, channels, spatial, scale, shift, eps, format, buf, dst);
 #else
@@ -5725,7 +6118,7 @@ SIMD_API void SimdSynetNormalizeLayerForwardV3(const float* src, size_t batch, s
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetNormalizeLayerForwardV3Ptr) (const float* src, size_t batch, size_t channels, size_t spatial,
         const float* scale, const float* shift, const float* eps, SimdTensorFormatType format, float* buf, float* dst);
-    const static SimdSynetNormalizeLayerForwardV3Ptr simdSynetNormalizeLayerForwardV3 = SIMD_FUNC3(SynetNormalizeLayerForwardV3, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);// , SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetNormalizeLayerForwardV3Ptr, simdSynetNormalizeLayerForwardV3, SIMD_FUNC3(SynetNormalizeLayerForwardV3, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));// , SIMD_NEON_FUNC);
 
     simdSynetNormalizeLayerForwardV3(src, batch, channels, spatial, scale, shift, eps, format, buf, dst);
 #else
@@ -5740,7 +6133,7 @@ SIMD_API void SimdSynetNormalizeLayerForwardV4(const float* src, size_t batch, s
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetNormalizeLayerForwardV4Ptr) (const float* src, size_t batch, size_t channels, size_t spatial,
         const float* scale, const float* shift, const float* eps, SimdTensorFormatType format, float* buf, float* dst);
-    const static SimdSynetNormalizeLayerForwardV4Ptr simdSynetNormalizeLayerForwardV4 = SIMD_FUNC3(SynetNormalizeLayerForwardV4, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);// , SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetNormalizeLayerForwardV4Ptr, simdSynetNormalizeLayerForwardV4, SIMD_FUNC3(SynetNormalizeLayerForwardV4, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));// , SIMD_NEON_FUNC);
 
     simdSynetNormalizeLayerForwardV4(src, batch, channels, spatial, scale, shift, eps, format, buf, dst);
 #else
@@ -5753,7 +6146,7 @@ SIMD_API void* SimdSynetPermuteInit(const size_t* shape, const size_t* order, si
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void* (*SimdSynetPermuteInitPtr) (const size_t* shape, const size_t* order, size_t count, SimdTensorDataType type);
-    const static SimdSynetPermuteInitPtr simdSynetPermuteInit = SIMD_FUNC4(SynetPermuteInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetPermuteInitPtr, simdSynetPermuteInit, SIMD_FUNC4(SynetPermuteInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     return simdSynetPermuteInit(shape, order, count, type);
 #else
@@ -5790,7 +6183,7 @@ void SimdSynetPoolingAverage(const float* src, size_t srcC, size_t srcH, size_t
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetPoolingAveragePtr) (const float* src, size_t srcC, size_t srcH, size_t srcW, size_t kernelY, size_t kernelX,
         size_t strideY, size_t strideX, size_t padY, size_t padX, float* dst, size_t dstH, size_t dstW, SimdBool exludePad, SimdTensorFormatType format);
-    const static SimdSynetPoolingAveragePtr simdSynetPoolingAverage = SIMD_FUNC4(SynetPoolingAverage, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetPoolingAveragePtr, simdSynetPoolingAverage, SIMD_FUNC4(SynetPoolingAverage, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetPoolingAverage(src, srcC, srcH, srcW, kernelY, kernelX, strideY, strideX, padY, padX, dst, dstH, dstW, excludePad, format);
 #else
@@ -5807,7 +6200,7 @@ SIMD_API void SimdSynetPoolingMax32f(const float* src, size_t srcC, size_t srcH,
     typedef void(*SimdSynetPoolingMax32fPtr) (const float* src, size_t srcC, size_t srcH, size_t srcW,
         size_t kernelC, size_t kernelY, size_t kernelX, size_t strideC, size_t strideY, size_t strideX,
         size_t padC, size_t padY, size_t padX, float* dst, size_t dstC, size_t dstH, size_t dstW, SimdTensorFormatType format);
-    const static SimdSynetPoolingMax32fPtr simdSynetPoolingMax32f = SIMD_FUNC4(SynetPoolingMax32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetPoolingMax32fPtr, simdSynetPoolingMax32f, SIMD_FUNC4(SynetPoolingMax32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetPoolingMax32f(src, srcC, srcH, srcW, kernelC, kernelY, kernelX, strideC, strideY, strideX, padC, padY, padX, dst, dstC, dstH, dstW, format);
 #else
@@ -5822,7 +6215,7 @@ SIMD_API void SimdSynetPoolingMax8u(const uint8_t* src, size_t srcC, size_t srcH
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetPoolingMax8uPtr) (const uint8_t* src, size_t srcC, size_t srcH, size_t srcW, size_t kernelY, size_t kernelX,
         size_t strideY, size_t strideX, size_t padY, size_t padX, uint8_t* dst, size_t dstH, size_t dstW, SimdTensorFormatType format);
-    const static SimdSynetPoolingMax8uPtr simdSynetPoolingMax8u = SIMD_FUNC4(SynetPoolingMax8u, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetPoolingMax8uPtr, simdSynetPoolingMax8u, SIMD_FUNC4(SynetPoolingMax8u, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetPoolingMax8u(src, srcC, srcH, srcW, kernelY, kernelX, strideY, strideX, padY, padX, dst, dstH, dstW, format);
 #else
@@ -5835,7 +6228,7 @@ SIMD_API void SimdSynetPreluLayerForward(const float * src, const float * slope,
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetPreluLayerForwardPtr) (const float * src, const float * slope, size_t channels, size_t spatial, float * dst, SimdTensorFormatType format);
-    const static SimdSynetPreluLayerForwardPtr simdSynetPreluLayerForward = SIMD_FUNC4(SynetPreluLayerForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetPreluLayerForwardPtr, simdSynetPreluLayerForward, SIMD_FUNC4(SynetPreluLayerForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetPreluLayerForward(src, slope, channels, spatial, dst, format);
 #else
@@ -5843,12 +6236,38 @@ SIMD_API void SimdSynetPreluLayerForward(const float * src, const float * slope,
 #endif
 }
 
+SIMD_API void* SimdSynetPreprocessInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels,
+    SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    typedef void* (*SimdSynetPreprocessInitPtr) (size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels,
+        SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat);
+    SIMD_DISPATCH(SimdSynetPreprocessInitPtr, simdSynetPreprocessInit, SIMD_FUNC3(SynetPreprocessInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));
+
+    return simdSynetPreprocessInit(srcW, srcH, srcFormat, yuvType, dstW, dstH, channels, method, lower, upper, dstType, dstFormat);
+#else
+    assert(0);
+    return NULL;
+#endif
+}
+
+SIMD_API void SimdSynetPreprocessForward(void* context, const uint8_t* src, size_t srcStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, uint8_t* dst)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    ((Base::SynetPreprocess*)context)->Forward(src, srcStride, u, uStride, v, vStride, dst);
+#else
+    assert(0);
+#endif
+}
+
 SIMD_API void SimdSynetRelu32f(const float* src, size_t size, const float* slope, float* dst)
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetRelu32fPtr) (const float* src, size_t size, const float* slope, float* dst);
-    const static SimdSynetRelu32fPtr simdSynetRelu32f = SIMD_FUNC4(SynetRelu32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetRelu32fPtr, simdSynetRelu32f, SIMD_FUNC4(SynetRelu32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetRelu32f(src, size, slope, dst);
 #else
@@ -5861,7 +6280,7 @@ SIMD_API void SimdSynetRelu16b(const uint16_t* src, size_t size, const float* sl
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetRelu16bPtr) (const uint16_t* src, size_t size, const float* slope, uint16_t* dst);
-    const static SimdSynetRelu16bPtr simdSynetRelu16b = SIMD_FUNC3(SynetRelu16b, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);
+    SIMD_DISPATCH(SimdSynetRelu16bPtr, simdSynetRelu16b, SIMD_FUNC3(SynetRelu16b, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));
 
     simdSynetRelu16b(src, size, slope, dst);
 #else
@@ -5874,7 +6293,7 @@ SIMD_API void SimdSynetRestrictRange32f(const float * src, size_t size, const fl
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetRestrictRange32fPtr) (const float * src, size_t size, const float * lower, const float * upper, float * dst);
-    const static SimdSynetRestrictRange32fPtr simdSynetRestrictRange32f = SIMD_FUNC4(SynetRestrictRange32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetRestrictRange32fPtr, simdSynetRestrictRange32f, SIMD_FUNC4(SynetRestrictRange32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetRestrictRange32f(src, size, lower, upper, dst);
 #else
@@ -5887,7 +6306,7 @@ SIMD_API void SimdSynetScaleLayerForward(const float* src, const float* scale, c
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetScaleLayerForwardPtr) (const float* src, const float* scale, const float* bias, size_t channels, size_t height, size_t width, float* dst, SimdTensorFormatType format, SimdSynetCompatibilityType compatibility);
-    const static SimdSynetScaleLayerForwardPtr simdSynetScaleLayerForward = SIMD_FUNC4(SynetScaleLayerForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetScaleLayerForwardPtr, simdSynetScaleLayerForward, SIMD_FUNC4(SynetScaleLayerForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetScaleLayerForward(src, scale, bias, channels, height, width, dst, format, compatibility);
 #else
@@ -5900,7 +6319,7 @@ SIMD_API void* SimdSynetScale8iInit(size_t batch, size_t channels, size_t spatia
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void* (*SimdSynetScale8iInitPtr) (size_t batch, size_t channels, size_t spatial, SimdTensorDataType srcType, SimdTensorDataType dstType, SimdTensorFormatType format, SimdSynetCompatibilityType compatibility);
-    const static SimdSynetScale8iInitPtr simdSynetScale8iInit = SIMD_FUNC3(SynetScale8iInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);
+    SIMD_DISPATCH(SimdSynetScale8iInitPtr, simdSynetScale8iInit, SIMD_FUNC3(SynetScale8iInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));
 
     return simdSynetScale8iInit(batch, channels, spatial, srcType, dstType, format, compatibility);
 #else
@@ -5976,7 +6395,7 @@ SIMD_API void SimdSynetShuffleLayerForward(const float* src0, const float* src1,
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetShuffleLayerForwardPtr) (const float* src0, const float* src1, size_t channels0, size_t channels1, size_t spatial, float* dst0, float* dst1, SimdTensorFormatType format, int type);
-    const static SimdSynetShuffleLayerForwardPtr simdSynetShuffleLayerForward = SIMD_FUNC4(SynetShuffleLayerForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetShuffleLayerForwardPtr, simdSynetShuffleLayerForward, SIMD_FUNC4(SynetShuffleLayerForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetShuffleLayerForward(src0, src1, channels0, channels1, spatial, dst0, dst1, format, type);
 #else
@@ -5989,7 +6408,7 @@ SIMD_API void SimdSynetSigmoid32f(const float* src, size_t size, const float* sl
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetSigmoid32fPtr) (const float* src, size_t size, const float* slope, float* dst);
-    const static SimdSynetSigmoid32fPtr simdSynetSigmoid32f = SIMD_FUNC4(SynetSigmoid32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetSigmoid32fPtr, simdSynetSigmoid32f, SIMD_FUNC4(SynetSigmoid32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetSigmoid32f(src, size, slope, dst);
 #else
@@ -6002,7 +6421,7 @@ SIMD_API void SimdSynetSoftmaxLayerForward(const float * src, size_t outer, size
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetSoftmaxLayerForwardPtr) (const float * src, size_t outer, size_t count, size_t inner, float * dst);
-    const static SimdSynetSoftmaxLayerForwardPtr simdSynetSoftmaxLayerForward = SIMD_FUNC4(SynetSoftmaxLayerForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetSoftmaxLayerForwardPtr, simdSynetSoftmaxLayerForward, SIMD_FUNC4(SynetSoftmaxLayerForward, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetSoftmaxLayerForward(src, outer, count, inner, dst);
 #else
@@ -6015,7 +6434,7 @@ SIMD_API void SimdSynetSoftplus32f(const float* src, size_t size, const float* b
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetSoftplus32fPtr) (const float* src, size_t size, const float* beta, const float* threshold, float* dst);
-    const static SimdSynetSoftplus32fPtr simdSynetSoftplus32f = SIMD_FUNC4(SynetSoftplus32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetSoftplus32fPtr, simdSynetSoftplus32f, SIMD_FUNC4(SynetSoftplus32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetSoftplus32f(src, size, beta, threshold, dst);
 #else
@@ -6028,7 +6447,7 @@ SIMD_API void SimdSynetSwish32f(const float* src, size_t size, const float* slop
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetSwish32fPtr) (const float* src, size_t size, const float* slope, float* dst);
-    const static SimdSynetSwish32fPtr simdSynetSwish32f = SIMD_FUNC4(SynetSwish32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetSwish32fPtr, simdSynetSwish32f, SIMD_FUNC4(SynetSwish32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetSwish32f(src, size, slope, dst);
 #else
@@ -6041,7 +6460,7 @@ SIMD_API void SimdSynetTanh32f(const float* src, size_t size, const float* slope
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetTanh32fPtr) (const float* src, size_t size, const float* slope, float* dst);
-    const static SimdSynetTanh32fPtr simdSynetTanh32f = SIMD_FUNC4(SynetTanh32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetTanh32fPtr, simdSynetTanh32f, SIMD_FUNC4(SynetTanh32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetTanh32f(src, size, slope, dst);
 #else
@@ -6054,7 +6473,7 @@ SIMD_API void SimdSynetTiledScale2D32f(const float* src, size_t channels, size_t
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetTiledScale2D32fPtr) (const float* src, size_t channels, size_t height, size_t width, SimdTensorFormatType format, const float* ver, const float* hor, float* dst);
-    const static SimdSynetTiledScale2D32fPtr simdSynetTiledScale2D32f = SIMD_FUNC3(SynetTiledScale2D32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);
+    SIMD_DISPATCH(SimdSynetTiledScale2D32fPtr, simdSynetTiledScale2D32f, SIMD_FUNC3(SynetTiledScale2D32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));
 
     simdSynetTiledScale2D32f(src, channels, height, width, format, ver, hor, dst);
 #else
@@ -6067,7 +6486,7 @@ SIMD_API void SimdSynetUnaryOperation32f(const float* src, size_t size, SimdSyne
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
     typedef void(*SimdSynetUnaryOperation32fPtr) (const float* src, size_t size, SimdSynetUnaryOperation32fType type, float* dst);
-    const static SimdSynetUnaryOperation32fPtr simdSynetUnaryOperation32f = SIMD_FUNC4(SynetUnaryOperation32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdSynetUnaryOperation32fPtr, simdSynetUnaryOperation32f, SIMD_FUNC4(SynetUnaryOperation32f, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdSynetUnaryOperation32f(src, size, type, dst);
 #else
@@ -6075,6 +6494,43 @@ SIMD_API void SimdSynetUnaryOperation32f(const float* src, size_t size, SimdSyne
 #endif
 }
 
+SIMD_API void * SimdSynetWorkspaceInit()
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return new SynetWorkspace();
+#else
+    assert(0);
+    return NULL;
+#endif
+}
+
+SIMD_API SimdBool SimdSynetSetWorkspace(void * context, void * workspace)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    SynetWorkspaceUser * user = dynamic_cast<SynetWorkspaceUser*>((Deletable*)context);
+    if (user == NULL)
+        return SimdFalse;
+    user->SetWorkspace((SynetWorkspace*)workspace);
+    return SimdTrue;
+#else
+    assert(0);
+    return SimdFalse;
+#endif
+}
+
+SIMD_API size_t SimdSynetWorkspacePeak(const void * workspace)
+{
+    SIMD_EMPTY();
+#if defined(SIMD_SYNET_ENABLE)
+    return ((const SynetWorkspace*)workspace)->Peak();
+#else
+    assert(0);
+    return 0;
+#endif
+}
+
 SIMD_API void SimdTextureBoostedSaturatedGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height,
                                      uint8_t saturation, uint8_t boost, uint8_t * dx, size_t dxStride, uint8_t * dy, size_t dyStride)
 {
@@ -6212,6 +6668,11 @@ SIMD_API void SimdTransformImage(const uint8_t * src, size_t srcStride, size_t w
 SIMD_API void SimdUyvy422ToBgr(const uint8_t* uyvy, size_t uyvyStride, size_t width, size_t height, uint8_t* bgr, size_t bgrStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdUyvy422ToBgr(uyvy + begin * uyvyStride, uyvyStride, width, end - begin, bgr + begin * bgrStride, bgrStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Uyvy422ToBgr(uyvy, uyvyStride, width, height, bgr, bgrStride, yuvType);
@@ -6238,6 +6699,11 @@ SIMD_API void SimdUyvy422ToBgr(const uint8_t* uyvy, size_t uyvyStride, size_t wi
 SIMD_API void SimdUyvy422ToYuv420p(const uint8_t* uyvy, size_t uyvyStride, size_t width, size_t height, uint8_t* y, size_t yStride, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 2, [&](size_t begin, size_t end)
+    {
+        SimdUyvy422ToYuv420p(uyvy + begin * uyvyStride, uyvyStride, width, end - begin, y + begin * yStride, yStride, u + begin / 2 * uStride, uStride, v + begin / 2 * vStride, vStride);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Uyvy422ToYuv420p(uyvy, uyvyStride, width, height, y, yStride, u, uStride, v, vStride);
@@ -6265,7 +6731,7 @@ SIMD_API void* SimdWarpAffineInit(size_t srcW, size_t srcH, size_t srcS, size_t
 {
     SIMD_EMPTY();    
     typedef void* (*SimdWarpAffineInitPtr) (size_t srcW, size_t srcH, size_t srcS, size_t dstW, size_t dstH, size_t dstS, size_t channels, const float* mat, SimdWarpAffineFlags flags, const uint8_t* border);
-    const static SimdWarpAffineInitPtr simdWarpAffineInit = SIMD_FUNC3(WarpAffineInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC);//, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWarpAffineInitPtr, simdWarpAffineInit, SIMD_FUNC3(WarpAffineInit, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC));//, SIMD_NEON_FUNC);
     return simdWarpAffineInit(srcW, srcH, srcS, dstW, dstH, dstS, channels, mat, flags, border);
 }
 
@@ -6283,7 +6749,7 @@ SIMD_API void SimdWinogradKernel1x3Block1x4SetFilter(const float* src, size_t si
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetFilterPtr simdWinogradKernel1x3Block1x4SetFilter = SIMD_FUNC4(WinogradKernel1x3Block1x4SetFilter, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetFilterPtr, simdWinogradKernel1x3Block1x4SetFilter, SIMD_FUNC4(WinogradKernel1x3Block1x4SetFilter, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel1x3Block1x4SetFilter(src, size, dst, trans);
 #else
@@ -6296,7 +6762,7 @@ SIMD_API void SimdWinogradKernel1x3Block1x4SetInput(const float* src, size_t src
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetInputPtr simdWinogradKernel1x3Block1x4SetInput = SIMD_FUNC4(WinogradKernel1x3Block1x4SetInput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetInputPtr, simdWinogradKernel1x3Block1x4SetInput, SIMD_FUNC4(WinogradKernel1x3Block1x4SetInput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel1x3Block1x4SetInput(src, srcChannels, srcHeight, srcWidth, padY, padX, padH, padW, dst, dstStride, trans);
 #else
@@ -6308,7 +6774,7 @@ SIMD_API void SimdWinogradKernel1x3Block1x4SetOutput(const float* src, size_t sr
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetOutputPtr simdWinogradKernel1x3Block1x4SetOutput = SIMD_FUNC4(WinogradKernel1x3Block1x4SetOutput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetOutputPtr, simdWinogradKernel1x3Block1x4SetOutput, SIMD_FUNC4(WinogradKernel1x3Block1x4SetOutput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel1x3Block1x4SetOutput(src, srcStride, dst, dstChannels, dstHeight, dstWidth, trans);
 #else
@@ -6320,7 +6786,7 @@ SIMD_API void SimdWinogradKernel1x5Block1x4SetFilter(const float* src, size_t si
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetFilterPtr simdWinogradKernel1x5Block1x4SetFilter = SIMD_FUNC4(WinogradKernel1x5Block1x4SetFilter, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetFilterPtr, simdWinogradKernel1x5Block1x4SetFilter, SIMD_FUNC4(WinogradKernel1x5Block1x4SetFilter, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel1x5Block1x4SetFilter(src, size, dst, trans);
 #else
@@ -6333,7 +6799,7 @@ SIMD_API void SimdWinogradKernel1x5Block1x4SetInput(const float* src, size_t src
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetInputPtr simdWinogradKernel1x5Block1x4SetInput = SIMD_FUNC4(WinogradKernel1x5Block1x4SetInput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetInputPtr, simdWinogradKernel1x5Block1x4SetInput, SIMD_FUNC4(WinogradKernel1x5Block1x4SetInput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel1x5Block1x4SetInput(src, srcChannels, srcHeight, srcWidth, padY, padX, padH, padW, dst, dstStride, trans);
 #else
@@ -6345,7 +6811,7 @@ SIMD_API void SimdWinogradKernel1x5Block1x4SetOutput(const float* src, size_t sr
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetOutputPtr simdWinogradKernel1x5Block1x4SetOutput = SIMD_FUNC4(WinogradKernel1x5Block1x4SetOutput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetOutputPtr, simdWinogradKernel1x5Block1x4SetOutput, SIMD_FUNC4(WinogradKernel1x5Block1x4SetOutput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel1x5Block1x4SetOutput(src, srcStride, dst, dstChannels, dstHeight, dstWidth, trans);
 #else
@@ -6357,7 +6823,7 @@ SIMD_API void SimdWinogradKernel2x2Block2x2SetFilter(const float* src, size_t si
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetFilterPtr simdWinogradKernel2x2Block2x2SetFilter = SIMD_FUNC4(WinogradKernel2x2Block2x2SetFilter, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetFilterPtr, simdWinogradKernel2x2Block2x2SetFilter, SIMD_FUNC4(WinogradKernel2x2Block2x2SetFilter, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel2x2Block2x2SetFilter(src, size, dst, trans);
 #else
@@ -6370,7 +6836,7 @@ SIMD_API void SimdWinogradKernel2x2Block2x2SetInput(const float* src, size_t src
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetInputPtr simdWinogradKernel2x2Block2x2SetInput = SIMD_FUNC4(WinogradKernel2x2Block2x2SetInput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetInputPtr, simdWinogradKernel2x2Block2x2SetInput, SIMD_FUNC4(WinogradKernel2x2Block2x2SetInput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel2x2Block2x2SetInput(src, srcChannels, srcHeight, srcWidth, padY, padX, padH, padW, dst, dstStride, trans);
 #else
@@ -6382,7 +6848,7 @@ SIMD_API void SimdWinogradKernel2x2Block2x2SetOutput(const float* src, size_t sr
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetOutputPtr simdWinogradKernel2x2Block2x2SetOutput = SIMD_FUNC4(WinogradKernel2x2Block2x2SetOutput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetOutputPtr, simdWinogradKernel2x2Block2x2SetOutput, SIMD_FUNC4(WinogradKernel2x2Block2x2SetOutput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel2x2Block2x2SetOutput(src, srcStride, dst, dstChannels, dstHeight, dstWidth, trans);
 #else
@@ -6394,7 +6860,7 @@ SIMD_API void SimdWinogradKernel2x2Block4x4SetFilter(const float* src, size_t si
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetFilterPtr simdWinogradKernel2x2Block4x4SetFilter = SIMD_FUNC4(WinogradKernel2x2Block4x4SetFilter, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetFilterPtr, simdWinogradKernel2x2Block4x4SetFilter, SIMD_FUNC4(WinogradKernel2x2Block4x4SetFilter, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel2x2Block4x4SetFilter(src, size, dst, trans);
 #else
@@ -6407,7 +6873,7 @@ SIMD_API void SimdWinogradKernel2x2Block4x4SetInput(const float* src, size_t src
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetInputPtr simdWinogradKernel2x2Block4x4SetInput = SIMD_FUNC4(WinogradKernel2x2Block4x4SetInput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetInputPtr, simdWinogradKernel2x2Block4x4SetInput, SIMD_FUNC4(WinogradKernel2x2Block4x4SetInput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel2x2Block4x4SetInput(src, srcChannels, srcHeight, srcWidth, padY, padX, padH, padW, dst, dstStride, trans);
 #else
@@ -6419,7 +6885,7 @@ SIMD_API void SimdWinogradKernel2x2Block4x4SetOutput(const float* src, size_t sr
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetOutputPtr simdWinogradKernel2x2Block4x4SetOutput = SIMD_FUNC4(WinogradKernel2x2Block4x4SetOutput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetOutputPtr, simdWinogradKernel2x2Block4x4SetOutput, SIMD_FUNC4(WinogradKernel2x2Block4x4SetOutput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel2x2Block4x4SetOutput(src, srcStride, dst, dstChannels, dstHeight, dstWidth, trans);
 #else
@@ -6431,7 +6897,7 @@ SIMD_API void SimdWinogradKernel3x3Block2x2SetFilter(const float * src, size_t s
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetFilterPtr simdWinogradKernel3x3Block2x2SetFilter = SIMD_FUNC4(WinogradKernel3x3Block2x2SetFilter, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetFilterPtr, simdWinogradKernel3x3Block2x2SetFilter, SIMD_FUNC4(WinogradKernel3x3Block2x2SetFilter, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel3x3Block2x2SetFilter(src, size, dst, trans);
 #else
@@ -6444,7 +6910,7 @@ SIMD_API void SimdWinogradKernel3x3Block2x2SetInput(const float* src, size_t src
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetInputPtr simdWinogradKernel3x3Block2x2SetInput = SIMD_FUNC4(WinogradKernel3x3Block2x2SetInput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetInputPtr, simdWinogradKernel3x3Block2x2SetInput, SIMD_FUNC4(WinogradKernel3x3Block2x2SetInput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel3x3Block2x2SetInput(src, srcChannels, srcHeight, srcWidth, padY, padX, padH, padW, dst, dstStride, trans);
 #else
@@ -6456,7 +6922,7 @@ SIMD_API void SimdWinogradKernel3x3Block2x2SetOutput(const float * src, size_t s
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetOutputPtr simdWinogradKernel3x3Block2x2SetOutput = SIMD_FUNC4(WinogradKernel3x3Block2x2SetOutput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetOutputPtr, simdWinogradKernel3x3Block2x2SetOutput, SIMD_FUNC4(WinogradKernel3x3Block2x2SetOutput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel3x3Block2x2SetOutput(src, srcStride, dst, dstChannels, dstHeight, dstWidth, trans);
 #else
@@ -6468,7 +6934,7 @@ SIMD_API void SimdWinogradKernel3x3Block3x3SetFilter(const float * src, size_t s
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetFilterPtr simdWinogradKernel3x3Block3x3SetFilter = SIMD_FUNC4(WinogradKernel3x3Block3x3SetFilter, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetFilterPtr, simdWinogradKernel3x3Block3x3SetFilter, SIMD_FUNC4(WinogradKernel3x3Block3x3SetFilter, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel3x3Block3x3SetFilter(src, size, dst, trans);
 #else
@@ -6481,7 +6947,7 @@ SIMD_API void SimdWinogradKernel3x3Block3x3SetInput(const float* src, size_t src
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetInputPtr simdWinogradKernel3x3Block3x3SetInput = SIMD_FUNC4(WinogradKernel3x3Block3x3SetInput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC); 
+    SIMD_DISPATCH(SimdWinogradSetInputPtr, simdWinogradKernel3x3Block3x3SetInput, SIMD_FUNC4(WinogradKernel3x3Block3x3SetInput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel3x3Block3x3SetInput(src, srcChannels, srcHeight, srcWidth, padY, padX, padH, padW, dst, dstStride, trans);
 #else
@@ -6493,7 +6959,7 @@ SIMD_API void SimdWinogradKernel3x3Block3x3SetOutput(const float * src, size_t s
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetOutputPtr simdWinogradKernel3x3Block3x3SetOutput = SIMD_FUNC4(WinogradKernel3x3Block3x3SetOutput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetOutputPtr, simdWinogradKernel3x3Block3x3SetOutput, SIMD_FUNC4(WinogradKernel3x3Block3x3SetOutput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel3x3Block3x3SetOutput(src, srcStride, dst, dstChannels, dstHeight, dstWidth, trans);
 #else
@@ -6505,7 +6971,7 @@ SIMD_API void SimdWinogradKernel3x3Block4x4SetFilter(const float * src, size_t s
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetFilterPtr simdWinogradKernel3x3Block4x4SetFilter = SIMD_FUNC4(WinogradKernel3x3Block4x4SetFilter, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetFilterPtr, simdWinogradKernel3x3Block4x4SetFilter, SIMD_FUNC4(WinogradKernel3x3Block4x4SetFilter, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel3x3Block4x4SetFilter(src, size, dst, trans);
 #else
@@ -6518,7 +6984,7 @@ SIMD_API void SimdWinogradKernel3x3Block4x4SetInput(const float* src, size_t src
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetInputPtr simdWinogradKernel3x3Block4x4SetInput = SIMD_FUNC4(WinogradKernel3x3Block4x4SetInput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetInputPtr, simdWinogradKernel3x3Block4x4SetInput, SIMD_FUNC4(WinogradKernel3x3Block4x4SetInput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel3x3Block4x4SetInput(src, srcChannels, srcHeight, srcWidth, padY, padX, padH, padW, dst, dstStride, trans);
 #else
@@ -6530,7 +6996,7 @@ SIMD_API void SimdWinogradKernel3x3Block4x4SetOutput(const float * src, size_t s
 {
     SIMD_EMPTY();
 #if defined(SIMD_SYNET_ENABLE)
-    const static SimdWinogradSetOutputPtr simdWinogradKernel3x3Block4x4SetOutput = SIMD_FUNC4(WinogradKernel3x3Block4x4SetOutput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC);
+    SIMD_DISPATCH(SimdWinogradSetOutputPtr, simdWinogradKernel3x3Block4x4SetOutput, SIMD_FUNC4(WinogradKernel3x3Block4x4SetOutput, SIMD_AVX512BW_FUNC, SIMD_AVX2_FUNC, SIMD_SSE41_FUNC, SIMD_NEON_FUNC));
 
     simdWinogradKernel3x3Block4x4SetOutput(src, srcStride, dst, dstChannels, dstHeight, dstWidth, trans);
 #else
@@ -6568,6 +7034,11 @@ SIMD_API void SimdYuva420pToBgraV2(const uint8_t* y, size_t yStride, const uint8
     const uint8_t* a, size_t aStride, size_t width, size_t height, uint8_t* bgra, size_t bgraStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 2, [&](size_t begin, size_t end)
+    {
+        SimdYuva420pToBgraV2(y + begin * yStride, yStride, u + begin / 2 * uStride, uStride, v + begin / 2 * vStride, vStride, a + begin * aStride, aStride, width, end - begin, bgra + begin * bgraStride, bgraStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Yuva420pToBgraV2(y, yStride, u, uStride, v, vStride, a, aStride, width, height, bgra, bgraStride, yuvType);
@@ -6595,6 +7066,11 @@ SIMD_API void SimdYuva422pToBgraV2(const uint8_t* y, size_t yStride, const uint8
     const uint8_t* a, size_t aStride, size_t width, size_t height, uint8_t* bgra, size_t bgraStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdYuva422pToBgraV2(y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, a + begin * aStride, aStride, width, end - begin, bgra + begin * bgraStride, bgraStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Yuva422pToBgraV2(y, yStride, u, uStride, v, vStride, a, aStride, width, height, bgra, bgraStride, yuvType);
@@ -6622,6 +7098,11 @@ SIMD_API void SimdYuva444pToBgraV2(const uint8_t* y, size_t yStride, const uint8
     const uint8_t* a, size_t aStride, size_t width, size_t height, uint8_t* bgra, size_t bgraStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdYuva444pToBgraV2(y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, a + begin * aStride, aStride, width, end - begin, bgra + begin * bgraStride, bgraStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Yuva444pToBgraV2(y, yStride, u, uStride, v, vStride, a, aStride, width, height, bgra, bgraStride, yuvType);
@@ -6649,6 +7130,11 @@ SIMD_API void SimdYuv420pToBgrV2(const uint8_t* y, size_t yStride, const uint8_t
     size_t width, size_t height, uint8_t* bgr, size_t bgrStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 2, [&](size_t begin, size_t end)
+    {
+        SimdYuv420pToBgrV2(y + begin * yStride, yStride, u + begin / 2 * uStride, uStride, v + begin / 2 * vStride, vStride, width, end - begin, bgr + begin * bgrStride, bgrStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Yuv420pToBgrV2(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride, yuvType);
@@ -6676,6 +7162,11 @@ SIMD_API void SimdYuv422pToBgrV2(const uint8_t* y, size_t yStride, const uint8_t
     size_t width, size_t height, uint8_t* bgr, size_t bgrStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdYuv422pToBgrV2(y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, width, end - begin, bgr + begin * bgrStride, bgrStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Yuv422pToBgrV2(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride, yuvType);
@@ -6703,6 +7194,11 @@ SIMD_API void SimdYuv444pToBgrV2(const uint8_t* y, size_t yStride, const uint8_t
     size_t width, size_t height, uint8_t* bgr, size_t bgrStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdYuv444pToBgrV2(y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, width, end - begin, bgr + begin * bgrStride, bgrStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Yuv444pToBgrV2(y, yStride, u, uStride, v, vStride, width, height, bgr, bgrStride, yuvType);
@@ -6730,6 +7226,11 @@ SIMD_API void SimdYuv420pToBgraV2(const uint8_t* y, size_t yStride, const uint8_
     size_t width, size_t height, uint8_t* bgra, size_t bgraStride, uint8_t alpha, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 2, [&](size_t begin, size_t end)
+    {
+        SimdYuv420pToBgraV2(y + begin * yStride, yStride, u + begin / 2 * uStride, uStride, v + begin / 2 * vStride, vStride, width, end - begin, bgra + begin * bgraStride, bgraStride, alpha, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Yuv420pToBgraV2(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha, yuvType);
@@ -6757,6 +7258,11 @@ SIMD_API void SimdYuv422pToBgraV2(const uint8_t* y, size_t yStride, const uint8_
     size_t width, size_t height, uint8_t* bgra, size_t bgraStride, uint8_t alpha, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdYuv422pToBgraV2(y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, width, end - begin, bgra + begin * bgraStride, bgraStride, alpha, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Yuv422pToBgraV2(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha, yuvType);
@@ -6784,6 +7290,11 @@ SIMD_API void SimdYuv444pToBgraV2(const uint8_t* y, size_t yStride, const uint8_
     size_t width, size_t height, uint8_t* bgra, size_t bgraStride, uint8_t alpha, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdYuv444pToBgraV2(y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, width, end - begin, bgra + begin * bgraStride, bgraStride, alpha, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Yuv444pToBgraV2(y, yStride, u, uStride, v, vStride, width, height, bgra, bgraStride, alpha, yuvType);
@@ -6811,6 +7322,11 @@ SIMD_API void SimdYuv444pToHsl(const uint8_t * y, size_t yStride, const uint8_t
                                size_t width, size_t height, uint8_t * hsl, size_t hslStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdYuv444pToHsl(y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, width, end - begin, hsl + begin * hslStride, hslStride);
+    }))
+        return;
     Base::Yuv444pToHsl(y, yStride, u, uStride, v, vStride, width, height, hsl, hslStride);
 }
 
@@ -6818,6 +7334,11 @@ SIMD_API void SimdYuv444pToHsv(const uint8_t * y, size_t yStride, const uint8_t
                                size_t width, size_t height, uint8_t * hsv, size_t hsvStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdYuv444pToHsv(y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, width, end - begin, hsv + begin * hsvStride, hsvStride);
+    }))
+        return;
     Base::Yuv444pToHsv(y, yStride, u, uStride, v, vStride, width, height, hsv, hsvStride);
 }
 
@@ -6879,6 +7400,11 @@ SIMD_API void SimdYuv420pToRgbV2(const uint8_t* y, size_t yStride, const uint8_t
     size_t width, size_t height, uint8_t* rgb, size_t rgbStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 2, [&](size_t begin, size_t end)
+    {
+        SimdYuv420pToRgbV2(y + begin * yStride, yStride, u + begin / 2 * uStride, uStride, v + begin / 2 * vStride, vStride, width, end - begin, rgb + begin * rgbStride, rgbStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Yuv420pToRgbV2(y, yStride, u, uStride, v, vStride, width, height, rgb, rgbStride, yuvType);
@@ -6906,6 +7432,11 @@ SIMD_API void SimdYuv422pToRgbV2(const uint8_t* y, size_t yStride, const uint8_t
     size_t width, size_t height, uint8_t* rgb, size_t rgbStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdYuv422pToRgbV2(y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, width, end - begin, rgb + begin * rgbStride, rgbStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Yuv422pToRgbV2(y, yStride, u, uStride, v, vStride, width, height, rgb, rgbStride, yuvType);
@@ -6933,6 +7464,11 @@ SIMD_API void SimdYuv444pToRgbV2(const uint8_t* y, size_t yStride, const uint8_t
     size_t width, size_t height, uint8_t* rgb, size_t rgbStride, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdYuv444pToRgbV2(y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, width, end - begin, rgb + begin * rgbStride, rgbStride, yuvType);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable)
         Avx512bw::Yuv444pToRgbV2(y, yStride, u, uStride, v, vStride, width, height, rgb, rgbStride, yuvType);
@@ -6960,6 +7496,11 @@ SIMD_API void SimdYuv444pToRgbaV2(const uint8_t* y, size_t yStride, const uint8_
     size_t width, size_t height, uint8_t* rgba, size_t rgbaStride, uint8_t alpha, SimdYuvType yuvType)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 1, [&](size_t begin, size_t end)
+    {
+        SimdYuv444pToRgbaV2(y + begin * yStride, yStride, u + begin * uStride, uStride, v + begin * vStride, vStride, width, end - begin, rgba + begin * rgbaStride, rgbaStride, alpha, yuvType);
+    }))
+        return;
 //#ifdef SIMD_AVX512BW_ENABLE
 //    if (Avx512bw::Enable)
 //        Avx512bw::Yuv444pToRgbaV2(y, yStride, u, uStride, v, vStride, width, height, rgba, rgbaStride, alpha, yuvType);
@@ -6987,6 +7528,11 @@ SIMD_API void SimdYuv420pToUyvy422(const uint8_t* y, size_t yStride, const uint8
     size_t width, size_t height, uint8_t* uyvy, size_t uyvyStride)
 {
     SIMD_EMPTY();
+    if (ParallelRowsRun(width, height, 2, [&](size_t begin, size_t end)
+    {
+        SimdYuv420pToUyvy422(y + begin * yStride, yStride, u + begin / 2 * uStride, uStride, v + begin / 2 * vStride, vStride, width, end - begin, uyvy + begin * uyvyStride, uyvyStride);
+    }))
+        return;
 #ifdef SIMD_AVX512BW_ENABLE
     if (Avx512bw::Enable && width >= Avx512bw::DA)
         Avx512bw::Yuv420pToUyvy422(y, yStride, u, uStride, v, vStride, width, height, uyvy, uyvyStride);
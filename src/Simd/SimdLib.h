@@ -274,6 +274,103 @@ typedef enum
     SimdCpuInfoCurrentFrequency, /*!< Gets CPU current frequency (for current CPU core). */
 } SimdCpuInfoType;
 
+/*! @ingroup c_types
+    Describes SIMD extensions which can be used by %Simd Library (see functions ::SimdGetIsaMask and ::SimdSetIsaMask).
+*/
+typedef enum
+{
+    SimdIsaSse41 = 1 << 0, /*!< SSE, SSE2, SSE3, SSSE3, SSE4.1, SSE4.2 (x86). */
+    SimdIsaAvx2 = 1 << 1, /*!< AVX, FMA, AVX2 (x86). */
+    SimdIsaAvx512bw = 1 << 2, /*!< AVX-512F, AVX-512BW (x86). */
+    SimdIsaAvx512vnni = 1 << 3, /*!< AVX-512VNNI (x86). */
+    SimdIsaAmxBf16 = 1 << 4, /*!< AVX-512VBMI, AVX-512BF16, AMX-BF16, AMX-INT8 (x86). */
+    SimdIsaNeon = 1 << 5, /*!< NEON (ARM). */
+    SimdIsaAll = 0x3F, /*!< All SIMD extensions. */
+} SimdIsaType;
+
+/*! @ingroup info
+    Describes performance statistics of one internal function of %Simd Library. It is used in ::SimdPerformanceStatisticItems.
+*/
+typedef struct SimdPerformanceStatisticItem
+{
+    /*!
+        A name of measured function. The pointer is valid until next call of ::SimdPerformanceStatisticItems.
+    */
+    const char * name;
+    /*!
+        An index of thread (only if statistics is collected per thread, otherwise it is equal to 0).
+    */
+    size_t thread;
+    /*!
+        A number of function calls.
+    */
+    uint64_t count;
+    /*!
+        A total execution time (in milliseconds).
+    */
+    double total;
+    /*!
+        A minimal execution time of one call (in milliseconds).
+    */
+    double min;
+    /*!
+        A maximal execution time of one call (in milliseconds).
+    */
+    double max;
+    /*!
+        A performance of function (in GFLOPS). It is equal to 0 if the number of operations is unknown.
+    */
+    double gflops;
+    /*!
+        A median (50th percentile) of execution time of one call (in milliseconds).
+    */
+    double p50;
+    /*!
+        A 90th percentile of execution time of one call (in milliseconds).
+    */
+    double p90;
+    /*!
+        A 99th percentile of execution time of one call (in milliseconds).
+    */
+    double p99;
+    /*!
+        A 99.9th percentile of execution time of one call (in milliseconds).
+    */
+    double p999;
+} SimdPerformanceStatisticItem;
+
+/*! @ingroup info
+    Describes modes of runtime cache (the cache of autotuning results of internal algorithms). It is used in ::SimdSetRuntimeCache.
+*/
+typedef enum
+{
+    SimdRuntimeCacheOff, /*!< The cache is not used (default). Internal algorithms are tuned during first calls. */
+    SimdRuntimeCacheRead, /*!< Tuning results are loaded from cache file. New results are not saved. */
+    SimdRuntimeCacheReadWrite, /*!< Tuning results are loaded from cache file. New results are saved to the file. */
+    SimdRuntimeCacheTune, /*!< Existing results are ignored. Every problem is tuned exhaustively at first call and results are saved to cache file. */
+} SimdRuntimeCacheModeType;
+
+/*! @ingroup memory
+    Describes modes of huge page backing of large memory blocks. It is used in ::SimdSetHugePageMode.
+*/
+typedef enum
+{
+    SimdHugePageOff, /*!< Huge pages are not used (default). */
+    SimdHugePageTransparent, /*!< Large blocks are aligned to 2 MB and marked with madvise(MADV_HUGEPAGE) to be backed by transparent huge pages. */
+    SimdHugePageExplicit, /*!< Large blocks are mapped from reserved pool of 2 MB huge pages (mmap with MAP_HUGETLB). If the pool is exhausted then transparent huge pages are used. */
+} SimdHugePageModeType;
+
+/*! @ingroup memory
+    Describes type of information which can return function ::SimdHugePageInfo.
+*/
+typedef enum
+{
+    SimdHugePageInfoExplicit, /*!< Current size (in bytes) of memory blocks backed by explicit huge pages. */
+    SimdHugePageInfoTransparent, /*!< Current size (in bytes) of memory blocks marked for transparent huge pages. */
+    SimdHugePageInfoRegular, /*!< Current size (in bytes) of large memory blocks backed by regular pages because huge pages are unavailable. */
+    SimdHugePageInfoFallbacks, /*!< Total number of allocations when requested kind of huge pages was unavailable. */
+} SimdHugePageInfoType;
+
 /*! @ingroup c_types
     Describes types and flags to get information about classifier cascade with using function ::SimdDetectionInfo.
     \note This type is used for implementation of Simd::Detection.
@@ -420,8 +517,56 @@ typedef enum
     SimdPixelFormatUyvy16,
     /*! A 32-bit (4 8-bit channels) ARGB (Alpha, Red, Green, Blue) pixel format. */
     SimdPixelFormatArgb32,
+    /*! A planar NV12 pixel format (8-bit Y plane and interleaved 16-bit UV plane with 2x2 subsampling). It is used only by ::SimdSynetPreprocessInit. */
+    SimdPixelFormatNv12,
+    /*! A planar YUV420P pixel format (8-bit Y, U and V planes, U and V have 2x2 subsampling). It is used only by ::SimdSynetPreprocessInit. */
+    SimdPixelFormatYuv420p,
 } SimdPixelFormatType;
 
+/*! @ingroup image_io
+    Describes image file properties which are read from its headers by function ::SimdImageProbeFromMemory.
+*/
+typedef struct SimdImageInfo
+{
+    /*!
+        A type of image file.
+    */
+    SimdImageFileType file;
+    /*!
+        A width of the image.
+    */
+    size_t width;
+    /*!
+        A height of the image.
+    */
+    size_t height;
+    /*!
+        A number of channels of the image (1 - gray, 2 - gray and alpha, 3 - color, 4 - color and alpha or CMYK).
+        For PNG image it takes into account palette and transparency chunk.
+    */
+    size_t channels;
+    /*!
+        A bit depth of one channel in image file (1, 2, 4, 8 or 16 for PNG image, 8 for other formats).
+    */
+    size_t depth;
+    /*!
+        Progressive JPEG image or interlaced (Adam7) PNG image.
+    */
+    SimdBool progressive;
+    /*!
+        A horizontal chroma subsampling factor of JPEG image (2 for 4:2:0 and 4:2:2, 1 otherwise).
+    */
+    size_t subsamplingX;
+    /*!
+        A vertical chroma subsampling factor of JPEG image (2 for 4:2:0, 1 otherwise).
+    */
+    size_t subsamplingY;
+    /*!
+        A pixel format of output image of function ::SimdImageLoadFromMemory when ::SimdPixelFormatNone is requested.
+    */
+    SimdPixelFormatType format;
+} SimdImageInfo;
+
 /*! @ingroup recursive_bilateral_filter
     Describes Recursive Bilateral Filter flags. This type used in function ::SimdRecursiveBilateralFilterInit.
 */
@@ -482,8 +627,12 @@ typedef enum
     SimdResizeMethodBicubic,
     /*! Area method. */
     SimdResizeMethodArea,
-    /*! Area method for previously reduced in 2 times image. */
+    /*! Area method for previously reduced in 2 times image. For channel types other than ::SimdResizeChannelByte it is equal to ::SimdResizeMethodArea. */
     SimdResizeMethodAreaFast,
+    /*! Lanczos method with 3 lobes (Lanczos3). */
+    SimdResizeMethodLanczos,
+    /*! Separable kernel method with user defined kernel. It is used only by ::SimdResizerInitKernel. */
+    SimdResizeMethodKernel,
 } SimdResizeMethodType;
 
 /*! @ingroup synet_types
@@ -815,6 +964,49 @@ extern "C"
     */
     SIMD_API uint64_t SimdCpuInfo(SimdCpuInfoType type);
 
+    /*! @ingroup info
+
+        \fn uint32_t SimdGetIsaMask();
+
+        \short Gets SIMD extensions which are currently used by %Simd Library.
+
+        \note See enumeration ::SimdIsaType. An extension is used if it is supported by CPU, enabled at compile time and is not disabled by function ::SimdSetIsaMask.
+
+        \return a bit mask of used SIMD extensions.
+    */
+    SIMD_API uint32_t SimdGetIsaMask();
+
+    /*! @ingroup info
+
+        \fn void SimdSetIsaMask(uint32_t mask);
+
+        \short Restricts SIMD extensions which can be used by %Simd Library.
+
+        All functions of %Simd Library choose their implementation with using of this mask. 
+        Extensions which are not supported by CPU are ignored. 
+        An extension is also disabled when a lower extension is disabled (for example AVX-512BW requires AVX2).
+        By default all supported extensions are used (::SimdIsaAll).
+
+        \note Contexts which were created earlier (for example by ::SimdSynetConvolution32fInit or ::SimdResizerInit) keep their implementation.
+            The function may be called concurrently with other functions of the library: a call which is already running finishes with the previous implementation.
+
+        Using example:
+        \verbatim
+        #include "Simd/SimdLib.h"
+
+        int main()
+        {
+            SimdSetIsaMask(SimdIsaSse41 | SimdIsaAvx2); // to avoid AVX-512 frequency throttling.
+            ...
+            SimdSetIsaMask(SimdIsaAll); // to restore all extensions.
+            return 0;
+        }
+        \endverbatim
+
+        \param [in] mask - a bit mask of allowed SIMD extensions (see ::SimdIsaType).
+    */
+    SIMD_API void SimdSetIsaMask(uint32_t mask);
+
     /*! @ingroup info
 
         \fn const char *SimdPerformanceStatistic();
@@ -827,6 +1019,69 @@ extern "C"
     */
     SIMD_API const char * SimdPerformanceStatistic();
 
+    /*! @ingroup info
+
+        \fn size_t SimdPerformanceStatisticItems(SimdPerformanceStatisticItem * items, size_t size, SimdBool threads);
+
+        \short Gets internal performance statistics of %Simd Library in structured form.
+
+        Percentiles of execution time are estimated with log-scale histogram (relative error is less then 1/16).
+
+        \note %Simd Library have to be build with defined SIMD_PERFORMANCE_STATISTIC macro.
+
+        \param [out] items - a pointer to array of statistics items. It can be NULL (to query the number of items).
+        \param [in] size - a size of array of statistics items.
+        \param [in] threads - a flag to return statistics per thread. Otherwise statistics of all threads are combined.
+        \return total number of statistics items. If it is greater than size then only first size items are filled.
+    */
+    SIMD_API size_t SimdPerformanceStatisticItems(SimdPerformanceStatisticItem * items, size_t size, SimdBool threads);
+
+    /*! @ingroup info
+
+        \fn const char * SimdPerformanceStatisticJson(SimdBool threads);
+
+        \short Gets internal performance statistics of %Simd Library in JSON format.
+
+        \note %Simd Library have to be build with defined SIMD_PERFORMANCE_STATISTIC macro.
+
+        \param [in] threads - a flag to return statistics per thread. Otherwise statistics of all threads are combined.
+        \return string with internal performance statistics in JSON format. It is valid until next call of this function.
+    */
+    SIMD_API const char * SimdPerformanceStatisticJson(SimdBool threads);
+
+    /*! @ingroup info
+
+        \fn void SimdPerformanceStatisticReset();
+
+        \short Resets internal performance statistics of %Simd Library.
+
+        It allows to collect statistics of separate stages of application (for example after warm-up).
+
+        \note %Simd Library have to be build with defined SIMD_PERFORMANCE_STATISTIC macro.
+    */
+    SIMD_API void SimdPerformanceStatisticReset();
+
+    /*! @ingroup info
+
+        \fn SimdBool SimdSetRuntimeCache(const char * path, SimdRuntimeCacheModeType mode);
+
+        \short Sets file of runtime cache of %Simd Library.
+
+        Some internal algorithms (for example GEMM and direct convolution in ::SimdSynetConvolution32fForward) have several implementations. 
+        By default the fastest one is chosen by timing of first calls of every problem. It makes first calls slow and the choice may vary between runs.
+        Runtime cache stores the choice (for given CPU, extensions, number of threads and problem shape) in text file and loads it at next start.
+
+        Offline tuning of a model: call this function with ::SimdRuntimeCacheTune mode and run the model once. 
+        After that use ::SimdRuntimeCacheRead mode in production.
+
+        \note The cache file should be set before creation of contexts of internal algorithms (for example ::SimdSynetConvolution32fInit).
+
+        \param [in] path - a path to cache file. It can be NULL if mode is ::SimdRuntimeCacheOff.
+        \param [in] mode - a mode of runtime cache.
+        \return result of the operation: ::SimdFalse if the file can't be read (for ::SimdRuntimeCacheRead mode) or written (in other modes).
+    */
+    SIMD_API SimdBool SimdSetRuntimeCache(const char * path, SimdRuntimeCacheModeType mode);
+
     /*! @ingroup memory
 
         \fn void * SimdAllocate(size_t size, size_t align);
@@ -889,12 +1144,43 @@ extern "C"
     */    
     SIMD_API void SimdRelease(void * context);
 
+    /*! @ingroup memory
+
+        \fn SimdBool SimdSetHugePageMode(SimdHugePageModeType mode, size_t threshold);
+
+        \short Sets huge page backing mode of large memory blocks allocated by %Simd Library.
+
+        It affects ::SimdAllocate and all internal buffers (for example buffers of GEMM and Synet contexts) with size not less than threshold.
+        Huge pages reduce TLB misses for large working sets. If requested kind of huge pages is unavailable then allocation falls back to regular pages.
+        The mode is supported only on Linux. 
+
+        \note The function should be called before creation of contexts which buffers have to be affected.
+
+        \param [in] mode - a huge page mode.
+        \param [in] threshold - a minimal size of memory block backed by huge pages. If it is 0 then default value (2 MB) is used.
+        \return ::SimdTrue if requested kind of huge pages is supported by the system and ::SimdFalse otherwise (the mode is still set and allocations fall back to regular pages).
+    */
+    SIMD_API SimdBool SimdSetHugePageMode(SimdHugePageModeType mode, size_t threshold);
+
+    /*! @ingroup memory
+
+        \fn size_t SimdHugePageInfo(SimdHugePageInfoType type);
+
+        \short Gets statistics about backing of large memory blocks allocated when huge page mode is enabled (see ::SimdSetHugePageMode).
+
+        \param [in] type - a type of requested information.
+        \return a value which contains requested information.
+    */
+    SIMD_API size_t SimdHugePageInfo(SimdHugePageInfoType type);
+
     /*! @ingroup thread
 
         \fn size_t SimdGetThreadNumber();
 
         \short Gets number of threads used by Simd Library to parallelize some algorithms.
 
+        \note If a thread pool is bound to current thread (see ::SimdThreadPoolBind) then it returns thread number of this pool.
+
         \return current thread number.
     */
     SIMD_API size_t SimdGetThreadNumber();
@@ -905,10 +1191,61 @@ extern "C"
 
         \short Sets number of threads used by Simd Library to parallelize some algorithms.
 
+        \note Simd Library keeps a pool of (threadNumber - 1) persistent worker threads (see Simd::ThreadPool).
+            This function creates or stops these workers. The calling thread is also used for computation.
+
         \param [in] threadNumber - a number of threads.
     */
     SIMD_API void SimdSetThreadNumber(size_t threadNumber);
 
+    /*! @ingroup thread
+
+        \fn SimdBool SimdSetThreadAffinity(const size_t * cpus, size_t count);
+
+        \short Restricts worker threads of global thread pool of Simd Library to given set of CPUs.
+
+        Existing workers are moved at once, workers started later by ::SimdSetThreadNumber are started on these CPUs. 
+        The calling thread (which also takes part in computation) is not affected.
+
+        \note It is supported only on Linux.
+
+        \param [in] cpus - a pointer to array with CPU indices. It can be NULL if count is 0.
+        \param [in] count - a number of CPUs. Zero value removes the restriction.
+        \return result of the operation.
+    */
+    SIMD_API SimdBool SimdSetThreadAffinity(const size_t * cpus, size_t count);
+
+    /*! @ingroup thread
+
+        \fn void * SimdThreadPoolInit(size_t threadNumber, const size_t * cpus, size_t count);
+
+        \short Creates an independent thread pool with its own thread number and CPU affinity.
+
+        The pool is used by all multithreaded algorithms called from a thread which the pool is bound to (see ::SimdThreadPoolBind).
+        It allows to run several pipelines in one process, each on its own cores, without interference with global pool (see ::SimdSetThreadNumber).
+
+        \param [in] threadNumber - a number of threads of the pool (the pool has threadNumber - 1 workers, the calling thread is also used for computation).
+        \param [in] cpus - a pointer to array with CPU indices of worker threads (see ::SimdSetThreadAffinity). It can be NULL if count is 0.
+        \param [in] count - a number of CPUs. Zero value means that there is no restriction.
+        \return a pointer to thread pool context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+            Release of the pool which is still used by other threads is undefined behavior.
+    */
+    SIMD_API void * SimdThreadPoolInit(size_t threadNumber, const size_t * cpus, size_t count);
+
+    /*! @ingroup thread
+
+        \fn void SimdThreadPoolBind(void * pool);
+
+        \short Binds a thread pool to current thread.
+
+        After that all multithreaded algorithms called from current thread (for example ::SimdGemm32fNN or ::SimdSynetConvolution32fForward) use this pool,
+        and ::SimdGetThreadNumber returns its thread number. Contexts which cache thread number (for example ::SimdSynetConvolution32fInit) 
+        should be created after binding.
+
+        \param [in] pool - a pointer to thread pool context created by function ::SimdThreadPoolInit. NULL restores using of global thread pool.
+    */
+    SIMD_API void SimdThreadPoolBind(void * pool);
+
     /*! @ingroup cpu_flags
 
         \fn void SimdEmpty();
@@ -975,6 +1312,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::AbsDifference(const View<A> & a, const View<A> & b, View<A> & c).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] a - a pointer to pixels data of first image.
         \param [in] aStride - a row size of first image.
         \param [in] b - a pointer to pixels data of second image.
@@ -1744,6 +2083,8 @@ extern "C"
         \note This function has C++ wrappers: Simd::BgraToBgr(const View<A>& bgra, View<A>& bgr)
             and Simd::RgbaToRgb(const View<A>& rgba, View<A>& rgb).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgra - a pointer to pixels data of input 32-bit BGRA (or 32-bit RGBA) image.
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -1763,6 +2104,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::BgraToGray(const View<A>& bgra, View<A>& gray).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgra - a pointer to pixels data of input 32-bit BGRA image.
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -1783,6 +2126,8 @@ extern "C"
         \note This function has C++ wrappers: Simd::BgraToRgb(const View<A>& bgra, View<A>& rgb)
             and Simd::RgbaToBgr(const View<A>& rgba, View<A>& bgr).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgra - a pointer to pixels data of input 32-bit BGRA (or 32-bit RGBA) image.
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -1803,6 +2148,8 @@ extern "C"
         \note This function has C++ wrappers: Simd::BgraToRgba(const View<A>& bgra, View<A>& rgba)
             and Simd::RgbaToBgra(const View<A>& rgba, View<A>& bgra).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgra - a pointer to pixels data of input 32-bit BGRA (or 32-bit RGBA) image.
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -1823,6 +2170,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::BgraToYuv420p(const View<A>& bgra, View<A>& y, View<A>& u, View<A>& v, SimdYuvType yuvType = SimdYuvBt601).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgra - a pointer to pixels data of input 32-bit BGRA image.
         \param [in] bgraStride - a row size of the BGRA image.
         \param [in] width - an image width.
@@ -1848,6 +2197,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::BgraToYuv422p(const View<A>& bgra, View<A>& y, View<A>& u, View<A>& v, SimdYuvType yuvType = SimdYuvBt601).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgra - a pointer to pixels data of input 32-bit BGRA image.
         \param [in] bgraStride - a row size of the BGRA image.
         \param [in] width - an image width.
@@ -1872,6 +2223,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::BgraToYuv444p(const View<A>& bgra, View<A>& y, View<A>& u, View<A>& v, SimdYuvType yuvType = SimdYuvBt601).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgra - a pointer to pixels data of input 32-bit BGRA image.
         \param [in] bgraStride - a row size of the BGRA image.
         \param [in] width - an image width.
@@ -1898,6 +2251,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::BgraToYuva420p(const View<A> & bgra, View<A> & y, View<A> & u, View<A> & v, View<A> & a, SimdYuvType yuvType = SimdYuvBt601).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgra - a pointer to pixels data of input 32-bit BGRA image.
         \param [in] bgraStride - a row size of the BGRA image.
         \param [in] width - an image width.
@@ -1945,6 +2300,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::BgrToBgra(const View<A>& bgr, View<A>& bgra, uint8_t alpha).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgr - a pointer to pixels data of input 24-bit BGR image.
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -1965,6 +2322,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::Bgr48pToBgra32(const View<A>& blue, const View<A>& green, const View<A>& red, View<A>& bgra, uint8_t alpha).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] blue - a pointer to pixels data of input 16-bit image with blue color plane.
         \param [in] blueStride - a row size of the blue image.
         \param [in] width - an image width.
@@ -1990,6 +2349,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::BgrToGray(const View<A>& bgr, View<A>& gray).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgr - a pointer to pixels data of input 24-bit BGR image.
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -2009,6 +2370,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::BgrToHsl(const View<A>& bgr, View<A>& hsl).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgr - a pointer to pixels data of input 24-bit BGR image.
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -2028,6 +2391,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::BgrToHsv(const View<A>& bgr, View<A>& hsv).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgr - a pointer to pixels data of input 24-bit BGR image.
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -2048,6 +2413,8 @@ extern "C"
         \note This function has C++ wrappers: Simd::BgrToRgb(const View<A> & bgr, View<A> & rgb) 
             and Simd::RgbToBgr(const View<A>& rgb, View<A>& bgr).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgr - a pointer to pixels data of input 24-bit BGR image (or 24-bit RGB image).
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -2069,6 +2436,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::BgrToYuv420p(const View<A>& bgr, View<A>& y, View<A>& u, View<A>& v, SimdYuvType yuvType = SimdYuvBt601).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgr - a pointer to pixels data of input 24-bit BGR image.
         \param [in] bgrStride - a row size of the BGR image.
         \param [in] width - an image width.
@@ -2094,6 +2463,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::BgrToYuv422p(const View<A>& bgr, View<A>& y, View<A>& u, View<A>& v, SimdYuvType yuvType = SimdYuvBt601).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgr - a pointer to pixels data of input 24-bit BGR image.
         \param [in] bgrStride - a row size of the BGR image.
         \param [in] width - an image width.
@@ -2118,6 +2489,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::BgrToYuv444p(const View<A>& bgr, View<A>& y, View<A>& u, View<A>& v, SimdYuvType yuvType = SimdYuvBt601).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] bgr - a pointer to pixels data of input 24-bit BGR image.
         \param [in] bgrStride - a row size of the BGR image.
         \param [in] width - an image width.
@@ -3417,6 +3790,8 @@ extern "C"
         \note This function has C++ wrappers: Simd::GrayToBgr(const View<A>& gray, View<A>& bgr) 
             and Simd::GrayToRgb(const View<A>& gray, View<A>& rgb).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] gray - a pointer to pixels data of input 8-bit gray image.
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -3437,6 +3812,8 @@ extern "C"
         \note This function has C++ wrappers: Simd::GrayToBgra(const View<A>& gray, View<A>& bgra, uint8_t alpha) 
             and Simd::GrayToRgba(const View<A>& gray, View<A>& rgba, uint8_t alpha).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] gray - a pointer to pixels data of input 8-bit gray image.
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -3458,6 +3835,8 @@ extern "C"
 
         \note This function has C++ wrappers: Simd::GrayToY(const View<A>& gray, View<A>& y).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] gray - a pointer to pixels data of input 8-bit gray image.
         \param [in] grayStride - a row size of the gray image.
         \param [in] width - an image width.
@@ -3727,6 +4106,8 @@ extern "C"
             Supported pixel formats: ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, ::SimdPixelFormatBgra32, ::SimdPixelFormatRgb24, ::SimdPixelFormatRgba32.
         \param [in] file - a format of output image file. To auto choise format of output file set this parameter to ::SimdImageFileUndefined.
         \param [in] quality - a parameter of compression quality (if file format supports it).
+            For PNG negative values select a fast compression level: -1 - stored blocks without compression (the fastest), -2 - Huffman coding only, 
+            -3 - Huffman coding of literals and runs of repeated bytes (RLE). Other values use full LZ77 compression (the smallest file).
         \param [out] size - a pointer to the size of output image file in bytes.
         \return a pointer to memory buffer with output image file. 
             It has to be deleted after use by function ::SimdFree. On error it returns NULL.
@@ -3749,6 +4130,8 @@ extern "C"
             Supported pixel formats: ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, ::SimdPixelFormatBgra32, ::SimdPixelFormatRgb24, ::SimdPixelFormatRgba32.
         \param [in] file - a format of output image file. To auto choise format of output file set this parameter to ::SimdImageFileUndefined.
         \param [in] quality - a parameter of compression quality (if file format supports it).
+            For PNG negative values select a fast compression level: -1 - stored blocks without compression (the fastest), -2 - Huffman coding only, 
+            -3 - Huffman coding of literals and runs of repeated bytes (RLE). Other values use full LZ77 compression (the smallest file).
         \param [in] path - a path to output image file.
         \return result of the operation.
     */
@@ -3838,6 +4221,140 @@ extern "C"
     */
     SIMD_API uint8_t* SimdImageLoadFromFile(const char* path, size_t* stride, size_t* width, size_t* height, SimdPixelFormatType * format);
 
+    /*! @ingroup image_io
+
+        \fn SimdBool SimdImageProbeFromMemory(const uint8_t* data, size_t size, SimdImageInfo * info);
+
+        \short Gets properties of an image in memory buffer without its decoding.
+
+        Only image headers are parsed (PGM/PPM header, PNG chunks before image data, JPEG markers before frame header), 
+        compressed or entropy-coded image data are not touched. So it is much faster than ::SimdImageLoadFromMemory 
+        and can be used in order to reject too large images or to allocate output buffers in advance.
+
+        \param [in] data - a pointer to memory buffer with input image file.
+        \param [in] size - a size of input image file in bytes.
+        \param [out] info - a pointer to structure with image properties.
+        \return result of the operation.
+    */
+    SIMD_API SimdBool SimdImageProbeFromMemory(const uint8_t* data, size_t size, SimdImageInfo * info);
+
+    /*! @ingroup image_io
+
+        \fn void * SimdJpegDecoderInit();
+
+        \short Creates reusable JPEG decoder.
+
+        The decoder keeps its internal state (Huffman and quantization tables, buffers of image components and color conversion) between images.
+        So decoding of a stream of images with the same geometry (for example MJPEG frames) does not allocate memory after the first image.
+        Typical use: 
+        
+        \verbatim
+        void * decoder = SimdJpegDecoderInit();
+        for (each frame)
+        {
+            size_t width, height;
+            if (SimdJpegDecoderParse(decoder, data, size, &width, &height))
+            {
+                // check size or (re)allocate output buffer here.
+                SimdJpegDecoderDecode(decoder, bgr, stride, SimdPixelFormatBgr24);
+            }
+        }
+        SimdRelease(decoder);
+        \endverbatim
+
+        \return a pointer to JPEG decoder context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+    */
+    SIMD_API void * SimdJpegDecoderInit();
+
+    /*! @ingroup image_io
+
+        \fn SimdBool SimdJpegDecoderSetScale(void * decoder, size_t denominator);
+
+        \short Sets scale of output image of JPEG decoder. 
+
+        Scaled decoding is performed in DCT domain: reduced inverse DCT (4x4, 2x2 or DC only) is used instead of full 8x8 one,
+        and color conversion works with reduced image. So it is several times faster than full decoding with following resizing.
+        Output image has size ((width + denominator - 1) / denominator, (height + denominator - 1) / denominator).
+        The scale is applied to all following images (see ::SimdJpegDecoderParse).
+
+        \param [in, out] decoder - a JPEG decoder context. It must be created by function ::SimdJpegDecoderInit and released by function ::SimdRelease.
+        \param [in] denominator - a denominator of the scale. It can be 1 (default), 2, 4 or 8.
+        \return result of the operation.
+    */
+    SIMD_API SimdBool SimdJpegDecoderSetScale(void * decoder, size_t denominator);
+
+    /*! @ingroup image_io
+
+        \fn SimdBool SimdJpegDecoderParse(void * decoder, const uint8_t * data, size_t size, size_t * width, size_t * height);
+
+        \short Parses headers of JPEG image and gets its size. 
+
+        Entropy-coded data is decoded later by function ::SimdJpegDecoderDecode. 
+        The memory buffer with input image must be valid until the end of decoding.
+
+        \param [in, out] decoder - a JPEG decoder context. It must be created by function ::SimdJpegDecoderInit and released by function ::SimdRelease.
+        \param [in] data - a pointer to memory buffer with input JPEG image.
+        \param [in] size - a size of input JPEG image in bytes.
+        \param [out] width - a pointer to width of output image (it takes into account scale set by ::SimdJpegDecoderSetScale). It can be NULL.
+        \param [out] height - a pointer to height of output image (it takes into account scale set by ::SimdJpegDecoderSetScale). It can be NULL.
+        \return result of the operation.
+    */
+    SIMD_API SimdBool SimdJpegDecoderParse(void * decoder, const uint8_t * data, size_t size, size_t * width, size_t * height);
+
+    /*! @ingroup image_io
+
+        \fn SimdBool SimdJpegDecoderDecode(void * decoder, uint8_t * dst, size_t stride, SimdPixelFormatType format);
+
+        \short Decodes JPEG image (previously parsed by function ::SimdJpegDecoderParse) into caller-supplied buffer.
+
+        \param [in, out] decoder - a JPEG decoder context. It must be created by function ::SimdJpegDecoderInit and released by function ::SimdRelease.
+        \param [out] dst - a pointer to pixels data of output image. Its size must be equal to the size returned by ::SimdJpegDecoderParse.
+        \param [in] stride - a row size of output image in bytes.
+        \param [in] format - a pixel format of output image. It can be ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, ::SimdPixelFormatBgra32, ::SimdPixelFormatRgb24, ::SimdPixelFormatRgba32.
+        \return result of the operation.
+    */
+    SIMD_API SimdBool SimdJpegDecoderDecode(void * decoder, uint8_t * dst, size_t stride, SimdPixelFormatType format);
+
+    /*! @ingroup image_io
+
+        \fn SimdBool SimdJpegDecoderDecodeYuv420p(void * decoder, uint8_t * y, size_t yStride, uint8_t * u, size_t uStride, uint8_t * v, size_t vStride);
+
+        \short Decodes JPEG image (previously parsed by function ::SimdJpegDecoderParse) into caller-supplied YUV420P planes.
+
+        Decoded YCbCr planes of 4:2:0 JPEG image are copied without color conversion and chroma upsampling.
+        Output planes have full range (::SimdYuvTrect871), so they can be saved back by function ::SimdYuv420pSaveAsJpegToMemory with this YUV type.
+        For grayscale JPEG image U and V planes are filled by value 128. Other JPEG images (4:4:4, 4:2:2, RGB, CMYK) are not supported.
+
+        \param [in, out] decoder - a JPEG decoder context. It must be created by function ::SimdJpegDecoderInit and released by function ::SimdRelease.
+        \param [out] y - a pointer to pixels data of output 8-bit image with Y color plane. Its size must be equal to the size returned by ::SimdJpegDecoderParse.
+        \param [in] yStride - a row size of the y image.
+        \param [out] u - a pointer to pixels data of output 8-bit image with U color plane. Its size is ((width + 1) / 2, (height + 1) / 2).
+        \param [in] uStride - a row size of the u image.
+        \param [out] v - a pointer to pixels data of output 8-bit image with V color plane. Its size is ((width + 1) / 2, (height + 1) / 2).
+        \param [in] vStride - a row size of the v image.
+        \return result of the operation.
+    */
+    SIMD_API SimdBool SimdJpegDecoderDecodeYuv420p(void * decoder, uint8_t * y, size_t yStride, uint8_t * u, size_t uStride, uint8_t * v, size_t vStride);
+
+    /*! @ingroup image_io
+
+        \fn SimdBool SimdJpegDecoderDecodeNv12(void * decoder, uint8_t * y, size_t yStride, uint8_t * uv, size_t uvStride);
+
+        \short Decodes JPEG image (previously parsed by function ::SimdJpegDecoderParse) into caller-supplied NV12 planes.
+
+        Decoded YCbCr planes of 4:2:0 JPEG image are copied without color conversion and chroma upsampling (U and V planes are interleaved).
+        Output planes have full range (::SimdYuvTrect871), so they can be saved back by function ::SimdNv12SaveAsJpegToMemory with this YUV type.
+        For grayscale JPEG image UV plane is filled by value 128. Other JPEG images (4:4:4, 4:2:2, RGB, CMYK) are not supported.
+
+        \param [in, out] decoder - a JPEG decoder context. It must be created by function ::SimdJpegDecoderInit and released by function ::SimdRelease.
+        \param [out] y - a pointer to pixels data of output 8-bit image with Y color plane. Its size must be equal to the size returned by ::SimdJpegDecoderParse.
+        \param [in] yStride - a row size of the y image.
+        \param [out] uv - a pointer to pixels data of output 16-bit image with interleaved UV color planes. Its size is ((width + 1) / 2, (height + 1) / 2).
+        \param [in] uvStride - a row size of the uv image.
+        \return result of the operation.
+    */
+    SIMD_API SimdBool SimdJpegDecoderDecodeNv12(void * decoder, uint8_t * y, size_t yStride, uint8_t * uv, size_t uvStride);
+
     /*! @ingroup other_conversion
 
         \fn void SimdInt16ToGray(const uint8_t * src, size_t width, size_t height, size_t srcStride, uint8_t * dst, size_t dstStride);
@@ -3853,6 +4370,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::Int16ToGray(const View<A> & src, View<A> & dst).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] src - a pointer to pixels data of input 16-bit signed integer image.
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -5095,6 +5614,41 @@ extern "C"
     */
     SIMD_API void * SimdResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
 
+    /*! @ingroup resizing
+
+        \fn void * SimdResizerInitKernel(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, const float * kernel, size_t size, float support);
+
+        \short Creates resize context with user defined separable kernel.
+
+        The kernel K(x) is assumed to be symmetric (K(-x) = K(x)) and equal to zero for |x| >= support.
+        It is set by samples in uniform grid: kernel[i] = K(i * support / (size - 1)), values between samples are linearly interpolated.
+        The kernel is stretched in case of downscaling, weights of every output pixel are normalized to unit sum.
+
+        An using example (resize with Mitchell-Netravali filter):
+        \verbatim
+        void * resizer = SimdResizerInitKernel(srcX, srcY, dstX, dstY, 3, SimdResizeChannelByte, mitchell, 1025, 2.0f);
+        if (resizer)
+        {
+             SimdResizerRun(resizer, src, srcStride, dst, dstStride);
+             SimdRelease(resizer);
+        }
+        \endverbatim
+
+        \param [in] srcX - a width of the input image.
+        \param [in] srcY - a height of the input image.
+        \param [in] dstX - a width of the output image.
+        \param [in] dstY - a height of the output image.
+        \param [in] channels - a channel number of input and output image.
+        \param [in] type - a type of input and output image channel.
+        \param [in] kernel - a pointer to kernel samples. The samples are copied into resize context.
+        \param [in] size - a number of kernel samples. It must be at least 2.
+        \param [in] support - a support (radius) of the kernel. It must be positive.
+        \return a pointer to resize context. On error it returns NULL.
+                This pointer is used in functions ::SimdResizerRun.
+                It must be released with using of function ::SimdRelease.
+    */
+    SIMD_API void * SimdResizerInitKernel(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, const float * kernel, size_t size, float support);
+
     /*! @ingroup resizing
 
         \fn void SimdResizerRun(const void * resizer, const uint8_t * src, size_t srcStride, uint8_t * dst, size_t dstStride);
@@ -5106,9 +5660,66 @@ extern "C"
         \param [in] srcStride - a row size (in bytes) of the input image.
         \param [out] dst - a pointer to pixels data of the resized output image.
         \param [in] dstStride - a row size (in bytes) of the output image.
+
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+            Output rows are split into bands, each band is processed by its own copy of resize context with own row buffers.
     */
     SIMD_API void SimdResizerRun(const void * resizer, const uint8_t * src, size_t srcStride, uint8_t * dst, size_t dstStride);
 
+    /*! @ingroup resizing
+
+        \fn void * SimdResizerBatchInit(size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
+
+        \short Creates context of batched crop-and-resize.
+
+        This context crops a set of regions (ROIs) from one input image and resizes each of them to the same output size.
+        Resize contexts of ROIs with equal size are shared, so their coefficients are computed only once.
+        For bilinear resize of 8-bit channels each thread keeps one resize context and rebuilds its coefficients in place for ROIs of other size.
+
+        An using example (crop and resize of detected faces in BGR24 image):
+        \verbatim
+        void * resizer = SimdResizerBatchInit(112, 112, 3, SimdResizeChannelByte, SimdResizeMethodBilinear);
+        if (resizer)
+        {
+             SimdResizerBatchRun(resizer, src, srcX, srcY, srcStride, rois, count, dst, 112 * 3);
+             SimdRelease(resizer);
+        }
+        \endverbatim
+
+        \param [in] dstX - a width of the output images.
+        \param [in] dstY - a height of the output images.
+        \param [in] channels - a channel number of input and output images.
+        \param [in] type - a type of input and output image channel.
+        \param [in] method - a method used in order to resize images. It supports the same methods as ::SimdResizerInit.
+        \return a pointer to batched resize context. On error it returns NULL.
+                This pointer is used in functions ::SimdResizerBatchRun.
+                It must be released with using of function ::SimdRelease.
+    */
+    SIMD_API void * SimdResizerBatchInit(size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
+
+    /*! @ingroup resizing
+
+        \fn SimdBool SimdResizerBatchRun(const void * resizer, const uint8_t * src, size_t srcX, size_t srcY, size_t srcStride, const size_t * rois, size_t count, uint8_t * dst, size_t dstStride);
+
+        \short Crops regions from the input image and resizes them to the output size.
+
+        \param [in] resizer - a batched resize context. It must be created by function ::SimdResizerBatchInit and released by function ::SimdRelease.
+        \param [in] src - a pointer to pixels data of the input image.
+        \param [in] srcX - a width of the input image.
+        \param [in] srcY - a height of the input image.
+        \param [in] srcStride - a row size (in bytes) of the input image.
+        \param [in] rois - a pointer to array of regions. Each region is set by 4 values: left, top, right, bottom (in pixels). 
+            Each region must be non-empty (left < right, top < bottom) and lie inside the input image.
+        \param [in] count - a number of regions.
+        \param [out] dst - a pointer to pixels data of the output images. Output image of i-th region starts at (dst + i * dstY * dstStride).
+        \param [in] dstStride - a row size (in bytes) of the output images.
+        \return a result of the operation. If any region is empty, inverted or lies outside the input image the function returns ::SimdFalse and does not change output images.
+
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+            Regions are distributed between threads, each thread uses its own cache of resize contexts.
+    */
+    SIMD_API SimdBool SimdResizerBatchRun(const void * resizer, const uint8_t * src, size_t srcX, size_t srcY, size_t srcStride, const size_t * rois, size_t count, uint8_t * dst, size_t dstStride);
+
     /*! @ingroup rgb_conversion
 
         \fn void SimdRgbToBgra(const uint8_t * rgb, size_t width, size_t height, size_t rgbStride, uint8_t * bgra, size_t bgraStride, uint8_t alpha);
@@ -5120,6 +5731,8 @@ extern "C"
         \note This function has C++ wrappers: Simd::RgbToBgra(const View<A>& rgb, View<A>& bgra, uint8_t alpha)
             and Simd::BgrToRgba(const View<A>& bgr, View<A>& rgba, uint8_t alpha).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] rgb - a pointer to pixels data of input 24-bit RGB (or 24-bit BGR) image.
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -5140,6 +5753,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::RgbToGray(const View<A>& rgb, View<A>& gray).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] rgb - a pointer to pixels data of input 24-bit RGB image.
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -5159,6 +5774,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::RgbaToGray(const View<A>& rgba, View<A>& gray).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] rgba - a pointer to pixels data of input 32-bit RGBA image.
         \param [in] width - an image width.
         \param [in] height - an image height.
@@ -7447,6 +8064,59 @@ extern "C"
     */
     SIMD_API void SimdSynetPreluLayerForward(const float * src, const float * slope, size_t channels, size_t spatial, float * dst, SimdTensorFormatType format);
 
+    /*! @ingroup synet_conversion
+
+        \fn void* SimdSynetPreprocessInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels, SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat);
+
+        \short Initilizes fused preprocessing of image for input of neural network of <a href="http://github.com/ermig1979/Synet">Synet Framework</a>.
+
+        It performs color conversion, resizing and normalization in one pass (without intermediate image).
+        Normalization is the same as in function ::SimdSynetSetInput:
+        \verbatim
+        dst[c] = resized[c]*(upper[c] - lower[c])/255 + lower[c];
+        \endverbatim
+        Output channel order is BGR (RGB order can be obtained for packed input images by exchange of ::SimdPixelFormatBgr24 <-> ::SimdPixelFormatRgb24 and
+        ::SimdPixelFormatBgra32 <-> ::SimdPixelFormatRgba32). For 8-bit unsigned integer output tensor values are rounded and saturated to range [0..255].
+
+        \param [in] srcW - a width of input image.
+        \param [in] srcH - a height of input image.
+        \param [in] srcFormat - a pixel format of input image. There are supported following pixel formats: ::SimdPixelFormatGray8, ::SimdPixelFormatBgr24, 
+            ::SimdPixelFormatBgra32, ::SimdPixelFormatRgb24, ::SimdPixelFormatRgba32, ::SimdPixelFormatNv12, ::SimdPixelFormatYuv420p (the last two require even width and height).
+        \param [in] yuvType - a type of YUV to BGR conversion (it is used only for ::SimdPixelFormatNv12 and ::SimdPixelFormatYuv420p input).
+        \param [in] dstW - a width of output image tensor.
+        \param [in] dstH - a height of output image tensor.
+        \param [in] channels - a number of channels in the output image tensor. It can be 1 or 3.
+        \param [in] method - a resize method. It can be ::SimdResizeMethodBilinear, ::SimdResizeMethodArea or ::SimdResizeMethodAreaFast (equal to ::SimdResizeMethodArea).
+            Area method uses bilinear interpolation in directions of upscaling.
+        \param [in] lower - a pointer to the array with lower bound of values of the output tensor. Its size must be equal to number of channels.
+        \param [in] upper - a pointer to the array with upper bound of values of the output tensor. Its size must be equal to number of channels.
+        \param [in] dstType - a type of output tensor. It can be ::SimdTensorData32f, ::SimdTensorData16b or ::SimdTensorData8u.
+        \param [in] dstFormat - a format of output image tensor. It can be ::SimdTensorFormatNchw or ::SimdTensorFormatNhwc.
+        \return a pointer to preprocessing context. On error it returns NULL. It must be released with using of function ::SimdRelease.
+            This pointer is used in function ::SimdSynetPreprocessForward.
+    */
+    SIMD_API void* SimdSynetPreprocessInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels,
+        SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat);
+
+    /*! @ingroup synet_conversion
+
+        \fn void SimdSynetPreprocessForward(void* context, const uint8_t* src, size_t srcStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, uint8_t* dst);
+
+        \short Performs fused preprocessing of image for input of neural network.
+
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber). Output rows are split into bands.
+
+        \param [in] context - a pointer to preprocessing context. It must be created by function ::SimdSynetPreprocessInit and released by function ::SimdRelease.
+        \param [in] src - a pointer to pixels data of input packed image (or to Y plane for ::SimdPixelFormatNv12 and ::SimdPixelFormatYuv420p).
+        \param [in] srcStride - a row size of input image (or of Y plane).
+        \param [in] u - a pointer to U plane for ::SimdPixelFormatYuv420p or to interleaved UV plane for ::SimdPixelFormatNv12. It is ignored for packed images.
+        \param [in] uStride - a row size of U (or UV) plane.
+        \param [in] v - a pointer to V plane for ::SimdPixelFormatYuv420p. It is ignored for other formats.
+        \param [in] vStride - a row size of V plane.
+        \param [out] dst - a pointer to the output image tensor.
+    */
+    SIMD_API void SimdSynetPreprocessForward(void* context, const uint8_t* src, size_t srcStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, uint8_t* dst);
+
     /*! @ingroup synet_activation
 
         \fn void SimdSynetRelu32f(const float* src, size_t size, const float* slope, float* dst);
@@ -7798,6 +8468,51 @@ extern "C"
     */
     SIMD_API void SimdSynetUnaryOperation32f(const float * src, size_t size, SimdSynetUnaryOperation32fType type, float * dst);
 
+    /*! @ingroup synet_workspace
+
+        \fn void * SimdSynetWorkspaceInit();
+
+        \short Initilizes workspace (shared external buffer) for Synet contexts.
+
+        By default every Synet context (for example created by ::SimdSynetConvolution32fInit) allocates its own external buffer 
+        if it is not passed to forward function (buffer is NULL). A workspace allows many contexts to share one buffer 
+        (its size is equal to maximal requirement of them). Contexts are attached to workspace with using of function ::SimdSynetSetWorkspace.
+
+        \note Contexts which share workspace must not be executed at the same time (for example in different threads).
+
+        \return a pointer to workspace. On error it returns NULL. It must be released with using of function ::SimdRelease 
+            (after release of all contexts which use it).
+    */
+    SIMD_API void * SimdSynetWorkspaceInit();
+
+    /*! @ingroup synet_workspace
+
+        \fn SimdBool SimdSynetSetWorkspace(void * context, void * workspace);
+
+        \short Sets workspace (shared external buffer) for Synet context.
+
+        This workspace is used in forward function of the context when external buffer is not passed (it is NULL).
+        It is supported by contexts created with using of functions ::SimdSynetConvolution32fInit, ::SimdSynetConvolution16bInit, 
+        ::SimdSynetConvolution8iInit, ::SimdSynetDeconvolution32fInit, ::SimdSynetDeconvolution16bInit, ::SimdSynetInnerProduct16bInit, 
+        ::SimdSynetMergedConvolution32fInit, ::SimdSynetMergedConvolution16bInit and ::SimdSynetMergedConvolution8iInit.
+
+        \param [in, out] context - a pointer to Synet context.
+        \param [in] workspace - a pointer to workspace created by function ::SimdSynetWorkspaceInit. It can be NULL (to detach context from workspace).
+        \return ::SimdTrue if the context supports workspace.
+    */
+    SIMD_API SimdBool SimdSynetSetWorkspace(void * context, void * workspace);
+
+    /*! @ingroup synet_workspace
+
+        \fn size_t SimdSynetWorkspacePeak(const void * workspace);
+
+        \short Gets peak size (in bytes) of workspace (shared external buffer).
+
+        \param [in] workspace - a pointer to workspace created by function ::SimdSynetWorkspaceInit.
+        \return maximal size of external buffer required by contexts which use this workspace.
+    */
+    SIMD_API size_t SimdSynetWorkspacePeak(const void * workspace);
+
     /*! @ingroup texture_estimation
 
         \fn void SimdTextureBoostedSaturatedGradient(const uint8_t * src, size_t srcStride, size_t width, size_t height, uint8_t saturation, uint8_t boost, uint8_t * dx, size_t dxStride, uint8_t * dy, size_t dyStride);
@@ -7944,6 +8659,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Uyvy422ToBgr(const View<A>& uyvy, View<A>& bgr, SimdYuvType yuvType = SimdYuvBt601);
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] uyvy - a pointer to pixels data of input 16-bit UYVY422 image.
         \param [in] uyvyStride - a row size of the UYVY422 image.
         \param [in] width - an image width. Width must be even number.
@@ -7965,6 +8682,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::Uyvy422ToYuv420p(const View<A>& uyvy, View<A>& y, View<A>& u, View<A>& v).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] uyvy - a pointer to pixels data of input 16-bit UYVY422 image.
         \param [in] uyvyStride - a row size of the UYVY422 image.
         \param [in] width - an image width. Width must be even number.
@@ -8458,6 +9177,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuva420pToBgra(const View<A>& y, const View<A>& u, const View<A>& v, const View<A>& a, View<A>& bgra, SimdYuvType yuvType = SimdYuvBt601).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8486,6 +9207,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuva422pToBgra(const View<A>& y, const View<A>& u, const View<A>& v, const View<A>& a, View<A>& bgra, SimdYuvType yuvType = SimdYuvBt601).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8513,6 +9236,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuva444pToBgra(const View<A>& y, const View<A>& u, const View<A>& v, const View<A>& a, View<A>& bgra, SimdYuvType yuvType = SimdYuvBt601).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8541,6 +9266,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuv420pToBgr(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& bgr, SimdYuvType yuvType = SimdYuvBt601);
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8567,6 +9294,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuv422pToBgr(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& bgr, SimdYuvType yuvType = SimdYuvBt601);
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8592,6 +9321,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuv444pToBgr(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& bgr, SimdYuvType yuvType = SimdYuvBt601);
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8618,6 +9349,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuv420pToBgra(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& bgra, uint8_t alpha, SimdYuvType yuvType).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8645,6 +9378,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuv422pToBgra(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& bgra, uint8_t alpha, SimdYuvType yuvType).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8671,6 +9406,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuv444pToBgra(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& bgra, uint8_t alpha, SimdYuvType yuvType).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8697,6 +9434,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuv444pToHsl(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& hsl).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8721,6 +9460,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuv444pToHsv(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& hsv).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8795,6 +9536,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuv420pToRgb(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& rgb, SimdYuvType yuvType = SimdYuvBt601);
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8821,6 +9564,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuv422pToRgb(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& rgb, SimdYuvType yuvType = SimdYuvBt601);
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8846,6 +9591,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuv444pToRgb(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& rgb, SimdYuvType yuvType = SimdYuvBt601);
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8871,6 +9618,8 @@ extern "C"
 
         \note This function has a C++ wrappers: Simd::Yuv444pToRgba(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& rgba, uint8_t alpha, SimdYuvType yuvType = SimdYuvBt601);
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param [in] y - a pointer to pixels data of input 8-bit image with Y color plane.
         \param [in] yStride - a row size of the y image.
         \param [in] u - a pointer to pixels data of input 8-bit image with U color plane.
@@ -8898,6 +9647,8 @@ extern "C"
 
         \note This function has a C++ wrapper Simd::Yuv420pToUyvy422(const View<A>& y, const View<A>& u, const View<A>& v, View<A>& uyvy).
 
+        \note This function supports multithreading (See functions ::SimdGetThreadNumber and ::SimdSetThreadNumber).
+
         \param[in] y - a pointer to pixels data of input 8 - bit image with Y color plane.
         \param[in] yStride - a row size of the y image.
         \param[in] u - a pointer to pixels data of input 8 - bit image with U color plane.
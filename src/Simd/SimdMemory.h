@@ -32,6 +32,7 @@
 #include <iostream>
 #endif
 #include <memory>
+#include <atomic>
 
 namespace Simd
 {
@@ -118,25 +119,46 @@ namespace Simd
     const uint8_t NO_MANS_LAND_WATERMARK = 0x55;
 #endif
 
+    namespace Base
+    {
+        const size_t HUGE_PAGE_SIZE = 0x200000;
+
+        extern std::atomic<SimdHugePageModeType> g_hugePageMode;
+        extern std::atomic<bool> g_hugePageUsed;
+
+        void* HugePageAllocate(size_t size, size_t align);
+
+        bool HugePageFree(void* ptr);
+
+        bool SetHugePageMode(SimdHugePageModeType mode, size_t threshold);
+
+        size_t HugePageInfo(SimdHugePageInfoType type);
+    }
+
     SIMD_INLINE void* Allocate(size_t size, size_t align = SIMD_ALIGN)
     {
 #ifdef SIMD_NO_MANS_LAND
         size += 2 * SIMD_NO_MANS_LAND;
 #endif
         void* ptr = NULL;
+        if (Base::g_hugePageMode.load(std::memory_order_relaxed) != SimdHugePageOff)
+            ptr = Base::HugePageAllocate(size, align);
+        if (ptr == NULL)
+        {
 #if defined(_MSC_VER) 
-        ptr = _aligned_malloc(size, align);
+            ptr = _aligned_malloc(size, align);
 #elif defined(__MINGW32__) || defined(__MINGW64__)
-        ptr = __mingw_aligned_malloc(size, align);
+            ptr = __mingw_aligned_malloc(size, align);
 #elif defined(__GNUC__)
-        align = AlignHi(align, sizeof(void*));
-        size = AlignHi(size, align);
-        int result = ::posix_memalign(&ptr, align, size);
-        if (result != 0)
-            ptr = NULL;
+            align = AlignHi(align, sizeof(void*));
+            size = AlignHi(size, align);
+            int result = ::posix_memalign(&ptr, align, size);
+            if (result != 0)
+                ptr = NULL;
 #else
-        ptr = malloc(size);
+            ptr = malloc(size);
 #endif
+        }
 #ifdef SIMD_ALLOCATE_ERROR_MESSAGE
         if (ptr == NULL)
             std::cout << "The function posix_memalign can't allocate " << size << " bytes with align " << align << " !" << std::endl << std::flush;
@@ -174,6 +196,8 @@ namespace Simd
 #endif  
         }
 #endif
+        if (Base::g_hugePageUsed.load(std::memory_order_relaxed) && ptr && Aligned(ptr, Base::HUGE_PAGE_SIZE) && Base::HugePageFree(ptr))
+            return;
 #if defined(_MSC_VER) 
         _aligned_free(ptr);
 #elif defined(__MINGW32__) || defined(__MINGW64__)
@@ -35,7 +35,7 @@ namespace Simd
 #ifdef SIMD_NEON_ENABLE    
     namespace Neon
     {
-        uint32_t ZlibAdler32(uint8_t* data, int size)
+        uint32_t ZlibAdler32(const uint8_t* data, int size)
         {
             int32x4_t _i0 = SetI32(0, -1, -2, -3), _4 = vdupq_n_s32(4);
             uint32_t lo = 1, hi = 0;
@@ -71,7 +71,7 @@ namespace Simd
             return (hi << 16) | lo;
         }
 
-        void ZlibCompress(uint8_t* data, int size, int quality, OutputMemoryStream& stream)
+        void ZlibDeflate(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream)
         {
             const int ZHASH = 16384;
             if (quality < 5)
@@ -79,23 +79,22 @@ namespace Simd
             const int basket = quality * 2;
             Array32i hashTable(ZHASH * basket);
             memset(hashTable.data, -1, hashTable.RawSize());
+            Base::ZlibPrime(hashTable.data, basket, quality, data, begin);
 
-            stream.Write(uint8_t(0x78));
-            stream.Write(uint8_t(0x5e));
-            stream.WriteBits(1, 1);
+            stream.WriteBits(last ? 1 : 0, 1);
             stream.WriteBits(1, 2);
 
-            int i = 0, j;
-            while (i < size - 3)
+            int i = begin, j;
+            while (i < end - 3)
             {
                 int h = Base::ZlibHash(data + i) & (ZHASH - 1), best = 3;
-                uint8_t* bestLoc = 0;
+                const uint8_t* bestLoc = 0;
                 int* hList = hashTable.data + h * basket;
                 for (j = 0; hList[j] != -1 && j < basket; ++j)
                 {
                     if (hList[j] > i - 32768)
                     {
-                        int d = Base::ZlibCount(data + hList[j], data + i, size - i);
+                        int d = Base::ZlibCount(data + hList[j], data + i, end - i);
                         if (d >= best)
                         {
                             best = d;
@@ -119,7 +118,7 @@ namespace Simd
                     {
                         if (hList[j] > i - 32767)
                         {
-                            int e = Base::ZlibCount(data + hList[j], data + i + 1, size - i - 1);
+                            int e = Base::ZlibCount(data + hList[j], data + i + 1, end - i - 1);
                             if (e > best)
                             {
                                 bestLoc = NULL;
@@ -149,11 +148,19 @@ namespace Simd
                     ++i;
                 }
             }
-            for (; i < size; ++i)
+            for (; i < end; ++i)
                 Base::ZlibHuffB(data[i], stream);
             Base::ZlibHuff(256, stream);
+            if (!last)
+                stream.WriteBits(0, 3);
             stream.FlushBits();
-            stream.WriteBe32u(ZlibAdler32(data, size));
+            if (!last)
+                stream.WriteBe32u(0x0000FFFF);
+        }
+
+        void ZlibDeflateRle(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream)
+        {
+            Base::ZlibDeflateDynamic(data, begin, end, last, Base::ZlibTokenizeRle<Neon::ZlibCount>, stream);
         }
 
         uint32_t EncodeLine0(const uint8_t* src, size_t stride, size_t n, size_t size, int8_t* dst)
@@ -402,7 +409,9 @@ namespace Simd
             _encode[4] = Neon::EncodeLine4;
             _encode[5] = Neon::EncodeLine5;
             _encode[6] = Neon::EncodeLine6;
-            _compress = Neon::ZlibCompress;
+            _adler32 = Neon::ZlibAdler32;
+            _deflate = Neon::ZlibDeflate;
+            _deflateRle = Neon::ZlibDeflateRle;
         }
     }
 #endif// SIMD_NEON_ENABLE
@@ -34,7 +34,7 @@ namespace Simd
     {
         void * ResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method)
         {
-            ResParam param(srcX, srcY, dstX, dstY, channels, type, method, sizeof(float32x4_t));
+            ResParam param(srcX, srcY, dstX, dstY, channels, type, method, sizeof(float32x4_t), ResizerInit);
             if (param.IsNearest())
                 return new Base::ResizerNearest(param);
             else if (param.IsByteBilinear() && dstX >= A)
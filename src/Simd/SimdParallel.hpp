@@ -25,40 +25,329 @@
 #define __SimdParallel_hpp__
 
 #include <vector>
-#include <thread>
+#include <list>
+#include <algorithm>
 #ifndef SIMD_FUTURE_DISABLE
-#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#if defined(__linux__)
+#include <pthread.h>
+#endif
 #endif
 
 namespace Simd
 {
+#ifndef SIMD_FUTURE_DISABLE
+    /*! @ingroup cpp_parallel
+
+        \short The ThreadPool class keeps a set of parked worker threads which are reused by all calls of Simd::Parallel.
+
+        A caller of ThreadPool::Run also executes blocks of its task, so nested and concurrent calls are safe.
+        The size of global pool is set by ::SimdSetThreadNumber (it creates threadNumber - 1 workers).
+        Simd::Parallel uses at most pool size + 1 threads (workers and the caller). It grows a pool up to required thread number 
+        (but not more than hardware concurrency) only while the pool size was never set explicitly (by ::SimdSetThreadNumber, 
+        ::SimdThreadPoolInit or ThreadPool::Resize).
+        Besides the global pool a process can have several independent pools (see ::SimdThreadPoolInit). 
+        A pool bound to current thread (see ThreadPool::Bind) is used by Simd::Parallel instead of the global one.
+        Worker threads of a pool can be restricted to given set of CPUs (see ThreadPool::SetAffinity).
+    */
+    class ThreadPool
+    {
+    public:
+        typedef void(*Task)(const void * context, size_t block);
+
+        ThreadPool()
+            : _size(0)
+            , _fixed(false)
+        {
+        }
+
+        ~ThreadPool()
+        {
+            Resize(0);
+        }
+
+        /*!
+            Gets a process-wide thread pool which is used by Simd::Parallel.
+
+            \return a reference to the global thread pool.
+        */
+        static ThreadPool & Global()
+        {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        /*!
+            Gets a thread pool bound to current thread.
+
+            \return a pointer to bound thread pool or NULL if there is no bound pool.
+        */
+        static ThreadPool * Bound()
+        {
+            return BoundRef();
+        }
+
+        /*!
+            Binds a thread pool to current thread. All calls of Simd::Parallel from this thread will use this pool.
+
+            \param [in] pool - a pointer to thread pool. NULL restores using of the global pool.
+        */
+        static void Bind(ThreadPool * pool)
+        {
+            BoundRef() = pool;
+        }
+
+        /*!
+            Gets a thread pool which is used by Simd::Parallel in current thread.
+
+            \return a reference to bound pool if it exists or to the global pool otherwise.
+        */
+        static ThreadPool & Current()
+        {
+            ThreadPool * pool = BoundRef();
+            return pool ? *pool : Global();
+        }
+
+        /*!
+            Gets current number of worker threads.
+
+            \return a number of worker threads.
+        */
+        size_t Size() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _size;
+        }
+
+        /*!
+            Sets number of worker threads. Extra workers are stopped, missing ones are started.
+
+            \param [in] size - a new number of worker threads.
+        */
+        void Resize(size_t size)
+        {
+            std::lock_guard<std::mutex> resize(_resize);
+            _fixed = true;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _size = size;
+            }
+            _wake.notify_all();
+            while (_workers.size() > size)
+            {
+                _workers.back().join();
+                _workers.pop_back();
+            }
+            while (_workers.size() < size)
+                Start();
+        }
+
+        /*!
+            Increases number of worker threads if it is less than given value and the pool size was never set explicitly by ThreadPool::Resize.
+
+            \param [in] size - a required minimal number of worker threads.
+        */
+        void Reserve(size_t size)
+        {
+            if (Size() < size)
+            {
+                std::lock_guard<std::mutex> resize(_resize);
+                if (!_fixed && _workers.size() < size)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _size = size;
+                    }
+                    while (_workers.size() < size)
+                        Start();
+                }
+            }
+        }
+
+        /*!
+            Restricts worker threads of the pool to given set of CPUs. Existing workers are moved at once, new workers are started on these CPUs.
+            The calling thread (which also executes blocks of tasks in ThreadPool::Run) is not affected.
+
+            \note It is supported only on Linux.
+
+            \param [in] cpus - a list of CPU indices. Empty list removes the restriction.
+            \return true if the affinity was successfully set for all workers.
+        */
+        bool SetAffinity(const std::vector<size_t> & cpus)
+        {
+            std::lock_guard<std::mutex> resize(_resize);
+            _cpus = cpus;
+            bool result = true;
+            for (size_t i = 0; i < _workers.size(); ++i)
+                result = Pin(_workers[i], _cpus, true) && result;
+#if !defined(__linux__)
+            result = result && cpus.empty();
+#endif
+            return result;
+        }
+
+        /*!
+            Gets current set of CPUs of worker threads.
+
+            \return a list of CPU indices. Empty list means that there is no restriction.
+        */
+        std::vector<size_t> Affinity() const
+        {
+            std::lock_guard<std::mutex> resize(_resize);
+            return _cpus;
+        }
+
+        /*!
+            Executes given task for blocks [0, count). The calling thread also executes blocks and returns when all of them are finished.
+
+            \param [in] task - a pointer to task function.
+            \param [in] context - a task context.
+            \param [in] count - a number of blocks.
+        */
+        void Run(Task task, const void * context, size_t count)
+        {
+            Job job = { task, context, count, 1, 0 };
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (count > 1)
+            {
+                _jobs.push_back(&job);
+                for (size_t i = 1; i < count; ++i)
+                    _wake.notify_one();
+            }
+            for (size_t block = 0; block < count;)
+            {
+                lock.unlock();
+                task(context, block);
+                lock.lock();
+                job.done++;
+                if (job.next < count)
+                {
+                    block = job.next++;
+                    if (job.next == count)
+                        _jobs.remove(&job);
+                }
+                else
+                    break;
+            }
+            _finish.wait(lock, [&job] { return job.done == job.count; });
+        }
+
+    private:
+        struct Job
+        {
+            Task task;
+            const void * context;
+            size_t count, next, done;
+        };
+
+        static ThreadPool * & BoundRef()
+        {
+            static thread_local ThreadPool * pool = NULL;
+            return pool;
+        }
+
+        static bool Pin(std::thread & thread, const std::vector<size_t> & cpus, bool reset)
+        {
+#if defined(__linux__)
+            if (cpus.empty() && !reset)
+                return true;
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (cpus.empty())
+            {
+                for (size_t i = 0, n = std::thread::hardware_concurrency(); i < n && i < CPU_SETSIZE; ++i)
+                    CPU_SET(i, &set);
+            }
+            else
+            {
+                for (size_t i = 0; i < cpus.size(); ++i)
+                    if (cpus[i] < CPU_SETSIZE)
+                        CPU_SET(cpus[i], &set);
+            }
+            return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+            return cpus.empty();
+#endif
+        }
+
+        void Start()
+        {
+            _workers.push_back(std::thread(&ThreadPool::Work, this, _workers.size()));
+            Pin(_workers.back(), _cpus, false);
+        }
+
+        void Work(size_t index)
+        {
+            if (this != &Global())
+                BoundRef() = this;
+            std::unique_lock<std::mutex> lock(_mutex);
+            for (;;)
+            {
+                _wake.wait(lock, [this, index] { return index >= _size || !_jobs.empty(); });
+                if (index >= _size)
+                    return;
+                Job * job = _jobs.front();
+                size_t block = job->next++;
+                if (job->next == job->count)
+                    _jobs.pop_front();
+                lock.unlock();
+                job->task(job->context, block);
+                lock.lock();
+                if (++job->done == job->count)
+                    _finish.notify_all();
+            }
+        }
+
+        mutable std::mutex _mutex, _resize;
+        std::condition_variable _wake, _finish;
+        std::list<Job*> _jobs;
+        std::vector<std::thread> _workers;
+        std::vector<size_t> _cpus;
+        size_t _size;
+        bool _fixed;
+    };
+
+    namespace Detail
+    {
+        template<class Function> struct ParallelContext
+        {
+            const Function * function;
+            size_t begin, end, blockSize;
+
+            static void Run(const void * context, size_t block)
+            {
+                const ParallelContext & c = *(const ParallelContext*)context;
+                size_t blockBegin = c.begin + block * c.blockSize;
+                size_t blockEnd = std::min(blockBegin + c.blockSize, c.end);
+                (*c.function)(block, blockBegin, blockEnd);
+            }
+        };
+    }
+#endif
+
     template<class Function> inline void Parallel(size_t begin, size_t end, const Function & function, size_t threadNumber, size_t blockAlign = 1)
     {
 #ifdef SIMD_FUTURE_DISABLE
         function(0, begin, end);
 #else
-        static const size_t threadNumberMax = std::thread::hardware_concurrency();
+        static const size_t threadNumberMax = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        ThreadPool & pool = ThreadPool::Current();
         threadNumber = std::min<size_t>(threadNumber, threadNumberMax);
+        if (threadNumber > 1)
+            pool.Reserve(threadNumber - 1);
+        threadNumber = std::min<size_t>(threadNumber, pool.Size() + 1);
         if (threadNumber <= 1 || size_t(blockAlign*1.5) >= (end - begin))
             function(0, begin, end);
         else
         {
-            std::vector<std::future<void>> futures;
-
             size_t blockSize = (end - begin + threadNumber - 1) / threadNumber;
             blockSize = (blockSize + blockAlign - 1) / blockAlign * blockAlign;
-            size_t blockBegin = begin;
-            size_t blockEnd = blockBegin + blockSize;
-
-            for (size_t thread = 0; thread < threadNumber && blockBegin < end; ++thread)
-            {
-                futures.push_back(std::move(std::async(std::launch::async, [blockBegin, blockEnd, thread, &function] { function(thread, blockBegin, blockEnd); })));
-                blockBegin += blockSize;
-                blockEnd = std::min(blockBegin + blockSize, end);
-            }
+            size_t blockCount = (end - begin + blockSize - 1) / blockSize;
 
-            for (size_t i = 0; i < futures.size(); ++i)
-                futures[i].wait();
+            Detail::ParallelContext<Function> context = { &function, begin, end, blockSize };
+            pool.Run(Detail::ParallelContext<Function>::Run, &context, blockCount);
         }
 #endif
     }
@@ -0,0 +1,82 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdParallelRows_h__
+#define __SimdParallelRows_h__
+
+#include "Simd/SimdMath.h"
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdBase.h"
+#include "Simd/SimdParallel.hpp"
+
+namespace Simd
+{
+    const size_t PARALLEL_ROWS_AREA_MIN = 0x40000;
+
+    SIMD_INLINE bool & ParallelRowsNested()
+    {
+        thread_local bool nested = false;
+        return nested;
+    }
+
+    // Test hook: if non-zero it sets number of row bands regardless of image size and thread number.
+    SIMD_INLINE size_t & ParallelRowsBands()
+    {
+        thread_local size_t bands = 0;
+        return bands;
+    }
+
+    SIMD_INLINE size_t ParallelRowsThreads(size_t width, size_t height, size_t rowAlign = 1)
+    {
+        if (ParallelRowsNested() || height < 2 * rowAlign)
+            return 1;
+        if (ParallelRowsBands())
+            return Min(ParallelRowsBands(), height / rowAlign);
+        return RestrictRange<size_t>(width * height / PARALLEL_ROWS_AREA_MIN, 1, Base::GetThreadNumber());
+    }
+
+    template<class Function> SIMD_INLINE void ParallelRows(size_t bands, size_t height, size_t rowAlign, Function function)
+    {
+        size_t band = AlignHiAny(DivHi(height, bands), rowAlign);
+        bands = DivHi(height, band);
+        Simd::Parallel(0, bands, [&](size_t thread, size_t begin, size_t end)
+        {
+            bool & nested = ParallelRowsNested();
+            nested = true;
+            for (size_t b = begin; b < end; ++b)
+                function(b * band, Min(b * band + band, height));
+            nested = false;
+        }, bands);
+    }
+
+    template<class Function> SIMD_INLINE bool ParallelRowsRun(size_t width, size_t height, size_t rowAlign, Function function)
+    {
+        size_t bands = ParallelRowsThreads(width, height, rowAlign);
+        if (bands < 2)
+            return false;
+        ParallelRows(bands, height, rowAlign, function);
+        return true;
+    }
+}
+
+#endif
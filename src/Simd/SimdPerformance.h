@@ -53,17 +53,41 @@ namespace Simd
 #include <thread>
 #include <mutex>
 #include <algorithm>
+#include <vector>
+#include <atomic>
 
 namespace Simd
 {
     namespace Base
     {
+        class PerformanceHistogram
+        {
+            static const int SUB_BITS = 4, SUB_SIZE = 1 << SUB_BITS, SIZE = (64 - SUB_BITS + 1) * SUB_SIZE;
+            uint32_t _counts[SIZE];
+
+            static size_t Index(int64_t value);
+            static int64_t Lower(size_t index);
+
+        public:
+            PerformanceHistogram();
+
+            void Add(int64_t value);
+
+            void Combine(const PerformanceHistogram& other);
+
+            void Reset();
+
+            int64_t Percentile(double percent) const;
+        };
+
         class PerformanceMeasurer
         {
             String	_name;
             int64_t _start, _current, _total, _min, _max;
             int64_t _count, _flop;
             bool _entered, _paused;
+            PerformanceHistogram _histogram;
+            std::atomic<uint64_t> _epoch;
 
         public:
             PerformanceMeasurer(const String& name = "Unknown", int64_t flop = 0);
@@ -78,6 +102,19 @@ namespace Simd
 
             void Combine(const PerformanceMeasurer& other);
 
+            void Reset();
+
+            SIMD_INLINE bool Actual() const
+            {
+                return _epoch.load(std::memory_order_acquire) == s_epoch.load(std::memory_order_acquire);
+            }
+
+            static std::atomic<uint64_t> s_epoch;
+
+            void Get(SimdPerformanceStatisticItem & item) const;
+
+            String Json() const;
+
         private:
             double Average() const;
             double GFlops() const;
@@ -120,10 +157,16 @@ namespace Simd
             typedef std::shared_ptr<Pm> PmPtr;
             typedef std::map<String, PmPtr> FunctionMap;
             typedef std::map<std::thread::id, FunctionMap> ThreadMap;
+            typedef std::vector<std::pair<size_t, PmPtr>> Snapshot;
 
             ThreadMap _map;
             mutable std::mutex _mutex;
-            String _report;
+            String _report, _json;
+            Snapshot _snapshot;
+
+            static PmPtr Copy(const PerformanceMeasurer & pm);
+
+            void MakeSnapshot(Snapshot & snapshot, bool threads) const;
 
             SIMD_INLINE FunctionMap & ThisThread()
             {
@@ -151,6 +194,7 @@ namespace Simd
                 if (it == thread.end())
                 {
                     pm = new PerformanceMeasurer(name, flop);
+                    std::lock_guard<std::mutex> lock(_mutex);
                     thread[name].reset(pm);
                 }
                 else
@@ -164,6 +208,12 @@ namespace Simd
             }
 
             const char* PerformanceStatistic();
+
+            size_t PerformanceStatistic(SimdPerformanceStatisticItem* items, size_t size, bool threads);
+
+            const char* PerformanceStatisticJson(bool threads);
+
+            void Reset();
         };
     }
 }
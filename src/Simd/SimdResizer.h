@@ -27,17 +27,24 @@
 #include "Simd/SimdArray.h"
 #include "Simd/SimdMath.h"
 
+#include <vector>
+
 #define SIMD_RESIZER_BICUBIC_BITS 7 // 7, 11
 
 namespace Simd
 {
+    typedef void* (*ResizerInitPtr)(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
+
+    typedef void* (*ResizerKernelInitPtr)(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, const float* kernel, size_t size, float support);
+
     struct ResParam
     {
         SimdResizeChannelType type;
         SimdResizeMethodType method;
         size_t srcW, srcH, dstW, dstH, channels, align;
+        ResizerInitPtr init;
 
-        ResParam(size_t srcW, size_t srcH, size_t dstW, size_t dstH, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method, size_t align)
+        ResParam(size_t srcW, size_t srcH, size_t dstW, size_t dstH, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method, size_t align, ResizerInitPtr init = NULL)
         {
             this->type = type;
             this->method = method;
@@ -47,6 +54,7 @@ namespace Simd
             this->dstH = dstH;
             this->channels = channels;
             this->align = align;
+            this->init = init;
         }
 
         bool IsNearest() const
@@ -94,6 +102,12 @@ namespace Simd
                 DivHi(srcW, 2) >= dstW && DivHi(srcH, 2) >= dstH;
         }
 
+        bool IsKernel() const
+        {
+            return method == SimdResizeMethodLanczos || (type != SimdResizeChannelByte && 
+                (method == SimdResizeMethodBicubic || method == SimdResizeMethodArea || method == SimdResizeMethodAreaFast));
+        }
+
         size_t ChannelSize() const
         {
             static const size_t sizes[4] = { 1, 2, 4, 2 };
@@ -113,13 +127,51 @@ namespace Simd
     public:
         Resizer(const ResParam & param)
             : _param(param)
+            , _yBeg(0)
+            , _yEnd(param.dstH)
         {
         }
 
+        virtual ~Resizer();
+
         virtual void Run(const uint8_t * src, size_t srcStride, uint8_t * dst, size_t dstStride) = 0;
 
+        void RunParallel(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+
+        virtual bool Reset(size_t srcW, size_t srcH);
+
+    protected:
+        ResParam _param;
+        size_t _yBeg, _yEnd;
+        std::vector<Resizer*> _workers;
+
+        virtual Resizer* Clone() const;
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    class ResizerBatch : Deletable
+    {
+    public:
+        ResizerBatch(const ResParam& param);
+
+        virtual ~ResizerBatch();
+
+        bool Run(const uint8_t* src, size_t srcW, size_t srcH, size_t srcStride, const size_t* rois, size_t count, uint8_t* dst, size_t dstStride);
+
     protected:
+        struct Item
+        {
+            size_t srcW, srcH, used;
+            Resizer* resizer;
+        };
+        typedef std::vector<Item> Cache;
+
         ResParam _param;
+        std::vector<Cache> _caches;
+        size_t _used;
+
+        Resizer* Get(size_t thread, size_t srcW, size_t srcH);
     };
 
     //-------------------------------------------------------------------------------------------------
@@ -149,12 +201,15 @@ namespace Simd
         {
         protected:
             Array32i _ax, _ix, _ay, _iy, _bx[2];
+            size_t _xSrcW;
 
             void EstimateIndexAlpha(size_t srcSize, size_t dstSize, size_t channels, int32_t * indices, int32_t * alphas);
         public:
             ResizerByteBilinear(const ResParam & param);
 
             virtual void Run(const uint8_t * src, size_t srcStride, uint8_t * dst, size_t dstStride);
+
+            virtual bool Reset(size_t srcW, size_t srcH);
         };
 
         //-------------------------------------------------------------------------------------------------
@@ -278,7 +333,48 @@ namespace Simd
 
         //-------------------------------------------------------------------------------------------------
 
+        const int32_t KERNEL_BITS = 14;
+        const int32_t KERNEL_RANGE = 1 << KERNEL_BITS;
+        const int32_t KERNEL_ROW_BITS = 4;
+        const int32_t KERNEL_X_SHIFT = KERNEL_BITS - KERNEL_ROW_BITS;
+        const int32_t KERNEL_X_ROUND = 1 << (KERNEL_X_SHIFT - 1);
+        const int32_t KERNEL_Y_SHIFT = KERNEL_BITS + KERNEL_ROW_BITS;
+        const int32_t KERNEL_Y_ROUND = 1 << (KERNEL_Y_SHIFT - 1);
+
+        class ResizerKernel : public Resizer
+        {
+        protected:
+            Array32f _kernel;
+            float _support;
+            ResizerKernelInitPtr _kernelInit;
+            size_t _xTaps, _yTaps, _rowSize;
+            Array32i _ix, _iy, _axi, _ayi, _ry;
+            Array32f _ax, _ay, _bs, _by;
+            std::vector<const float*> _rows;
+
+            float Kernel(float x) const;
+            void EstimateKernelTaps(size_t srcSize, size_t dstSize, size_t& taps, Array32i& index, Array32f& alpha) const;
+            void EstimateBicubicTaps(size_t srcSize, size_t dstSize, size_t& taps, Array32i& index, Array32f& alpha) const;
+            void EstimateAreaTaps(size_t srcSize, size_t dstSize, size_t& taps, Array32i& index, Array32f& alpha) const;
+            void EstimateTaps(size_t srcSize, size_t dstSize, size_t& taps, Array32i& index, Array32f& alpha) const;
+            void Init();
+
+            virtual Resizer* Clone() const;
+
+            virtual void Convert(const uint8_t* src, float* dst);
+            virtual void Horizontal(const float* src, float* dst);
+            virtual void Vertical(const float* const* rows, size_t dy, uint8_t* dst);
+        public:
+            ResizerKernel(const ResParam& param, const float* kernel = NULL, size_t size = 0, float support = 0.0f);
+
+            virtual void Run(const uint8_t* src, size_t srcStride, uint8_t* dst, size_t dstStride);
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
         void * ResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
+
+        void * ResizerKernelInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, const float* kernel, size_t size, float support);
     }
 
 #ifdef SIMD_SSE41_ENABLE    
@@ -410,7 +506,21 @@ namespace Simd
 
         //-------------------------------------------------------------------------------------------------
 
+        class ResizerKernel : public Base::ResizerKernel
+        {
+        protected:
+            virtual void Convert(const uint8_t* src, float* dst);
+            virtual void Horizontal(const float* src, float* dst);
+            virtual void Vertical(const float* const* rows, size_t dy, uint8_t* dst);
+        public:
+            ResizerKernel(const ResParam& param, const float* kernel = NULL, size_t size = 0, float support = 0.0f);
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
         void * ResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
+
+        void * ResizerKernelInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, const float* kernel, size_t size, float support);
     }
 #endif
 
@@ -524,7 +634,21 @@ namespace Simd
 
         //-------------------------------------------------------------------------------------------------
 
+        class ResizerKernel : public Sse41::ResizerKernel
+        {
+        protected:
+            virtual void Convert(const uint8_t* src, float* dst);
+            virtual void Horizontal(const float* src, float* dst);
+            virtual void Vertical(const float* const* rows, size_t dy, uint8_t* dst);
+        public:
+            ResizerKernel(const ResParam& param, const float* kernel = NULL, size_t size = 0, float support = 0.0f);
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
         void * ResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
+
+        void * ResizerKernelInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, const float* kernel, size_t size, float support);
     }
 #endif 
 
@@ -640,7 +764,21 @@ namespace Simd
 
         //-------------------------------------------------------------------------------------------------
 
+        class ResizerKernel : public Avx2::ResizerKernel
+        {
+        protected:
+            virtual void Convert(const uint8_t* src, float* dst);
+            virtual void Horizontal(const float* src, float* dst);
+            virtual void Vertical(const float* const* rows, size_t dy, uint8_t* dst);
+        public:
+            ResizerKernel(const ResParam& param, const float* kernel = NULL, size_t size = 0, float support = 0.0f);
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
         void * ResizerInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, SimdResizeMethodType method);
+
+        void * ResizerKernelInit(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, const float* kernel, size_t size, float support);
     }
 #endif 
 
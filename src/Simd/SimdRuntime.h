@@ -31,8 +31,10 @@
 #include <limits>
 #include <algorithm>
 #include <string>
-#ifdef SIMD_RUNTIME_STATISTIC
 #include <sstream>
+#include <map>
+#include <mutex>
+#ifdef SIMD_RUNTIME_STATISTIC
 #include <iostream>
 #include <iomanip>
 #endif
@@ -41,10 +43,51 @@ namespace Simd
 {
     typedef ::std::string String;
 
+    namespace Base
+    {
+        class RuntimeCache
+        {
+        public:
+            static RuntimeCache & Global();
+
+            bool Open(const char * path, SimdRuntimeCacheModeType mode);
+
+            SIMD_INLINE SimdRuntimeCacheModeType Mode() const { return _mode; }
+
+            String Key(const String & info, const String & names) const;
+
+            bool Load(const String & key, String & name);
+
+            void Store(const String & key, const String & name);
+
+            // Statistics since last Open(): successful loads, failed loads and stored results.
+            SIMD_INLINE size_t Hits() const { return _hits; }
+            SIMD_INLINE size_t Misses() const { return _misses; }
+            SIMD_INLINE size_t Stores() const { return _stores; }
+
+        private:
+            typedef std::map<String, String> Entries;
+            typedef std::map<String, Entries> Signatures;
+
+            std::mutex _mutex;
+            SimdRuntimeCacheModeType _mode;
+            String _path, _signature;
+            Signatures _signatures;
+            size_t _hits, _misses, _stores;
+
+            RuntimeCache();
+            bool Read();
+            bool Write() const;
+        };
+    }
+
+    //-------------------------------------------------------------------------
+
     template <class Func, class Args> struct Runtime
     {
         SIMD_INLINE Runtime()
             : _best(NULL)
+            , _cached(false)
         {
         }
 
@@ -71,6 +114,7 @@ namespace Simd
             _candidates.clear();
             _candidates.push_back(Candidate(func));
             _best = &_candidates[0].func;
+            _cached = false;
         }
 
         SIMD_INLINE void Init(const std::vector<Func> & funcs)
@@ -80,6 +124,7 @@ namespace Simd
             for (size_t i = 0; i < funcs.size(); ++i)
                 _candidates.push_back(Candidate(funcs[i]));
             _best = funcs.size() == 1 ? &_candidates[0].func : NULL;
+            _cached = false;
         }
 
         SIMD_INLINE void Run(const Args & args)
@@ -102,6 +147,7 @@ namespace Simd
 
     private:
         static const size_t TEST_COUNT = 3 + 2;
+        static const size_t TUNE_COUNT = 8 + 2;
 
         struct Candidate
         {
@@ -140,12 +186,27 @@ namespace Simd
 
         Func * _best;
         Candidates _candidates;
-        String _info;
+        String _info, _key;
+        bool _cached;
 
         SIMD_INLINE void Test(const Args & args)
         {
             assert(_candidates.size());
-            Candidate * current = Current();
+            if (!_cached)
+            {
+                _cached = true;
+                if (Cached(args))
+                {
+                    _best->Run(args);
+                    return;
+                }
+                if (Base::RuntimeCache::Global().Mode() == SimdRuntimeCacheTune)
+                {
+                    Tune(args);
+                    return;
+                }
+            }
+            Candidate * current = Current(TEST_COUNT);
             if (current)
             {
 #ifdef SIMD_RUNTIME_STATISTIC
@@ -158,14 +219,60 @@ namespace Simd
             }
             else
             {
-                _best = &Best()->func;
+                SetBest();
                 _best->Run(args);
             }
         }
 
-        SIMD_INLINE Candidate * Current()
+        bool Cached(const Args & args)
         {
-            size_t min = TEST_COUNT;
+            Base::RuntimeCache & cache = Base::RuntimeCache::Global();
+            if (cache.Mode() == SimdRuntimeCacheOff)
+                return false;
+            String names;
+            for (size_t i = 0; i < _candidates.size(); ++i)
+                names += (i ? "," : "") + _candidates[i].func.Name();
+            _key = cache.Key(_candidates[0].func.Info(args), names);
+            String name;
+            if (cache.Mode() == SimdRuntimeCacheTune || !cache.Load(_key, name))
+                return false;
+            for (size_t i = 0; i < _candidates.size(); ++i)
+            {
+                if (_candidates[i].func.Name() == name)
+                {
+                    _best = &_candidates[i].func;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void Tune(const Args & args)
+        {
+#ifdef SIMD_RUNTIME_STATISTIC
+            _info = _candidates[0].func.Info(args);
+#endif
+            for (Candidate * current = Current(TUNE_COUNT); current; current = Current(TUNE_COUNT))
+            {
+                int64_t start = Simd::TimeCounter();
+                current->func.Run(args);
+                current->Update(Simd::TimeCounter() - start);
+            }
+            SetBest();
+            _best->Run(args);
+        }
+
+        void SetBest()
+        {
+            _best = &Best()->func;
+            Base::RuntimeCache & cache = Base::RuntimeCache::Global();
+            if (!_key.empty() && (cache.Mode() == SimdRuntimeCacheReadWrite || cache.Mode() == SimdRuntimeCacheTune))
+                cache.Store(_key, _best->Name());
+        }
+
+        SIMD_INLINE Candidate * Current(size_t count)
+        {
+            size_t min = count;
             Candidate * current = NULL;
             for (size_t i = 0; i < _candidates.size(); ++i)
             {
@@ -222,14 +329,12 @@ namespace Simd
             _func(args.M, args.N, args.K, args.alpha, args.A, args.lda, args.B, args.ldb, args.beta, args.C, args.ldc);
         }
 
-#ifdef SIMD_RUNTIME_STATISTIC
         SIMD_INLINE String Info(const GemmArgs & args) const
         {
             std::stringstream ss;
             ss << "Gemm [" << args.M << ", " << args.N << ", " << args.K << "]";
             return ss.str();
         }
-#endif
 
     private:
         Func _func;
@@ -280,14 +385,12 @@ namespace Simd
             _run(args.M, args.N, args.K, args.A, args.pB, args.C, _type, _type != GemmKernelAny);
         }
 
-#ifdef SIMD_RUNTIME_STATISTIC
         SIMD_INLINE String Info(const GemmCbArgs & args) const
         {
             std::stringstream ss;
             ss << "GemmCb [" << args.M << ", " << args.N << ", " << args.K << "]";
             return ss.str();
         }
-#endif 
         
         SIMD_INLINE GemmKernelType Type() const { return _type; }
 
@@ -172,6 +172,8 @@ namespace Simd
         void ConditionalFill(const uint8_t* src, size_t srcStride, size_t width, size_t height,
             uint8_t threshold, SimdCompareType compareType, uint8_t value, uint8_t* dst, size_t dstStride);
 
+        uint32_t Crc32(const void* src, size_t size);
+
         uint32_t Crc32c(const void* src, size_t size);
 
         void DeinterleaveUv(const uint8_t* uv, size_t uvStride, size_t width, size_t height, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride);
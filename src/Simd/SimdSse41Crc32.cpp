@@ -22,6 +22,12 @@
 * SOFTWARE.
 */
 #include "Simd/SimdMemory.h"
+#include "Simd/SimdCpu.h"
+#include "Simd/SimdBase.h"
+
+#ifdef SIMD_SSE41_ENABLE
+#include <wmmintrin.h>
+#endif
 
 namespace Simd
 {
@@ -58,6 +64,55 @@ namespace Simd
             Crc32c(crc, (uint8_t*)tail, nose + size);
             return ~(uint32_t)crc;
         }
+
+        //-------------------------------------------------------------------------------------------------
+
+        const bool PclmulEnable = Base::CheckBit(1, 0, Cpuid::Ecx, Cpuid::PCLMULQDQ);
+
+        SIMD_INLINE __m128i Crc32Fold(__m128i a, __m128i b, __m128i k)
+        {
+            return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(a, k, 0x00), _mm_clmulepi64_si128(a, k, 0x11)), b);
+        }
+
+        SIMD_INLINE uint32_t Crc32Reduce(__m128i x0)
+        {
+            const __m128i k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+            const __m128i k5 = _mm_set_epi64x(0x0000000000, 0x0163cd6124);
+            const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+            const __m128i mask = _mm_setr_epi32(-1, 0, -1, 0);
+            __m128i x1 = _mm_xor_si128(_mm_srli_si128(x0, 8), _mm_clmulepi64_si128(x0, k4, 0x10));
+            x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), k5, 0x00), _mm_srli_si128(x1, 4));
+            __m128i x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), poly, 0x10);
+            x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), poly, 0x00);
+            return ~(uint32_t)_mm_extract_epi32(_mm_xor_si128(x1, x2), 1);
+        }
+
+        uint32_t Crc32(const void* src, size_t size)
+        {
+            if (!PclmulEnable || size < 64)
+                return Base::Crc32(src, size);
+            const uint8_t* p = (const uint8_t*)src;
+            const __m128i k1 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+            const __m128i k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+            __m128i x0 = _mm_xor_si128(_mm_loadu_si128((__m128i*)p + 0), _mm_cvtsi32_si128(-1));
+            __m128i x1 = _mm_loadu_si128((__m128i*)p + 1);
+            __m128i x2 = _mm_loadu_si128((__m128i*)p + 2);
+            __m128i x3 = _mm_loadu_si128((__m128i*)p + 3);
+            size_t i = 64, size64 = AlignLo(size, 64), size16 = AlignLo(size, 16);
+            for (; i < size64; i += 64)
+            {
+                x0 = Crc32Fold(x0, _mm_loadu_si128((__m128i*)(p + i) + 0), k1);
+                x1 = Crc32Fold(x1, _mm_loadu_si128((__m128i*)(p + i) + 1), k1);
+                x2 = Crc32Fold(x2, _mm_loadu_si128((__m128i*)(p + i) + 2), k1);
+                x3 = Crc32Fold(x3, _mm_loadu_si128((__m128i*)(p + i) + 3), k1);
+            }
+            x0 = Crc32Fold(x0, x1, k4);
+            x0 = Crc32Fold(x0, x2, k4);
+            x0 = Crc32Fold(x0, x3, k4);
+            for (; i < size16; i += 16)
+                x0 = Crc32Fold(x0, _mm_loadu_si128((__m128i*)(p + i)), k4);
+            return Base::Crc32(Crc32Reduce(x0), p + i, size - i);
+        }
     }
 #endif
 }
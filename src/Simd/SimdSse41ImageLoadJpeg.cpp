@@ -186,6 +186,42 @@ namespace Simd
 
         //-------------------------------------------------------------------------------------------------
 
+        SIMD_INLINE __m128 JpegIdct4x4Row(const int16_t* src, const float* k)
+        {
+            __m128 f = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)src)));
+            __m128 f0 = _mm_mul_ps(_mm_shuffle_ps(f, f, 0x00), _mm_load_ps(k + 0 * 4));
+            __m128 f1 = _mm_mul_ps(_mm_shuffle_ps(f, f, 0x55), _mm_load_ps(k + 1 * 4));
+            __m128 f2 = _mm_mul_ps(_mm_shuffle_ps(f, f, 0xAA), _mm_load_ps(k + 2 * 4));
+            __m128 f3 = _mm_mul_ps(_mm_shuffle_ps(f, f, 0xFF), _mm_load_ps(k + 3 * 4));
+            return _mm_add_ps(_mm_add_ps(f0, f1), _mm_add_ps(f2, f3));
+        }
+
+        SIMD_INLINE __m128i JpegIdct4x4Col(const __m128* t, const float* k, int y)
+        {
+            __m128 o02 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(k[0 * 4 + y]), t[0]), _mm_mul_ps(_mm_set1_ps(k[2 * 4 + y]), t[2]));
+            __m128 o13 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(k[1 * 4 + y]), t[1]), _mm_mul_ps(_mm_set1_ps(k[3 * 4 + y]), t[3]));
+            return _mm_add_epi32(_mm_cvtps_epi32(_mm_add_ps(o02, o13)), _mm_set1_epi32(128));
+        }
+
+        static void JpegIdctBlock4x4(const int16_t* src, uint8_t* dst, int stride)
+        {
+            const float* k = Base::JpegIdct4x4K;
+            __m128 t[4];
+            t[0] = JpegIdct4x4Row(src + 0 * 8, k);
+            t[1] = JpegIdct4x4Row(src + 1 * 8, k);
+            t[2] = JpegIdct4x4Row(src + 2 * 8, k);
+            t[3] = JpegIdct4x4Row(src + 3 * 8, k);
+            __m128i o01 = _mm_packs_epi32(JpegIdct4x4Col(t, k, 0), JpegIdct4x4Col(t, k, 1));
+            __m128i o23 = _mm_packs_epi32(JpegIdct4x4Col(t, k, 2), JpegIdct4x4Col(t, k, 3));
+            __m128i o = _mm_packus_epi16(o01, o23);
+            *(int32_t*)(dst + 0 * stride) = _mm_extract_epi32(o, 0);
+            *(int32_t*)(dst + 1 * stride) = _mm_extract_epi32(o, 1);
+            *(int32_t*)(dst + 2 * stride) = _mm_extract_epi32(o, 2);
+            *(int32_t*)(dst + 3 * stride) = _mm_extract_epi32(o, 3);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
 #define jpeg__div4(x) ((uint8_t) ((x) >> 2))
 #define jpeg__div16(x) ((uint8_t) ((x) >> 4))
 
@@ -415,37 +451,52 @@ namespace Simd
 
         //-------------------------------------------------------------------------------------------------
 
-        ImageJpegLoader::ImageJpegLoader(const ImageLoaderParam& param)
-            : Base::ImageJpegLoader(param)
+        void JpegSetConverters(Base::JpegContext* context, SimdPixelFormatType format)
         {
-            _context->idctBlock = JpegIdctBlock;
-            _context->resampleRowHv2 = JpegResampleRowHv2;
-            if (_param.format == SimdPixelFormatGray8)
-                _context->rgbaToAny = Sse41::RgbaToGray;
-            if (_param.format == SimdPixelFormatBgr24)
+            Base::JpegSetConverters(context, format);
+            context->idctBlock = JpegIdctBlock;
+            context->idctBlock4x4 = JpegIdctBlock4x4;
+            context->resampleRowHv2 = JpegResampleRowHv2;
+            context->interleaveUv = Sse41::InterleaveUv;
+            if (format == SimdPixelFormatGray8)
+                context->rgbaToAny = Sse41::RgbaToGray;
+            if (format == SimdPixelFormatBgr24)
             {
-                _context->yuv444pToBgr = Sse41::Yuv444pToBgrV2;
-                _context->yuv420pToBgr = Sse41::JpegYuv420pToBgr;
-                _context->rgbaToAny = Sse41::BgraToRgb;
+                context->yuv444pToBgr = Sse41::Yuv444pToBgrV2;
+                context->yuv420pToBgr = Sse41::JpegYuv420pToBgr;
+                context->rgbaToAny = Sse41::BgraToRgb;
             }
-            if (_param.format == SimdPixelFormatBgra32)
+            if (format == SimdPixelFormatBgra32)
             {
-                _context->yuv444pToBgra = Sse41::Yuv444pToBgraV2;
-                _context->yuv420pToBgra = Sse41::JpegYuv420pToBgra;
-                _context->rgbaToAny = Sse41::BgraToRgba;
+                context->yuv444pToBgra = Sse41::Yuv444pToBgraV2;
+                context->yuv420pToBgra = Sse41::JpegYuv420pToBgra;
+                context->rgbaToAny = Sse41::BgraToRgba;
             }
-            if (_param.format == SimdPixelFormatRgb24)
+            if (format == SimdPixelFormatRgb24)
             {
-                _context->yuv444pToBgr = Sse41::Yuv444pToRgbV2;
-                _context->yuv420pToBgr = Sse41::JpegYuv420pToRgb;
-                _context->rgbaToAny = Sse41::BgraToBgr;
+                context->yuv444pToBgr = Sse41::Yuv444pToRgbV2;
+                context->yuv420pToBgr = Sse41::JpegYuv420pToRgb;
+                context->rgbaToAny = Sse41::BgraToBgr;
             }
-            if (_param.format == SimdPixelFormatRgba32)
+            if (format == SimdPixelFormatRgba32)
             {
-                _context->yuv444pToBgra = Sse41::Yuv444pToRgbaV2;
-                _context->yuv420pToBgra = Sse41::JpegYuv420pToRgba;
+                context->yuv444pToBgra = Sse41::Yuv444pToRgbaV2;
+                context->yuv420pToBgra = Sse41::JpegYuv420pToRgba;
             }
         }
+
+        //-------------------------------------------------------------------------------------------------
+
+        ImageJpegLoader::ImageJpegLoader(const ImageLoaderParam& param)
+            : Base::ImageJpegLoader(param)
+        {
+            Sse41::JpegSetConverters(_context, _param.format);
+        }
+
+        void* JpegDecoderInit()
+        {
+            return new Base::JpegDecoder(Sse41::JpegSetConverters);
+        }
     }
 #endif
 }
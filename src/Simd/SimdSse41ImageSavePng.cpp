@@ -34,37 +34,39 @@ namespace Simd
 #ifdef SIMD_SSE41_ENABLE    
     namespace Sse41
     {
-        uint32_t ZlibAdler32(uint8_t* data, int size)
+        uint32_t ZlibAdler32(const uint8_t* data, int size)
         {
-            __m128i _i0 = _mm_setr_epi32(0, -1, -2, -3), _4 = _mm_set1_epi32(4);
+            const int BASE = 65521, BLOCK = 5552 / 32;
+            const __m128i tap0 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+            const __m128i tap1 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
             uint32_t lo = 1, hi = 0;
-            for (int b = 0, n = (int)(size % 5552); b < size;)
+            for (int blocks = size / 32; blocks > 0;)
             {
-                int n4 = n & (~3), i = 0;
-                __m128i _i = _mm_add_epi32(_i0, _mm_set1_epi32(n));
-                __m128i _l = _mm_setzero_si128(), _h = _mm_setzero_si128();
-                for (; i < n4; i += 4)
+                int n = Simd::Min(blocks, BLOCK);
+                blocks -= n, size -= n * 32;
+                __m128i _p = _mm_setr_epi32(0, 0, 0, lo * n), _l = _mm_setzero_si128(), _h = _mm_setr_epi32(0, 0, 0, hi);
+                for (; n > 0; n -= 1, data += 32)
                 {
-                    __m128i d = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(int32_t*)(data + b + i)));
-                    _l = _mm_add_epi32(_l, d);
-                    _h = _mm_add_epi32(_h, _mm_mullo_epi32(d, _i));
-                    _i = _mm_sub_epi32(_i, _4);
+                    __m128i d0 = _mm_loadu_si128((__m128i*)data + 0);
+                    __m128i d1 = _mm_loadu_si128((__m128i*)data + 1);
+                    _p = _mm_add_epi32(_p, _l);
+                    _l = _mm_add_epi32(_l, _mm_add_epi32(_mm_sad_epu8(d0, K_ZERO), _mm_sad_epu8(d1, K_ZERO)));
+                    _h = _mm_add_epi32(_h, _mm_madd_epi16(_mm_maddubs_epi16(d0, tap0), K16_0001));
+                    _h = _mm_add_epi32(_h, _mm_madd_epi16(_mm_maddubs_epi16(d1, tap1), K16_0001));
                 }
-                int l = ExtractInt32Sum(_l), h = ExtractInt32Sum(_h);
-                for (; i < n; ++i)
-                {
-                    l += data[b + i];
-                    h += data[b + i]*(n - i);
-                }
-                hi = (hi + h + lo*n) % 65521;
-                lo = (lo + l) % 65521;
-                b += n;
-                n = 5552;
+                _h = _mm_add_epi32(_h, _mm_slli_epi32(_p, 5));
+                lo = (lo + (uint32_t)ExtractInt32Sum(_l)) % BASE;
+                hi = (uint32_t)ExtractInt32Sum(_h) % BASE;
+            }
+            for (; size > 0; size -= 1)
+            {
+                lo += *data++;
+                hi += lo;
             }
-            return (hi << 16) | lo;
+            return ((hi % BASE) << 16) | (lo % BASE);
         }
 
-        void ZlibCompress(uint8_t* data, int size, int quality, OutputMemoryStream& stream)
+        void ZlibDeflate(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream)
         {
             const int ZHASH = 16384;
             if (quality < 5)
@@ -72,23 +74,22 @@ namespace Simd
             const int basket = quality * 2;
             Array32i hashTable(ZHASH * basket);
             memset(hashTable.data, -1, hashTable.RawSize());
+            Base::ZlibPrime(hashTable.data, basket, quality, data, begin);
 
-            stream.Write(uint8_t(0x78));
-            stream.Write(uint8_t(0x5e));
-            stream.WriteBits(1, 1);
+            stream.WriteBits(last ? 1 : 0, 1);
             stream.WriteBits(1, 2);
 
-            int i = 0, j;
-            while (i < size - 3)
+            int i = begin, j;
+            while (i < end - 3)
             {
                 int h = Base::ZlibHash(data + i) & (ZHASH - 1), best = 3;
-                uint8_t* bestLoc = 0;
+                const uint8_t* bestLoc = 0;
                 int* hList = hashTable.data + h * basket;
                 for (j = 0; hList[j] != -1 && j < basket; ++j)
                 {
                     if (hList[j] > i - 32768)
                     {
-                        int d = ZlibCount(data + hList[j], data + i, size - i);
+                        int d = ZlibCount(data + hList[j], data + i, end - i);
                         if (d >= best)
                         {
                             best = d;
@@ -112,7 +113,7 @@ namespace Simd
                     {
                         if (hList[j] > i - 32767)
                         {
-                            int e = ZlibCount(data + hList[j], data + i + 1, size - i - 1);
+                            int e = ZlibCount(data + hList[j], data + i + 1, end - i - 1);
                             if (e > best)
                             {
                                 bestLoc = NULL;
@@ -142,11 +143,19 @@ namespace Simd
                     ++i;
                 }
             }
-            for (; i < size; ++i)
+            for (; i < end; ++i)
                 Base::ZlibHuffB(data[i], stream);
             Base::ZlibHuff(256, stream);
+            if (!last)
+                stream.WriteBits(0, 3);
             stream.FlushBits();
-            stream.WriteBe32u(ZlibAdler32(data, size));
+            if (!last)
+                stream.WriteBe32u(0x0000FFFF);
+        }
+
+        void ZlibDeflateRle(const uint8_t* data, int begin, int end, int quality, bool last, OutputMemoryStream& stream)
+        {
+            Base::ZlibDeflateDynamic(data, begin, end, last, Base::ZlibTokenizeRle<Sse41::ZlibCount>, stream);
         }
 
         uint32_t EncodeLine0(const uint8_t* src, size_t stride, size_t n, size_t size, int8_t* dst)
@@ -364,7 +373,10 @@ namespace Simd
             _encode[4] = Sse41::EncodeLine4;
             _encode[5] = Sse41::EncodeLine5;
             _encode[6] = Sse41::EncodeLine6;
-            _compress = Sse41::ZlibCompress;
+            _adler32 = Sse41::ZlibAdler32;
+            _crc32 = Sse41::Crc32;
+            _deflate = Sse41::ZlibDeflate;
+            _deflateRle = Sse41::ZlibDeflateRle;
         }
     }
 #endif// SIMD_SSE41_ENABLE
@@ -45,16 +45,19 @@ namespace Simd
 
         void ResizerByteBilinear::EstimateParams()
         {
-            if (_ax.data)
+            if (_xSrcW == _param.srcW)
                 return;
-            if (_param.channels == 1 && _param.srcW < 4 * _param.dstW)
+            _xSrcW = _param.srcW;
+            _blocks = 0;
+            if (_param.channels == 1 && _param.srcW < 4 * _param.dstW && _param.srcW >= A)
                 _blocks = BlockCountMax(A);
             float scale = (float)_param.srcW / _param.dstW;
             _ax.Resize(AlignHi(_param.dstW, A) * _param.channels * 2, false, _param.align);
             uint8_t* alphas = _ax.data;
             if (_blocks)
             {
-                _ixg.Resize(_blocks);
+                if (_ixg.size < _blocks)
+                    _ixg.Resize(_blocks);
                 int block = 0;
                 _ixg[0].src = 0;
                 _ixg[0].dst = 0;
@@ -222,7 +225,7 @@ namespace Simd
             const int32_t* ix = _ix.data;
             size_t dstW = _param.dstW;
 
-            for (size_t yDst = 0; yDst < _param.dstH; yDst++, dst += dstStride)
+            for (size_t yDst = _yBeg; yDst < _yEnd; yDst++, dst += dstStride)
             {
                 a[0] = _mm_set1_epi16(int16_t(Base::FRACTION_RANGE - _ay[yDst]));
                 a[1] = _mm_set1_epi16(int16_t(_ay[yDst]));
@@ -279,7 +282,7 @@ namespace Simd
             const uint8_t* ax = _ax.data;
             const Idx* ixg = _ixg.data;
 
-            for (size_t yDst = 0; yDst < _param.dstH; yDst++, dst += dstStride)
+            for (size_t yDst = _yBeg; yDst < _yEnd; yDst++, dst += dstStride)
             {
                 a[0] = _mm_set1_epi16(int16_t(Base::FRACTION_RANGE - _ay[yDst]));
                 a[1] = _mm_set1_epi16(int16_t(_ay[yDst]));
@@ -349,7 +352,7 @@ namespace Simd
             size_t rs4 = AlignLo(rs, 4);
             size_t rs8 = AlignLo(rs, 8);
             __m128 _1 = _mm_set1_ps(1.0f);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -448,7 +451,7 @@ namespace Simd
             size_t rs4 = AlignLo(rs, 4);
             size_t rs8 = AlignLo(rs, 8);
             __m128 _1 = _mm_set1_ps(1.0f);
-            for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+            for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
             {
                 float fy1 = _ay[dy];
                 float fy0 = 1.0f - fy1;
@@ -606,7 +609,7 @@ namespace Simd
                 float* pbx[2] = { _bx[0].data, _bx[1].data };
                 int32_t prev = -2;
                 size_t rsF = AlignLo(rs, F);
-                for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                 {
                     float fy1 = _ay[dy];
                     float fy0 = 1.0f - fy1;
@@ -712,7 +715,7 @@ namespace Simd
             }
             else
             {
-                for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                 {
                     __m128 fy1 = _mm_set1_ps(_ay[dy]);
                     __m128 fy0 = _mm_sub_ps(_1, fy1);
@@ -851,7 +854,7 @@ namespace Simd
                 size_t rs = _param.dstW * cn, rsF = AlignLo(rs, F), rsD = AlignLo(rs, DF);
                 float* pbx[2] = { _bx[0].data, _bx[1].data };
                 int32_t prev = -2;
-                for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                 {
                     float fy1 = _ay[dy];
                     float fy0 = 1.0f - fy1;
@@ -980,7 +983,7 @@ namespace Simd
             }
             else
             {
-                for (size_t dy = 0; dy < _param.dstH; dy++, dst += dstStride)
+                for (size_t dy = _yBeg; dy < _yEnd; dy++, dst += dstStride)
                 {
                     __m128 fy1 = _mm_set1_ps(_ay[dy]);
                     __m128 fy0 = _mm_sub_ps(_1, fy1);
@@ -0,0 +1,231 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Simd/SimdSynetPreprocess.h"
+#include "Simd/SimdBFloat16.h"
+#include "Simd/SimdExtract.h"
+#include "Simd/SimdStore.h"
+#include "Simd/SimdSse41.h"
+
+namespace Simd
+{
+#if defined(SIMD_SSE41_ENABLE) && defined(SIMD_SYNET_ENABLE)    
+    namespace Sse41
+    {
+        void SynetPreprocessHorizontal1(const uint8_t* src, size_t srcW, size_t channels, const int32_t* ix, const float* ax, size_t taps, size_t dstW, bool planar, float* dst)
+        {
+            size_t x = 0;
+            if (taps == 2)
+            {
+                size_t dstW4 = AlignLo(dstW, 4);
+                for (; x < dstW4; x += 4, ax += 8)
+                {
+                    __m128i s = _mm_setr_epi32(*(uint16_t*)(src + ix[x + 0]), *(uint16_t*)(src + ix[x + 1]), 
+                        *(uint16_t*)(src + ix[x + 2]), *(uint16_t*)(src + ix[x + 3]));
+                    __m128 s0 = _mm_cvtepi32_ps(_mm_and_si128(s, K32_000000FF));
+                    __m128 s1 = _mm_cvtepi32_ps(_mm_srli_epi32(s, 8));
+                    __m128 a01 = _mm_loadu_ps(ax + 0), a23 = _mm_loadu_ps(ax + 4);
+                    __m128 a0 = _mm_shuffle_ps(a01, a23, 0x88), a1 = _mm_shuffle_ps(a01, a23, 0xDD);
+                    _mm_storeu_ps(dst + x, _mm_add_ps(_mm_mul_ps(a0, s0), _mm_mul_ps(a1, s1)));
+                }
+            }
+            else if (taps >= 4)
+            {
+                size_t taps4 = AlignLo(taps, 4);
+                for (; x < dstW; ++x, ax += taps)
+                {
+                    const uint8_t* s = src + ix[x];
+                    __m128 sum = _mm_setzero_ps();
+                    size_t t = 0;
+                    for (; t < taps4; t += 4)
+                        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(ax + t), _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(int32_t*)(s + t))))));
+                    float res = ExtractSum(sum);
+                    for (; t < taps; ++t)
+                        res += ax[t] * float(s[t]);
+                    dst[x] = res;
+                }
+            }
+            if (x < dstW)
+                Base::SynetPreprocessHorizontal(src, srcW, 1, ix + x, ax, taps, dstW - x, planar, dst + x);
+        }
+
+        SIMD_INLINE __m128 LoadBgr(const uint8_t* p)
+        {
+            return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(int32_t*)p)));
+        }
+
+        SIMD_INLINE __m128 LoadLastBgr(const uint8_t* p)
+        {
+            return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(_mm_cvtsi32_si128(*(int32_t*)(p - 1)), 1)));
+        }
+
+        static void SynetPreprocessHorizontal3(const uint8_t* src, size_t srcW, size_t channels, const int32_t* ix, const float* ax, size_t taps, size_t dstW, bool planar, float* dst)
+        {
+            size_t last = taps - 1;
+            for (size_t x = 0; x < dstW; ++x, ax += taps)
+            {
+                const uint8_t* s = src + ix[x] * 3;
+                __m128 sum = _mm_setzero_ps();
+                for (size_t t = 0; t < last; ++t)
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(ax[t]), LoadBgr(s + t * 3)));
+                __m128 pixel = size_t(ix[x]) + taps < srcW ? LoadBgr(s + last * 3) : LoadLastBgr(s + last * 3);
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(ax[last]), pixel));
+                if (planar)
+                {
+                    dst[x] = _mm_cvtss_f32(sum);
+                    dst[x + dstW] = _mm_cvtss_f32(_mm_shuffle_ps(sum, sum, 1));
+                    dst[x + dstW * 2] = _mm_cvtss_f32(_mm_movehl_ps(sum, sum));
+                }
+                else
+                {
+                    _mm_storel_pi((__m64*)(dst + x * 3), sum);
+                    _mm_store_ss(dst + x * 3 + 2, _mm_movehl_ps(sum, sum));
+                }
+            }
+        }
+
+        static void SynetPreprocessMulRow(const float* src, float weight, size_t size, float* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i = 0;
+            __m128 _weight = _mm_set1_ps(weight);
+            for (; i < sizeF; i += F)
+                _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), _weight));
+            for (; i < size; ++i)
+                dst[i] = src[i] * weight;
+        }
+
+        static void SynetPreprocessAddMulRow(const float* src, float weight, size_t size, float* dst)
+        {
+            size_t sizeF = AlignLo(size, F), i = 0;
+            __m128 _weight = _mm_set1_ps(weight);
+            for (; i < sizeF; i += F)
+                _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), _weight)));
+            for (; i < size; ++i)
+                dst[i] += src[i] * weight;
+        }
+
+        SIMD_INLINE __m128 Normalize(const float* src, const float* scale, const float* shift)
+        {
+            return _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src), _mm_loadu_ps(scale)), _mm_loadu_ps(shift));
+        }
+
+        static void SynetPreprocessStore32f(const float* src, const float* scale, const float* shift, size_t size, uint8_t* dst)
+        {
+            float* dst32f = (float*)dst;
+            size_t sizeF = AlignLo(size, F), i = 0;
+            for (; i < sizeF; i += F)
+                _mm_storeu_ps(dst32f + i, Normalize(src + i, scale + i, shift + i));
+            for (; i < size; ++i)
+                dst32f[i] = src[i] * scale[i] + shift[i];
+        }
+
+        static void SynetPreprocessStore16b(const float* src, const float* scale, const float* shift, size_t size, uint8_t* dst)
+        {
+            uint16_t* dst16b = (uint16_t*)dst;
+            size_t sizeDF = AlignLo(size, DF), i = 0;
+            for (; i < sizeDF; i += DF)
+            {
+                __m128 lo = Normalize(src + i + 0, scale + i + 0, shift + i + 0);
+                __m128 hi = Normalize(src + i + F, scale + i + F, shift + i + F);
+                _mm_storeu_si128((__m128i*)(dst16b + i), Float32ToBFloat16(lo, hi));
+            }
+            for (; i < size; ++i)
+                dst16b[i] = Base::Float32ToBFloat16(src[i] * scale[i] + shift[i]);
+        }
+
+        static void SynetPreprocessStore8u(const float* src, const float* scale, const float* shift, size_t size, uint8_t* dst)
+        {
+            size_t sizeDF = AlignLo(size, DF), i = 0;
+            for (; i < sizeDF; i += DF)
+            {
+                __m128i lo = _mm_cvtps_epi32(Normalize(src + i + 0, scale + i + 0, shift + i + 0));
+                __m128i hi = _mm_cvtps_epi32(Normalize(src + i + F, scale + i + F, shift + i + F));
+                _mm_storel_epi64((__m128i*)(dst + i), _mm_packus_epi16(_mm_packs_epi32(lo, hi), K_ZERO));
+            }
+            for (; i < size; ++i)
+                dst[i] = (uint8_t)RestrictRange(Round(src[i] * scale[i] + shift[i]), 0, 255);
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        SynetPreprocess::SynetPreprocess(const PreprocessParam& param)
+            : Base::SynetPreprocess(param)
+        {
+            const PreprocessParam& p = _param;
+            if (p.srcW >= DA)
+            {
+                if (p.channels == 3)
+                {
+                    switch (p.srcFormat)
+                    {
+                    case SimdPixelFormatGray8: _convert = GrayToBgr; break;
+                    case SimdPixelFormatRgb24: _convert = BgrToRgb; break;
+                    case SimdPixelFormatBgra32: _convert = BgraToBgr; break;
+                    case SimdPixelFormatRgba32: _convert = BgraToRgb; break;
+                    default: break;
+                    }
+                }
+                else
+                {
+                    switch (p.srcFormat)
+                    {
+                    case SimdPixelFormatBgr24: _convert = BgrToGray; break;
+                    case SimdPixelFormatRgb24: _convert = RgbToGray; break;
+                    case SimdPixelFormatBgra32: _convert = BgraToGray; break;
+                    case SimdPixelFormatRgba32: _convert = RgbaToGray; break;
+                    case SimdPixelFormatNv12: _toGray = BgrToGray; break;
+                    case SimdPixelFormatYuv420p: _toGray = BgrToGray; break;
+                    default: break;
+                    }
+                }
+                _deinterleaveUv = DeinterleaveUv;
+                _yuvToBgr = Yuv422pToBgrV2;
+            }
+            if (p.channels == 1)
+                _horizontal = SynetPreprocessHorizontal1;
+            else if (p.srcW > 1)
+                _horizontal = SynetPreprocessHorizontal3;
+            _mulRow = SynetPreprocessMulRow;
+            _addMulRow = SynetPreprocessAddMulRow;
+            switch (p.dstType)
+            {
+            case SimdTensorData32f: _store = SynetPreprocessStore32f; break;
+            case SimdTensorData16b: _store = SynetPreprocessStore16b; break;
+            case SimdTensorData8u: _store = SynetPreprocessStore8u; break;
+            default: break;
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetPreprocessInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels,
+            SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat)
+        {
+            PreprocessParam param(srcW, srcH, srcFormat, yuvType, dstW, dstH, channels, method, lower, upper, dstType, dstFormat);
+            if (!param.Valid())
+                return NULL;
+            return new Sse41::SynetPreprocess(param);
+        }
+    }
+#endif
+}
@@ -25,6 +25,7 @@
 #define __SimdSynetConvolution16b_h__
 
 #include "Simd/SimdArray.h"
+#include "Simd/SimdSynetWorkspace.h"
 #include "Simd/SimdPerformance.h"
 #include "Simd/SimdRuntime.h"
 #include "Simd/SimdSynetConvParam.h"
@@ -32,7 +33,7 @@
 
 namespace Simd
 {
-    class SynetConvolution16b : public Deletable
+    class SynetConvolution16b : public SynetWorkspaceUser
     {
     public:
         SynetConvolution16b(const ConvParam& p);
@@ -45,6 +46,11 @@ namespace Simd
         virtual String Ext() const = 0;
         virtual String Desc() const = 0;
 
+        virtual size_t WorkspaceSize() const
+        {
+            return ExternalBufferSize();
+        }
+
         virtual size_t ExternalBufferSize() const
         {
             return 1;
@@ -66,8 +72,7 @@ namespace Simd
                 return buffer;
             else
             {
-                _buffer.Resize(ExternalBufferSize());
-                return _buffer.data;
+                return Workspace(_buffer, ExternalBufferSize());
             }
         }
 
@@ -25,6 +25,7 @@
 #define __SimdSynetConvolution32f_h__
 
 #include "Simd/SimdArray.h"
+#include "Simd/SimdSynetWorkspace.h"
 #include "Simd/SimdRuntime.h"
 #include "Simd/SimdGemm.h"
 #include "Simd/SimdSynetConvParam.h"
@@ -44,7 +45,7 @@ namespace Simd
 
     //-------------------------------------------------------------------------------------------------
 
-    class SynetConvolution32f : public Deletable
+    class SynetConvolution32f : public SynetWorkspaceUser
     {
     public:
         SynetConvolution32f(const ConvParam & p) 
@@ -68,6 +69,11 @@ namespace Simd
         virtual String Ext() const = 0;
         virtual String Desc() const = 0;
 
+        virtual size_t WorkspaceSize() const
+        {
+            return ExternalBufferSize() * sizeof(float);
+        }
+
         virtual size_t ExternalBufferSize() const
         {
             return 1;
@@ -95,8 +101,7 @@ namespace Simd
                 return buffer;
             else
             {
-                _buffer.Resize(ExternalBufferSize());
-                return _buffer.data;
+                return Workspace(_buffer, ExternalBufferSize());
             }
         }
 
@@ -354,14 +359,12 @@ namespace Simd
                     Forward(args.src, args.p, alg, args.weight, args.bias, args.params, args.dst);
                 }
 
-#ifdef SIMD_RUNTIME_STATISTIC
                 SIMD_INLINE String Info(const RunArgs& args) const
                 {
                     std::stringstream ss;
-                    ss << "NhwcDirect [" << args.p.Info() << "]";
+                    ss << "NhwcDirect [" << args.p.Info(true) << "-" << args.p.padY << "x" << args.p.padX << "-" << args.p.padH << "x" << args.p.padW << "]";
                     return ss.str();
                 }
-#endif
 
                 AlgParam alg;
             private:
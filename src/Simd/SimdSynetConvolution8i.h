@@ -26,6 +26,7 @@
 
 #include "Simd/SimdSynetConvParam.h"
 #include "Simd/SimdArray.h"
+#include "Simd/SimdSynetWorkspace.h"
 #include "Simd/SimdPerformance.h"
 
 #ifdef _N
@@ -54,7 +55,7 @@ namespace Simd
         }
     };
 
-    class SynetConvolution8i : public Deletable
+    class SynetConvolution8i : public SynetWorkspaceUser
     {
     public:
         SynetConvolution8i(const ConvParam& p);
@@ -64,6 +65,11 @@ namespace Simd
         virtual String Ext() const = 0;
         virtual String Desc() const = 0;
 
+        virtual size_t WorkspaceSize() const
+        {
+            return ExternalBufferSize();
+        }
+
         virtual size_t ExternalBufferSize() const;
         virtual size_t InternalBufferSize() const;
 
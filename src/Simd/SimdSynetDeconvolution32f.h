@@ -25,6 +25,7 @@
 #define __SimdSynetDeconvolution32f_h__
 
 #include "Simd/SimdArray.h"
+#include "Simd/SimdSynetWorkspace.h"
 #include "Simd/SimdPerformance.h"
 #include "Simd/SimdRuntime.h"
 #include "Simd/SimdGemm.h"
@@ -36,7 +37,7 @@
 
 namespace Simd
 {
-    class SynetDeconvolution32f : public Deletable
+    class SynetDeconvolution32f : public SynetWorkspaceUser
     {
     public:
         SynetDeconvolution32f(const DeconvParam & p)
@@ -60,6 +61,11 @@ namespace Simd
         virtual String Ext() const = 0;
         virtual String Desc() const = 0;
 
+        virtual size_t WorkspaceSize() const
+        {
+            return ExternalBufferSize() * sizeof(float);
+        }
+
         virtual size_t ExternalBufferSize() const
         {
             return 1;
@@ -87,8 +93,7 @@ namespace Simd
                 return buffer;
             else
             {
-                _buffer.Resize(ExternalBufferSize());
-                return _buffer.data;
+                return Workspace(_buffer, ExternalBufferSize());
             }
         }
 
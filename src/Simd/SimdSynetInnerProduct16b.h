@@ -25,6 +25,7 @@
 #define __SimdSynetInnerProduct16b_h__
 
 #include "Simd/SimdArray.h"
+#include "Simd/SimdSynetWorkspace.h"
 #include "Simd/SimdPerformance.h"
 #include "Simd/SimdSynetConvParam.h"
 
@@ -70,7 +71,7 @@ namespace Simd
 
     //-------------------------------------------------------------------------------------------------
 
-    class SynetInnerProduct16b : public Deletable
+    class SynetInnerProduct16b : public SynetWorkspaceUser
     {
     public:
         SynetInnerProduct16b(const InnerProductParam16b& p)
@@ -94,6 +95,11 @@ namespace Simd
             return _buffer.RawSize() + _weight.RawSize() + _bias.RawSize();
         }
 
+        virtual size_t WorkspaceSize() const
+        {
+            return ExternalBufferSize();
+        }
+
         virtual size_t ExternalBufferSize() const
         {
             return _sizeA * 2 + _sizeB * 2 + _sizeC * 4;
@@ -137,8 +143,7 @@ namespace Simd
                 return buffer;
             else
             {
-                _buffer.Resize(ExternalBufferSize());
-                return _buffer.data;
+                return Workspace(_buffer, ExternalBufferSize());
             }
         }
     };
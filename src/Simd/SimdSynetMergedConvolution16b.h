@@ -26,14 +26,20 @@
 
 #include "Simd/SimdSynetConvParam.h"
 #include "Simd/SimdArray.h"
+#include "Simd/SimdSynetWorkspace.h"
 
 namespace Simd
 {
-    class SynetMergedConvolution16b : public Deletable
+    class SynetMergedConvolution16b : public SynetWorkspaceUser
     {
     public:
         virtual const MergConvParam& Param() const = 0;
 
+        virtual size_t WorkspaceSize() const
+        {
+            return ExternalBufferSize();
+        }
+
         virtual size_t ExternalBufferSize() const = 0;
 
         virtual size_t InternalBufferSize() const = 0;
@@ -26,6 +26,7 @@
 
 #include "Simd/SimdSynetConvolution32f.h"
 #include "Simd/SimdArray.h"
+#include "Simd/SimdSynetWorkspace.h"
 #include "Simd/SimdPerformance.h"
 #include "Simd/SimdRuntime.h"
 
@@ -35,7 +36,7 @@
 
 namespace Simd
 {
-    class SynetMergedConvolution32f : public Deletable
+    class SynetMergedConvolution32f : public SynetWorkspaceUser
     {
     public:
         SynetMergedConvolution32f(const MergConvParam& p)
@@ -51,6 +52,11 @@ namespace Simd
             return _param; 
         }
 
+        virtual size_t WorkspaceSize() const
+        {
+            return ExternalBufferSize() * sizeof(float);
+        }
+
         virtual size_t ExternalBufferSize() const = 0;
 
         virtual size_t InternalBufferSize() const = 0;
@@ -88,8 +94,7 @@ namespace Simd
                 return buffer;
             else
             {
-                _buffer.Resize(ExternalBufferSize());
-                return _buffer.data;
+                return Workspace(_buffer, ExternalBufferSize());
             }
         }
 
@@ -25,6 +25,7 @@
 #define __SimdSynetMergedConvolution8i_h__
 
 #include "Simd/SimdArray.h"
+#include "Simd/SimdSynetWorkspace.h"
 #include "Simd/SimdPerformance.h"
 #include "Simd/SimdRuntime.h"
 #include "Simd/SimdSynetConvolution8i.h"
@@ -123,11 +124,16 @@ namespace Simd
 #endif
     };
 
-    class SynetMergedConvolution8i : public Deletable
+    class SynetMergedConvolution8i : public SynetWorkspaceUser
     {
     public:
         virtual const MergConvParam8i & Param() const = 0;
 
+        virtual size_t WorkspaceSize() const
+        {
+            return ExternalBufferSize();
+        }
+
         virtual size_t ExternalBufferSize() const = 0;
 
         virtual size_t InternalBufferSize() const = 0;
@@ -0,0 +1,168 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#ifndef __SimdSynetPreprocess_h__
+#define __SimdSynetPreprocess_h__
+
+#include "Simd/SimdMath.h"
+#include "Simd/SimdMemory.h"
+#include "Simd/SimdArray.h"
+
+#include <vector>
+
+namespace Simd
+{
+    struct PreprocessParam
+    {
+        size_t srcW, srcH, dstW, dstH, channels;
+        SimdPixelFormatType srcFormat;
+        SimdYuvType yuvType;
+        SimdResizeMethodType method;
+        float lower[3], upper[3];
+        SimdTensorDataType dstType;
+        SimdTensorFormatType dstFormat;
+
+        PreprocessParam(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels,
+            SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat);
+
+        bool Valid() const;
+
+        SIMD_INLINE bool IsYuv() const
+        {
+            return srcFormat == SimdPixelFormatNv12 || srcFormat == SimdPixelFormatYuv420p;
+        }
+
+        SIMD_INLINE size_t DstTypeSize() const
+        {
+            return dstType == SimdTensorData32f ? 4 : (dstType == SimdTensorData16b ? 2 : 1);
+        }
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    namespace Base
+    {
+        class SynetPreprocess : public Deletable
+        {
+        public:
+            SynetPreprocess(const PreprocessParam& param);
+
+            void Forward(const uint8_t* src, size_t srcStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, uint8_t* dst);
+
+            typedef void (*ConvertPtr)(const uint8_t* src, size_t width, size_t height, size_t srcStride, uint8_t* dst, size_t dstStride);
+            typedef void (*DeinterleaveUvPtr)(const uint8_t* uv, size_t uvStride, size_t width, size_t height, uint8_t* u, size_t uStride, uint8_t* v, size_t vStride);
+            typedef void (*YuvToBgrPtr)(const uint8_t* y, size_t yStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride,
+                size_t width, size_t height, uint8_t* bgr, size_t bgrStride, SimdYuvType yuvType);
+            typedef void (*HorizontalPtr)(const uint8_t* src, size_t srcW, size_t channels, const int32_t* ix, const float* ax, size_t taps, size_t dstW, bool planar, float* dst);
+            typedef void (*MulRowPtr)(const float* src, float weight, size_t size, float* dst);
+            typedef void (*StorePtr)(const float* src, const float* scale, const float* shift, size_t size, uint8_t* dst);
+
+        protected:
+            struct Buffer
+            {
+                Array8u pixels, uv;
+                Array32f rows, sum;
+                Array32i index;
+            };
+
+            PreprocessParam _param;
+            size_t _xTaps, _yTaps, _rowSize;
+            bool _planar;
+            Array32i _ix, _iy;
+            Array32f _ax, _ay, _scale, _shift;
+            std::vector<Buffer> _buffers;
+
+            ConvertPtr _convert, _toGray;
+            DeinterleaveUvPtr _deinterleaveUv;
+            YuvToBgrPtr _yuvToBgr;
+            HorizontalPtr _horizontal;
+            MulRowPtr _mulRow, _addMulRow;
+            StorePtr _store;
+
+            void EstimateTaps(size_t srcSize, size_t dstSize, size_t& taps, Array32i& index, Array32f& alpha);
+            const uint8_t* SourceRow(Buffer& buf, const uint8_t* src, size_t srcStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, size_t row);
+            void Run(Buffer& buf, const uint8_t* src, size_t srcStride, const uint8_t* u, size_t uStride, const uint8_t* v, size_t vStride, size_t yBeg, size_t yEnd, uint8_t* dst);
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void SynetPreprocessHorizontal(const uint8_t* src, size_t srcW, size_t channels, const int32_t* ix, const float* ax, size_t taps, size_t dstW, bool planar, float* dst);
+
+        void* SynetPreprocessInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels,
+            SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat);
+    }
+
+#ifdef SIMD_SSE41_ENABLE    
+    namespace Sse41
+    {
+        class SynetPreprocess : public Base::SynetPreprocess
+        {
+        public:
+            SynetPreprocess(const PreprocessParam& param);
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void SynetPreprocessHorizontal1(const uint8_t* src, size_t srcW, size_t channels, const int32_t* ix, const float* ax, size_t taps, size_t dstW, bool planar, float* dst);
+
+        void* SynetPreprocessInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels,
+            SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat);
+    }
+#endif
+
+#ifdef SIMD_AVX2_ENABLE    
+    namespace Avx2
+    {
+        class SynetPreprocess : public Sse41::SynetPreprocess
+        {
+        public:
+            SynetPreprocess(const PreprocessParam& param);
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void SynetPreprocessHorizontal1(const uint8_t* src, size_t srcW, size_t channels, const int32_t* ix, const float* ax, size_t taps, size_t dstW, bool planar, float* dst);
+
+        void* SynetPreprocessInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels,
+            SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat);
+    }
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE    
+    namespace Avx512bw
+    {
+        class SynetPreprocess : public Avx2::SynetPreprocess
+        {
+        public:
+            SynetPreprocess(const PreprocessParam& param);
+        };
+
+        //-------------------------------------------------------------------------------------------------
+
+        void* SynetPreprocessInit(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels,
+            SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat);
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,105 @@
+/*
+* Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#ifndef __SimdSynetWorkspace_h__
+#define __SimdSynetWorkspace_h__
+
+#include "Simd/SimdArray.h"
+
+namespace Simd
+{
+    class SynetWorkspace : public Deletable
+    {
+    public:
+        SynetWorkspace()
+            : _peak(0)
+        {
+        }
+
+        SIMD_INLINE void Reserve(size_t size)
+        {
+            _peak = Max(_peak, size);
+        }
+
+        SIMD_INLINE uint8_t * Get(size_t size)
+        {
+            Reserve(size);
+            if (_buffer.size < _peak)
+                _buffer.Resize(_peak);
+            return _buffer.data;
+        }
+
+        SIMD_INLINE size_t Peak() const
+        {
+            return _peak;
+        }
+
+        SIMD_INLINE size_t Allocated() const
+        {
+            return _buffer.RawSize();
+        }
+
+    private:
+        Array8u _buffer;
+        size_t _peak;
+    };
+
+    //-------------------------------------------------------------------------------------------------
+
+    class SynetWorkspaceUser : public Deletable
+    {
+    public:
+        SynetWorkspaceUser()
+            : _workspace(NULL)
+        {
+        }
+
+        virtual size_t WorkspaceSize() const = 0;
+
+        void SetWorkspace(SynetWorkspace * workspace)
+        {
+            _workspace = workspace;
+            if (_workspace)
+                _workspace->Reserve(WorkspaceSize());
+        }
+
+    protected:
+        template<class T> SIMD_INLINE T * Workspace(Array<T> & buffer, size_t size)
+        {
+            if (_workspace)
+            {
+                if (buffer.size)
+                    buffer.Resize(0);
+                return (T*)_workspace->Get(size * sizeof(T));
+            }
+            buffer.Resize(size);
+            return buffer.data;
+        }
+
+    private:
+        SynetWorkspace * _workspace;
+    };
+}
+
+#endif//__SimdSynetWorkspace_h__
@@ -24,6 +24,7 @@
 * SOFTWARE.
 */
 #include "Test/TestPerformance.h"
+#include "Test/TestBenchmark.h"
 #include "Test/TestCompare.h"
 #include "Test/TestLog.h"
 #include "Test/TestString.h"
@@ -161,6 +162,7 @@ namespace Test
 
     TEST_ADD_GROUP_A0(Crc32);
     TEST_ADD_GROUP_A0(Crc32c);
+    TEST_ADD_GROUP_A0(ZlibAdler32);
 
     TEST_ADD_GROUP_A0(DescrIntEncode32f);
     TEST_ADD_GROUP_A0(DescrIntEncode16f);
@@ -180,6 +182,7 @@ namespace Test
     TEST_ADD_GROUP_A0(DetectionLbpDetect32fi);
     TEST_ADD_GROUP_A0(DetectionLbpDetect16ip);
     TEST_ADD_GROUP_A0(DetectionLbpDetect16ii);
+    TEST_ADD_GROUP_A0(DetectionThreads);
     TEST_ADD_GROUP_0S(Detection);
 
     TEST_ADD_GROUP_A0(AlphaBlending);
@@ -221,10 +224,19 @@ namespace Test
     TEST_ADD_GROUP_A0(Gemm32fNN);
     TEST_ADD_GROUP_A0(Gemm32fNT);
 
+    TEST_ADD_GROUP_A0(HugePage);
+
     TEST_ADD_GROUP_A0(ImageSaveToMemory);
     TEST_ADD_GROUP_A0(Nv12SaveAsJpegToMemory);
     TEST_ADD_GROUP_A0(Yuv420pSaveAsJpegToMemory);
+    TEST_ADD_GROUP_A0(JpegEncoderParallel);
+    TEST_ADD_GROUP_A0(PngEncoderParallel);
+    TEST_ADD_GROUP_A0(PngEncoderLevels);
     TEST_ADD_GROUP_AS(ImageLoadFromMemory);
+    TEST_ADD_GROUP_A0(ImageProbeFromMemory);
+    TEST_ADD_GROUP_A0(JpegDecoder);
+    TEST_ADD_GROUP_A0(JpegDecoderYuv);
+    TEST_ADD_GROUP_A0(JpegDecoderParallel);
 
     TEST_ADD_GROUP_A0(MeanFilter3x3);
     TEST_ADD_GROUP_A0(MedianFilterRhomb3x3);
@@ -260,6 +272,8 @@ namespace Test
 
     TEST_ADD_GROUP_A0(Integral);
 
+    TEST_ADD_GROUP_A0(IsaMask);
+
     TEST_ADD_GROUP_A0(InterleaveUv);
     TEST_ADD_GROUP_A0(InterleaveBgr);
     TEST_ADD_GROUP_A0(InterleaveBgra);
@@ -301,6 +315,11 @@ namespace Test
     TEST_ADD_GROUP_A0(OperationBinary16i);
     TEST_ADD_GROUP_A0(VectorProduct);
 
+    TEST_ADD_GROUP_A0(Parallel);
+    TEST_ADD_GROUP_A0(ParallelRows);
+    TEST_ADD_GROUP_A0(PerformanceStatistic);
+    TEST_ADD_GROUP_A0(ThreadPool);
+
     TEST_ADD_GROUP_A0(ReduceColor2x2);
     TEST_ADD_GROUP_A0(ReduceGray2x2);
     TEST_ADD_GROUP_A0(ReduceGray3x3);
@@ -312,6 +331,9 @@ namespace Test
     TEST_ADD_GROUP_A0(Reorder64bit);
 
     TEST_ADD_GROUP_A0(Resizer);
+    TEST_ADD_GROUP_A0(ResizerParallel);
+    TEST_ADD_GROUP_A0(ResizerBatch);
+    TEST_ADD_GROUP_A0(ResizerKernel);
     TEST_ADD_GROUP_0S(ResizeYuv420p);
 
     TEST_ADD_GROUP_A0(SegmentationShrinkRegion);
@@ -368,12 +390,14 @@ namespace Test
     TEST_ADD_GROUP_A0(SynetConvert32fTo8u);
     TEST_ADD_GROUP_A0(SynetConvert8uTo32f);
     TEST_ADD_GROUP_A0(SynetSetInput);
+    TEST_ADD_GROUP_A0(SynetPreprocess);
 
     TEST_ADD_GROUP_A0(SynetConvolution8iForward);
 
     TEST_ADD_GROUP_A0(SynetConvolution16bForward);
 
     TEST_ADD_GROUP_A0(SynetConvolution32fForward);
+    TEST_ADD_GROUP_A0(SynetRuntimeCache);
 
     TEST_ADD_GROUP_A0(SynetDeconvolution32fForward);
 
@@ -410,6 +434,8 @@ namespace Test
     TEST_ADD_GROUP_A0(SynetSoftmaxLayerForward);
 
     TEST_ADD_GROUP_A0(SynetUnaryOperation32f);
+
+    TEST_ADD_GROUP_A0(SynetWorkspace);
 #endif
 
     TEST_ADD_GROUP_A0(TextureBoostedSaturatedGradient);
@@ -614,13 +640,18 @@ namespace Test
         {
             Auto,
             Special,
+            Bench,
         } mode;
 
         bool help;
 
         Strings include, exclude;
 
-        String text, html;
+        String text, html, json, baseline;
+
+        std::vector<Size> benchSizes;
+        std::vector<size_t> benchThreads;
+        double regression;
 
         size_t workThreads, testRepeats, testStatistics;
 
@@ -635,6 +666,7 @@ namespace Test
             , printAlign(false)
             , printInternal(true)
             , checkCpp(false)
+            , regression(5.0)
         {
             for (int i = 1; i < argc; ++i)
             {
@@ -650,6 +682,7 @@ namespace Test
                     {
                     case 'a': mode = Auto; break;
                     case 's': mode = Special; break;
+                    case 'b': mode = Bench; break;
                     default:
                         TEST_LOG_SS(Error, "Unknown command line options: '" << arg << "'!" << std::endl);
                         exit(1);
@@ -683,6 +716,33 @@ namespace Test
                 {
                     html = arg.substr(4, arg.size() - 4);
                 }
+                else if (arg.find("-oj=") == 0)
+                {
+                    json = arg.substr(4, arg.size() - 4);
+                }
+                else if (arg.find("-bb=") == 0)
+                {
+                    baseline = arg.substr(4, arg.size() - 4);
+                }
+                else if (arg.find("-br=") == 0)
+                {
+                    regression = FromString<double>(arg.substr(4, arg.size() - 4));
+                }
+                else if (arg.find("-bs=") == 0)
+                {
+                    String size = arg.substr(4, arg.size() - 4);
+                    size_t x = size.find('x');
+                    if (x == String::npos)
+                    {
+                        TEST_LOG_SS(Error, "Wrong benchmark size: '" << arg << "'!" << std::endl);
+                        exit(1);
+                    }
+                    benchSizes.push_back(Size(FromString<int>(size.substr(0, x)), FromString<int>(size.substr(x + 1))));
+                }
+                else if (arg.find("-bt=") == 0)
+                {
+                    benchThreads.push_back(FromString<size_t>(arg.substr(4, arg.size() - 4)));
+                }
                 else if (arg.find("-r=") == 0)
                 {
                     ROOT_PATH = arg.substr(3, arg.size() - 3);
@@ -753,7 +813,7 @@ namespace Test
 
         bool Required(const Group & group) const
         {
-            if (mode == Auto && group.autoTest == NULL)
+            if ((mode == Auto || mode == Bench) && group.autoTest == NULL)
                 return false;
             if (mode == Special && group.specialTest == NULL)
                 return false;
@@ -861,6 +921,63 @@ namespace Test
         return 0;
     }
 
+    int MakeBenchmark(Groups & groups, const Options & options)
+    {
+#ifdef TEST_PERFORMANCE_TEST_ENABLE
+        std::vector<Size> sizes = options.benchSizes;
+        if (sizes.empty())
+            sizes.push_back(Size(W, H));
+        std::vector<size_t> threads = options.benchThreads;
+        if (threads.empty())
+            threads.push_back(options.workThreads);
+
+        if (WARM_UP_TIME > 0)
+            WarmUpCpu();
+        Test::Benchmark benchmark;
+        for (size_t s = 0; s < sizes.size(); ++s)
+        {
+            for (size_t t = 0; t < threads.size(); ++t)
+            {
+                W = (int)sizes[s].x;
+                H = (int)sizes[s].y;
+                ::SimdSetThreadNumber(threads[t]);
+                TEST_LOG_SS(Info, "Benchmark for image " << W << "x" << H << " and " << threads[t] << " threads is started :" << std::endl);
+                Test::PerformanceMeasurerStorage::s_storage.Clear();
+                for (size_t i = 0; i < groups.size(); ++i)
+                {
+                    if (!groups[i].autoTest())
+                    {
+                        TEST_LOG_SS(Error, groups[i].name << "AutoTest has errors. BENCHMARK IS TERMINATED!" << std::endl);
+                        return 1;
+                    }
+                }
+                benchmark.Add(W, H, threads[t], Test::PerformanceMeasurerStorage::s_storage);
+                TEST_LOG_SS(Info, Test::PerformanceMeasurerStorage::s_storage.ConsoleReport(false, false));
+            }
+        }
+        ::SimdSetThreadNumber(options.workThreads);
+
+        if (!options.json.empty() && !benchmark.Save(options.json))
+            return 1;
+        if (!options.baseline.empty())
+        {
+            Test::Benchmark baseline;
+            if (!baseline.Load(options.baseline))
+                return 1;
+            if (!benchmark.Compare(baseline, options.regression))
+            {
+                TEST_LOG_SS(Error, "BENCHMARK HAS PERFORMANCE REGRESSIONS!" << std::endl);
+                return 1;
+            }
+        }
+        TEST_LOG_SS(Info, "BENCHMARK IS FINISHED SUCCESSFULLY!" << std::endl);
+        return 0;
+#else
+        TEST_LOG_SS(Error, "Benchmark requires performance testing (Release build of Test framework)!" << std::endl);
+        return 1;
+#endif
+    }
+
     int PrintHelp()
     {
         std::cout << "Test framework of Simd Library." << std::endl << std::endl;
@@ -874,7 +991,10 @@ namespace Test
         std::cout << "               (for example a scalar implementation and implementations" << std::endl;
         std::cout << "               with using of different SIMD instructions such as SSE4.1, " << std::endl;
         std::cout << "               AVX2, and other). Also it can be: " << std::endl;
-        std::cout << "               -m=s - running of special tests." << std::endl << std::endl;
+        std::cout << "               -m=s - running of special tests." << std::endl;
+        std::cout << "               -m=b - benchmark: auto tests are run for every image size" << std::endl;
+        std::cout << "               and thread number, results can be saved in JSON and compared" << std::endl;
+        std::cout << "               with baseline (see -bs, -bt, -oj, -bb, -br)." << std::endl << std::endl;
         std::cout << "-tt=1        - a number of test threads." << std::endl;
         std::cout << "-fi=Sobel    - an include filter. In current case will be tested only" << std::endl;
         std::cout << "               functions which contain word 'Sobel' in their names." << std::endl;
@@ -906,6 +1026,11 @@ namespace Test
         std::cout << "    -de=2         a flags of SIMD extensions which testing are disabled." << std::endl;
         std::cout << "                  Base - 1, 2 - SSE4.1/NEON, 4 - AVX2, 8 - AVX-512BW, 16 - AVX-512VNNI, 32 - AMX-BF16." << std::endl << std::endl;
         std::cout << "    -wu=100       a time to warm up CPU before testing (in milliseconds)." << std::endl << std::endl;
+        std::cout << "    -bs=640x480   an image size used in benchmark (can be used several times)." << std::endl << std::endl;
+        std::cout << "    -bt=4         a thread number used in benchmark (can be used several times)." << std::endl << std::endl;
+        std::cout << "    -oj=bench.json a file name with benchmark results (in JSON format)." << std::endl << std::endl;
+        std::cout << "    -bb=base.json a file name with benchmark baseline (in JSON format)." << std::endl << std::endl;
+        std::cout << "    -br=5         a maximal allowed regression of minimal time relative to baseline (in percents)." << std::endl << std::endl;
         return 0;
     }
 
@@ -981,6 +1106,8 @@ int main(int argc, char* argv[])
         return Test::MakeAutoTests(groups, options);
     case Test::Options::Special:
         return Test::MakeSpecialTests(groups, options);
+    case Test::Options::Bench:
+        return Test::MakeBenchmark(groups, options);
     default:
         return 0;
     }
@@ -0,0 +1,401 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Test/TestBenchmark.h"
+#include "Test/TestFile.h"
+#include "Test/TestLog.h"
+#include "Test/TestString.h"
+
+namespace Test
+{
+    static String JsonEscape(const String & src)
+    {
+        String dst;
+        for (size_t i = 0; i < src.size(); ++i)
+        {
+            unsigned char c = (unsigned char)src[i];
+            if (c == '"' || c == '\\')
+            {
+                dst.push_back('\\');
+                dst.push_back(c);
+            }
+            else if (c < 0x20)
+            {
+                char buf[8];
+                ::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                dst += buf;
+            }
+            else
+                dst.push_back(c);
+        }
+        return dst;
+    }
+
+    struct Json
+    {
+        enum Type { Null, Boolean, Number, Text, Array, Object } type;
+        double number;
+        String text;
+        std::vector<String> keys;
+        std::vector<std::shared_ptr<Json>> items;
+
+        Json() : type(Null), number(0) {}
+
+        const Json * Find(const String & key) const
+        {
+            for (size_t i = 0; i < keys.size(); ++i)
+                if (keys[i] == key)
+                    return items[i].get();
+            return NULL;
+        }
+
+        bool Get(const String & key, String & value) const
+        {
+            const Json * json = Find(key);
+            if (json == NULL || json->type != Text)
+                return false;
+            value = json->text;
+            return true;
+        }
+
+        bool Get(const String & key, double & value) const
+        {
+            const Json * json = Find(key);
+            if (json == NULL || json->type != Number)
+                return false;
+            value = json->number;
+            return true;
+        }
+    };
+
+    class JsonParser
+    {
+    public:
+        JsonParser(const String & src)
+            : _src(src)
+            , _pos(0)
+        {
+        }
+
+        bool Parse(Json & json)
+        {
+            if (!ParseValue(json))
+                return false;
+            SkipSpace();
+            return _pos == _src.size();
+        }
+
+        size_t Position() const { return _pos; }
+
+    private:
+        const String & _src;
+        size_t _pos;
+
+        void SkipSpace()
+        {
+            while (_pos < _src.size() && (_src[_pos] == ' ' || _src[_pos] == '\t' || _src[_pos] == '\r' || _src[_pos] == '\n'))
+                _pos++;
+        }
+
+        bool Skip(char c)
+        {
+            SkipSpace();
+            if (_pos < _src.size() && _src[_pos] == c)
+            {
+                _pos++;
+                return true;
+            }
+            return false;
+        }
+
+        bool ParseLiteral(const String & literal)
+        {
+            if (_src.compare(_pos, literal.size(), literal) != 0)
+                return false;
+            _pos += literal.size();
+            return true;
+        }
+
+        bool ParseValue(Json & json)
+        {
+            SkipSpace();
+            if (_pos >= _src.size())
+                return false;
+            switch (_src[_pos])
+            {
+            case '{': return ParseObject(json);
+            case '[': return ParseArray(json);
+            case '"': json.type = Json::Text; return ParseString(json.text);
+            case 't': json.type = Json::Boolean; json.number = 1; return ParseLiteral("true");
+            case 'f': json.type = Json::Boolean; json.number = 0; return ParseLiteral("false");
+            case 'n': json.type = Json::Null; return ParseLiteral("null");
+            default: return ParseNumber(json);
+            }
+        }
+
+        bool ParseNumber(Json & json)
+        {
+            const char * beg = _src.c_str() + _pos;
+            char * end = NULL;
+            json.number = ::strtod(beg, &end);
+            if (end == beg)
+                return false;
+            json.type = Json::Number;
+            _pos += end - beg;
+            return true;
+        }
+
+        bool ParseString(String & text)
+        {
+            if (!Skip('"'))
+                return false;
+            text.clear();
+            while (_pos < _src.size())
+            {
+                char c = _src[_pos++];
+                if (c == '"')
+                    return true;
+                if (c != '\\')
+                {
+                    text.push_back(c);
+                    continue;
+                }
+                if (_pos >= _src.size())
+                    return false;
+                c = _src[_pos++];
+                switch (c)
+                {
+                case '"': case '\\': case '/': text.push_back(c); break;
+                case 'b': text.push_back('\b'); break;
+                case 'f': text.push_back('\f'); break;
+                case 'n': text.push_back('\n'); break;
+                case 'r': text.push_back('\r'); break;
+                case 't': text.push_back('\t'); break;
+                case 'u':
+                {
+                    if (_pos + 4 > _src.size())
+                        return false;
+                    char * end = NULL;
+                    String hex = _src.substr(_pos, 4);
+                    unsigned long code = ::strtoul(hex.c_str(), &end, 16);
+                    if (end != hex.c_str() + 4)
+                        return false;
+                    _pos += 4;
+                    if (code < 0x80)
+                        text.push_back(char(code));
+                    else if (code < 0x800)
+                    {
+                        text.push_back(char(0xC0 | (code >> 6)));
+                        text.push_back(char(0x80 | (code & 0x3F)));
+                    }
+                    else
+                    {
+                        text.push_back(char(0xE0 | (code >> 12)));
+                        text.push_back(char(0x80 | ((code >> 6) & 0x3F)));
+                        text.push_back(char(0x80 | (code & 0x3F)));
+                    }
+                    break;
+                }
+                default:
+                    return false;
+                }
+            }
+            return false;
+        }
+
+        bool ParseArray(Json & json)
+        {
+            Skip('[');
+            json.type = Json::Array;
+            if (Skip(']'))
+                return true;
+            do
+            {
+                json.items.push_back(std::make_shared<Json>());
+                if (!ParseValue(*json.items.back()))
+                    return false;
+            } while (Skip(','));
+            return Skip(']');
+        }
+
+        bool ParseObject(Json & json)
+        {
+            Skip('{');
+            json.type = Json::Object;
+            if (Skip('}'))
+                return true;
+            do
+            {
+                json.keys.push_back(String());
+                json.items.push_back(std::make_shared<Json>());
+                if (!ParseString(json.keys.back()) || !Skip(':') || !ParseValue(*json.items.back()))
+                    return false;
+            } while (Skip(','));
+            return Skip('}');
+        }
+    };
+
+    //-------------------------------------------------------------------------
+
+    void Benchmark::Add(size_t width, size_t height, size_t threads, const PerformanceMeasurerStorage & storage)
+    {
+        PerformanceMeasurerStorage::Measurers measurers = storage.Combined();
+        for (size_t i = 0; i < measurers.size(); ++i)
+        {
+            const PerformanceMeasurer & pm = measurers[i];
+            if (pm.Count() == 0)
+                continue;
+            Result result;
+            result.config = ToString(width) + "x" + ToString(height) + "-t" + ToString(threads);
+            result.function = pm.Description();
+            result.width = width;
+            result.height = height;
+            result.threads = threads;
+            result.count = pm.Count();
+            result.average = pm.Average();
+            result.min = pm.Min();
+            result.size = pm.Size() > pm.Count() ? double(pm.Size()) / pm.Count() : 0.0;
+            result.flop = pm.Flop() / pm.Count();
+            result.elements = pm.Elements() / pm.Count();
+            _results.push_back(result);
+        }
+    }
+
+    bool Benchmark::Save(const String & path) const
+    {
+        CreatePathIfNotExist(path, true);
+        std::ofstream file(path);
+        if (!file.is_open())
+        {
+            TEST_LOG_SS(Error, "Can't open benchmark file '" << path << "' !");
+            return false;
+        }
+        file << "{" << std::endl;
+        file << "  \"version\": \"" << JsonEscape(SimdVersion()) << "\"," << std::endl;
+        file << "  \"cpu\": \"" << JsonEscape(SimdCpuDesc(SimdCpuDescModel)) << "\"," << std::endl;
+        file << "  \"date\": \"" << GetCurrentDateTimeString() << "\"," << std::endl;
+        file << "  \"results\": [" << std::endl;
+        file << std::setprecision(6) << std::scientific;
+        for (size_t i = 0; i < _results.size(); ++i)
+        {
+            const Result & r = _results[i];
+            file << "    {\"config\": \"" << r.config << "\", \"function\": \"" << JsonEscape(r.function) << "\"";
+            file << ", \"width\": " << r.width << ", \"height\": " << r.height << ", \"threads\": " << r.threads << ", \"count\": " << r.count;
+            file << ", \"average_ms\": " << r.average * 1000.0 << ", \"min_ms\": " << r.min * 1000.0;
+            file << ", \"calls_per_second\": " << 1.0 / r.average;
+            if (r.flop > 0)
+                file << ", \"flop\": " << r.flop << ", \"gflops\": " << r.flop / r.average * 0.000000001;
+            if (r.elements > 0)
+                file << ", \"elements\": " << r.elements << ", \"elements_per_second\": " << r.elements / r.average;
+            if (r.size > 0)
+                file << ", \"bytes_per_second\": " << r.size / r.average;
+            file << "}" << (i + 1 < _results.size() ? "," : "") << std::endl;
+        }
+        file << "  ]" << std::endl;
+        file << "}" << std::endl;
+        return true;
+    }
+
+    bool Benchmark::Load(const String & path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            TEST_LOG_SS(Error, "Can't open benchmark baseline '" << path << "' !");
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        String text = buffer.str();
+        Json json;
+        JsonParser parser(text);
+        if (!parser.Parse(json))
+        {
+            TEST_LOG_SS(Error, "Can't parse benchmark baseline '" << path << "': JSON error at position " << parser.Position() << " !");
+            return false;
+        }
+        const Json * results = json.type == Json::Object ? json.Find("results") : NULL;
+        if (results == NULL || results->type != Json::Array)
+        {
+            TEST_LOG_SS(Error, "Benchmark baseline '" << path << "' has no 'results' array !");
+            return false;
+        }
+        _results.clear();
+        for (size_t i = 0; i < results->items.size(); ++i)
+        {
+            const Json & item = *results->items[i];
+            Result result;
+            double width, height, threads, count, average, min;
+            if (item.type != Json::Object || !item.Get("config", result.config) || !item.Get("function", result.function) ||
+                !item.Get("width", width) || !item.Get("height", height) || !item.Get("threads", threads) ||
+                !item.Get("count", count) || !item.Get("average_ms", average) || !item.Get("min_ms", min))
+            {
+                TEST_LOG_SS(Error, "Benchmark baseline '" << path << "' has wrong result " << i << " !");
+                return false;
+            }
+            result.width = size_t(width);
+            result.height = size_t(height);
+            result.threads = size_t(threads);
+            result.count = int(count);
+            result.average = average * 0.001;
+            result.min = min * 0.001;
+            result.size = 0;
+            if (!item.Get("flop", result.flop))
+                result.flop = 0;
+            if (!item.Get("elements", result.elements))
+                result.elements = 0;
+            _results.push_back(result);
+        }
+        if (_results.empty())
+        {
+            TEST_LOG_SS(Error, "Benchmark baseline '" << path << "' is empty !");
+            return false;
+        }
+        return true;
+    }
+
+    bool Benchmark::Compare(const Benchmark & baseline, double regression) const
+    {
+        std::map<String, const Result*> base;
+        for (size_t i = 0; i < baseline._results.size(); ++i)
+            base[baseline._results[i].config + " " + baseline._results[i].function] = &baseline._results[i];
+        size_t compared = 0, regressed = 0;
+        for (size_t i = 0; i < _results.size(); ++i)
+        {
+            const Result & curr = _results[i];
+            std::map<String, const Result*>::const_iterator it = base.find(curr.config + " " + curr.function);
+            if (it == base.end() || it->second->min <= 0 || curr.min <= 0)
+                continue;
+            double change = (curr.min / it->second->min - 1.0) * 100.0;
+            compared++;
+            if (change > regression)
+            {
+                TEST_LOG_SS(Error, "Regression of " << curr.function << " [" << curr.config << "]: min " << ToString(it->second->min * 1000.0, 3, false)
+                    << " ms -> " << ToString(curr.min * 1000.0, 3, false) << " ms (+" << ToString(change, 1, false) << "%) !");
+                regressed++;
+            }
+        }
+        TEST_LOG_SS(Info, "Compared with baseline " << compared << " functions by minimal time: " << regressed << " regressions (threshold is " << ToString(regression, 1, false) << "%).");
+        return regressed == 0;
+    }
+}
@@ -0,0 +1,59 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#ifndef __TestBenchmark_h__
+#define __TestBenchmark_h__
+
+#include "Test/TestPerformance.h"
+
+namespace Test
+{
+    class Benchmark
+    {
+    public:
+        struct Result
+        {
+            String config, function;
+            size_t width, height, threads;
+            int count;
+            double average, min, size, flop, elements;
+        };
+        typedef std::vector<Result> Results;
+
+        void Add(size_t width, size_t height, size_t threads, const PerformanceMeasurerStorage & storage);
+
+        bool Save(const String & path) const;
+
+        bool Load(const String & path);
+
+        bool Compare(const Benchmark & baseline, double regression) const;
+
+        const Results & Get() const { return _results; }
+
+    private:
+        Results _results;
+    };
+}
+
+#endif//__TestBenchmark_h__
@@ -25,6 +25,8 @@
 #include "Test/TestPerformance.h"
 #include "Test/TestRandom.h"
 
+#include "Simd/SimdImageSavePng.h"
+
 namespace Test
 {
     namespace
@@ -80,6 +82,9 @@ namespace Test
     {
         bool result = true;
 
+        const size_t sizes[] = { 1, 15, 16, 63, 64, 65, 127, 128, 129, 191, 192, 255, 256, 257, 383, 511, 512, 513 };
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+            result = result && Crc32AutoTest(sizes[i], f1, f2);
         result = result && Crc32AutoTest(W*H, f1, f2);
         result = result && Crc32AutoTest(W*H + O, f1, f2);
 
@@ -93,6 +98,21 @@ namespace Test
         if (TestBase())
             result = result && Crc32AutoTest(FUNC(Simd::Base::Crc32), FUNC(SimdCrc32));
 
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable && TestSse41())
+            result = result && Crc32AutoTest(FUNC(Simd::Sse41::Crc32), FUNC(SimdCrc32));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable && TestAvx2())
+            result = result && Crc32AutoTest(FUNC(Simd::Avx2::Crc32), FUNC(SimdCrc32));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable && TestAvx512bw())
+            result = result && Crc32AutoTest(FUNC(Simd::Avx512bw::Crc32), FUNC(SimdCrc32));
+#endif 
+
         return result;
     }
 
@@ -110,4 +130,108 @@ namespace Test
 
         return result;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncA
+        {
+            typedef uint32_t(*FuncPtr)(const uint8_t* data, int size);
+
+            FuncPtr func;
+            String description;
+
+            FuncA(const FuncPtr& f, const String& d) : func(f), description(d) {}
+
+            uint32_t Call(const std::vector<uint8_t>& src, size_t offset, size_t size) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                return func(src.data() + offset, (int)size);
+            }
+        };
+    }
+
+#define FUNC_A(func) FuncA(func, #func)
+
+    bool ZlibAdler32AutoTest(size_t size, bool saturated, const FuncA& f1, const FuncA& f2)
+    {
+        bool result = true;
+
+        std::vector<uint8_t> src(size, 0xFF);
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " for size = " << size << (saturated ? " of 0xFF." : "."));
+
+        if (!saturated)
+            SetRandom(src.data(), src.size());
+
+        uint32_t adler1, adler2;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(adler1 = f1.Call(src, 0, size));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(adler2 = f2.Call(src, 0, size));
+
+        TEST_CHECK_VALUE(adler);
+
+        const size_t splits[] = { 0, 1, size / 3, size / 2 + 7, size - 1, size };
+        for (size_t i = 0; i < sizeof(splits) / sizeof(splits[0]); ++i)
+        {
+            size_t split = Simd::Min(splits[i], size);
+            uint32_t head = f2.Call(src, 0, split), tail = f2.Call(src, split, size - split);
+            adler2 = Simd::Base::ZlibAdler32Combine(head, tail, size - split);
+            if (adler1 != adler2)
+            {
+                TEST_LOG_SS(Error, "Error ZlibAdler32Combine for split " << split << ": (" << adler1 << " != " << adler2 << ")! ");
+                return false;
+            }
+        }
+
+        return result;
+    }
+
+    bool ZlibAdler32AutoTest(const FuncA& f1, const FuncA& f2)
+    {
+        bool result = true;
+
+        const size_t sizes[] = { 1, 15, 16, 31, 32, 33, 63, 64, 65, 5551, 5552, 5553, 5552 * 3 + 17 };
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+        {
+            result = result && ZlibAdler32AutoTest(sizes[i], false, f1, f2);
+            result = result && ZlibAdler32AutoTest(sizes[i], true, f1, f2);
+        }
+        result = result && ZlibAdler32AutoTest(W * H, false, f1, f2);
+        result = result && ZlibAdler32AutoTest(W * H + O, true, f1, f2);
+
+        return result;
+    }
+
+    bool ZlibAdler32AutoTest()
+    {
+        bool result = true;
+
+        if (TestBase())
+            result = result && ZlibAdler32AutoTest(FUNC_A(Simd::Base::ZlibAdler32), FUNC_A(Simd::Base::ZlibAdler32));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable && TestSse41())
+            result = result && ZlibAdler32AutoTest(FUNC_A(Simd::Base::ZlibAdler32), FUNC_A(Simd::Sse41::ZlibAdler32));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable && TestAvx2())
+            result = result && ZlibAdler32AutoTest(FUNC_A(Simd::Base::ZlibAdler32), FUNC_A(Simd::Avx2::ZlibAdler32));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable && TestAvx512bw())
+            result = result && ZlibAdler32AutoTest(FUNC_A(Simd::Base::ZlibAdler32), FUNC_A(Simd::Avx512bw::ZlibAdler32));
+#endif 
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable && TestNeon())
+            result = result && ZlibAdler32AutoTest(FUNC_A(Simd::Base::ZlibAdler32), FUNC_A(Simd::Neon::ZlibAdler32));
+#endif 
+
+        return result;
+    }
 }
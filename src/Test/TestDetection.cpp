@@ -539,5 +539,38 @@ namespace Test
 
         return result;
     }
+
+    bool DetectionThreadsAutoTest()
+    {
+        bool result = true;
+
+        size_t expected = std::min<size_t>(std::thread::hardware_concurrency(), 2);
+
+        TEST_LOG_SS(Info, "Test Simd::Detection with auto thread number.");
+
+        Detection detection;
+        if (!detection.Load(ROOT_PATH + "/data/cascade/haar_face_0.xml"))
+        {
+            TEST_LOG_SS(Error, "Can't load haar cascade!");
+            return false;
+        }
+
+        View src = GetSample(Size(W, H), true);
+        Objects objects;
+
+        Simd::ThreadPool pool;
+        Simd::ThreadPool::Bind(&pool);
+        detection.Init(src.Size(), 1.1, Size(), Size(INT_MAX, INT_MAX), View(), -1);
+        detection.Detect(src, objects);
+        Simd::ThreadPool::Bind(NULL);
+
+        if (pool.Size() + 1 < expected)
+        {
+            TEST_LOG_SS(Error, "Simd::Detection with auto thread number has used " << pool.Size() + 1 << " threads instead of at least " << expected << " !");
+            result = false;
+        }
+
+        return result;
+    }
 }
 
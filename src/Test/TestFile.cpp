@@ -22,6 +22,7 @@
 * SOFTWARE.
 */
 #include "Test/TestFile.h"
+#include "Test/TestString.h"
 
 #if defined(_WIN32)
 #ifndef NOMINMAX
@@ -137,4 +138,22 @@ namespace Test
         }
         return result;
     }
+
+    String TempPath(const String& name)
+    {
+        String dir;
+#if defined(_WIN32)
+        char buf[MAX_PATH + 1];
+        DWORD size = ::GetTempPathA(MAX_PATH + 1, buf);
+        if (size > 0 && size <= MAX_PATH)
+            dir = String(buf, size);
+        return MakePath(dir, ToString(::GetCurrentProcessId()) + "_" + name);
+#elif defined(__linux__)
+        const char* tmp = ::getenv("TMPDIR");
+        dir = tmp && tmp[0] ? tmp : "/tmp";
+        return MakePath(dir, ToString(::getpid()) + "_" + name);
+#else
+        return name;
+#endif
+    }
 }
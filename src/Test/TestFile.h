@@ -71,6 +71,8 @@ namespace Test
     bool FileLoad(const char* path, uint8_t** data, size_t* size);
 
     bool FileSave(const uint8_t* data, size_t size, const char* path);
+
+    String TempPath(const String& name);
 }
 
 #endif//__TestFile_h__
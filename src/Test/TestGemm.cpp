@@ -44,6 +44,7 @@ namespace Test
                 if(beta != 0.0f)
                     memcpy(dstC.Data(), srcC.Data(), sizeof(float)*srcC.Size());
                 TEST_PERFORMANCE_TEST(description);
+                TEST_PERFORMANCE_TEST_SET_FLOP(2.0 * M * N * K);
                 func(M, N, K, &alpha, A.Data(), A.Axis(1), B.Data(), B.Axis(1), &beta, dstC.Data(), dstC.Axis(1));
             }
 
@@ -0,0 +1,169 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include "Test/TestCompare.h"
+#include "Test/TestPerformance.h"
+#include "Test/TestString.h"
+#include "Test/TestTensor.h"
+#include "Test/TestSynetConvolutionParam.h"
+#include "Test/TestRandom.h"
+
+namespace Test
+{
+    namespace
+    {
+        String ModeDesc(SimdHugePageModeType mode)
+        {
+            switch (mode)
+            {
+            case SimdHugePageOff: return "regular";
+            case SimdHugePageTransparent: return "transparent";
+            case SimdHugePageExplicit: return "explicit";
+            default: return "unknown";
+            }
+        }
+
+        size_t HugePageTotal()
+        {
+            return ::SimdHugePageInfo(SimdHugePageInfoExplicit) + ::SimdHugePageInfo(SimdHugePageInfoTransparent) + 
+                ::SimdHugePageInfo(SimdHugePageInfoRegular);
+        }
+
+        struct Matrix
+        {
+            size_t size;
+            float* data;
+
+            Matrix(size_t s)
+                : size(s)
+                , data((float*)::SimdAllocate(s * sizeof(float), ::SimdAlignment()))
+            {
+            }
+
+            ~Matrix()
+            {
+                ::SimdFree(data);
+            }
+        };
+
+        bool Gemm32fNN(SimdHugePageModeType mode, size_t N, Tensor32f & dst)
+        {
+            bool result = true;
+
+            ::SimdSetHugePageMode(mode, 0);
+            size_t before = HugePageTotal();
+            {
+                Matrix a(N * N), b(N * N), c(N * N);
+                if (mode != SimdHugePageOff && HugePageTotal() < before + 3 * N * N * sizeof(float))
+                {
+                    TEST_LOG_SS(Error, "Huge page statistics does not include allocated matrices!");
+                    result = false;
+                }
+                for (size_t i = 0; i < N; ++i)
+                    for (size_t j = 0; j < N; ++j)
+                        a.data[i * N + j] = float((i + 3 * j) % 17) * 0.125f, b.data[i * N + j] = float((3 * i + j) % 13) * 0.25f;
+                const float alpha = 1.0f, beta = 0.0f;
+                for (int i = 0; i < 4; ++i)
+                {
+                    TEST_PERFORMANCE_TEST(String("SimdGemm32fNN[") + ToString(N) + "-" + ToString(N) + "-" + ToString(N) + "-" + ModeDesc(mode) + "]");
+                    TEST_PERFORMANCE_TEST_SET_FLOP(2.0 * N * N * N);
+                    ::SimdGemm32fNN(N, N, N, &alpha, a.data, N, b.data, N, &beta, c.data, N);
+                }
+                memcpy(dst.Data(), c.data, N * N * sizeof(float));
+            }
+            if (HugePageTotal() != before)
+            {
+                TEST_LOG_SS(Error, "Huge page statistics is not restored after release of matrices!");
+                result = false;
+            }
+            ::SimdSetHugePageMode(SimdHugePageOff, 0);
+
+            return result;
+        }
+
+#if defined(SIMD_SYNET_ENABLE)
+        typedef Test::SynetConvolutionParam<false> Param;
+
+        bool Convolution32f(SimdHugePageModeType mode, const Param & p, const Tensor32f & src, const Tensor32f & weight, const Tensor32f & bias, Tensor32f & dst)
+        {
+            ::SimdSetHugePageMode(mode, 0);
+            void * context = ::SimdSynetConvolution32fInit(p.batch, &p.conv);
+            ::SimdSynetConvolution32fSetParams(context, weight.Data(), NULL, bias.Data(), NULL);
+            for (int i = 0; i < 4; ++i)
+            {
+                TEST_PERFORMANCE_TEST(String("SimdSynetConvolution32fForward") + p.Decription(String("-") + ModeDesc(mode)));
+                ::SimdSynetConvolution32fForward(context, src.Data(), NULL, dst.Data());
+            }
+            ::SimdRelease(context);
+            ::SimdSetHugePageMode(SimdHugePageOff, 0);
+            return true;
+        }
+#endif
+    }
+
+    bool HugePageAutoTest()
+    {
+        bool result = true;
+
+        const SimdHugePageModeType modes[3] = { SimdHugePageOff, SimdHugePageTransparent, SimdHugePageExplicit };
+
+        const size_t N = 1024;
+        TEST_ALIGN(SIMD_ALIGN);
+        TEST_LOG_SS(Info, "Test SimdGemm32fNN [" << N << "x" << N << "] with huge page modes.");
+        Tensor32f gemm[3];
+        for (size_t m = 0; m < 3 && result; ++m)
+        {
+            gemm[m].Reshape({ N, N });
+            result = result && Gemm32fNN(modes[m], N, gemm[m]);
+            if (m)
+                result = result && Compare(gemm[0], gemm[m], 0.0f, true, 64, DifferenceAbsolute, ModeDesc(modes[m]));
+        }
+
+#if defined(SIMD_SYNET_ENABLE)
+        Param p(SimdTrue, 1, 64, 128, 128, 128, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, SimdConvolutionActivationIdentity);
+        const SimdConvolutionParameters & c = p.conv;
+        TEST_LOG_SS(Info, "Test SimdSynetConvolution32fForward [" << p.Decription() << "] with huge page modes.");
+        Tensor32f src({ p.batch, c.srcH, c.srcW, c.srcC });
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+        Tensor32f weight({ c.kernelY, c.kernelX, c.srcC / c.group, c.dstC });
+        FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+        Tensor32f bias({ c.dstC });
+        FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+        Tensor32f conv[3];
+        for (size_t m = 0; m < 3 && result; ++m)
+        {
+            conv[m].Reshape({ p.batch, c.dstH, c.dstW, c.dstC });
+            result = result && Convolution32f(modes[m], p, src, weight, bias, conv[m]);
+            if (m)
+                result = result && Compare(conv[0], conv[m], 0.0f, true, 64, DifferenceAbsolute, ModeDesc(modes[m]));
+        }
+#endif
+
+        TEST_LOG_SS(Info, "Huge page backing: explicit " << ::SimdHugePageInfo(SimdHugePageInfoExplicit) << ", transparent " << 
+            ::SimdHugePageInfo(SimdHugePageInfoTransparent) << ", regular " << ::SimdHugePageInfo(SimdHugePageInfoRegular) << 
+            " bytes, fallbacks " << ::SimdHugePageInfo(SimdHugePageInfoFallbacks) << ".");
+
+        return result;
+    }
+}
@@ -28,6 +28,7 @@
 #include "Test/TestRandom.h"
 
 #include "Simd/SimdImageLoad.h"
+#include "Simd/SimdImageLoadJpeg.h"
 #include "Simd/SimdImageSave.h"
 
 #include "Simd/SimdDrawing.hpp"
@@ -129,7 +130,7 @@ namespace Test
             void Update(View::Format format, SimdImageFileType file, int quality)
             {
                 desc = desc + "[" + ToString(format) + "-" + ToString(file) + 
-                    (file == SimdImageFileJpeg ? String("-") + ToString(quality) : String("")) + "]";
+                    (file == SimdImageFileJpeg || (file == SimdImageFilePng && quality != 100) ? String("-") + ToString(quality) : String("")) + "]";
             }
 
             void Call(const View& src, SimdImageFileType file, int quality, uint8_t** data, size_t* size) const
@@ -902,4 +903,915 @@ namespace Test
 
         return result;
     }
+
+    //-----------------------------------------------------------------------
+
+    bool ImageProbeFromMemoryAutoTest(size_t width, size_t height, View::Format format, SimdImageFileType file, int quality)
+    {
+        bool result = true;
+
+        String desc = String("[") + ToString(format) + "-" + ToString(file) + 
+            (file == SimdImageFileJpeg ? String("-") + ToString(quality) : String("")) + "]";
+        String probeDesc = "SimdImageProbeFromMemory" + desc, loadDesc = "SimdImageLoadFromMemory" + desc;
+
+        View src;
+        size_t size = 0;
+        uint8_t* data = NULL;
+        if (!GetTestImage(src, width, height, format, probeDesc, loadDesc, file, quality, &data, &size))
+            return false;
+
+        SimdImageInfo info, head;
+        memset(&info, 0, sizeof(info));
+        memset(&head, 0, sizeof(head));
+        SimdBool probed = SimdFalse;
+        TEST_EXECUTE_AT_LEAST_MIN_TIME({ TEST_PERFORMANCE_TEST(probeDesc); probed = ::SimdImageProbeFromMemory(data, size, &info); });
+
+        View dst;
+        TEST_EXECUTE_AT_LEAST_MIN_TIME({ TEST_PERFORMANCE_TEST(loadDesc); if (dst.data) SimdFree(dst.data); 
+            *(SimdPixelFormatType*)&dst.format = SimdPixelFormatNone; *(uint8_t**)&dst.data = ::SimdImageLoadFromMemory(data, size, 
+            (size_t*)&dst.stride, (size_t*)&dst.width, (size_t*)&dst.height, (SimdPixelFormatType*)&dst.format); });
+
+        size_t channels = 3, subsampling = 1;
+        if (file == SimdImageFilePgmTxt || file == SimdImageFilePgmBin)
+            channels = 1;
+        else if (file == SimdImageFilePng && format == View::Gray8)
+            channels = 1;
+        else if (file == SimdImageFilePng && (format == View::Bgra32 || format == View::Rgba32))
+            channels = 4;
+        if (file == SimdImageFileJpeg && channels == 3 && quality <= 90)
+            subsampling = 2;
+
+        if (!probed || dst.data == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't probe or load image " << desc << " !");
+            result = false;
+        }
+        else if (info.file != file || info.width != dst.width || info.height != dst.height || info.format != (SimdPixelFormatType)dst.format ||
+            info.channels != channels || info.depth != 8 || info.progressive != SimdFalse || info.subsamplingX != subsampling || info.subsamplingY != subsampling)
+        {
+            TEST_LOG_SS(Error, "Wrong properties of image " << desc << ": file " << ToString(info.file) << ", size " << info.width << "x" << info.height << 
+                ", format " << ToString((View::Format)info.format) << ", channels " << info.channels << ", depth " << info.depth << 
+                ", subsampling " << info.subsamplingX << "x" << info.subsamplingY << " !");
+            result = false;
+        }
+
+        if (result && (!::SimdImageProbeFromMemory(data, Simd::Min<size_t>(size, 1024), &head) || memcmp(&info, &head, sizeof(info)) != 0))
+        {
+            TEST_LOG_SS(Error, "Can't probe image " << desc << " by its headers only!");
+            result = false;
+        }
+
+        if (dst.data)
+            SimdFree(dst.data);
+        SimdFree(data);
+
+        return result;
+    }
+
+    bool ImageProbeFromMemoryAutoTest()
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            for (int file = (int)SimdImageFilePgmTxt; file <= (int)SimdImageFileJpeg; file++)
+            {
+                if (file == SimdImageFileJpeg)
+                    result = result && ImageProbeFromMemoryAutoTest(W, H, formats[format], (SimdImageFileType)file, 95);
+                result = result && ImageProbeFromMemoryAutoTest(W + O, H - O, formats[format], (SimdImageFileType)file, 65);
+            }
+        }
+
+        return result;
+    }
+
+    //-----------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncJD
+        {
+            typedef void* (*FuncPtr)();
+
+            FuncPtr func;
+            String desc;
+
+            FuncJD(const FuncPtr& f, const String& d) : func(f), desc(d) {}
+
+            void Update(View::Format format, int quality, size_t scale)
+            {
+                desc = desc + "[" + ToString(format) + "-" + ToString(quality) + "-1/" + ToString(scale) + "]";
+            }
+
+            bool Call(void* decoder, const uint8_t* data, size_t size, View& dst) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                size_t width, height;
+                return ::SimdJpegDecoderParse(decoder, data, size, &width, &height) && width == dst.width && height == dst.height &&
+                    ::SimdJpegDecoderDecode(decoder, dst.data, dst.stride, (SimdPixelFormatType)dst.format);
+            }
+
+            bool CallYuv420p(void* decoder, const uint8_t* data, size_t size, View& y, View& u, View& v) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                size_t width, height;
+                return ::SimdJpegDecoderParse(decoder, data, size, &width, &height) && width == y.width && height == y.height &&
+                    ::SimdJpegDecoderDecodeYuv420p(decoder, y.data, y.stride, u.data, u.stride, v.data, v.stride);
+            }
+
+            bool CallNv12(void* decoder, const uint8_t* data, size_t size, View& y, View& uv) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                size_t width, height;
+                return ::SimdJpegDecoderParse(decoder, data, size, &width, &height) && width == y.width && height == y.height &&
+                    ::SimdJpegDecoderDecodeNv12(decoder, y.data, y.stride, uv.data, uv.stride);
+            }
+        };
+
+        double Mean(const View& view)
+        {
+            double sum = 0;
+            for (size_t row = 0; row < view.height; ++row)
+                for (size_t col = 0, size = view.width * view.PixelSize(); col < size; ++col)
+                    sum += view.Row<uint8_t>(row)[col];
+            return sum / double(view.height * view.width * view.PixelSize());
+        }
+
+        double MeanDifference(const View& a, const View& b)
+        {
+            double sum = 0;
+            for (size_t row = 0; row < b.height; ++row)
+                for (size_t col = 0, size = b.width * b.PixelSize(); col < size; ++col)
+                    sum += ::abs(int(a.Row<uint8_t>(row)[col]) - int(b.Row<uint8_t>(row)[col]));
+            return sum / double(b.height * b.width * b.PixelSize());
+        }
+    }
+
+#define FUNC_JD(func) \
+    FuncJD(func, std::string(#func))
+
+    bool JpegDecoderAutoTest(size_t width, size_t height, View::Format format, int quality, size_t scale, void* decoder1, void* decoder2, FuncJD f1, FuncJD f2)
+    {
+        bool result = true;
+
+        f1.Update(format, quality, scale);
+        f2.Update(format, quality, scale);
+
+        View src;
+        size_t size = 0;
+        uint8_t* data = NULL;
+        if (!GetTestImage(src, width, height, format, f1.desc, f2.desc, SimdImageFileJpeg, quality, &data, &size))
+            return false;
+
+        size_t dstW = (src.width + scale - 1) / scale, dstH = (src.height + scale - 1) / scale;
+        View dst1(dstW, dstH, format), dst2(dstW, dstH, format);
+        ::SimdJpegDecoderSetScale(decoder1, scale);
+        ::SimdJpegDecoderSetScale(decoder2, scale);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(result = result && f1.Call(decoder1, data, size, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(result = result && f2.Call(decoder2, data, size, dst2));
+
+        if (!result)
+            TEST_LOG_SS(Error, "Can't decode JPEG image!");
+
+        result = result && Compare(dst1, dst2, GetMaxJpegError(quality), true, 64, 0, "dst1 & dst2");
+
+        if (result)
+        {
+            View full, reduced(src.width / scale, src.height / scale, format);
+            if (full.Load(data, size, format))
+            {
+                void* resizer = ::SimdResizerInit(reduced.width * scale, reduced.height * scale, reduced.width, reduced.height, 
+                    reduced.ChannelCount(), SimdResizeChannelByte, SimdResizeMethodArea);
+                ::SimdResizerRun(resizer, full.data, full.stride, reduced.data, reduced.stride);
+                ::SimdRelease(resizer);
+                double difference = MeanDifference(dst1, reduced), differenceMax = quality >= 90 ? 4.0 : 8.0;
+                if (difference > differenceMax)
+                {
+                    TEST_LOG_SS(Error, "Scaled image differs from reduced full image: mean difference " << difference << " > " << differenceMax << " !");
+                    result = false;
+                }
+            }
+        }
+
+        if (!result)
+        {
+            SaveTestImage(dst1, SimdImageFileJpeg, quality, "_1");
+            SaveTestImage(dst2, SimdImageFileJpeg, quality, "_2");
+        }
+
+        SimdFree(data);
+
+        return result;
+    }
+
+    bool JpegDecoderAutoTest(const FuncJD& f1, const FuncJD& f2)
+    {
+        bool result = true;
+
+        void* decoder1 = f1.func();
+        void* decoder2 = f2.func();
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            for (size_t scale = 1; scale <= 8; scale *= 2)
+            {
+                result = result && JpegDecoderAutoTest(W, H, formats[format], 95, scale, decoder1, decoder2, f1, f2);
+                result = result && JpegDecoderAutoTest(W + O, H - O, formats[format], 65, scale, decoder1, decoder2, f1, f2);
+            }
+        }
+        ::SimdRelease(decoder1);
+        ::SimdRelease(decoder2);
+
+        return result;
+    }
+
+    bool JpegDecoderAutoTest()
+    {
+        bool result = true;
+
+        if (TestBase())
+            result = result && JpegDecoderAutoTest(FUNC_JD(Simd::Base::JpegDecoderInit), FUNC_JD(SimdJpegDecoderInit));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable && TestSse41())
+            result = result && JpegDecoderAutoTest(FUNC_JD(Simd::Sse41::JpegDecoderInit), FUNC_JD(SimdJpegDecoderInit));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable && TestAvx2())
+            result = result && JpegDecoderAutoTest(FUNC_JD(Simd::Avx2::JpegDecoderInit), FUNC_JD(SimdJpegDecoderInit));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable && TestAvx512bw())
+            result = result && JpegDecoderAutoTest(FUNC_JD(Simd::Avx512bw::JpegDecoderInit), FUNC_JD(SimdJpegDecoderInit));
+#endif 
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool JpegDecoderYuvAutoTest(size_t width, size_t height, int quality, void* decoder1, void* decoder2, FuncJD f1, FuncJD f2)
+    {
+        bool result = true;
+
+        f1.desc = f1.desc + "[Yuv420p-" + ToString(quality) + "]";
+        f2.desc = f2.desc + "[Nv12-" + ToString(quality) + "]";
+
+        View bgra;
+        if (!GetTestImage(bgra, width, height, View::Bgra32, f1.desc, f2.desc, SimdImageFileJpeg, quality, NULL, NULL))
+            return false;
+
+        size_t uvW = (width + 1) / 2, uvH = (height + 1) / 2;
+        View y0(width, height, View::Gray8), u0(uvW, uvH, View::Gray8), v0(uvW, uvH, View::Gray8);
+        SimdBgraToYuv420pV2(bgra.data, bgra.stride, bgra.width, bgra.height, y0.data, y0.stride, u0.data, u0.stride, v0.data, v0.stride, SimdYuvTrect871);
+
+        size_t size = 0;
+        uint8_t* data = SimdYuv420pSaveAsJpegToMemory(y0.data, y0.stride, u0.data, u0.stride, v0.data, v0.stride, width, height, SimdYuvTrect871, quality, &size);
+        if (data == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't save YUV420P image as JPEG!");
+            return false;
+        }
+
+        View y1(width, height, View::Gray8), u1(uvW, uvH, View::Gray8), v1(uvW, uvH, View::Gray8);
+        View y2(width, height, View::Gray8), uv2(uvW, uvH, View::Uv16), u2(uvW, uvH, View::Gray8), v2(uvW, uvH, View::Gray8);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(result = result && f1.CallYuv420p(decoder1, data, size, y1, u1, v1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(result = result && f2.CallNv12(decoder2, data, size, y2, uv2));
+
+        SimdFree(data);
+
+        if (!result)
+        {
+            TEST_LOG_SS(Error, "Can't decode JPEG image to YUV!");
+            return false;
+        }
+
+        SimdDeinterleaveUv(uv2.data, uv2.stride, uvW, uvH, u2.data, u2.stride, v2.data, v2.stride);
+
+        int differenceMax = GetMaxJpegError(quality);
+        result = result && Compare(y1, y2, differenceMax, true, 64, 0, "y1 & y2");
+        result = result && Compare(u1, u2, differenceMax, true, 64, 0, "u1 & u2");
+        result = result && Compare(v1, v2, differenceMax, true, 64, 0, "v1 & v2");
+
+        const View* planes0[3] = { &y0, &u0, &v0 }, * planes1[3] = { &y1, &u1, &v1 };
+        for (size_t i = 0; i < 3 && result; ++i)
+        {
+            double mean0 = Mean(*planes0[i]), mean1 = Mean(*planes1[i]);
+            if (::fabs(mean1 - mean0) > 2.0)
+            {
+                TEST_LOG_SS(Error, "Mean of decoded plane " << i << " " << mean1 << " differs from mean of source plane " << mean0 << " !");
+                result = false;
+            }
+        }
+
+        return result;
+    }
+
+    bool JpegDecoderYuvAutoTest(const FuncJD& f1, const FuncJD& f2)
+    {
+        bool result = true;
+
+        void* decoder1 = f1.func();
+        void* decoder2 = f2.func();
+        Ints qualities({ 95, 65 });
+        for (size_t q = 0; q < qualities.size(); ++q)
+        {
+            result = result && JpegDecoderYuvAutoTest(W, H, qualities[q], decoder1, decoder2, f1, f2);
+            result = result && JpegDecoderYuvAutoTest(W + E, H - E, qualities[q], decoder1, decoder2, f1, f2);
+        }
+        ::SimdRelease(decoder1);
+        ::SimdRelease(decoder2);
+
+        return result;
+    }
+
+    bool JpegDecoderYuvAutoTest()
+    {
+        bool result = true;
+
+        if (TestBase())
+            result = result && JpegDecoderYuvAutoTest(FUNC_JD(Simd::Base::JpegDecoderInit), FUNC_JD(SimdJpegDecoderInit));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable && TestSse41())
+            result = result && JpegDecoderYuvAutoTest(FUNC_JD(Simd::Sse41::JpegDecoderInit), FUNC_JD(SimdJpegDecoderInit));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable && TestAvx2())
+            result = result && JpegDecoderYuvAutoTest(FUNC_JD(Simd::Avx2::JpegDecoderInit), FUNC_JD(SimdJpegDecoderInit));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable && TestAvx512bw())
+            result = result && JpegDecoderYuvAutoTest(FUNC_JD(Simd::Avx512bw::JpegDecoderInit), FUNC_JD(SimdJpegDecoderInit));
+#endif 
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool JpegDecoderParallelAutoTest(size_t width, size_t height, View::Format format, int quality, void* decoder, FuncJD f1)
+    {
+        bool result = true;
+
+        FuncJD f2 = f1;
+        f1.desc = f1.desc + "[" + ToString(format) + "-" + ToString(quality) + "-1]";
+        f2.desc = f2.desc + "[" + ToString(format) + "-" + ToString(quality) + "-4]";
+
+        View src;
+        size_t size = 0;
+        uint8_t* data = NULL;
+        if (!GetTestImage(src, width, height, format, f1.desc, f2.desc, SimdImageFileJpeg, quality, &data, &size))
+            return false;
+
+        View dst1(src.width, src.height, format), dst2(src.width, src.height, format);
+        ::SimdJpegDecoderSetScale(decoder, 1);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(result = result && f1.Call(decoder, data, size, dst1));
+
+        void* pool = ::SimdThreadPoolInit(4, NULL, 0);
+        ::SimdThreadPoolBind(pool);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(result = result && f2.Call(decoder, data, size, dst2));
+
+        ::SimdThreadPoolBind(NULL);
+        ::SimdRelease(pool);
+
+        if (!result)
+            TEST_LOG_SS(Error, "Can't decode JPEG image!");
+
+        result = result && Compare(dst1, dst2, 0, true, 64, 0, "dst1 & dst2");
+
+        SimdFree(data);
+
+        return result;
+    }
+
+    bool JpegDecoderParallelAutoTest(const FuncJD& f1)
+    {
+        bool result = true;
+
+        void* decoder = f1.func();
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            result = result && JpegDecoderParallelAutoTest(W, H, formats[format], 95, decoder, f1);
+            result = result && JpegDecoderParallelAutoTest(W + O, H - O, formats[format], 65, decoder, f1);
+        }
+        ::SimdRelease(decoder);
+
+        return result;
+    }
+
+    bool JpegDecoderParallelAutoTest()
+    {
+        bool result = true;
+
+        if (TestBase())
+            result = result && JpegDecoderParallelAutoTest(FUNC_JD(Simd::Base::JpegDecoderInit));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable && TestSse41())
+            result = result && JpegDecoderParallelAutoTest(FUNC_JD(Simd::Sse41::JpegDecoderInit));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable && TestAvx2())
+            result = result && JpegDecoderParallelAutoTest(FUNC_JD(Simd::Avx2::JpegDecoderInit));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable && TestAvx512bw())
+            result = result && JpegDecoderParallelAutoTest(FUNC_JD(Simd::Avx512bw::JpegDecoderInit));
+#endif 
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    namespace
+    {
+        struct JpegStrips
+        {
+            size_t width, height, block, interval;
+            std::vector<uint8_t> restarts;
+            std::vector<std::pair<size_t, size_t>> segments;
+        };
+
+        bool ParseJpegStrips(const uint8_t* data, size_t size, JpegStrips& strips)
+        {
+            strips = JpegStrips();
+            if (size < 4 || data[0] != 0xFF || data[1] != 0xD8)
+                return false;
+            size_t i = 2;
+            for (uint8_t marker = 0; marker != 0xDA;)
+            {
+                if (i + 4 > size || data[i] != 0xFF)
+                    return false;
+                marker = data[i + 1];
+                size_t length = data[i + 2] * 256 + data[i + 3];
+                if (length < 2 || i + 2 + length > size)
+                    return false;
+                if (marker == 0xC0 && length >= 11)
+                {
+                    strips.height = data[i + 5] * 256 + data[i + 6];
+                    strips.width = data[i + 7] * 256 + data[i + 8];
+                    strips.block = data[i + 11] == 0x22 ? 16 : 8;
+                }
+                if (marker == 0xDD && length == 4)
+                    strips.interval = data[i + 4] * 256 + data[i + 5];
+                i += 2 + length;
+            }
+            for (size_t begin = i; i + 1 < size;)
+            {
+                if (data[i] == 0xFF && data[i + 1] != 0x00)
+                {
+                    strips.segments.push_back(std::make_pair(begin, i));
+                    if (data[i + 1] == 0xD9)
+                        return i + 2 == size && strips.block != 0;
+                    if (data[i + 1] < 0xD0 || data[i + 1] > 0xD7)
+                        return false;
+                    strips.restarts.push_back(data[i + 1]);
+                    i += 2;
+                    begin = i;
+                }
+                else
+                    i += data[i] == 0xFF ? 2 : 1;
+            }
+            return false;
+        }
+
+        bool CheckJpegStrips(const uint8_t* data, size_t size, size_t strips, const String& desc)
+        {
+            JpegStrips js;
+            if (!ParseJpegStrips(data, size, js))
+            {
+                TEST_LOG_SS(Error, desc << " : can't parse JPEG markers!");
+                return false;
+            }
+            if (strips == 0)
+            {
+                if (js.interval || js.restarts.size())
+                {
+                    TEST_LOG_SS(Error, desc << " : single-threaded encoder must not emit restart markers!");
+                    return false;
+                }
+                return true;
+            }
+            size_t mcuCols = Simd::DivHi(js.width, js.block), mcuRows = Simd::DivHi(js.height, js.block);
+            size_t expected = Simd::DivHi(mcuRows, Simd::DivHi(mcuRows, strips));
+            if (js.interval == 0 || js.interval % mcuCols != 0)
+            {
+                TEST_LOG_SS(Error, desc << " : wrong DRI restart interval " << js.interval << " for " << mcuCols << " MCU columns!");
+                return false;
+            }
+            if (Simd::DivHi(mcuCols * mcuRows, js.interval) != expected || js.restarts.size() != expected - 1)
+            {
+                TEST_LOG_SS(Error, desc << " : " << js.restarts.size() << " restart markers instead of " << expected - 1 << " !");
+                return false;
+            }
+            for (size_t s = 0; s < js.restarts.size(); ++s)
+            {
+                if (js.restarts[s] != 0xD0 + s % 8)
+                {
+                    TEST_LOG_SS(Error, desc << " : restart marker " << s << " is RST" << js.restarts[s] - 0xD0 << " instead of RST" << s % 8 << " !");
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool CheckJpegDcReset(uint8_t* data, size_t size, const String& desc)
+        {
+            JpegStrips js;
+            bool result = ParseJpegStrips(data, size, js) && js.segments.size() > 2;
+            if (!result)
+                TEST_LOG_SS(Error, desc << " : can't find restart interval strips!");
+            for (size_t s = 1; result && s < js.segments.size() - 1; ++s)
+            {
+                const std::pair<size_t, size_t>& first = js.segments[0], & curr = js.segments[s];
+                if (curr.second - curr.first != first.second - first.first || memcmp(data + curr.first, data + first.first, first.second - first.first))
+                {
+                    TEST_LOG_SS(Error, desc << " : strip " << s << " of vertically uniform image differs from strip 0, DC predictors are not reset!");
+                    result = false;
+                }
+            }
+            SimdFree(data);
+            return result;
+        }
+
+        bool CompareParallelJpeg(uint8_t* data1, size_t size1, uint8_t* data2, size_t size2, View::Format format, size_t strips, const String& desc)
+        {
+            bool result = true;
+            if (data1 == NULL || data2 == NULL)
+            {
+                TEST_LOG_SS(Error, desc << " : can't save image as JPEG!");
+                result = false;
+            }
+            result = result && CheckJpegStrips(data1, size1, 0, desc);
+            result = result && CheckJpegStrips(data2, size2, strips, desc);
+            View dst1, dst2;
+            if (result && !(dst1.Load(data1, size1, format) && dst2.Load(data2, size2, format)))
+            {
+                TEST_LOG_SS(Error, desc << " : can't load JPEG image!");
+                result = false;
+            }
+            result = result && Compare(dst1, dst2, 0, true, 64, 0, desc);
+            if (result)
+            {
+                void* decoder = ::SimdJpegDecoderInit();
+                void* pool = ::SimdThreadPoolInit(4, NULL, 0);
+                ::SimdThreadPoolBind(pool);
+                View dst3(dst2.width, dst2.height, format);
+                size_t width, height;
+                result = ::SimdJpegDecoderParse(decoder, data2, size2, &width, &height) && width == dst3.width && height == dst3.height &&
+                    ::SimdJpegDecoderDecode(decoder, dst3.data, dst3.stride, (SimdPixelFormatType)format);
+                ::SimdThreadPoolBind(NULL);
+                ::SimdRelease(pool);
+                ::SimdRelease(decoder);
+                if (!result)
+                    TEST_LOG_SS(Error, desc << " : can't decode JPEG image with restart markers!");
+                result = result && Compare(dst2, dst3, GetMaxJpegError(100), true, 64, 0, desc + " decoder");
+            }
+            SimdFree(data1);
+            SimdFree(data2);
+            return result;
+        }
+    }
+
+    bool JpegEncoderParallelAutoTest(size_t width, size_t height, View::Format format, int quality, FuncSM f1, FuncSNJM f2, FuncSYJM f3)
+    {
+        bool result = true;
+
+        const size_t strips = 5;
+
+        f1.Update(format, SimdImageFileJpeg, quality);
+        f2.Update(quality, SimdYuvTrect871);
+        f3.Update(quality, SimdYuvTrect871);
+
+        View src;
+        if (!GetTestImage(src, width, height, format, f1.desc, "", SimdImageFileJpeg, quality, NULL, NULL))
+            return false;
+
+        View bgra(width, height, View::Bgra32);
+        Simd::Convert(src, bgra);
+        size_t uvW = width / 2, uvH = height / 2;
+        View y(width, height, View::Gray8), u(uvW, uvH, View::Gray8), v(uvW, uvH, View::Gray8), uv(uvW, uvH, View::Uv16);
+        ::SimdBgraToYuv420pV2(bgra.data, bgra.stride, width, height, y.data, y.stride, u.data, u.stride, v.data, v.stride, SimdYuvTrect871);
+        ::SimdInterleaveUv(u.data, u.stride, v.data, v.stride, uvW, uvH, uv.data, uv.stride);
+
+        uint8_t* data[6] = { NULL, NULL, NULL, NULL, NULL, NULL };
+        size_t size[6] = { 0, 0, 0, 0, 0, 0 };
+
+        f1.Call(src, SimdImageFileJpeg, quality, data + 0, size + 0);
+        f2.Call(y, uv, SimdYuvTrect871, quality, data + 2, size + 2);
+        f3.Call(y, u, v, SimdYuvTrect871, quality, data + 4, size + 4);
+
+        void* pool = ::SimdThreadPoolInit(4, NULL, 0);
+        ::SimdThreadPoolBind(pool);
+        Simd::Base::ImageJpegSaverStrips() = strips;
+        f1.desc = f1.desc + "-mt";
+        f2.desc = f2.desc + "-mt";
+        f3.desc = f3.desc + "-mt";
+        f1.Call(src, SimdImageFileJpeg, quality, data + 1, size + 1);
+        f2.Call(y, uv, SimdYuvTrect871, quality, data + 3, size + 3);
+        f3.Call(y, u, v, SimdYuvTrect871, quality, data + 5, size + 5);
+
+        result = CompareParallelJpeg(data[0], size[0], data[1], size[1], format, strips, f1.desc) && result;
+        result = CompareParallelJpeg(data[2], size[2], data[3], size[3], View::Bgra32, strips, f2.desc) && result;
+        result = CompareParallelJpeg(data[4], size[4], data[5], size[5], View::Bgra32, strips, f3.desc) && result;
+
+        for (size_t row = 0, rowSize = width * src.PixelSize(); row < height; ++row)
+            for (size_t col = 0; col < rowSize; ++col)
+                src.data[row * src.stride + col] = uint8_t(col * 255 / rowSize);
+        Simd::Convert(src, bgra);
+        ::SimdBgraToYuv420pV2(bgra.data, bgra.stride, width, height, y.data, y.stride, u.data, u.stride, v.data, v.stride, SimdYuvTrect871);
+        ::SimdInterleaveUv(u.data, u.stride, v.data, v.stride, uvW, uvH, uv.data, uv.stride);
+
+        f1.Call(src, SimdImageFileJpeg, quality, data + 0, size + 0);
+        f2.Call(y, uv, SimdYuvTrect871, quality, data + 2, size + 2);
+        f3.Call(y, u, v, SimdYuvTrect871, quality, data + 4, size + 4);
+        Simd::Base::ImageJpegSaverStrips() = 0;
+        ::SimdThreadPoolBind(NULL);
+        ::SimdRelease(pool);
+
+        result = CheckJpegDcReset(data[0], size[0], f1.desc) && result;
+        result = CheckJpegDcReset(data[2], size[2], f2.desc) && result;
+        result = CheckJpegDcReset(data[4], size[4], f3.desc) && result;
+
+        return result;
+    }
+
+    bool JpegEncoderParallelAutoTest(const FuncSM& f1, const FuncSNJM& f2, const FuncSYJM& f3)
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            result = result && JpegEncoderParallelAutoTest(W, H, formats[format], 95, f1, f2, f3);
+            result = result && JpegEncoderParallelAutoTest(W + E, H - E, formats[format], 65, f1, f2, f3);
+        }
+
+        return result;
+    }
+
+    bool JpegEncoderParallelAutoTest()
+    {
+        bool result = true;
+
+        if (TestBase())
+            result = result && JpegEncoderParallelAutoTest(FUNC_SM(Simd::Base::ImageSaveToMemory), 
+                FUNC_SNJM(Simd::Base::Nv12SaveAsJpegToMemory), FUNC_SYJM(Simd::Base::Yuv420pSaveAsJpegToMemory));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable && TestSse41())
+            result = result && JpegEncoderParallelAutoTest(FUNC_SM(Simd::Sse41::ImageSaveToMemory),
+                FUNC_SNJM(Simd::Sse41::Nv12SaveAsJpegToMemory), FUNC_SYJM(Simd::Sse41::Yuv420pSaveAsJpegToMemory));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable && TestAvx2())
+            result = result && JpegEncoderParallelAutoTest(FUNC_SM(Simd::Avx2::ImageSaveToMemory),
+                FUNC_SNJM(Simd::Avx2::Nv12SaveAsJpegToMemory), FUNC_SYJM(Simd::Avx2::Yuv420pSaveAsJpegToMemory));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable && TestAvx512bw())
+            result = result && JpegEncoderParallelAutoTest(FUNC_SM(Simd::Avx512bw::ImageSaveToMemory),
+                FUNC_SNJM(Simd::Avx512bw::Nv12SaveAsJpegToMemory), FUNC_SYJM(Simd::Avx512bw::Yuv420pSaveAsJpegToMemory));
+#endif 
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable && TestNeon())
+            result = result && JpegEncoderParallelAutoTest(FUNC_SM(Simd::Neon::ImageSaveToMemory),
+                FUNC_SNJM(Simd::Neon::Nv12SaveAsJpegToMemory), FUNC_SYJM(Simd::Neon::Yuv420pSaveAsJpegToMemory));
+#endif 
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    namespace
+    {
+        SIMD_INLINE size_t PngChunkLength(const uint8_t* data)
+        {
+            return size_t(data[0]) << 24 | size_t(data[1]) << 16 | size_t(data[2]) << 8 | size_t(data[3]);
+        }
+
+        bool CorruptPngAdler32(uint8_t* data, size_t size)
+        {
+            size_t last = 0;
+            for (size_t offs = 8; offs + 12 <= size; offs += PngChunkLength(data + offs) + 12)
+                if (memcmp(data + offs + 4, "IDAT", 4) == 0)
+                    last = offs;
+            size_t length = last ? PngChunkLength(data + last) : 0;
+            if (length < 4)
+                return false;
+            uint8_t* chunk = data + last + 4;
+            chunk[4 + length - 1] ^= 1;
+            uint32_t crc = ::SimdCrc32(chunk, length + 4);
+            for (size_t i = 0; i < 4; ++i)
+                chunk[4 + length + i] = uint8_t(crc >> (24 - 8 * i));
+            return true;
+        }
+    }
+
+    bool PngEncoderParallelAutoTest(size_t width, size_t height, View::Format format, FuncSM f1)
+    {
+        bool result = true;
+
+        f1.Update(format, SimdImageFilePng, 100);
+
+        View src;
+        if (!GetTestImage(src, width, height, format, f1.desc, "", SimdImageFilePng, 100, NULL, NULL))
+            return false;
+
+        uint8_t* data[2] = { NULL, NULL };
+        size_t size[2] = { 0, 0 };
+
+        f1.Call(src, SimdImageFilePng, 100, data + 0, size + 0);
+
+        void* pool = ::SimdThreadPoolInit(4, NULL, 0);
+        ::SimdThreadPoolBind(pool);
+        bool parallel = ::SimdGetThreadNumber() > 1;
+        f1.desc = f1.desc + "-mt";
+        f1.Call(src, SimdImageFilePng, 100, data + 1, size + 1);
+        ::SimdThreadPoolBind(NULL);
+        ::SimdRelease(pool);
+
+        for (size_t i = 0; i < 2 && result; ++i)
+        {
+            View dst;
+            if (data[i] == NULL)
+            {
+                TEST_LOG_SS(Error, f1.desc << " : can't save image as PNG!");
+                result = false;
+            }
+            else if (!dst.Load(data[i], size[i], format))
+            {
+                TEST_LOG_SS(Error, f1.desc << " : can't load PNG image!");
+                result = false;
+            }
+            else
+                result = Compare(src, dst, 0, true, 64, 0, f1.desc + (i ? " multi-threaded" : " single-threaded"));
+            View bad;
+            if (result && !CorruptPngAdler32(data[i], size[i]))
+            {
+                TEST_LOG_SS(Error, f1.desc << " : can't find IDAT chunk with zlib Adler-32 checksum!");
+                result = false;
+            }
+            if (result && bad.Load(data[i], size[i], format))
+            {
+                TEST_LOG_SS(Error, f1.desc << " : PNG image with wrong zlib Adler-32 checksum must not be loaded!");
+                result = false;
+            }
+        }
+        SimdFree(data[0]);
+        SimdFree(data[1]);
+
+        return result;
+    }
+
+    bool PngEncoderParallelAutoTest(const FuncSM& f1)
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Bgra32, View::Rgb24, View::Rgba32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            result = result && PngEncoderParallelAutoTest(W, H, formats[format], f1);
+            result = result && PngEncoderParallelAutoTest(W + E, H - E, formats[format], f1);
+        }
+
+        return result;
+    }
+
+    bool PngEncoderParallelAutoTest()
+    {
+        bool result = true;
+
+        if (TestBase())
+            result = result && PngEncoderParallelAutoTest(FUNC_SM(Simd::Base::ImageSaveToMemory));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable && TestSse41())
+            result = result && PngEncoderParallelAutoTest(FUNC_SM(Simd::Sse41::ImageSaveToMemory));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable && TestAvx2())
+            result = result && PngEncoderParallelAutoTest(FUNC_SM(Simd::Avx2::ImageSaveToMemory));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable && TestAvx512bw())
+            result = result && PngEncoderParallelAutoTest(FUNC_SM(Simd::Avx512bw::ImageSaveToMemory));
+#endif 
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable && TestNeon())
+            result = result && PngEncoderParallelAutoTest(FUNC_SM(Simd::Neon::ImageSaveToMemory));
+#endif 
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool PngEncoderLevelsAutoTest(size_t width, size_t height, View::Format format, int quality, FuncSM f1)
+    {
+        bool result = true;
+
+        f1.Update(format, SimdImageFilePng, quality);
+
+        View src;
+        if (!GetTestImage(src, width, height, format, f1.desc, "", SimdImageFilePng, quality, NULL, NULL))
+            return false;
+
+        uint8_t* data = NULL;
+        size_t size = 0;
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(if (data) SimdFree(data); f1.Call(src, SimdImageFilePng, quality, &data, &size));
+
+        View dst;
+        if (data == NULL)
+        {
+            TEST_LOG_SS(Error, f1.desc << " : can't save image as PNG!");
+            result = false;
+        }
+        else if (!dst.Load(data, size, format))
+        {
+            TEST_LOG_SS(Error, f1.desc << " : can't load PNG image!");
+            result = false;
+        }
+        else
+        {
+            size_t raw = src.width * src.height * src.PixelSize();
+            TEST_LOG_SS(Info, f1.desc << " : " << size << " bytes (" << ToString(100.0 * size / raw, 1, false) << "% of raw size).");
+            result = Compare(src, dst, 0, true, 64, 0, f1.desc);
+        }
+        SimdFree(data);
+
+        return result;
+    }
+
+    bool PngEncoderLevelsAutoTest(const FuncSM& f1)
+    {
+        bool result = true;
+
+        std::vector<View::Format> formats = { View::Gray8, View::Bgr24, View::Rgba32 };
+        for (size_t format = 0; format < formats.size(); format++)
+        {
+            for (int quality = -1; quality >= -3; --quality)
+            {
+                result = result && PngEncoderLevelsAutoTest(W, H, formats[format], quality, f1);
+                result = result && PngEncoderLevelsAutoTest(W + E, H - E, formats[format], quality, f1);
+            }
+            result = result && PngEncoderLevelsAutoTest(W, H, formats[format], 100, f1);
+        }
+
+        return result;
+    }
+
+    bool PngEncoderLevelsAutoTest()
+    {
+        bool result = true;
+
+        if (TestBase())
+            result = result && PngEncoderLevelsAutoTest(FUNC_SM(Simd::Base::ImageSaveToMemory));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable && TestSse41())
+            result = result && PngEncoderLevelsAutoTest(FUNC_SM(Simd::Sse41::ImageSaveToMemory));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable && TestAvx2())
+            result = result && PngEncoderLevelsAutoTest(FUNC_SM(Simd::Avx2::ImageSaveToMemory));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable && TestAvx512bw())
+            result = result && PngEncoderLevelsAutoTest(FUNC_SM(Simd::Avx512bw::ImageSaveToMemory));
+#endif 
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable && TestNeon())
+            result = result && PngEncoderLevelsAutoTest(FUNC_SM(Simd::Neon::ImageSaveToMemory));
+#endif 
+
+        return result;
+    }
 }
@@ -0,0 +1,127 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Test/TestCompare.h"
+#include "Test/TestPerformance.h"
+#include "Test/TestRandom.h"
+
+#include "Simd/SimdBase.h"
+#include "Simd/SimdSse41.h"
+#include "Simd/SimdAvx2.h"
+#include "Simd/SimdAvx512bw.h"
+#include "Simd/SimdNeon.h"
+
+namespace Test
+{
+    bool IsaMaskAutoTest(uint32_t mask, const View & src, const View & dst1, const Buffer32f & a, const Buffer32f & b)
+    {
+        bool result = true;
+
+        ::SimdSetIsaMask(mask);
+        uint32_t used = ::SimdGetIsaMask();
+
+        TEST_LOG_SS(Info, "Test SimdSetIsaMask(0x" << std::hex << mask << ") : used mask = 0x" << used << std::dec << ".");
+
+        if ((used & ~mask) != 0)
+        {
+            TEST_LOG_SS(Error, "Used ISA mask 0x" << std::hex << used << " exceeds required mask 0x" << mask << std::dec << " !");
+            result = false;
+        }
+        if ((used & SimdIsaAvx2) && !(used & SimdIsaSse41))
+        {
+            TEST_LOG_SS(Error, "AVX2 is used without SSE4.1 !");
+            result = false;
+        }
+        if ((used & (SimdIsaAvx512bw | SimdIsaAvx512vnni | SimdIsaAmxBf16)) && !(used & SimdIsaAvx2))
+        {
+            TEST_LOG_SS(Error, "AVX-512 is used without AVX2 !");
+            result = false;
+        }
+
+        View dst2(src.width, src.height, View::Gray8, NULL, TEST_ALIGN(src.width));
+        ::SimdBgrToGray(src.data, src.width, src.height, src.stride, dst2.data, dst2.stride);
+
+        result = result && Compare(dst1, dst2, 0, true, 64);
+
+        String isa = "Base";
+        uint32_t known = 0;
+        float expected, distance;
+        Simd::Base::CosineDistance32f(a.data(), b.data(), a.size(), &expected);
+#ifdef SIMD_SSE41_ENABLE
+        known |= SimdIsaSse41;
+        if (used & SimdIsaSse41)
+            Simd::Sse41::CosineDistance32f(a.data(), b.data(), a.size(), &expected), isa = "Sse41";
+#endif
+#ifdef SIMD_AVX2_ENABLE
+        known |= SimdIsaAvx2;
+        if (used & SimdIsaAvx2)
+            Simd::Avx2::CosineDistance32f(a.data(), b.data(), a.size(), &expected), isa = "Avx2";
+#endif
+#ifdef SIMD_AVX512BW_ENABLE
+        known |= SimdIsaAvx512bw;
+        if (used & SimdIsaAvx512bw)
+            Simd::Avx512bw::CosineDistance32f(a.data(), b.data(), a.size(), &expected), isa = "Avx512bw";
+#endif
+#ifdef SIMD_NEON_ENABLE
+        known |= SimdIsaNeon;
+        if (used & SimdIsaNeon)
+            Simd::Neon::CosineDistance32f(a.data(), b.data(), a.size(), &expected), isa = "Neon";
+#endif
+        ::SimdCosineDistance32f(a.data(), b.data(), a.size(), &distance);
+        if (used & (SimdIsaSse41 | SimdIsaAvx2 | SimdIsaAvx512bw | SimdIsaNeon) & ~known)
+        {
+            // The test is compiled without some of the used extensions, so the selected implementation can't be reproduced here.
+            if (!Compare(expected, distance, EPS, true, DifferenceBoth, "SimdCosineDistance32f"))
+                result = false;
+        }
+        else if (memcmp(&expected, &distance, sizeof(float)) != 0)
+        {
+            TEST_LOG_SS(Error, "SimdCosineDistance32f has not used " << isa << " implementation: " << distance << " != " << expected << " !");
+            result = false;
+        }
+
+        ::SimdSetIsaMask(SimdIsaAll);
+
+        return result;
+    }
+
+    bool IsaMaskAutoTest()
+    {
+        bool result = true;
+
+        View src(W, H, View::Bgr24, NULL, TEST_ALIGN(W));
+        FillRandom(src);
+        View dst1(W, H, View::Gray8, NULL, TEST_ALIGN(W));
+        Simd::Base::BgrToGray(src.data, src.width, src.height, src.stride, dst1.data, dst1.stride);
+
+        Buffer32f a(W * H + O), b(W * H + O);
+        FillRandom(a, -1.0f, 1.0f);
+        FillRandom(b, -1.0f, 1.0f);
+
+        const uint32_t masks[] = { SimdIsaAll, SimdIsaAll & ~SimdIsaAmxBf16, SimdIsaSse41 | SimdIsaAvx2, SimdIsaSse41, SimdIsaAvx2, 0 };
+        for (size_t i = 0; i < sizeof(masks) / sizeof(masks[0]); ++i)
+            result = result && IsaMaskAutoTest(masks[i], src, dst1, a, b);
+
+        return result;
+    }
+}
@@ -0,0 +1,343 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+#include "Test/TestCompare.h"
+#include "Test/TestPerformance.h"
+#include "Test/TestString.h"
+#include "Test/TestTensor.h"
+#include "Test/TestRandom.h"
+
+#include "Simd/SimdParallel.hpp"
+#include "Simd/SimdParallelRows.h"
+
+#include <future>
+#include <atomic>
+
+namespace Test
+{
+    namespace
+    {
+        template<class Function> void ParallelAsync(size_t begin, size_t end, const Function& function, size_t threadNumber, size_t blockAlign = 1)
+        {
+            threadNumber = std::min<size_t>(threadNumber, std::thread::hardware_concurrency());
+            if (threadNumber <= 1 || size_t(blockAlign * 1.5) >= (end - begin))
+                function(0, begin, end);
+            else
+            {
+                std::vector<std::future<void>> futures;
+                size_t blockSize = (end - begin + threadNumber - 1) / threadNumber;
+                blockSize = (blockSize + blockAlign - 1) / blockAlign * blockAlign;
+                size_t blockBegin = begin;
+                size_t blockEnd = blockBegin + blockSize;
+                for (size_t thread = 0; thread < threadNumber && blockBegin < end; ++thread)
+                {
+                    futures.push_back(std::async(std::launch::async, [blockBegin, blockEnd, thread, &function] { function(thread, blockBegin, blockEnd); }));
+                    blockBegin += blockSize;
+                    blockEnd = std::min(blockBegin + blockSize, end);
+                }
+                for (size_t i = 0; i < futures.size(); ++i)
+                    futures[i].wait();
+            }
+        }
+
+        void FillAsync(size_t size, uint32_t* dst, size_t threadNumber)
+        {
+            ParallelAsync(0, size, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                    dst[i] = uint32_t(i * 7 + (thread << 24));
+            }, threadNumber);
+        }
+
+        void FillPool(size_t size, uint32_t* dst, size_t threadNumber)
+        {
+            Simd::Parallel(0, size, [&](size_t thread, size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                    dst[i] = uint32_t(i * 7 + (thread << 24));
+            }, threadNumber);
+        }
+
+        struct FuncP
+        {
+            typedef void(*FuncPtr)(size_t size, uint32_t* dst, size_t threadNumber);
+
+            FuncPtr func;
+            String description;
+
+            FuncP(const FuncPtr& f, const String& d) : func(f), description(d) {}
+
+            void Update(size_t threadNumber)
+            {
+                description = description + "[" + ToString(threadNumber) + "]";
+            }
+
+            void Call(Sums & dst, size_t threadNumber) const
+            {
+                TEST_PERFORMANCE_TEST(description);
+                func(dst.size(), dst.data(), threadNumber);
+            }
+        };
+    }
+
+#define FUNC_P(func) FuncP(func, #func)
+
+    bool ParallelAutoTest(size_t size, size_t threadNumber, FuncP f1, FuncP f2)
+    {
+        bool result = true;
+
+        f1.Update(threadNumber);
+        f2.Update(threadNumber);
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << " for size = " << size << ".");
+
+        Sums dst1(size, 0), dst2(size, 1);
+
+        size_t global = ::SimdGetThreadNumber();
+        ::SimdSetThreadNumber(threadNumber);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(dst1, threadNumber));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(dst2, threadNumber));
+
+        ::SimdSetThreadNumber(global);
+
+        result = result && Compare(dst1, dst2, 0, true, 32);
+
+        return result;
+    }
+
+    bool ParallelAutoTest(const FuncP & f1, const FuncP & f2)
+    {
+        bool result = true;
+
+        size_t threadMax = std::thread::hardware_concurrency();
+        for (size_t threadNumber = 2; threadNumber <= std::max<size_t>(threadMax, 2); threadNumber *= 2)
+        {
+            result = result && ParallelAutoTest(64, threadNumber, f1, f2);
+            result = result && ParallelAutoTest(W * H, threadNumber, f1, f2);
+        }
+
+        return result;
+    }
+
+    bool ParallelAutoTest()
+    {
+        bool result = true;
+
+        if (TestBase())
+            result = result && ParallelAutoTest(FUNC_P(FillAsync), FUNC_P(FillPool));
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    namespace
+    {
+        void Gemm32fNN(size_t N, const Tensor32f & a, const Tensor32f & b, Tensor32f & c)
+        {
+            const float alpha = 1.0f, beta = 0.0f;
+            ::SimdGemm32fNN(N, N, N, &alpha, a.Data(), N, b.Data(), N, &beta, c.Data(), N);
+        }
+    }
+
+    bool ThreadPoolAutoTest()
+    {
+        bool result = true;
+
+        const size_t threads = 3, cpu = 0, N = 512;
+        size_t global = ::SimdGetThreadNumber();
+        size_t expected = std::min<size_t>(threads, std::thread::hardware_concurrency());
+
+        TEST_LOG_SS(Info, "Test SimdThreadPoolInit(" << threads << ") pinned to CPU " << cpu << ".");
+
+        Tensor32f a({ N, N }), b({ N, N }), c1({ N, N }), c2({ N, N });
+        FillRandom(a.Data(), a.Size(), -1.0, 1.0f);
+        FillRandom(b.Data(), b.Size(), -1.0, 1.0f);
+        Gemm32fNN(N, a, b, c1);
+
+        void * context = ::SimdThreadPoolInit(threads, &cpu, 1);
+        ::SimdThreadPoolBind(context);
+        Simd::ThreadPool * pool = Simd::ThreadPool::Bound();
+        if (pool == NULL || ::SimdGetThreadNumber() != expected)
+        {
+            TEST_LOG_SS(Error, "Bound thread pool has wrong thread number: " << ::SimdGetThreadNumber() << " != " << expected << " !");
+            result = false;
+        }
+
+        std::atomic<size_t> foreign(0), unpinned(0);
+        std::thread::id caller = std::this_thread::get_id();
+        Simd::Parallel(0, N * N, [&](size_t thread, size_t begin, size_t end)
+        {
+            if (Simd::ThreadPool::Bound() != pool)
+                foreign++;
+#if defined(__linux__)
+            if (std::this_thread::get_id() != caller)
+            {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0 || CPU_COUNT(&set) != 1 || !CPU_ISSET(cpu, &set))
+                    unpinned++;
+            }
+#endif
+        }, ::SimdGetThreadNumber() * 4);
+        if (pool && pool->Size() + 1 != expected)
+        {
+            TEST_LOG_SS(Error, "Simd::Parallel has changed size of bound thread pool: " << pool->Size() + 1 << " != " << expected << " !");
+            result = false;
+        }
+        if (foreign)
+        {
+            TEST_LOG_SS(Error, foreign << " blocks were executed outside of bound thread pool!");
+            result = false;
+        }
+        if (unpinned)
+        {
+            TEST_LOG_SS(Error, unpinned << " blocks were executed by workers with wrong CPU affinity!");
+            result = false;
+        }
+
+        Gemm32fNN(N, a, b, c2);
+        result = result && Compare(c1, c2, EPS, true, 32, DifferenceRelative, "SimdGemm32fNN in bound pool");
+
+        ::SimdThreadPoolBind(NULL);
+        if (Simd::ThreadPool::Bound() != NULL || ::SimdGetThreadNumber() != global)
+        {
+            TEST_LOG_SS(Error, "Global thread pool is not restored after unbinding!");
+            result = false;
+        }
+        ::SimdRelease(context);
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncR
+        {
+            typedef void(*FuncPtr)(const View & src, View * dst);
+
+            FuncPtr func;
+            String description;
+            View::Format srcFormat, dstFormat;
+            bool yuv420;
+
+            FuncR(const FuncPtr& f, const String& d, View::Format sf, View::Format df, bool y) : func(f), description(d), srcFormat(sf), dstFormat(df), yuv420(y) {}
+
+            void Call(const View & src, View * dst, size_t bands) const
+            {
+                Simd::ParallelRowsBands() = bands;
+                func(src, dst);
+                Simd::ParallelRowsBands() = 0;
+            }
+        };
+
+        void BgraToBgr(const View & src, View * dst)
+        {
+            ::SimdBgraToBgr(src.data, src.width, src.height, src.stride, dst[0].data, dst[0].stride);
+        }
+
+        void BgrToGray(const View & src, View * dst)
+        {
+            ::SimdBgrToGray(src.data, src.width, src.height, src.stride, dst[0].data, dst[0].stride);
+        }
+
+        void BgraToYuv420pV2(const View & src, View * dst)
+        {
+            ::SimdBgraToYuv420pV2(src.data, src.stride, src.width, src.height, dst[0].data, dst[0].stride, dst[1].data, dst[1].stride, dst[2].data, dst[2].stride, SimdYuvBt601);
+        }
+
+        void Yuv420pToBgraV2(const View & src, View * dst)
+        {
+            ::SimdYuv420pToBgraV2(src.data, src.stride, src.data, src.stride, src.data + src.stride, src.stride, src.width, src.height, dst[0].data, dst[0].stride, 0xFF, SimdYuvBt601);
+        }
+    }
+
+#define FUNC_R(func, sf, df, y) FuncR(func, #func, View::sf, View::df, y)
+
+    bool ParallelRowsAutoTest(size_t width, size_t height, size_t bands, const FuncR & f)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test " << f.description << " in " << bands << " row bands for size [" << width << ", " << height << "].");
+
+        View src(width, height, f.srcFormat, NULL, TEST_ALIGN(width));
+        FillRandom(src);
+
+        View dst1[3], dst2[3];
+        size_t planes = f.yuv420 ? 3 : 1;
+        for (size_t i = 0; i < planes; ++i)
+        {
+            size_t w = i ? width / 2 : width, h = i ? height / 2 : height;
+            dst1[i].Recreate(w, h, f.dstFormat, NULL, TEST_ALIGN(w));
+            dst2[i].Recreate(w, h, f.dstFormat, NULL, TEST_ALIGN(w));
+            Simd::Fill(dst1[i], 0x00);
+            Simd::Fill(dst2[i], 0xFF);
+        }
+
+        size_t global = ::SimdGetThreadNumber();
+        ::SimdSetThreadNumber(std::thread::hardware_concurrency());
+
+        f.Call(src, dst1, 1);
+
+        f.Call(src, dst2, bands);
+
+        ::SimdSetThreadNumber(global);
+
+        for (size_t i = 0; i < planes; ++i)
+            result = result && Compare(dst1[i], dst2[i], 0, true, 64, 0, f.description);
+
+        return result;
+    }
+
+    bool ParallelRowsAutoTest(const FuncR & f)
+    {
+        bool result = true;
+
+        for (size_t bands = 2; bands <= 7; bands += 5)
+        {
+            result = result && ParallelRowsAutoTest(W, H, bands, f);
+            result = result && ParallelRowsAutoTest(W + E, H - E, bands, f);
+        }
+
+        return result;
+    }
+
+    bool ParallelRowsAutoTest()
+    {
+        bool result = true;
+
+        if (TestBase())
+        {
+            result = result && ParallelRowsAutoTest(FUNC_R(BgraToBgr, Bgra32, Bgr24, false));
+            result = result && ParallelRowsAutoTest(FUNC_R(BgrToGray, Bgr24, Gray8, false));
+            result = result && ParallelRowsAutoTest(FUNC_R(BgraToYuv420pV2, Bgra32, Gray8, true));
+            result = result && ParallelRowsAutoTest(FUNC_R(Yuv420pToBgraV2, Gray8, Bgra32, false));
+        }
+
+        return result;
+    }
+}
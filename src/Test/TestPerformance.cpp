@@ -78,6 +78,8 @@ namespace Test
         , _max(std::numeric_limits<double>::min())
         , _entered(false)
         , _size(0)
+        , _flop(0)
+        , _elements(0)
     {
     }
 
@@ -89,6 +91,8 @@ namespace Test
         , _max(pm._max)
         , _entered(pm._entered)
         , _size(pm._size)
+        , _flop(pm._flop)
+        , _elements(pm._elements)
     {
     }
 
@@ -101,7 +105,7 @@ namespace Test
         }
     }
 
-    void PerformanceMeasurer::Leave(size_t size)
+    void PerformanceMeasurer::Leave(size_t size, double flop, double elements)
     {
         if (_entered)
         {
@@ -112,6 +116,8 @@ namespace Test
             _max = std::max(_max, difference);
             ++_count;
             _size += std::max<size_t>(1, size);
+            _flop += flop;
+            _elements += elements;
         }
     }
 
@@ -143,6 +149,8 @@ namespace Test
         _min = std::min(_min, other._min);
         _max = std::max(_max, other._max);
         _size += other._size;
+        _flop += other._flop;
+        _elements += other._elements;
     }
 
     //-------------------------------------------------------------------------
@@ -391,6 +399,16 @@ namespace Test
         }
     }
 
+    PerformanceMeasurerStorage::Measurers PerformanceMeasurerStorage::Combined() const
+    {
+        FunctionMap map;
+        Combine(map);
+        Measurers measurers;
+        for (FunctionMap::const_iterator it = map.begin(); it != map.end(); ++it)
+            measurers.push_back(*it->second);
+        return measurers;
+    }
+
     PerformanceMeasurerStorage::TablePtr PerformanceMeasurerStorage::GenerateTable(bool align) const
     {
         FunctionMap map;
@@ -412,11 +430,16 @@ namespace Test
         for (FunctionStatisticMap::const_iterator it = functions.begin(); it != functions.end(); ++it)
             AddToCommon(it->second, enable, common);
 
-        size_t size = 0;
+        size_t size = 0, simd = 0;
         for (size_t i = 0; i < enable.Size(); ++i)
+        {
             if (enable[i])
                 size++;
-        TablePtr table(new Table(1 + size + (enable[1] ? size - 2 : 0) + (size > 2 ? size - 2: 0) + (align ? size : 0), 1 + functions.size()));
+            if (enable[i] && i >= 2)
+                simd++;
+        }
+        size_t relations = (enable[1] ? simd : 0) + (enable[1] || simd == 0 ? simd : simd - 1);
+        TablePtr table(new Table(1 + size + relations + (align ? size : 0), 1 + functions.size()));
         AddHeader(*table, names, enable, align);
         size_t row = 0;
         table->SetRowProp(row, true, true);
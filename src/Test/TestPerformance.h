@@ -43,17 +43,24 @@ namespace Test
         bool _entered;
 
         long long _size;
+        double _flop, _elements;
 
     public:
         PerformanceMeasurer(const String & description = "Unnamed");
         PerformanceMeasurer(const PerformanceMeasurer & pm);
 
         void Enter();
-        void Leave(size_t size = 1);
+        void Leave(size_t size = 1, double flop = 0, double elements = 0);
 
         double Average() const;
         String Statistic() const;
 
+        int Count() const { return _count; }
+        double Min() const { return _min; }
+        long long Size() const { return _size; }
+        double Flop() const { return _flop; }
+        double Elements() const { return _elements; }
+
         String Description() const { return _description; }
 
         void Combine(const PerformanceMeasurer & other);
@@ -65,15 +72,16 @@ namespace Test
     {
         PerformanceMeasurer * _pm;
         size_t _size;
+        double _flop, _elements;
     public:
 
-        ScopedPerformanceMeasurer(PerformanceMeasurer & pm) : _pm(&pm), _size(1)
+        ScopedPerformanceMeasurer(PerformanceMeasurer & pm) : _pm(&pm), _size(1), _flop(0), _elements(0)
         {
             if (_pm)
                 _pm->Enter();
         }
 
-        ScopedPerformanceMeasurer(PerformanceMeasurer * pm) : _pm(pm), _size(1)
+        ScopedPerformanceMeasurer(PerformanceMeasurer * pm) : _pm(pm), _size(1), _flop(0), _elements(0)
         {
             if (_pm)
                 _pm->Enter();
@@ -82,10 +90,12 @@ namespace Test
         ~ScopedPerformanceMeasurer()
         {
             if (_pm)
-                _pm->Leave(_size);
+                _pm->Leave(_size, _flop, _elements);
         }
 
         void SetSize(size_t size) { _size = size; }
+        void SetFlop(double flop) { _flop = flop; }
+        void SetElements(double elements) { _elements = elements; }
     };
 
     //-------------------------------------------------------------------------
@@ -119,6 +129,9 @@ namespace Test
 
         PerformanceMeasurer* Get(String name);
 
+        typedef std::vector<PerformanceMeasurer> Measurers;
+        Measurers Combined() const;
+
         size_t Align(size_t size);
 
         String ConsoleReport(bool align = false, bool raw = false) const;
@@ -134,15 +147,21 @@ namespace Test
 #define TEST_PERFORMANCE_TEST_(decription) Test::ScopedPerformanceMeasurer ___spm(*(Test::PerformanceMeasurerStorage::s_storage.Get(decription)));
 #define TEST_FUNCTION_PERFORMANCE_TEST_ TEST_PERFORMANCE_TEST_(__FUNCTION__)
 #define TEST_PERFORMANCE_TEST_SET_SIZE_(size) ___spm.SetSize(size);
+#define TEST_PERFORMANCE_TEST_SET_FLOP_(flop) ___spm.SetFlop(flop);
+#define TEST_PERFORMANCE_TEST_SET_ELEMENTS_(elements) ___spm.SetElements(elements);
 
 #ifdef TEST_PERFORMANCE_TEST_ENABLE
 #define TEST_PERFORMANCE_TEST(decription) TEST_PERFORMANCE_TEST_(decription)
 #define TEST_FUNCTION_PERFORMANCE_TEST TEST_FUNCTION_PERFORMANCE_TEST_
 #define TEST_PERFORMANCE_TEST_SET_SIZE(size) TEST_PERFORMANCE_TEST_SET_SIZE_(size)
+#define TEST_PERFORMANCE_TEST_SET_FLOP(flop) TEST_PERFORMANCE_TEST_SET_FLOP_(flop)
+#define TEST_PERFORMANCE_TEST_SET_ELEMENTS(elements) TEST_PERFORMANCE_TEST_SET_ELEMENTS_(elements)
 #else//TEST_PERFORMANCE_TEST_ENABLE
 #define TEST_PERFORMANCE_TEST(decription)
 #define TEST_FUNCTION_PERFORMANCE_TEST
 #define TEST_PERFORMANCE_TEST_SET_SIZE(size)
+#define TEST_PERFORMANCE_TEST_SET_FLOP(flop)
+#define TEST_PERFORMANCE_TEST_SET_ELEMENTS(elements)
 #endif//TEST_PERFORMANCE_TEST_ENABLE
 
 #ifdef NDEBUG
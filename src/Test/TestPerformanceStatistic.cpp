@@ -0,0 +1,209 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include "Test/TestCompare.h"
+#include "Test/TestPerformance.h"
+#include "Test/TestString.h"
+
+#include "Simd/SimdPerformance.h"
+
+#include <atomic>
+
+namespace Test
+{
+#if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
+    namespace
+    {
+        bool CheckPercentile(const Simd::Base::PerformanceHistogram& histogram, double percent, int64_t expected)
+        {
+            int64_t value = histogram.Percentile(percent);
+            if (value < expected - expected / 16 - 1 || value > expected + expected / 16 + 1)
+            {
+                TEST_LOG_SS(Error, "PerformanceHistogram: p" << percent << " = " << value << " instead of " << expected << " !");
+                return false;
+            }
+            return true;
+        }
+
+        void Measure(Simd::Base::PerformanceMeasurer* pm, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                pm->Enter();
+                volatile size_t sum = 0;
+                for (size_t j = 0; j < 1000; ++j)
+                    sum = sum + j;
+                pm->Leave();
+            }
+        }
+
+        bool FindItem(const String& name, bool threads, SimdPerformanceStatisticItem& item)
+        {
+            std::vector<SimdPerformanceStatisticItem> items(::SimdPerformanceStatisticItems(NULL, 0, threads ? SimdTrue : SimdFalse));
+            items.resize(::SimdPerformanceStatisticItems(items.data(), items.size(), threads ? SimdTrue : SimdFalse));
+            for (size_t i = 0; i < items.size(); ++i)
+            {
+                if (name == items[i].name)
+                {
+                    item = items[i];
+                    return true;
+                }
+            }
+            TEST_LOG_SS(Error, "Can't find performance statistic item '" << name << "' !");
+            return false;
+        }
+    }
+
+    bool PerformanceHistogramTest()
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test Simd::Base::PerformanceHistogram.");
+
+        Simd::Base::PerformanceHistogram histogram;
+        result = result && CheckPercentile(histogram, 50.0, 0);
+
+        for (int64_t value = 1; value <= 1000; ++value)
+            histogram.Add(value);
+        result = result && CheckPercentile(histogram, 50.0, 500);
+        result = result && CheckPercentile(histogram, 90.0, 900);
+        result = result && CheckPercentile(histogram, 99.0, 990);
+        result = result && CheckPercentile(histogram, 100.0, 1000);
+
+        Simd::Base::PerformanceHistogram large;
+        for (int64_t i = 0; i < 999; ++i)
+            large.Add(1000000000);
+        large.Add(int64_t(1) << 50);
+        histogram.Combine(large);
+        result = result && CheckPercentile(large, 50.0, 1000000000);
+        result = result && CheckPercentile(large, 99.99, int64_t(1) << 50);
+        result = result && CheckPercentile(histogram, 25.0, 500);
+        result = result && CheckPercentile(histogram, 75.0, 1000000000);
+
+        histogram.Reset();
+        result = result && CheckPercentile(histogram, 50.0, 0);
+
+        return result;
+    }
+
+    bool PerformanceMeasurerTest()
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test SimdPerformanceStatisticItems, SimdPerformanceStatisticJson and SimdPerformanceStatisticReset.");
+
+        const String name = "PerformanceStatisticTest \"quoted\"";
+        const size_t count = 100;
+        Simd::Base::PerformanceMeasurer* pm = Simd::Base::PerformanceMeasurerStorage::s_storage.Get(name);
+
+        ::SimdPerformanceStatisticReset();
+        Measure(pm, count);
+
+        SimdPerformanceStatisticItem item;
+        result = result && FindItem(name, false, item);
+        if (result && (item.count != count || item.min > item.max || item.total < item.max))
+        {
+            TEST_LOG_SS(Error, "Wrong statistic: count = " << item.count << ", min = " << item.min << ", max = " << item.max << ", total = " << item.total << " !");
+            result = false;
+        }
+        if (result && !(item.p50 <= item.p90 && item.p90 <= item.p99 && item.p99 <= item.p999 &&
+            item.p50 >= item.min * 15 / 16 && item.p999 <= item.max * 17 / 16))
+        {
+            TEST_LOG_SS(Error, "Wrong percentiles: min = " << item.min << ", p50 = " << item.p50 << ", p90 = " << item.p90 << 
+                ", p99 = " << item.p99 << ", p999 = " << item.p999 << ", max = " << item.max << " !");
+            result = false;
+        }
+
+        String json = ::SimdPerformanceStatisticJson(SimdTrue);
+        if (result && (json.find("{\"statistics\": [") != 0 || json.find("\"name\": \"PerformanceStatisticTest \\\"quoted\\\"\", \"count\": " + ToString(count)) == String::npos ||
+            json.find("{\"thread\": ") == String::npos || json.find("]}") == String::npos))
+        {
+            TEST_LOG_SS(Error, "Wrong JSON performance statistic: " << json);
+            result = false;
+        }
+
+        std::atomic<bool> stop(false);
+        String other = name + " other thread";
+        std::thread thread([&]()
+        {
+            Simd::Base::PerformanceMeasurer* pm = Simd::Base::PerformanceMeasurerStorage::s_storage.Get(other);
+            while (!stop)
+                Measure(pm, 1);
+        });
+        for (size_t i = 0; i < count; ++i)
+        {
+            ::SimdPerformanceStatisticReset();
+            ::SimdPerformanceStatisticJson(SimdFalse);
+        }
+        stop = true;
+        thread.join();
+        ::SimdPerformanceStatisticReset();
+
+        result = result && FindItem(name, false, item);
+        if (result && (item.count != 0 || item.total != 0))
+        {
+            TEST_LOG_SS(Error, "Statistic is not reset: count = " << item.count << " !");
+            result = false;
+        }
+        result = result && FindItem(other, true, item);
+        if (result && item.count != 0)
+        {
+            TEST_LOG_SS(Error, "Statistic of other thread is not reset: count = " << item.count << " !");
+            result = false;
+        }
+
+        Measure(pm, 1);
+        result = result && FindItem(name, false, item);
+        if (result && item.count != 1)
+        {
+            TEST_LOG_SS(Error, "Wrong statistic after reset: count = " << item.count << " !");
+            result = false;
+        }
+
+        return result;
+    }
+#endif
+
+    bool PerformanceStatisticAutoTest()
+    {
+        bool result = true;
+
+#if defined(SIMD_PERFORMANCE_STATISTIC) && (defined(NDEBUG) || defined(SIMD_PERF_STAT_IN_DEBUG))
+        result = result && PerformanceHistogramTest();
+
+        result = result && PerformanceMeasurerTest();
+#else
+        TEST_LOG_SS(Info, "Test SimdPerformanceStatisticItems and SimdPerformanceStatisticJson without SIMD_PERFORMANCE_STATISTIC.");
+
+        ::SimdPerformanceStatisticReset();
+        if (::SimdPerformanceStatisticItems(NULL, 0, SimdTrue) != 0 || String(::SimdPerformanceStatisticJson(SimdFalse)) != "{\"statistics\": []}")
+        {
+            TEST_LOG_SS(Error, "Performance statistic must be empty without SIMD_PERFORMANCE_STATISTIC!");
+            result = false;
+        }
+#endif
+
+        return result;
+    }
+}
@@ -42,6 +42,8 @@ namespace Test
         case SimdResizeMethodBicubic: return "BcO";
         case SimdResizeMethodArea: return "ArO";
         case SimdResizeMethodAreaFast: return "ArF";
+        case SimdResizeMethodLanczos: return "LcO";
+        case SimdResizeMethodKernel: return "KrU";
         default: assert(0); return "";
         }
     }
@@ -66,8 +68,9 @@ namespace Test
 
             FuncPtr func;
             String description;
+            void* pool;
 
-            FuncRS(const FuncPtr & f, const String & d) : func(f), description(d) {}
+            FuncRS(const FuncPtr & f, const String & d, void* p = NULL) : func(f), description(d), pool(p) {}
 
             void Update(SimdResizeMethodType method, SimdResizeChannelType type, size_t channels, size_t srcW, size_t srcH, size_t dstW, size_t dstH)
             {
@@ -86,10 +89,15 @@ namespace Test
                     resizer = func(src.width, src.height, dst.width, dst.height, channels, type, method);
                 if (resizer)
                 {
+                    if (pool)
+                        SimdThreadPoolBind(pool);
                     {
                         TEST_PERFORMANCE_TEST(description);
+                        TEST_PERFORMANCE_TEST_SET_ELEMENTS(double(dst.width * dst.ChannelCount()) * dst.height);
                         SimdResizerRun(resizer, src.data, src.stride, dst.data, dst.stride);
                     }
+                    if (pool)
+                        SimdThreadPoolBind(NULL);
                     SimdRelease(resizer);
                 }
             }
@@ -260,6 +268,8 @@ namespace Test
         result = result && ResizerAutoTest(SimdResizeMethodBilinear, SimdResizeChannelFloat, 2, f1, f2);
         result = result && ResizerAutoTest(SimdResizeMethodBilinear, SimdResizeChannelFloat, 1, f1, f2);
 #endif
+        result = result && ResizerAutoTest(SimdResizeMethodBilinear, SimdResizeChannelByte, 1, 7, 5, 128, 48, f1, f2);
+        result = result && ResizerAutoTest(SimdResizeMethodBilinear, SimdResizeChannelByte, 1, 31, 17, 128, 48, f1, f2);
 
 #if 0
 #if defined(SIMD_X64_ENABLE) 
@@ -286,15 +296,13 @@ namespace Test
         //result = result && ResizerAutoTest(SimdResizeMethodBicubic, SimdResizeChannelByte, 4, 100, 2, 200, 10, f1, f2);
 
 #if !defined(__aarch64__) || 1  
-        std::vector<SimdResizeMethodType> methods = { SimdResizeMethodNearest, SimdResizeMethodBilinear, SimdResizeMethodBicubic, SimdResizeMethodArea, SimdResizeMethodAreaFast };
+        std::vector<SimdResizeMethodType> methods = { SimdResizeMethodNearest, SimdResizeMethodBilinear, SimdResizeMethodBicubic, SimdResizeMethodArea, SimdResizeMethodAreaFast, SimdResizeMethodLanczos };
         for (size_t m = 0; m < methods.size(); ++m)
         {
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelByte, 1, f1, f2);
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelByte, 2, f1, f2);
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelByte, 3, f1, f2);
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelByte, 4, f1, f2);
-            if (methods[m] == SimdResizeMethodBicubic || methods[m] == SimdResizeMethodArea || methods[m] == SimdResizeMethodAreaFast)
-                continue;
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelShort, 1, f1, f2);
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelShort, 2, f1, f2);
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelShort, 3, f1, f2);
@@ -302,6 +310,8 @@ namespace Test
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelFloat, 1, f1, f2);
             result = result && ResizerAutoTest(methods[m], SimdResizeChannelFloat, 3, f1, f2);
         }
+        for (size_t m = 2; m < methods.size(); ++m)
+            result = result && ResizerAutoTest(methods[m], SimdResizeChannelBf16, 3, f1, f2);
 #endif
 
         return result;
@@ -337,6 +347,393 @@ namespace Test
         return result;
     }
 
+    //-------------------------------------------------------------------------------------------------
+
+    bool ResizerParallelAutoTest(const FuncRS& f)
+    {
+        bool result = true;
+
+        void* pool = ::SimdThreadPoolInit(4, NULL, 0);
+        FuncRS f1(f.func, f.description + "-1"), f2(f.func, f.description + "-4", pool);
+
+        SimdResizeMethodType methods[] = { SimdResizeMethodNearest, SimdResizeMethodBilinear, SimdResizeMethodBicubic, SimdResizeMethodArea, SimdResizeMethodAreaFast, SimdResizeMethodLanczos };
+        for (int m = 0; m < 6; m++)
+        {
+            result = result && ResizerAutoTest(methods[m], SimdResizeChannelByte, 3, 1920, 1080, 480, 270, f1, f2);
+            result = result && ResizerAutoTest(methods[m], SimdResizeChannelByte, 1, 319, 239, 1281, 719, f1, f2);
+            result = result && ResizerAutoTest(methods[m], SimdResizeChannelShort, 2, 1919, 1081, 299, 168, f1, f2);
+            result = result && ResizerAutoTest(methods[m], SimdResizeChannelFloat, 3, 999, 749, 319, 239, f1, f2);
+        }
+        result = result && ResizerAutoTest(SimdResizeMethodBilinear, SimdResizeChannelBf16, 4, 1920, 1080, 480, 270, f1, f2);
+        result = result && ResizerAutoTest(SimdResizeMethodBicubic, SimdResizeChannelBf16, 4, 1920, 1080, 480, 270, f1, f2);
+        result = result && ResizerAutoTest(SimdResizeMethodArea, SimdResizeChannelBf16, 4, 1920, 1080, 480, 270, f1, f2);
+
+        ::SimdRelease(pool);
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    bool ResizerBatchAutoTest(SimdResizeMethodType method, SimdResizeChannelType type, size_t channels, size_t srcW, size_t srcH, size_t dstW, size_t dstH, size_t count)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test SimdResizerBatchRun [" << count << "x" << channels << ":" << srcW << "x" << srcH << "->" << dstW << "x" << dstH << ":" << ToString(method) << "-" << ToString(type) << "].");
+
+        View::Format format = View::Int16;
+        size_t k = channels;
+        if (type == SimdResizeChannelFloat)
+            format = View::Float;
+        else if (type == SimdResizeChannelByte)
+        {
+            format = channels == 1 ? View::Gray8 : (channels == 3 ? View::Bgr24 : View::Bgra32);
+            k = 1;
+        }
+
+        View src(srcW * k, srcH, format);
+        if (type == SimdResizeChannelFloat)
+            FillRandom32f(src);
+        else if (type == SimdResizeChannelBf16)
+        {
+            View src32f(srcW * k, srcH, View::Float);
+            FillRandom32f(src32f, 0.0f, 10.0f);
+            for (size_t row = 0; row < srcH; row++)
+                SimdFloat32ToBFloat16(src32f.Row<float>(row), srcW * k, src.Row<uint16_t>(row));
+        }
+        else
+            FillRandom(src);
+
+        std::vector<size_t> rois(count * 4);
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t w = 2 + Random((int)srcW / 2), h = 2 + Random((int)srcH / 2);
+            if (i % 3 == 2)
+                w = rois[i * 4 - 2] - rois[i * 4 - 4], h = rois[i * 4 - 1] - rois[i * 4 - 3];
+            rois[i * 4 + 0] = Random(int(srcW - w + 1));
+            rois[i * 4 + 1] = Random(int(srcH - h + 1));
+            rois[i * 4 + 2] = rois[i * 4 + 0] + w;
+            rois[i * 4 + 3] = rois[i * 4 + 1] + h;
+        }
+
+        View dst1(dstW * k, dstH * count, format), dst2(dstW * k, dstH * count, format);
+        if (format == View::Int16)
+        {
+            Simd::FillPixel(dst1, uint16_t(0x0001));
+            Simd::FillPixel(dst2, uint16_t(0x0002));
+        }
+        else
+        {
+            Simd::Fill(dst1, 0x01);
+            Simd::Fill(dst2, 0x02);
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const size_t* roi = rois.data() + i * 4;
+            void* resizer = SimdResizerInit(roi[2] - roi[0], roi[3] - roi[1], dstW, dstH, channels, type, method);
+            if (resizer)
+            {
+                SimdResizerRun(resizer, src.data + roi[1] * src.stride + roi[0] * k * src.PixelSize(), src.stride, dst1.data + i * dstH * dst1.stride, dst1.stride);
+                SimdRelease(resizer);
+            }
+        }
+
+        void* batch = SimdResizerBatchInit(dstW, dstH, channels, type, method);
+        if (batch == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't create batched resize context!");
+            return false;
+        }
+        void* pool = ::SimdThreadPoolInit(4, NULL, 0);
+        ::SimdThreadPoolBind(pool);
+        {
+            TEST_PERFORMANCE_TEST("SimdResizerBatchRun");
+            if (!SimdResizerBatchRun(batch, src.data, srcW, srcH, src.stride, rois.data(), count, dst2.data, dst2.stride))
+            {
+                TEST_LOG_SS(Error, "SimdResizerBatchRun has rejected valid regions!");
+                result = false;
+            }
+        }
+        ::SimdThreadPoolBind(NULL);
+        ::SimdRelease(pool);
+
+        const size_t invalid[3][4] = { { 1, 1, 1, 3 }, { 4, 1, 2, 3 }, { srcW - 2, srcH - 2, srcW + 1, srcH } };
+        View dst3(dst2.width, dst2.height, dst2.format);
+        Simd::Copy(dst2, dst3);
+        for (size_t i = 0; i < 3; ++i)
+        {
+            std::vector<size_t> bad(rois);
+            memcpy(bad.data() + i % count * 4, invalid[i], 4 * sizeof(size_t));
+            if (SimdResizerBatchRun(batch, src.data, srcW, srcH, src.stride, bad.data(), count, dst3.data, dst3.stride))
+            {
+                TEST_LOG_SS(Error, "SimdResizerBatchRun has accepted invalid region [" << invalid[i][0] << ", " << invalid[i][1] << ", " << invalid[i][2] << ", " << invalid[i][3] << "]!");
+                result = false;
+            }
+        }
+        ::SimdRelease(batch);
+        result = result && Compare(dst2, dst3, 0, true, 64, 0, "invalid regions");
+
+        if (type == SimdResizeChannelFloat)
+            result = result && Compare(dst1, dst2, EPS, true, 64, DifferenceBoth);
+        else
+            result = result && Compare(dst1, dst2, 0, true, 64);
+
+        return result;
+    }
+
+    bool ResizerBatchAutoTest()
+    {
+        bool result = true;
+
+        result = result && ResizerBatchAutoTest(SimdResizeMethodBilinear, SimdResizeChannelByte, 3, 1920, 1080, 112, 112, 32);
+        result = result && ResizerBatchAutoTest(SimdResizeMethodBilinear, SimdResizeChannelByte, 1, 640, 480, 96, 48, 17);
+        result = result && ResizerBatchAutoTest(SimdResizeMethodBilinear, SimdResizeChannelByte, 1, 64, 48, 8, 8, 5);
+        result = result && ResizerBatchAutoTest(SimdResizeMethodArea, SimdResizeChannelByte, 3, 1920, 1080, 112, 112, 32);
+        result = result && ResizerBatchAutoTest(SimdResizeMethodAreaFast, SimdResizeChannelByte, 4, 1920, 1080, 64, 64, 9);
+        result = result && ResizerBatchAutoTest(SimdResizeMethodBilinear, SimdResizeChannelFloat, 3, 1280, 720, 112, 112, 24);
+        result = result && ResizerBatchAutoTest(SimdResizeMethodBilinear, SimdResizeChannelBf16, 3, 1280, 720, 112, 112, 24);
+        result = result && ResizerBatchAutoTest(SimdResizeMethodBilinear, SimdResizeChannelByte, 3, 1920, 1080, 112, 112, 1);
+
+        return result;
+    }
+
+    bool ResizerParallelAutoTest()
+    {
+        bool result = true;
+
+        if (TestBase())
+            result = result && ResizerParallelAutoTest(FUNC_RS(Simd::Base::ResizerInit));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable && TestSse41())
+            result = result && ResizerParallelAutoTest(FUNC_RS(Simd::Sse41::ResizerInit));
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable && TestAvx2())
+            result = result && ResizerParallelAutoTest(FUNC_RS(Simd::Avx2::ResizerInit));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable && TestAvx512bw())
+            result = result && ResizerParallelAutoTest(FUNC_RS(Simd::Avx512bw::ResizerInit));
+#endif
+
+#ifdef SIMD_NEON_ENABLE
+        if (Simd::Neon::Enable && TestNeon())
+            result = result && ResizerParallelAutoTest(FUNC_RS(Simd::Neon::ResizerInit));
+#endif 
+
+        return result;
+    }
+
+    //-------------------------------------------------------------------------------------------------
+
+    namespace
+    {
+        struct FuncRK
+        {
+            typedef void*(*FuncPtr)(size_t srcX, size_t srcY, size_t dstX, size_t dstY, size_t channels, SimdResizeChannelType type, const float* kernel, size_t size, float support);
+
+            FuncPtr func;
+            String description;
+
+            FuncRK(const FuncPtr& f, const String& d) : func(f), description(d) {}
+
+            void Update(SimdResizeChannelType type, size_t channels, size_t srcW, size_t srcH, size_t dstW, size_t dstH)
+            {
+                std::stringstream ss;
+                ss << description << "[" << channels << ":" << srcW << "x" << srcH << "->" << dstW << "x" << dstH << ":" << ToString(type) << "]";
+                description = ss.str();
+            }
+
+            void Call(const View& src, View& dst, size_t channels, SimdResizeChannelType type, const Buffer32f& kernel, float support) const
+            {
+                size_t k = (src.format == View::Float || src.format == View::Int16) ? channels : 1;
+                void* resizer = func(src.width / k, src.height, dst.width / k, dst.height, channels, type, kernel.data(), kernel.size(), support);
+                if (resizer)
+                {
+                    TEST_PERFORMANCE_TEST(description);
+                    SimdResizerRun(resizer, src.data, src.stride, dst.data, dst.stride);
+                    SimdRelease(resizer);
+                }
+            }
+        };
+    }
+
+#define FUNC_RK(function) \
+    FuncRK(function, std::string(#function))
+
+    void MitchellKernel(size_t size, Buffer32f& kernel, float& support)
+    {
+        const double B = 1.0 / 3.0, C = 1.0 / 3.0;
+        support = 2.0f;
+        kernel.resize(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            double x = double(i) * support / double(size - 1);
+            if (x < 1.0)
+                kernel[i] = float(((12 - 9 * B - 6 * C) * x * x * x + (-18 + 12 * B + 6 * C) * x * x + (6 - 2 * B)) / 6.0);
+            else
+                kernel[i] = float(((-B - 6 * C) * x * x * x + (6 * B + 30 * C) * x * x + (-12 * B - 48 * C) * x + (8 * B + 24 * C)) / 6.0);
+        }
+    }
+
+    bool ResizerKernelAutoTest(SimdResizeChannelType type, size_t channels, size_t srcW, size_t srcH, size_t dstW, size_t dstH, FuncRK f1, FuncRK f2)
+    {
+        bool result = true;
+
+        f1.Update(type, channels, srcW, srcH, dstW, dstH);
+        f2.Update(type, channels, srcW, srcH, dstW, dstH);
+
+        TEST_LOG_SS(Info, "Test " << f1.description << " & " << f2.description << ".");
+
+        View::Format format = View::Int16;
+        size_t k = channels;
+        if (type == SimdResizeChannelFloat)
+            format = View::Float;
+        else if (type == SimdResizeChannelByte)
+        {
+            format = channels == 1 ? View::Gray8 : (channels == 3 ? View::Bgr24 : View::Bgra32);
+            k = 1;
+        }
+
+        View src(srcW * k, srcH, format);
+        if (type == SimdResizeChannelFloat)
+            FillRandom32f(src);
+        else if (type == SimdResizeChannelShort)
+            FillRandom16u(src);
+        else if (type == SimdResizeChannelBf16)
+        {
+            View src32f(srcW * k, srcH, View::Float);
+            FillRandom32f(src32f, 0.0f, 10.0f);
+            for (size_t row = 0; row < srcH; row++)
+                SimdFloat32ToBFloat16(src32f.Row<float>(row), srcW * k, src.Row<uint16_t>(row));
+        }
+        else
+            FillRandom(src);
+
+        View dst1(dstW * k, dstH, format), dst2(dstW * k, dstH, format);
+        if (format == View::Int16)
+        {
+            Simd::FillPixel(dst1, uint16_t(0x0001));
+            Simd::FillPixel(dst2, uint16_t(0x0002));
+        }
+        else
+        {
+            Simd::Fill(dst1, 0x01);
+            Simd::Fill(dst2, 0x02);
+        }
+
+        Buffer32f kernel;
+        float support;
+        MitchellKernel(1025, kernel, support);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(src, dst1, channels, type, kernel, support));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(src, dst2, channels, type, kernel, support));
+
+        if (type == SimdResizeChannelFloat)
+            result = result && Compare(dst1, dst2, EPS, true, 64, DifferenceBoth);
+        else if (type == SimdResizeChannelBf16)
+        {
+            View dst32f1(dstW * k, dstH, View::Float), dst32f2(dstW * k, dstH, View::Float);
+            for (size_t row = 0; row < dstH; row++)
+            {
+                SimdBFloat16ToFloat32(dst1.Row<uint16_t>(row), dstW * k, dst32f1.Row<float>(row));
+                SimdBFloat16ToFloat32(dst2.Row<uint16_t>(row), dstW * k, dst32f2.Row<float>(row));
+            }
+            result = result && Compare(dst32f1, dst32f2, EPS * 8.0f, true, 64, DifferenceBoth);
+        }
+        else if (type == SimdResizeChannelShort)
+            result = result && Compare(dst1, dst2, 1, true, 64);
+        else
+            result = result && Compare(dst1, dst2, 0, true, 64);
+
+        return result;
+    }
+
+    bool ResizerKernelLanczosTest(size_t channels, size_t srcW, size_t srcH, size_t dstW, size_t dstH)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test SimdResizerInitKernel with Lanczos3 samples & SimdResizeMethodLanczos [" << channels << ":" << srcW << "x" << srcH << "->" << dstW << "x" << dstH << "].");
+
+        View src(srcW * channels, srcH, View::Float), dst1(dstW * channels, dstH, View::Float), dst2(dstW * channels, dstH, View::Float);
+        FillRandom32f(src, 0.0f, 1.0f);
+
+        const size_t size = 4097;
+        Buffer32f kernel(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            double x = double(i) * 3.0 / double(size - 1), px = x * M_PI;
+            kernel[i] = i ? float(3.0 * ::sin(px) * ::sin(px / 3.0) / (px * px)) : 1.0f;
+        }
+
+        void* resizer1 = SimdResizerInitKernel(srcW, srcH, dstW, dstH, channels, SimdResizeChannelFloat, kernel.data(), size, 3.0f);
+        void* resizer2 = SimdResizerInit(srcW, srcH, dstW, dstH, channels, SimdResizeChannelFloat, SimdResizeMethodLanczos);
+        if (resizer1 == NULL || resizer2 == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't create resize context!");
+            result = false;
+        }
+        else
+        {
+            SimdResizerRun(resizer1, src.data, src.stride, dst1.data, dst1.stride);
+            SimdResizerRun(resizer2, src.data, src.stride, dst2.data, dst2.stride);
+            result = result && Compare(dst1, dst2, EPS, true, 64, DifferenceBoth);
+        }
+        SimdRelease(resizer1);
+        SimdRelease(resizer2);
+
+        return result;
+    }
+
+    bool ResizerKernelAutoTest(const FuncRK& f1, const FuncRK& f2)
+    {
+        bool result = true;
+
+        result = result && ResizerKernelAutoTest(SimdResizeChannelByte, 1, 1920, 1080, 299, 168, f1, f2);
+        result = result && ResizerKernelAutoTest(SimdResizeChannelByte, 3, 319, 239, 1281, 719, f1, f2);
+        result = result && ResizerKernelAutoTest(SimdResizeChannelByte, 4, 960, 540, 480, 270, f1, f2);
+        result = result && ResizerKernelAutoTest(SimdResizeChannelShort, 1, 1919, 1081, 299, 168, f1, f2);
+        result = result && ResizerKernelAutoTest(SimdResizeChannelShort, 2, 124, 93, 319, 239, f1, f2);
+        result = result && ResizerKernelAutoTest(SimdResizeChannelFloat, 3, 999, 749, 319, 239, f1, f2);
+        result = result && ResizerKernelAutoTest(SimdResizeChannelBf16, 4, 499, 374, 319, 239, f1, f2);
+
+        return result;
+    }
+
+    bool ResizerKernelAutoTest()
+    {
+        bool result = true;
+
+        if (TestBase())
+        {
+            result = result && ResizerKernelAutoTest(FUNC_RK(Simd::Base::ResizerKernelInit), FUNC_RK(SimdResizerInitKernel));
+            result = result && ResizerKernelLanczosTest(3, 1920, 1080, 299, 168);
+            result = result && ResizerKernelLanczosTest(1, 319, 239, 1281, 719);
+        }
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable && TestSse41())
+            result = result && ResizerKernelAutoTest(FUNC_RK(Simd::Sse41::ResizerKernelInit), FUNC_RK(SimdResizerInitKernel));
+#endif
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable && TestAvx2())
+            result = result && ResizerKernelAutoTest(FUNC_RK(Simd::Avx2::ResizerKernelInit), FUNC_RK(SimdResizerInitKernel));
+#endif
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable && TestAvx512bw())
+            result = result && ResizerKernelAutoTest(FUNC_RK(Simd::Avx512bw::ResizerKernelInit), FUNC_RK(SimdResizerInitKernel));
+#endif
+
+        return result;
+    }
+
     //---------------------------------------------------------------------------------------------
 
     bool ResizeYuv420pSpecialTest(SimdResizeMethodType method)
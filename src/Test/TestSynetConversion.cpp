@@ -28,6 +28,7 @@
 #include "Test/TestRandom.h"
 
 #include "Simd/SimdSynet.h"
+#include "Simd/SimdSynetPreprocess.h"
 
 namespace Test
 {
@@ -334,5 +335,182 @@ namespace Test
 
         return result;
     }
+
+    //-------------------------------------------------------------------------------------------------
+
+    String ToString(SimdResizeMethodType method);
+
+    namespace
+    {
+        struct FuncSP
+        {
+            typedef void* (*FuncPtr)(size_t srcW, size_t srcH, SimdPixelFormatType srcFormat, SimdYuvType yuvType, size_t dstW, size_t dstH, size_t channels,
+                SimdResizeMethodType method, const float* lower, const float* upper, SimdTensorDataType dstType, SimdTensorFormatType dstFormat);
+
+            FuncPtr func;
+            String desc;
+
+            FuncSP(const FuncPtr& f, const String& d) : func(f), desc(d) {}
+
+            void Update(SimdPixelFormatType src, size_t c, size_t sw, size_t sh, size_t dw, size_t dh, SimdResizeMethodType m, SimdTensorDataType t, SimdTensorFormatType f)
+            {
+                std::stringstream ss;
+                ss << desc << "[" << ToString((View::Format)src) << "-" << c << ":" << sw << "x" << sh << "->" << dw << "x" << dh << ":";
+                ss << ToString(m) << "-" << ToChar(t) << "-" << ToString(f) << "]";
+                desc = ss.str();
+            }
+
+            void Call(void* context, const View& y, const View& u, const View& v, View& dst) const
+            {
+                TEST_PERFORMANCE_TEST(desc);
+                TEST_PERFORMANCE_TEST_SET_ELEMENTS(double(dst.width) * dst.height);
+                SimdSynetPreprocessForward(context, y.data, y.stride, u.data, u.stride, v.data, v.stride, dst.data);
+            }
+        };
+    }
+
+#define FUNC_SP(function) FuncSP(function, #function)
+
+    bool SynetPreprocessAutoTest(SimdPixelFormatType srcFormat, size_t c, size_t srcW, size_t srcH, size_t dstW, size_t dstH, 
+        SimdResizeMethodType method, SimdTensorDataType dstType, SimdTensorFormatType dstFormat, FuncSP f1, FuncSP f2)
+    {
+        bool result = true;
+
+        f1.Update(srcFormat, c, srcW, srcH, dstW, dstH, method, dstType, dstFormat);
+        f2.Update(srcFormat, c, srcW, srcH, dstW, dstH, method, dstType, dstFormat);
+
+        TEST_LOG_SS(Info, "Test " << f1.desc << " & " << f2.desc);
+
+        bool yuv = srcFormat == SimdPixelFormatNv12 || srcFormat == SimdPixelFormatYuv420p;
+        View y(srcW, srcH, yuv ? View::Gray8 : (View::Format)srcFormat), u, v;
+        FillRandom(y);
+        if (srcFormat == SimdPixelFormatNv12)
+        {
+            u.Recreate(srcW / 2, srcH / 2, View::Uv16);
+            FillRandom(u);
+        }
+        else if (srcFormat == SimdPixelFormatYuv420p)
+        {
+            u.Recreate(srcW / 2, srcH / 2, View::Gray8);
+            v.Recreate(srcW / 2, srcH / 2, View::Gray8);
+            FillRandom(u);
+            FillRandom(v);
+        }
+
+        View::Format format = dstType == SimdTensorData32f ? View::Float : (dstType == SimdTensorData16b ? View::Int16 : View::Gray8);
+        View dst1(dstW * c, dstH, format, NULL, 1), dst2(dstW * c, dstH, format, NULL, 1);
+
+        float lower[3] = { -0.9f, -1.0f, -1.2f };
+        float upper[3] = { 0.91f, 1.01f, 1.21f };
+        if (dstType == SimdTensorData8u)
+        {
+            lower[0] = 1.0f, lower[1] = -2.0f, lower[2] = 0.0f;
+            upper[0] = 250.0f, upper[1] = 260.0f, upper[2] = 255.0f;
+        }
+
+        void* context1 = f1.func(srcW, srcH, srcFormat, SimdYuvBt601, dstW, dstH, c, method, lower, upper, dstType, dstFormat);
+        void* context2 = f2.func(srcW, srcH, srcFormat, SimdYuvBt601, dstW, dstH, c, method, lower, upper, dstType, dstFormat);
+        if (context1 == NULL || context2 == NULL)
+        {
+            TEST_LOG_SS(Error, "Can't create preprocessing context!");
+            SimdRelease(context1);
+            SimdRelease(context2);
+            return false;
+        }
+
+        TEST_ALIGN(SIMD_ALIGN);
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f1.Call(context1, y, u, v, dst1));
+
+        TEST_EXECUTE_AT_LEAST_MIN_TIME(f2.Call(context2, y, u, v, dst2));
+
+        SimdRelease(context1);
+        SimdRelease(context2);
+
+        if (dstType == SimdTensorData32f)
+            result = result && Compare(dst1, dst2, EPS, true, 64, DifferenceBoth);
+        else if (dstType == SimdTensorData16b)
+        {
+            View dst32f1(dstW * c, dstH, View::Float, NULL, 1), dst32f2(dstW * c, dstH, View::Float, NULL, 1);
+            SimdBFloat16ToFloat32(dst1.Row<uint16_t>(0), dstW * c * dstH, dst32f1.Row<float>(0));
+            SimdBFloat16ToFloat32(dst2.Row<uint16_t>(0), dstW * c * dstH, dst32f2.Row<float>(0));
+            result = result && Compare(dst32f1, dst32f2, EPS * 8.0f, true, 64, DifferenceBoth);
+        }
+        else
+            result = result && Compare(dst1, dst2, 1, true, 64);
+
+        if (result && !yuv && srcW == dstW && srcH == dstH && dstType == SimdTensorData32f)
+        {
+            Tensor32f ref(ToShape(1, c, dstH, dstW, dstFormat), dstFormat);
+            SimdSynetSetInput(y.data, y.width, y.height, y.stride, srcFormat, lower, upper, ref.Data(), c, dstFormat);
+            View dst3(dstW * c, dstH, dstW * c * 4, View::Float, ref.Data());
+            result = result && Compare(dst3, dst2, EPS, true, 64, DifferenceBoth, "SimdSynetSetInput");
+        }
+
+        return result;
+    }
+
+    bool SynetPreprocessAutoTest(const FuncSP& f1, const FuncSP& f2)
+    {
+        bool result = true;
+
+        SimdPixelFormatType srcFormats[7] = { SimdPixelFormatGray8, SimdPixelFormatBgr24, SimdPixelFormatBgra32, SimdPixelFormatRgb24, 
+            SimdPixelFormatRgba32, SimdPixelFormatNv12, SimdPixelFormatYuv420p };
+        SimdTensorDataType dstTypes[3] = { SimdTensorData32f, SimdTensorData16b, SimdTensorData8u };
+        SimdTensorFormatType dstFormats[2] = { SimdTensorFormatNchw, SimdTensorFormatNhwc };
+
+        for (int s = 0; s < 7; ++s)
+        {
+            for (size_t c = 1; c <= 3; c += 2)
+            {
+                result = result && SynetPreprocessAutoTest(srcFormats[s], c, 1920, 1080, 300, 300, SimdResizeMethodBilinear, SimdTensorData32f, SimdTensorFormatNchw, f1, f2);
+                result = result && SynetPreprocessAutoTest(srcFormats[s], c, 1280, 720, 224, 224, SimdResizeMethodArea, SimdTensorData32f, SimdTensorFormatNhwc, f1, f2);
+                result = result && SynetPreprocessAutoTest(srcFormats[s], c, 96, 64, 97, 63, SimdResizeMethodArea, SimdTensorData32f, SimdTensorFormatNchw, f1, f2);
+            }
+        }
+        for (int t = 0; t < 3; ++t)
+        {
+            for (int f = 0; f < 2; ++f)
+            {
+                result = result && SynetPreprocessAutoTest(SimdPixelFormatBgr24, 3, 640, 480, 320, 240, SimdResizeMethodBilinear, dstTypes[t], dstFormats[f], f1, f2);
+                result = result && SynetPreprocessAutoTest(SimdPixelFormatNv12, 3, 640, 480, 299, 171, SimdResizeMethodArea, dstTypes[t], dstFormats[f], f1, f2);
+            }
+        }
+        for (int s = 0; s < 5; ++s)
+            result = result && SynetPreprocessAutoTest(srcFormats[s], 3, 112, 96, 112, 96, SimdResizeMethodBilinear, SimdTensorData32f, SimdTensorFormatNchw, f1, f2);
+        for (size_t c = 1; c <= 3; c += 2)
+        {
+            result = result && SynetPreprocessAutoTest(SimdPixelFormatGray8, c, 2, 2, 37, 5, SimdResizeMethodBilinear, SimdTensorData32f, SimdTensorFormatNhwc, f1, f2);
+            result = result && SynetPreprocessAutoTest(SimdPixelFormatBgr24, c, 47, 9, 21, 3, SimdResizeMethodBilinear, SimdTensorData32f, SimdTensorFormatNchw, f1, f2);
+            result = result && SynetPreprocessAutoTest(SimdPixelFormatBgr24, c, 203, 61, 9, 5, SimdResizeMethodArea, SimdTensorData32f, SimdTensorFormatNhwc, f1, f2);
+        }
+
+        return result;
+    }
+
+    bool SynetPreprocessAutoTest()
+    {
+        bool result = true;
+
+        if (TestBase())
+            result = result && SynetPreprocessAutoTest(FUNC_SP(Simd::Base::SynetPreprocessInit), FUNC_SP(SimdSynetPreprocessInit));
+
+#ifdef SIMD_SSE41_ENABLE
+        if (Simd::Sse41::Enable && TestSse41())
+            result = result && SynetPreprocessAutoTest(FUNC_SP(Simd::Sse41::SynetPreprocessInit), FUNC_SP(SimdSynetPreprocessInit));
+#endif 
+
+#ifdef SIMD_AVX2_ENABLE
+        if (Simd::Avx2::Enable && TestAvx2())
+            result = result && SynetPreprocessAutoTest(FUNC_SP(Simd::Avx2::SynetPreprocessInit), FUNC_SP(SimdSynetPreprocessInit));
+#endif 
+
+#ifdef SIMD_AVX512BW_ENABLE
+        if (Simd::Avx512bw::Enable && TestAvx512bw())
+            result = result && SynetPreprocessAutoTest(FUNC_SP(Simd::Avx512bw::SynetPreprocessInit), FUNC_SP(SimdSynetPreprocessInit));
+#endif 
+
+        return result;
+    }
 #endif
 }
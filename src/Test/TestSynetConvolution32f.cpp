@@ -43,17 +43,21 @@ namespace Test
 
             FuncPtr func;
             String desc;
+            double flop;
 
-            FuncC(const FuncPtr & f, const String & d) : func(f), desc(d) {}
+            FuncC(const FuncPtr & f, const String & d) : func(f), desc(d), flop(0) {}
 
             void Update(const Param & p)
             {
+                const SimdConvolutionParameters & c = p.conv;
                 desc = desc + p.Decription();
+                flop = 2.0 * p.batch * c.dstH * c.dstW * c.dstC * c.kernelY * c.kernelX * c.srcC / c.group;
             }
 
             void Call(void * context, const Tensor32f & src, Tensor32f & buf, Tensor32f & dst) const
             {
                 TEST_PERFORMANCE_TEST(desc);
+                TEST_PERFORMANCE_TEST_SET_FLOP(flop);
                 ::SimdSynetConvolution32fForward(context, src.Data(), buf.Data(), dst.Data());
             }
         };
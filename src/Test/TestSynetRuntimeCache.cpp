@@ -0,0 +1,175 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include "Test/TestCompare.h"
+#include "Test/TestPerformance.h"
+#include "Test/TestTensor.h"
+#include "Test/TestSynetConvolutionParam.h"
+#include "Test/TestRandom.h"
+#include "Test/TestFile.h"
+
+#include "Simd/SimdSynetConvolution32f.h"
+
+#include <cstdio>
+#include <fstream>
+
+namespace Test
+{
+#if defined(SIMD_SYNET_ENABLE)
+    namespace
+    {
+        typedef Test::SynetConvolutionParam<false> Param;
+
+        struct Data
+        {
+            Tensor32f src, weight, bias, params, dst;
+
+            Data(const Param & p)
+            {
+                const SimdConvolutionParameters & c = p.conv;
+                src.Reshape({ p.batch, c.srcH, c.srcW, c.srcC });
+                FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+                weight.Reshape({ c.kernelY, c.kernelX, c.srcC / c.group, c.dstC });
+                FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+                bias.Reshape({ c.dstC });
+                FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+                params.Reshape({ c.dstC });
+                FillRandom(params.Data(), params.Size(), 0.0f, 2.0f);
+                dst.Reshape({ p.batch, c.dstH, c.dstW, c.dstC });
+            }
+        };
+
+        void Forward(const Param & p, Data & d, Tensor32f & dst, size_t count)
+        {
+            void * context = ::SimdSynetConvolution32fInit(p.batch, &p.conv);
+            Tensor32f buf({ ::SimdSynetConvolution32fExternalBufferSize(context) });
+            ::SimdSynetConvolution32fSetParams(context, d.weight.Data(), NULL, d.bias.Data(), d.params.Data());
+            dst.Reshape(d.dst.Shape());
+            for (size_t i = 0; i < count; ++i)
+                ::SimdSynetConvolution32fForward(context, d.src.Data(), buf.Data(), dst.Data());
+            ::SimdRelease(context);
+        }
+
+        size_t CacheEntries(const String & path)
+        {
+            std::ifstream ifs(path.c_str());
+            size_t entries = 0;
+            String line;
+            while (std::getline(ifs, line))
+                if (line.size() && line[0] != '#')
+                    entries++;
+            return entries;
+        }
+
+        struct Stat
+        {
+            size_t hits, misses, stores;
+        };
+    }
+
+    bool SynetRuntimeCacheAutoTest(const Param & p, SimdRuntimeCacheModeType mode, const String & path, Data & d, Stat & stat)
+    {
+        bool result = true;
+
+        TEST_LOG_SS(Info, "Test SimdSetRuntimeCache(" << path << ", " << (int)mode << ") for " << p.Decription() << ".");
+
+        if (!::SimdSetRuntimeCache(path.c_str(), mode))
+        {
+            TEST_LOG_SS(Error, "Can't set runtime cache '" << path << "' !");
+            return false;
+        }
+
+        Tensor32f dst;
+        Forward(p, d, dst, 11);
+
+        const Simd::Base::RuntimeCache & cache = Simd::Base::RuntimeCache::Global();
+        stat.hits = cache.Hits();
+        stat.misses = cache.Misses();
+        stat.stores = cache.Stores();
+
+        ::SimdSetRuntimeCache(NULL, SimdRuntimeCacheOff);
+
+        result = result && Compare(d.dst, dst, EPS, true, 64, DifferenceBoth);
+
+        if (FileExists(path + ".tmp"))
+        {
+            TEST_LOG_SS(Error, "Temporary file of runtime cache '" << path << "' is not removed !");
+            result = false;
+        }
+
+        return result;
+    }
+
+    bool SynetRuntimeCacheAutoTest()
+    {
+        bool result = true;
+
+        const SimdConvolutionActivationType a = SimdConvolutionActivationRelu;
+        const String path = TempPath("runtime_cache.txt");
+        Param p(SimdTrue, 1, 64, 24, 24, 64, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, a);
+        Data d(p);
+
+        ::SimdSetRuntimeCache(NULL, SimdRuntimeCacheOff);
+        Forward(p, d, d.dst, 1);
+
+        std::remove(path.c_str());
+        if (::SimdSetRuntimeCache(path.c_str(), SimdRuntimeCacheRead))
+        {
+            TEST_LOG_SS(Error, "Missing runtime cache '" << path << "' is opened in read mode !");
+            result = false;
+        }
+
+        Stat tune, read, readWrite;
+        result = result && SynetRuntimeCacheAutoTest(p, SimdRuntimeCacheTune, path, d, tune);
+        if (result && tune.stores == 0)
+        {
+            TEST_LOG_SS(Info, "There is no runtime tuned algorithm for " << p.Decription() << " on current ISA.");
+            std::remove(path.c_str());
+            return result;
+        }
+        if (result && CacheEntries(path) == 0)
+        {
+            TEST_LOG_SS(Error, "Tuning results are not saved to runtime cache '" << path << "' !");
+            result = false;
+        }
+
+        result = result && SynetRuntimeCacheAutoTest(p, SimdRuntimeCacheRead, path, d, read);
+        if (result && (read.hits == 0 || read.misses != 0 || read.stores != 0))
+        {
+            TEST_LOG_SS(Error, "Runtime cache in read mode: hits = " << read.hits << ", misses = " << read.misses << ", stores = " << read.stores << " !");
+            result = false;
+        }
+
+        result = result && SynetRuntimeCacheAutoTest(p, SimdRuntimeCacheReadWrite, path, d, readWrite);
+        if (result && (readWrite.hits == 0 || readWrite.misses != 0 || readWrite.stores != 0))
+        {
+            TEST_LOG_SS(Error, "Runtime cache in read-write mode retunes cached problems: hits = " << readWrite.hits << ", misses = " << readWrite.misses << ", stores = " << readWrite.stores << " !");
+            result = false;
+        }
+        std::remove(path.c_str());
+
+        return result;
+    }
+#endif
+}
@@ -0,0 +1,132 @@
+/*
+* Tests for Simd Library (http://ermig1979.github.io/Simd).
+*
+* Copyright (c) 2011-2024 Yermalayeu Ihar.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*/
+
+#include "Test/TestCompare.h"
+#include "Test/TestPerformance.h"
+#include "Test/TestTensor.h"
+#include "Test/TestSynetConvolutionParam.h"
+#include "Test/TestRandom.h"
+
+namespace Test
+{
+#if defined(SIMD_SYNET_ENABLE)
+    namespace
+    {
+        typedef Test::SynetConvolutionParam<false> Param;
+
+        struct Layer
+        {
+            Param param;
+            Tensor32f weight, bias, params, dst1, dst2;
+            void * context1, * context2;
+
+            Layer(const Param & p)
+                : param(p)
+            {
+                const SimdConvolutionParameters & c = p.conv;
+                weight.Reshape({ c.kernelY, c.kernelX, c.srcC / c.group, c.dstC });
+                FillRandom(weight.Data(), weight.Size(), -1.0, 1.0f);
+                bias.Reshape({ c.dstC });
+                FillRandom(bias.Data(), bias.Size(), -1.0, 1.0f);
+                params.Reshape({ c.dstC });
+                FillRandom(params.Data(), params.Size(), 0.0f, 2.0f);
+                dst1.Reshape({ p.batch, c.dstH, c.dstW, c.dstC });
+                dst2.Reshape({ p.batch, c.dstH, c.dstW, c.dstC });
+                context1 = ::SimdSynetConvolution32fInit(p.batch, &c);
+                context2 = ::SimdSynetConvolution32fInit(p.batch, &c);
+                ::SimdSynetConvolution32fSetParams(context1, weight.Data(), NULL, bias.Data(), params.Data());
+                ::SimdSynetConvolution32fSetParams(context2, weight.Data(), NULL, bias.Data(), params.Data());
+            }
+
+            ~Layer()
+            {
+                ::SimdRelease(context1);
+                ::SimdRelease(context2);
+            }
+        };
+    }
+
+    bool SynetWorkspaceAutoTest()
+    {
+        bool result = true;
+
+        const SimdConvolutionActivationType a = SimdConvolutionActivationRelu;
+        Param params[3] = {
+            Param(SimdTrue, 1, 32, 32, 32, 64, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, a),
+            Param(SimdTrue, 1, 64, 32, 32, 64, 3, 3, 1, 1, 2, 2, 1, 1, 1, 1, 1, a),
+            Param(SimdTrue, 1, 64, 16, 16, 128, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 1, a) };
+        std::vector<std::shared_ptr<Layer>> layers;
+        for (size_t i = 0; i < 3; ++i)
+            layers.push_back(std::make_shared<Layer>(params[i]));
+
+        TEST_LOG_SS(Info, "Test SimdSynetSetWorkspace for " << layers.size() << " convolutions.");
+
+        Tensor32f src({ 1, 32, 32, 32 });
+        FillRandom(src.Data(), src.Size(), -1.0, 1.0f);
+        for (size_t i = 0; i < layers.size(); ++i)
+            ::SimdSynetConvolution32fForward(layers[i]->context2, i ? layers[i - 1]->dst2.Data() : src.Data(), NULL, layers[i]->dst2.Data());
+
+        void * workspace = ::SimdSynetWorkspaceInit();
+        size_t peak = 0;
+        for (size_t i = 0; i < layers.size(); ++i)
+        {
+            if (!::SimdSynetSetWorkspace(layers[i]->context2, workspace))
+            {
+                TEST_LOG_SS(Error, "SimdSynetSetWorkspace is not supported by " << ::SimdSynetConvolution32fInfo(layers[i]->context2) << " !");
+                result = false;
+            }
+            peak = std::max(peak, ::SimdSynetConvolution32fExternalBufferSize(layers[i]->context2) * sizeof(float));
+        }
+        if (::SimdSynetWorkspacePeak(workspace) != peak)
+        {
+            TEST_LOG_SS(Error, "Workspace peak " << ::SimdSynetWorkspacePeak(workspace) << " != " << peak << " !");
+            result = false;
+        }
+
+        for (size_t i = 0; i < layers.size() && result; ++i)
+        {
+            const Tensor32f & input = i ? layers[i - 1]->dst1 : src;
+            ::SimdSynetConvolution32fForward(layers[i]->context1, input.Data(), NULL, layers[i]->dst1.Data());
+            ::SimdSynetConvolution32fForward(layers[i]->context2, input.Data(), NULL, layers[i]->dst2.Data());
+            result = result && Compare(layers[i]->dst1, layers[i]->dst2, EPS, true, 64, DifferenceBoth);
+            size_t internal1 = ::SimdSynetConvolution32fInternalBufferSize(layers[i]->context1);
+            size_t internal2 = ::SimdSynetConvolution32fInternalBufferSize(layers[i]->context2);
+            size_t external = ::SimdSynetConvolution32fExternalBufferSize(layers[i]->context2);
+            if (external <= 1)
+                external = 0; // a layer reports a buffer of size 1 when it doesn't use it.
+            if (internal1 != internal2 + external)
+            {
+                TEST_LOG_SS(Error, "Private buffer of " << ::SimdSynetConvolution32fInfo(layers[i]->context2) << " is not released: "
+                    << internal2 << " + " << external << " != " << internal1 << " !");
+                result = false;
+            }
+        }
+
+        layers.clear();
+        ::SimdRelease(workspace);
+
+        return result;
+    }
+#endif
+}